@@ -0,0 +1,134 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// Overhead of matrix-free operator callbacks in the native Krylov solvers: a fixed number of CG iterations
+    /// on the 5-point Laplacian, assembled as CSR against the same stencil applied by a managed callback.
+    /// A diagonal callback isolates the cost of the transition itself.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class MatrixFreeKrylov
+    {
+        [Params(100, 300, 1000)]
+        public int Grid { get; set; }
+
+        [Params(100)]
+        public int Iterations { get; set; }
+
+        int _n;
+        int[] _rowPointers;
+        int[] _columnIndices;
+        double[] _values;
+        double[] _diagonal;
+        double[] _b;
+        double[] _x;
+        double[] _in;
+        double[] _out;
+
+        // Kept in fields so the delegates outlive the native calls.
+        SparseCallback _stencil;
+        SparseCallback _scale;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+
+            _n = Grid*Grid;
+            _rowPointers = new int[_n + 1];
+            _columnIndices = new int[5*_n];
+            _values = new double[5*_n];
+
+            var nnz = 0;
+            for (var i = 0; i < Grid; i++)
+            {
+                for (var j = 0; j < Grid; j++)
+                {
+                    var row = i*Grid + j;
+                    if (i > 0) { _columnIndices[nnz] = row - Grid; _values[nnz++] = -1.0; }
+                    if (j > 0) { _columnIndices[nnz] = row - 1; _values[nnz++] = -1.0; }
+                    _columnIndices[nnz] = row; _values[nnz++] = 4.0;
+                    if (j < Grid - 1) { _columnIndices[nnz] = row + 1; _values[nnz++] = -1.0; }
+                    if (i < Grid - 1) { _columnIndices[nnz] = row + Grid; _values[nnz++] = -1.0; }
+                    _rowPointers[row + 1] = nnz;
+                }
+            }
+
+            _diagonal = new double[_n];
+            _b = new double[_n];
+            for (var i = 0; i < _n; i++)
+            {
+                _diagonal[i] = 1.0 + i%1000;
+                _b[i] = 1.0;
+            }
+
+            _x = new double[_n];
+            _in = new double[_n];
+            _out = new double[_n];
+            _stencil = Stencil;
+            _scale = Scale;
+        }
+
+        int Stencil(IntPtr context, IntPtr x, IntPtr y)
+        {
+            Marshal.Copy(x, _in, 0, _n);
+            for (var i = 0; i < Grid; i++)
+            {
+                for (var j = 0; j < Grid; j++)
+                {
+                    var row = i*Grid + j;
+                    var sum = 4.0*_in[row];
+                    if (i > 0) sum -= _in[row - Grid];
+                    if (j > 0) sum -= _in[row - 1];
+                    if (j < Grid - 1) sum -= _in[row + 1];
+                    if (i < Grid - 1) sum -= _in[row + Grid];
+                    _out[row] = sum;
+                }
+            }
+
+            Marshal.Copy(_out, 0, y, _n);
+            return 0;
+        }
+
+        int Scale(IntPtr context, IntPtr x, IntPtr y)
+        {
+            Marshal.Copy(x, _in, 0, _n);
+            for (var i = 0; i < _n; i++)
+            {
+                _out[i] = _diagonal[i]*_in[i];
+            }
+
+            Marshal.Copy(_out, 0, y, _n);
+            return 0;
+        }
+
+        [IterationSetup]
+        public void Reset()
+        {
+            Array.Clear(_x, 0, _n);
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = 1)]
+        public int Csr()
+        {
+            return d_sparse_cg(_n, _rowPointers, _columnIndices, _values, IntPtr.Zero, _b, _x, Iterations, 0.0, 0.0, out _, null, out _);
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int StencilCallback()
+        {
+            return d_matrix_free_cg(_n, _stencil, null, IntPtr.Zero, _b, _x, Iterations, 0.0, 0.0, out _, null, out _);
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int DiagonalCallback()
+        {
+            return d_matrix_free_cg(_n, _scale, null, IntPtr.Zero, _b, _x, Iterations, 0.0, 0.0, out _, null, out _);
+        }
+    }
+}
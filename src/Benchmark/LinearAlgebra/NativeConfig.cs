@@ -0,0 +1,33 @@
+﻿using System;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Environments;
+using BenchmarkDotNet.Jobs;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// Jobs for the benchmarks that call the native exports directly through the MKL provider's
+    /// SafeNativeMethods (visible to this assembly), so they need the native MKL provider and x64.
+    /// </summary>
+    class NativeConfig : ManualConfig
+    {
+        public NativeConfig()
+        {
+            AddJob(Job.Default.WithRuntime(ClrRuntime.Net48).WithPlatform(Platform.X64).WithJit(Jit.RyuJit));
+#if NET5_0_OR_GREATER
+            AddJob(Job.Default.WithRuntime(CoreRuntime.Core50).WithPlatform(Platform.X64).WithJit(Jit.RyuJit));
+#endif
+        }
+
+        /// <summary>
+        /// Fails the setup if a native export returned a nonzero info, so a benchmark never times an empty handle.
+        /// </summary>
+        public static void Check(int info, string export)
+        {
+            if (info != 0)
+            {
+                throw new InvalidOperationException(export + " returned " + info + ".");
+            }
+        }
+    }
+}
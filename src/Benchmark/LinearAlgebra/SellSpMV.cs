@@ -0,0 +1,159 @@
+﻿using System;
+using System.IO;
+using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics.Data.Text;
+using AHSEsim.Numerics.LinearAlgebra;
+using AHSEsim.Numerics.LinearAlgebra.Storage;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// SpMV in SELL-C-sigma storage (default C and sigma) against CSR, both as handles created once in setup;
+    /// the CSR baseline is an MKL handle run through mkl_sparse_optimize. The real matrices of data/MatrixMarket
+    /// fit in cache, so Irregular1M adds a generated matrix of one million rows with 4 to 31 entries each
+    /// (about 17M non-zeros, some 200 MB in CSR) that does not.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class SellSpMV
+    {
+        const int Repeat = 100;
+        const int General = 0;
+        const int ExpectedCalls = 1000;
+        const string Irregular = "Irregular1M";
+
+        [Params("fidap007.mtx", "bp___200.mtx", "gear_integer_general_coordinate_100.mtx", Irregular)]
+        public string Matrix { get; set; }
+
+        int _rows;
+        int _columns;
+        int[] _rowPointers;
+        int[] _columnIndices;
+        double[] _values;
+        double[] _x;
+        double[] _y;
+        IntPtr _csr;
+        IntPtr _sell;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+
+            if (Matrix == Irregular)
+            {
+                GenerateIrregular(1000000);
+            }
+            else
+            {
+                var matrix = MatrixMarketReader.ReadMatrix<double>(Path.Combine(FindDataDirectory(), Matrix));
+                var storage = (SparseCompressedRowMatrixStorage<double>)Matrix<double>.Build.SparseOfMatrix(matrix).Storage;
+                _rows = storage.RowCount;
+                _columns = storage.ColumnCount;
+                _rowPointers = storage.RowPointers;
+                _columnIndices = storage.ColumnIndices;
+                _values = storage.Values;
+            }
+
+            _x = new double[_columns];
+            _y = new double[_rows];
+            for (var i = 0; i < _columns; i++)
+            {
+                _x[i] = 1.0 + i%7;
+            }
+
+            NativeConfig.Check(d_sparse_csr_create(out _csr, _rows, _columns, _rowPointers, _columnIndices, _values, General, 0, 0, ExpectedCalls), "d_sparse_csr_create");
+            NativeConfig.Check(d_sparse_sell_create(out _sell, _rows, _columns, _rowPointers, _columnIndices, _values, 0, 0, out _), "d_sparse_sell_create");
+        }
+
+        // Rows of irregular length around the diagonal, with one in four entries anywhere in the row.
+        void GenerateIrregular(int n)
+        {
+            var random = new Random(42);
+            _rows = n;
+            _columns = n;
+            _rowPointers = new int[n + 1];
+            for (var i = 0; i < n; i++)
+            {
+                _rowPointers[i + 1] = _rowPointers[i] + random.Next(4, 32);
+            }
+
+            _columnIndices = new int[_rowPointers[n]];
+            _values = new double[_rowPointers[n]];
+            for (var i = 0; i < n; i++)
+            {
+                var begin = _rowPointers[i];
+                var length = _rowPointers[i + 1] - begin;
+                var start = Math.Min(Math.Max(i - length/2, 0), n - length);
+                for (var p = 0; p < length; p++)
+                {
+                    var column = start + p;
+                    if (random.Next(4) == 0)
+                    {
+                        // outside the band and not yet in the row, so the row stays free of duplicates
+                        do
+                        {
+                            column = random.Next(n - length);
+                            column += column >= start ? length : 0;
+                        }
+                        while (Array.IndexOf(_columnIndices, column, begin, p) >= 0);
+                    }
+
+                    _columnIndices[begin + p] = column;
+                    _values[begin + p] = random.NextDouble();
+                }
+
+                Array.Sort(_columnIndices, begin, length);
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            d_sparse_csr_free(ref _csr);
+            d_sparse_sell_free(ref _sell);
+        }
+
+        static string FindDataDirectory()
+        {
+            var directory = new DirectoryInfo(AppContext.BaseDirectory);
+            while (directory != null)
+            {
+                var candidate = Path.Combine(directory.FullName, "data", "MatrixMarket");
+                if (Directory.Exists(candidate))
+                {
+                    return candidate;
+                }
+
+                directory = directory.Parent;
+            }
+
+            throw new DirectoryNotFoundException("data/MatrixMarket");
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = Repeat)]
+        public int Csr()
+        {
+            var info = 0;
+            for (var k = 0; k < Repeat; k++)
+            {
+                info |= d_sparse_csr_mv(_csr, _x, _y);
+            }
+
+            return info;
+        }
+
+        [Benchmark(OperationsPerInvoke = Repeat)]
+        public int Sell()
+        {
+            var info = 0;
+            for (var k = 0; k < Repeat; k++)
+            {
+                info |= d_sparse_sell_mv(_sell, _x, _y);
+            }
+
+            return info;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+﻿using System;
+using System.Numerics;
+using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// The lowest modes of a plate-like stiffness matrix (5-point Laplacian): the dense symmetric
+    /// eigensolver on the expanded matrix against the native sparse Lanczos solver with shift-invert
+    /// around zero, which factors the shifted matrix once with DSS. Grids stay small enough for the
+    /// dense baseline; SparseEigenLarge times the sparse solver alone at realistic sizes.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class SparseEigen
+    {
+        [Params(20, 40)]
+        public int Grid { get; set; }
+
+        [Params(10)]
+        public int Modes { get; set; }
+
+        int _n;
+        int[] _rowPointers;
+        int[] _columnIndices;
+        double[] _values;
+        double[] _dense;
+        double[] _vectors;
+        Complex[] _eigenvalues;
+        double[] _d;
+        double[] _modes;
+        double[] _modeVectors;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+
+            _n = Grid*Grid;
+            Laplacian(Grid, out _rowPointers, out _columnIndices, out _values);
+            _dense = new double[_n*_n];
+            for (var row = 0; row < _n; row++)
+            {
+                for (var p = _rowPointers[row]; p < _rowPointers[row + 1]; p++)
+                {
+                    _dense[_columnIndices[p]*_n + row] = _values[p];
+                }
+            }
+
+            _vectors = new double[_n*_n];
+            _eigenvalues = new Complex[_n];
+            _d = new double[_n*_n];
+            _modes = new double[Modes];
+            _modeVectors = new double[_n*Modes];
+        }
+
+        /// <summary>
+        /// Zero-based CSR of the 5-point Laplacian on a grid x grid plate, both triangles stored.
+        /// </summary>
+        internal static void Laplacian(int grid, out int[] rowPointers, out int[] columnIndices, out double[] values)
+        {
+            var n = grid*grid;
+            rowPointers = new int[n + 1];
+            columnIndices = new int[5*n - 4*grid];
+            values = new double[columnIndices.Length];
+
+            var nnz = 0;
+            for (var i = 0; i < grid; i++)
+            {
+                for (var j = 0; j < grid; j++)
+                {
+                    var row = i*grid + j;
+                    if (i > 0) { columnIndices[nnz] = row - grid; values[nnz++] = -1.0; }
+                    if (j > 0) { columnIndices[nnz] = row - 1; values[nnz++] = -1.0; }
+                    columnIndices[nnz] = row; values[nnz++] = 4.0;
+                    if (j < grid - 1) { columnIndices[nnz] = row + 1; values[nnz++] = -1.0; }
+                    if (i < grid - 1) { columnIndices[nnz] = row + grid; values[nnz++] = -1.0; }
+                    rowPointers[row + 1] = nnz;
+                }
+            }
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = 1)]
+        public int Dense()
+        {
+            return d_eigen(true, _n, _dense, _vectors, _eigenvalues, _d);
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int ShiftInvert()
+        {
+            return d_sparse_eigen(_n, _rowPointers, _columnIndices, _values, 2, Modes, -1e-3, 0.0, 0.0, 0, 300, 0.0, _modes, _modeVectors, out _, out _);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+﻿using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// The lowest modes of the plate Laplacian at sizes where a dense eigensolver is out of reach
+    /// (90,000 and 250,000 DOF): the sparse Lanczos solver only, shift-invert around zero.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class SparseEigenLarge
+    {
+        [Params(300, 500)]
+        public int Grid { get; set; }
+
+        [Params(10, 50)]
+        public int Modes { get; set; }
+
+        int _n;
+        int[] _rowPointers;
+        int[] _columnIndices;
+        double[] _values;
+        double[] _modes;
+        double[] _modeVectors;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+
+            _n = Grid*Grid;
+            SparseEigen.Laplacian(Grid, out _rowPointers, out _columnIndices, out _values);
+            _modes = new double[Modes];
+            _modeVectors = new double[_n*Modes];
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int ShiftInvert()
+        {
+            return d_sparse_eigen(_n, _rowPointers, _columnIndices, _values, 2, Modes, -1e-3, 0.0, 0.0, 0, 300, 0.0, _modes, _modeVectors, out _, out _);
+        }
+    }
+}
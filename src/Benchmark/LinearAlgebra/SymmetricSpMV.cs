@@ -0,0 +1,130 @@
+﻿using System;
+using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// SpMV on a symmetric 27-point stiffness pattern stored in full against the same matrix stored as its
+    /// upper triangle with a symmetric descriptor, which reads about half the values and column indices.
+    /// Both are handles created once in setup (optimized with mkl_sparse_optimize on MKL), so only the
+    /// products are timed. Grid 128 gives about 55M stored non-zeros in full.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class SymmetricSpMV
+    {
+        const int General = 0;
+        const int Symmetric = 1;
+        const int Upper = 1;
+        const int NonUnit = 0;
+        const int Repeat = 10;
+        const int ExpectedCalls = 1000;
+
+        [Params(64, 128)]
+        public int Grid { get; set; }
+
+        int _n;
+        int[] _fullRows;
+        int[] _fullColumns;
+        double[] _fullValues;
+        int[] _upperRows;
+        int[] _upperColumns;
+        double[] _upperValues;
+        IntPtr _full;
+        IntPtr _upper;
+        double[] _x;
+        double[] _y;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+
+            _n = Grid*Grid*Grid;
+            _fullRows = new int[_n + 1];
+            _upperRows = new int[_n + 1];
+            _fullColumns = new int[27*_n];
+            _fullValues = new double[27*_n];
+            _upperColumns = new int[14*_n];
+            _upperValues = new double[14*_n];
+
+            int full = 0, upper = 0;
+            for (var i = 0; i < Grid; i++)
+            {
+                for (var j = 0; j < Grid; j++)
+                {
+                    for (var k = 0; k < Grid; k++)
+                    {
+                        var row = (i*Grid + j)*Grid + k;
+                        for (var di = -1; di <= 1; di++)
+                        {
+                            for (var dj = -1; dj <= 1; dj++)
+                            {
+                                for (var dk = -1; dk <= 1; dk++)
+                                {
+                                    int ii = i + di, jj = j + dj, kk = k + dk;
+                                    if (ii < 0 || ii >= Grid || jj < 0 || jj >= Grid || kk < 0 || kk >= Grid) continue;
+
+                                    var column = (ii*Grid + jj)*Grid + kk;
+                                    var value = column == row ? 26.0 : -1.0;
+                                    _fullColumns[full] = column;
+                                    _fullValues[full++] = value;
+                                    if (column >= row)
+                                    {
+                                        _upperColumns[upper] = column;
+                                        _upperValues[upper++] = value;
+                                    }
+                                }
+                            }
+                        }
+
+                        _fullRows[row + 1] = full;
+                        _upperRows[row + 1] = upper;
+                    }
+                }
+            }
+
+            _x = new double[_n];
+            _y = new double[_n];
+            for (var i = 0; i < _n; i++)
+            {
+                _x[i] = 1.0 + i%7;
+            }
+
+            NativeConfig.Check(d_sparse_csr_create(out _full, _n, _n, _fullRows, _fullColumns, _fullValues, General, Upper, NonUnit, ExpectedCalls), "d_sparse_csr_create");
+            NativeConfig.Check(d_sparse_csr_create(out _upper, _n, _n, _upperRows, _upperColumns, _upperValues, Symmetric, Upper, NonUnit, ExpectedCalls), "d_sparse_csr_create");
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            d_sparse_csr_free(ref _full);
+            d_sparse_csr_free(ref _upper);
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = Repeat)]
+        public int Full()
+        {
+            var info = 0;
+            for (var k = 0; k < Repeat; k++)
+            {
+                info |= d_sparse_csr_mv(_full, _x, _y);
+            }
+
+            return info;
+        }
+
+        [Benchmark(OperationsPerInvoke = Repeat)]
+        public int SymmetricUpper()
+        {
+            var info = 0;
+            for (var k = 0; k < Repeat; k++)
+            {
+                info |= d_sparse_csr_mv(_upper, _x, _y);
+            }
+
+            return info;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+﻿using System;
+using BenchmarkDotNet.Attributes;
+using AHSEsim.Numerics;
+using AHSEsim.Numerics.Providers.MKL;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+
+namespace Benchmark.LinearAlgebra
+{
+    /// <summary>
+    /// Thin QR of tall-skinny matrices: ?geqrf + ?orgqr on the whole panel against the TSQR reduction tree.
+    /// </summary>
+    [Config(typeof(NativeConfig))]
+    public class TallSkinnyQR
+    {
+        [Params(100000, 1000000, 10000000)]
+        public int Rows { get; set; }
+
+        [Params(64)]
+        public int Columns { get; set; }
+
+        [Params(1, 2, 4, 8, 16)]
+        public int Threads { get; set; }
+
+        double[] _a;
+        double[] _q;
+        double[] _r;
+        double[] _tau;
+        double[] _tsqrTau;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            MklControl.UseNativeMKL(MklConsistency.Auto, MklPrecision.Double, MklAccuracy.High);
+            set_max_threads(Threads);
+
+            _a = Generate.Normal(Rows*Columns, 0.0, 1.0);
+            _q = new double[_a.Length];
+            _r = new double[Columns*Columns];
+            _tau = new double[Columns];
+            _tsqrTau = new double[d_tsqr_tau_size(Rows, Columns)];
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            set_max_threads(Control.MaxDegreeOfParallelism);
+        }
+
+        [IterationSetup]
+        public void Reset()
+        {
+            Array.Copy(_a, _q, _a.Length);
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = 1)]
+        public int Householder()
+        {
+            return d_qr_thin_factor(Rows, Columns, _q, _tau, _r);
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int TsqrExplicitQ()
+        {
+            return d_tsqr_thin_factor(Rows, Columns, _q, _r);
+        }
+
+        [Benchmark(OperationsPerInvoke = 1)]
+        public int TsqrImplicitQ()
+        {
+            return d_tsqr_factor(Rows, Columns, _q, _r, _tsqrTau);
+        }
+    }
+}
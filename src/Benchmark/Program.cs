@@ -16,6 +16,12 @@ public static void Main(string[] args)
                         typeof(Transforms.FFT),
                         typeof(LinearAlgebra.DenseMatrixProduct),
                         typeof(LinearAlgebra.DenseVector),
+                        typeof(LinearAlgebra.TallSkinnyQR),
+                        typeof(LinearAlgebra.MatrixFreeKrylov),
+                        typeof(LinearAlgebra.SymmetricSpMV),
+                        typeof(LinearAlgebra.SellSpMV),
+                        typeof(LinearAlgebra.SparseEigen),
+                        typeof(LinearAlgebra.SparseEigenLarge),
                     });
 
             switcher.Run(args);
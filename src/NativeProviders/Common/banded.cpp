@@ -0,0 +1,310 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "parallel.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	Banded and tridiagonal solvers, O(n*kl*ku) and O(n) instead of the O(n^3)
+	of the dense factorizations.
+
+	Band matrices use the LAPACK band storage, column-major:
+	- general (?gb): A(i,j) at ab[(kl + ku + i - j) + j * ldab] with
+	  ldab = 2*kl + ku + 1; the first kl rows are workspace for the fill-in
+	  of the pivoting and need not be set on entry.
+	- positive definite (?pb): lower triangle only, A(i,j) at ab[(i - j) + j * ldab]
+	  with ldab = kd + 1.
+	Tridiagonal matrices are given by their sub-, main and super-diagonal.
+
+	As with the dense LU, pivot indices are zero-based and the solve entry
+	points leave the matrix untouched.
+*/
+
+inline lapack_int band_lu_ldab(const lapack_int kl, const lapack_int ku)
+{
+	return 2 * kl + ku + 1;
+}
+
+template<typename T, typename GBTRF>
+inline lapack_int band_lu_factor(lapack_int n, lapack_int kl, lapack_int ku, T ab[], lapack_int ipiv[], GBTRF gbtrf)
+{
+	auto info = gbtrf(LAPACK_COL_MAJOR, n, n, kl, ku, ab, band_lu_ldab(kl, ku), ipiv);
+	shift_ipiv_down(n, ipiv);
+	return info;
+}
+
+template<typename T, typename GBTRS>
+inline lapack_int band_lu_solve_factored(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, T ab[], lapack_int ipiv[], T b[], GBTRS gbtrs)
+{
+	shift_ipiv_up(n, ipiv);
+	auto info = gbtrs(LAPACK_COL_MAJOR, 'N', n, kl, ku, nrhs, ab, band_lu_ldab(kl, ku), ipiv, b, n);
+	shift_ipiv_down(n, ipiv);
+	return info;
+}
+
+template<typename T, typename GBSV>
+inline lapack_int band_lu_solve(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, T ab[], T b[], GBSV gbsv)
+{
+	try
+	{
+		const auto ldab = band_lu_ldab(kl, ku);
+		std::vector<T> clone(ab, ab + static_cast<size_t>(ldab) * n);
+		auto ipiv = array_new<lapack_int>(std::max(1, n));
+		return gbsv(LAPACK_COL_MAJOR, n, kl, ku, nrhs, clone.data(), ldab, ipiv.get(), b, n);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename PBSV>
+inline lapack_int band_cholesky_solve(lapack_int n, lapack_int kd, lapack_int nrhs, T ab[], T b[], PBSV pbsv)
+{
+	try
+	{
+		std::vector<T> clone(ab, ab + static_cast<size_t>(kd + 1) * n);
+		return pbsv(LAPACK_COL_MAJOR, 'L', n, kd, nrhs, clone.data(), kd + 1, b, n);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GTSV>
+inline lapack_int tridiagonal_solve(lapack_int n, lapack_int nrhs, T dl[], T d[], T du[], T b[], GTSV gtsv)
+{
+	try
+	{
+		const auto off = std::max(0, n - 1);
+		auto clone_dl = array_clone(off, dl);
+		auto clone_d = array_clone(n, d);
+		auto clone_du = array_clone(off, du);
+		return gtsv(LAPACK_COL_MAJOR, n, nrhs, clone_dl.get(), clone_d.get(), clone_du.get(), b, n);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+// Positive definite (Hermitian) tridiagonal, LDL' factorization; the diagonal d is real.
+template<typename T, typename R, typename PTSV>
+inline lapack_int tridiagonal_cholesky_solve(lapack_int n, lapack_int nrhs, R d[], T e[], T b[], PTSV ptsv)
+{
+	try
+	{
+		auto clone_d = array_clone(n, d);
+		auto clone_e = array_clone(std::max(0, n - 1), e);
+		return ptsv(LAPACK_COL_MAJOR, n, nrhs, clone_d.get(), clone_e.get(), b, n);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+/*
+	count independent n x n tridiagonal systems with one right-hand side each,
+	stored back to back: system s uses dl + s*(n-1), d + s*n, du + s*(n-1) and
+	b + s*n. The systems are solved in parallel with partial pivoting and the
+	solutions overwrite b. info[s] receives the ?gtsv result of system s; the
+	return value is 0 if all systems were solved, otherwise the number of
+	singular systems.
+*/
+template<typename T, typename GTSV>
+inline lapack_int tridiagonal_solve_batch(lapack_int n, lapack_int count, const T dl[], const T d[], const T du[], T b[], lapack_int info[], GTSV gtsv)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	if (count < 0)
+	{
+		return -2;
+	}
+
+	try
+	{
+		const auto off = std::max(0, n - 1);
+		const auto size = static_cast<size_t>(n) + 2 * off;
+		const auto chunks = parallel_chunk_count(count, 1);
+		std::vector<T> work(std::max<size_t>(1, static_cast<size_t>(chunks) * size));
+		auto* w = work.data();
+
+		parallel_for_chunks(count, chunks, [=](int chunk, int begin, int end)
+		{
+#ifdef PROVIDER_MKL
+			auto previous = mkl_set_num_threads_local(1);
+#endif
+			auto* wd = w + chunk * size;
+			auto* wdl = wd + n;
+			auto* wdu = wdl + off;
+
+			for (auto s = begin; s < end; ++s)
+			{
+				std::copy(d + static_cast<size_t>(s) * n, d + static_cast<size_t>(s + 1) * n, wd);
+				std::copy(dl + static_cast<size_t>(s) * off, dl + static_cast<size_t>(s + 1) * off, wdl);
+				std::copy(du + static_cast<size_t>(s) * off, du + static_cast<size_t>(s + 1) * off, wdu);
+				info[s] = gtsv(LAPACK_COL_MAJOR, n, 1, wdl, wd, wdu, b + static_cast<size_t>(s) * n, n);
+			}
+
+#ifdef PROVIDER_MKL
+			mkl_set_num_threads_local(previous);
+#endif
+		});
+
+		return static_cast<lapack_int>(std::count_if(info, info + count, [](lapack_int i) { return i != 0; }));
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_band_lu_factor(lapack_int n, lapack_int kl, lapack_int ku, float ab[], lapack_int ipiv[])
+	{
+		return band_lu_factor(n, kl, ku, ab, ipiv, LAPACKE_sgbtrf);
+	}
+
+	DLLEXPORT lapack_int d_band_lu_factor(lapack_int n, lapack_int kl, lapack_int ku, double ab[], lapack_int ipiv[])
+	{
+		return band_lu_factor(n, kl, ku, ab, ipiv, LAPACKE_dgbtrf);
+	}
+
+	DLLEXPORT lapack_int c_band_lu_factor(lapack_int n, lapack_int kl, lapack_int ku, lapack_complex_float ab[], lapack_int ipiv[])
+	{
+		return band_lu_factor(n, kl, ku, ab, ipiv, LAPACKE_cgbtrf);
+	}
+
+	DLLEXPORT lapack_int z_band_lu_factor(lapack_int n, lapack_int kl, lapack_int ku, lapack_complex_double ab[], lapack_int ipiv[])
+	{
+		return band_lu_factor(n, kl, ku, ab, ipiv, LAPACKE_zgbtrf);
+	}
+
+	DLLEXPORT lapack_int s_band_lu_solve_factored(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, float ab[], lapack_int ipiv[], float b[])
+	{
+		return band_lu_solve_factored(n, kl, ku, nrhs, ab, ipiv, b, LAPACKE_sgbtrs);
+	}
+
+	DLLEXPORT lapack_int d_band_lu_solve_factored(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, double ab[], lapack_int ipiv[], double b[])
+	{
+		return band_lu_solve_factored(n, kl, ku, nrhs, ab, ipiv, b, LAPACKE_dgbtrs);
+	}
+
+	DLLEXPORT lapack_int c_band_lu_solve_factored(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, lapack_complex_float ab[], lapack_int ipiv[], lapack_complex_float b[])
+	{
+		return band_lu_solve_factored(n, kl, ku, nrhs, ab, ipiv, b, LAPACKE_cgbtrs);
+	}
+
+	DLLEXPORT lapack_int z_band_lu_solve_factored(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, lapack_complex_double ab[], lapack_int ipiv[], lapack_complex_double b[])
+	{
+		return band_lu_solve_factored(n, kl, ku, nrhs, ab, ipiv, b, LAPACKE_zgbtrs);
+	}
+
+	DLLEXPORT lapack_int s_band_lu_solve(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, float ab[], float b[])
+	{
+		return band_lu_solve(n, kl, ku, nrhs, ab, b, LAPACKE_sgbsv);
+	}
+
+	DLLEXPORT lapack_int d_band_lu_solve(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, double ab[], double b[])
+	{
+		return band_lu_solve(n, kl, ku, nrhs, ab, b, LAPACKE_dgbsv);
+	}
+
+	DLLEXPORT lapack_int c_band_lu_solve(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, lapack_complex_float ab[], lapack_complex_float b[])
+	{
+		return band_lu_solve(n, kl, ku, nrhs, ab, b, LAPACKE_cgbsv);
+	}
+
+	DLLEXPORT lapack_int z_band_lu_solve(lapack_int n, lapack_int kl, lapack_int ku, lapack_int nrhs, lapack_complex_double ab[], lapack_complex_double b[])
+	{
+		return band_lu_solve(n, kl, ku, nrhs, ab, b, LAPACKE_zgbsv);
+	}
+
+	DLLEXPORT lapack_int s_band_cholesky_solve(lapack_int n, lapack_int kd, lapack_int nrhs, float ab[], float b[])
+	{
+		return band_cholesky_solve(n, kd, nrhs, ab, b, LAPACKE_spbsv);
+	}
+
+	DLLEXPORT lapack_int d_band_cholesky_solve(lapack_int n, lapack_int kd, lapack_int nrhs, double ab[], double b[])
+	{
+		return band_cholesky_solve(n, kd, nrhs, ab, b, LAPACKE_dpbsv);
+	}
+
+	DLLEXPORT lapack_int c_band_cholesky_solve(lapack_int n, lapack_int kd, lapack_int nrhs, lapack_complex_float ab[], lapack_complex_float b[])
+	{
+		return band_cholesky_solve(n, kd, nrhs, ab, b, LAPACKE_cpbsv);
+	}
+
+	DLLEXPORT lapack_int z_band_cholesky_solve(lapack_int n, lapack_int kd, lapack_int nrhs, lapack_complex_double ab[], lapack_complex_double b[])
+	{
+		return band_cholesky_solve(n, kd, nrhs, ab, b, LAPACKE_zpbsv);
+	}
+
+	DLLEXPORT lapack_int s_tridiagonal_solve(lapack_int n, lapack_int nrhs, float dl[], float d[], float du[], float b[])
+	{
+		return tridiagonal_solve(n, nrhs, dl, d, du, b, LAPACKE_sgtsv);
+	}
+
+	DLLEXPORT lapack_int d_tridiagonal_solve(lapack_int n, lapack_int nrhs, double dl[], double d[], double du[], double b[])
+	{
+		return tridiagonal_solve(n, nrhs, dl, d, du, b, LAPACKE_dgtsv);
+	}
+
+	DLLEXPORT lapack_int c_tridiagonal_solve(lapack_int n, lapack_int nrhs, lapack_complex_float dl[], lapack_complex_float d[], lapack_complex_float du[], lapack_complex_float b[])
+	{
+		return tridiagonal_solve(n, nrhs, dl, d, du, b, LAPACKE_cgtsv);
+	}
+
+	DLLEXPORT lapack_int z_tridiagonal_solve(lapack_int n, lapack_int nrhs, lapack_complex_double dl[], lapack_complex_double d[], lapack_complex_double du[], lapack_complex_double b[])
+	{
+		return tridiagonal_solve(n, nrhs, dl, d, du, b, LAPACKE_zgtsv);
+	}
+
+	DLLEXPORT lapack_int s_tridiagonal_cholesky_solve(lapack_int n, lapack_int nrhs, float d[], float e[], float b[])
+	{
+		return tridiagonal_cholesky_solve(n, nrhs, d, e, b, LAPACKE_sptsv);
+	}
+
+	DLLEXPORT lapack_int d_tridiagonal_cholesky_solve(lapack_int n, lapack_int nrhs, double d[], double e[], double b[])
+	{
+		return tridiagonal_cholesky_solve(n, nrhs, d, e, b, LAPACKE_dptsv);
+	}
+
+	DLLEXPORT lapack_int c_tridiagonal_cholesky_solve(lapack_int n, lapack_int nrhs, float d[], lapack_complex_float e[], lapack_complex_float b[])
+	{
+		return tridiagonal_cholesky_solve(n, nrhs, d, e, b, LAPACKE_cptsv);
+	}
+
+	DLLEXPORT lapack_int z_tridiagonal_cholesky_solve(lapack_int n, lapack_int nrhs, double d[], lapack_complex_double e[], lapack_complex_double b[])
+	{
+		return tridiagonal_cholesky_solve(n, nrhs, d, e, b, LAPACKE_zptsv);
+	}
+
+	DLLEXPORT lapack_int s_tridiagonal_solve_batch(lapack_int n, lapack_int count, float dl[], float d[], float du[], float b[], lapack_int info[])
+	{
+		return tridiagonal_solve_batch(n, count, dl, d, du, b, info, LAPACKE_sgtsv);
+	}
+
+	DLLEXPORT lapack_int d_tridiagonal_solve_batch(lapack_int n, lapack_int count, double dl[], double d[], double du[], double b[], lapack_int info[])
+	{
+		return tridiagonal_solve_batch(n, count, dl, d, du, b, info, LAPACKE_dgtsv);
+	}
+
+	DLLEXPORT lapack_int c_tridiagonal_solve_batch(lapack_int n, lapack_int count, lapack_complex_float dl[], lapack_complex_float d[], lapack_complex_float du[], lapack_complex_float b[], lapack_int info[])
+	{
+		return tridiagonal_solve_batch(n, count, dl, d, du, b, info, LAPACKE_cgtsv);
+	}
+
+	DLLEXPORT lapack_int z_tridiagonal_solve_batch(lapack_int n, lapack_int count, lapack_complex_double dl[], lapack_complex_double d[], lapack_complex_double du[], lapack_complex_double b[], lapack_int info[])
+	{
+		return tridiagonal_solve_batch(n, count, dl, d, du, b, info, LAPACKE_zgtsv);
+	}
+}
@@ -56,6 +56,70 @@ DLLEXPORT blas_complex_double z_dot_product(const blas_int n, const blas_complex
 	return ret;
 }
 
+DLLEXPORT float s_nrm2(const blas_int n, const float x[]){
+	return cblas_snrm2(n, x, 1);
+}
+
+DLLEXPORT double d_nrm2(const blas_int n, const double x[]){
+	return cblas_dnrm2(n, x, 1);
+}
+
+DLLEXPORT float c_nrm2(const blas_int n, const blas_complex_float x[]){
+	return cblas_scnrm2(n, (float*)x, 1);
+}
+
+DLLEXPORT double z_nrm2(const blas_int n, const blas_complex_double x[]){
+	return cblas_dznrm2(n, (double*)x, 1);
+}
+
+DLLEXPORT float s_asum(const blas_int n, const float x[]){
+	return cblas_sasum(n, x, 1);
+}
+
+DLLEXPORT double d_asum(const blas_int n, const double x[]){
+	return cblas_dasum(n, x, 1);
+}
+
+DLLEXPORT float c_asum(const blas_int n, const blas_complex_float x[]){
+	return cblas_scasum(n, (float*)x, 1);
+}
+
+DLLEXPORT double z_asum(const blas_int n, const blas_complex_double x[]){
+	return cblas_dzasum(n, (double*)x, 1);
+}
+
+DLLEXPORT blas_int s_iamax(const blas_int n, const float x[]){
+	return (blas_int)cblas_isamax(n, x, 1);
+}
+
+DLLEXPORT blas_int d_iamax(const blas_int n, const double x[]){
+	return (blas_int)cblas_idamax(n, x, 1);
+}
+
+DLLEXPORT blas_int c_iamax(const blas_int n, const blas_complex_float x[]){
+	return (blas_int)cblas_icamax(n, (float*)x, 1);
+}
+
+DLLEXPORT blas_int z_iamax(const blas_int n, const blas_complex_double x[]){
+	return (blas_int)cblas_izamax(n, (double*)x, 1);
+}
+
+DLLEXPORT blas_int s_iamin(const blas_int n, const float x[]){
+	return (blas_int)cblas_isamin(n, x, 1);
+}
+
+DLLEXPORT blas_int d_iamin(const blas_int n, const double x[]){
+	return (blas_int)cblas_idamin(n, x, 1);
+}
+
+DLLEXPORT blas_int c_iamin(const blas_int n, const blas_complex_float x[]){
+	return (blas_int)cblas_icamin(n, (float*)x, 1);
+}
+
+DLLEXPORT blas_int z_iamin(const blas_int n, const blas_complex_double x[]){
+	return (blas_int)cblas_izamin(n, (double*)x, 1);
+}
+
 DLLEXPORT void s_matrix_multiply(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, const blas_int m, const blas_int n, const blas_int k, const float alpha, const float x[], const float y[], const float beta, float c[]){
 	const blas_int lda = transA == CblasNoTrans ? m : k;
     const blas_int ldb = transB == CblasNoTrans ? k : n;
@@ -84,6 +148,35 @@ DLLEXPORT void z_matrix_multiply(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB,
 	cblas_zgemm(CblasColMajor, transA, transB, m, n, k, (double*)&alpha, (double*)x, lda, (double*)y, ldb, (double*)&beta, (double*)c, m);
 }
 
+/* Row-major counterparts of x_matrix_multiply: x is m x k (k x m if transposed), y is k x n (n x k), c is m x n, all stored by rows. */
+DLLEXPORT void s_matrix_multiply_rm(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, const blas_int m, const blas_int n, const blas_int k, const float alpha, const float x[], const float y[], const float beta, float c[]){
+	const blas_int lda = transA == CblasNoTrans ? k : m;
+	const blas_int ldb = transB == CblasNoTrans ? n : k;
+
+	cblas_sgemm(CblasRowMajor, transA, transB, m, n, k, alpha, x, lda, y, ldb, beta, c, n);
+}
+
+DLLEXPORT void d_matrix_multiply_rm(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, const blas_int m, const blas_int n, const blas_int k, const double alpha, const double x[], const double y[], const double beta, double c[]){
+	const blas_int lda = transA == CblasNoTrans ? k : m;
+	const blas_int ldb = transB == CblasNoTrans ? n : k;
+
+	cblas_dgemm(CblasRowMajor, transA, transB, m, n, k, alpha, x, lda, y, ldb, beta, c, n);
+}
+
+DLLEXPORT void c_matrix_multiply_rm(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, const blas_int m, const blas_int n, const blas_int k, const blas_complex_float alpha, const blas_complex_float x[], const blas_complex_float y[], const blas_complex_float beta, blas_complex_float c[]){
+	const blas_int lda = transA == CblasNoTrans ? k : m;
+	const blas_int ldb = transB == CblasNoTrans ? n : k;
+
+	cblas_cgemm(CblasRowMajor, transA, transB, m, n, k, (float*)&alpha, (float*)x, lda, (float*)y, ldb, (float*)&beta, (float*)c, n);
+}
+
+DLLEXPORT void z_matrix_multiply_rm(CBLAS_TRANSPOSE transA, CBLAS_TRANSPOSE transB, const blas_int m, const blas_int n, const blas_int k, const blas_complex_double alpha, const blas_complex_double x[], const blas_complex_double y[], const blas_complex_double beta, blas_complex_double c[]){
+	const blas_int lda = transA == CblasNoTrans ? k : m;
+	const blas_int ldb = transB == CblasNoTrans ? n : k;
+
+	cblas_zgemm(CblasRowMajor, transA, transB, m, n, k, (double*)&alpha, (double*)x, lda, (double*)y, ldb, (double*)&beta, (double*)c, n);
+}
+
 #if __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+
+/*
+	Scalar helpers and type-overloaded column-major BLAS calls for the
+	templated kernels. Include after the provider's lapack.h.
+*/
+
+inline float conj_value(const float x) { return x; }
+inline double conj_value(const double x) { return x; }
+template<typename R> inline std::complex<R> conj_value(const std::complex<R>& x) { return std::conj(x); }
+
+inline float real_value(const float x) { return x; }
+inline double real_value(const double x) { return x; }
+template<typename R> inline R real_value(const std::complex<R>& x) { return x.real(); }
+
+inline float abs2(const float x) { return x * x; }
+inline double abs2(const double x) { return x * x; }
+template<typename R> inline R abs2(const std::complex<R>& x) { return std::norm(x); }
+
+inline void gemm(const CBLAS_TRANSPOSE transa, const CBLAS_TRANSPOSE transb, const int m, const int n, const int k,
+	const float alpha, const float a[], const int lda, const float b[], const int ldb, const float beta, float c[], const int ldc)
+{
+	cblas_sgemm(CblasColMajor, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+inline void gemm(const CBLAS_TRANSPOSE transa, const CBLAS_TRANSPOSE transb, const int m, const int n, const int k,
+	const double alpha, const double a[], const int lda, const double b[], const int ldb, const double beta, double c[], const int ldc)
+{
+	cblas_dgemm(CblasColMajor, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+inline void gemm(const CBLAS_TRANSPOSE transa, const CBLAS_TRANSPOSE transb, const int m, const int n, const int k,
+	const lapack_complex_float alpha, const lapack_complex_float a[], const int lda, const lapack_complex_float b[], const int ldb,
+	const lapack_complex_float beta, lapack_complex_float c[], const int ldc)
+{
+	cblas_cgemm(CblasColMajor, transa, transb, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+}
+
+inline void gemm(const CBLAS_TRANSPOSE transa, const CBLAS_TRANSPOSE transb, const int m, const int n, const int k,
+	const lapack_complex_double alpha, const lapack_complex_double a[], const int lda, const lapack_complex_double b[], const int ldb,
+	const lapack_complex_double beta, lapack_complex_double c[], const int ldc)
+{
+	cblas_zgemm(CblasColMajor, transa, transb, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+}
@@ -0,0 +1,236 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include <algorithm>
+
+/*
+	Rank-k update and downdate of a lower Cholesky factor, L*L' +/- X*X',
+	in place and in O(k*n^2) instead of refactoring in O(n^3).
+
+	Every column of X is eliminated against the columns of L by a rotation
+	(hyperbolic for downdates). The rotations that act on column j of L are
+	the same for every row below the diagonal, so for larger k the factor
+	is processed in panels: the rotations of a panel are accumulated into a
+	small (nb+k)x(nb+k) matrix while its diagonal block is factored, and the
+	rows below the panel are then transformed by a single matrix product.
+
+	X is n x k and used as workspace, its contents are destroyed.
+	Returns 0 on success, or j+1 if the result is not positive definite at
+	column j (only possible for downdates); the factor is then incomplete.
+*/
+
+const int CHOLESKY_UPDATE_BLOCK = 64;
+const int CHOLESKY_UPDATE_MIN_RANK = 8;
+
+// Rotation that eliminates x[j] against l[j]: l' = (l + sigma*conj(s)*x)/c, x' = c*x - s*l'.
+template<typename T, typename R>
+struct cholesky_rotation
+{
+	R c;
+	T s;
+	T sigma_conj_s;
+
+	inline void apply(T& l, T& x) const
+	{
+		l = (l + sigma_conj_s * x) / c;
+		x = c * x - s * l;
+	}
+};
+
+template<typename T, typename R>
+inline bool cholesky_rotation_make(T& ljj, T& xj, const R sigma, cholesky_rotation<T, R>& rotation)
+{
+	const auto l = real_value(ljj);
+	const auto r2 = l * l + sigma * abs2(xj);
+
+	if (!(l > R(0)) || !(r2 > R(0)))
+	{
+		return false;
+	}
+
+	const auto r = std::sqrt(r2);
+	rotation.c = r / l;
+	rotation.s = xj / l;
+	rotation.sigma_conj_s = sigma * conj_value(rotation.s);
+
+	ljj = T(r);
+	xj = T();
+	return true;
+}
+
+template<typename T, typename R>
+inline lapack_int cholesky_rank_update_unblocked(const lapack_int n, const lapack_int k, T a[], T x[], const R sigma)
+{
+	cholesky_rotation<T, R> rotation;
+
+	for (auto j = 0; j < n; ++j)
+	{
+		auto* lj = a + static_cast<size_t>(j) * n;
+
+		for (auto p = 0; p < k; ++p)
+		{
+			auto* xp = x + static_cast<size_t>(p) * n;
+
+			if (!cholesky_rotation_make(lj[j], xp[j], sigma, rotation))
+			{
+				return j + 1;
+			}
+
+			for (auto i = j + 1; i < n; ++i)
+			{
+				rotation.apply(lj[i], xp[i]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+template<typename T, typename R>
+inline lapack_int cholesky_rank_update_blocked(const lapack_int n, const lapack_int k, T a[], T x[], const R sigma)
+{
+	const auto nb = CHOLESKY_UPDATE_BLOCK;
+	const auto width = nb + k;
+	auto transform = array_new<T>(width * width);
+	auto product = array_new<T>((n - std::min(n, nb)) * width);
+	auto* m = transform.get();
+	auto* u = product.get();
+	cholesky_rotation<T, R> rotation;
+
+	for (auto j0 = 0; j0 < n; j0 += nb)
+	{
+		const auto j1 = std::min(n, j0 + nb);
+		const auto b = j1 - j0;
+		const auto w = b + k;
+		const auto rows = n - j1;
+
+		// m accumulates the rotations applied to a row [L(i, j0:j1), X(i, :)], starting from the identity
+		std::fill(m, m + w * w, T());
+		for (auto d = 0; d < w; ++d)
+		{
+			m[d * w + d] = T(1);
+		}
+
+		for (auto j = j0; j < j1; ++j)
+		{
+			auto* lj = a + static_cast<size_t>(j) * n;
+			auto* mj = m + (j - j0) * w;
+
+			for (auto p = 0; p < k; ++p)
+			{
+				auto* xp = x + static_cast<size_t>(p) * n;
+				auto* mp = m + (b + p) * w;
+
+				if (!cholesky_rotation_make(lj[j], xp[j], sigma, rotation))
+				{
+					return j + 1;
+				}
+
+				for (auto i = j + 1; i < j1; ++i)
+				{
+					rotation.apply(lj[i], xp[i]);
+				}
+
+				for (auto r = 0; r < w; ++r)
+				{
+					rotation.apply(mj[r], mp[r]);
+				}
+			}
+		}
+
+		if (rows == 0)
+		{
+			break;
+		}
+
+		// [L(j1:n, j0:j1), X(j1:n, :)] * m, as L-part times the top rows plus X-part times the bottom rows
+		auto* panel = a + static_cast<size_t>(j0) * n + j1;
+		gemm(CblasNoTrans, CblasNoTrans, rows, w, b, T(1), panel, n, m, w, T(), u, rows);
+		gemm(CblasNoTrans, CblasNoTrans, rows, w, k, T(1), x + j1, n, m + b, w, T(1), u, rows);
+
+		for (auto c = 0; c < b; ++c)
+		{
+			std::copy(u + c * rows, u + (c + 1) * rows, panel + static_cast<size_t>(c) * n);
+		}
+
+		for (auto p = 0; p < k; ++p)
+		{
+			std::copy(u + (b + p) * rows, u + (b + p + 1) * rows, x + static_cast<size_t>(p) * n + j1);
+		}
+	}
+
+	return 0;
+}
+
+template<typename T, typename R>
+inline lapack_int cholesky_rank_update(const lapack_int n, const lapack_int k, T a[], T x[], const R sigma)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	if (k < 0)
+	{
+		return -2;
+	}
+
+	if (k < CHOLESKY_UPDATE_MIN_RANK || n <= 2 * CHOLESKY_UPDATE_BLOCK)
+	{
+		return cholesky_rank_update_unblocked(n, k, a, x, sigma);
+	}
+
+	try
+	{
+		return cholesky_rank_update_blocked(n, k, a, x, sigma);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_cholesky_update(lapack_int n, lapack_int k, float a[], float x[])
+	{
+		return cholesky_rank_update(n, k, a, x, 1.0f);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_update(lapack_int n, lapack_int k, double a[], double x[])
+	{
+		return cholesky_rank_update(n, k, a, x, 1.0);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_update(lapack_int n, lapack_int k, lapack_complex_float a[], lapack_complex_float x[])
+	{
+		return cholesky_rank_update(n, k, a, x, 1.0f);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_update(lapack_int n, lapack_int k, lapack_complex_double a[], lapack_complex_double x[])
+	{
+		return cholesky_rank_update(n, k, a, x, 1.0);
+	}
+
+	DLLEXPORT lapack_int s_cholesky_downdate(lapack_int n, lapack_int k, float a[], float x[])
+	{
+		return cholesky_rank_update(n, k, a, x, -1.0f);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_downdate(lapack_int n, lapack_int k, double a[], double x[])
+	{
+		return cholesky_rank_update(n, k, a, x, -1.0);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_downdate(lapack_int n, lapack_int k, lapack_complex_float a[], lapack_complex_float x[])
+	{
+		return cholesky_rank_update(n, k, a, x, -1.0f);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_downdate(lapack_int n, lapack_int k, lapack_complex_double a[], lapack_complex_double x[])
+	{
+		return cholesky_rank_update(n, k, a, x, -1.0);
+	}
+}
@@ -0,0 +1,205 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "parallel.h"
+#include <cmath>
+
+/*
+	Element-wise complex helpers: conjugate, modulus, argument, construction
+	from polar form and conversion between interleaved and split storage.
+
+	The MKL provider forwards conjugate, modulus and argument to VML. The
+	portable kernels work on the interleaved real view so that the compiler
+	can vectorize them, and split large inputs across threads.
+*/
+
+const int COMPLEX_PARALLEL_GRAIN = 1 << 15;
+
+template<typename T>
+inline void complex_conjugate(const int n, const std::complex<T> x[], std::complex<T> result[])
+{
+	const auto* in = reinterpret_cast<const T*>(x);
+	auto* out = reinterpret_cast<T*>(result);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = 2 * begin; i < 2 * end; i += 2)
+		{
+			out[i] = in[i];
+			out[i + 1] = -in[i + 1];
+		}
+	});
+}
+
+// Single precision is squared in double, which can neither overflow nor underflow.
+inline float complex_modulus(const float re, const float im)
+{
+	return static_cast<float>(std::sqrt(static_cast<double>(re) * re + static_cast<double>(im) * im));
+}
+
+// Double precision falls back to hypot only where the squares may have lost range.
+inline double complex_modulus(const double re, const double im)
+{
+	auto r = std::sqrt(re * re + im * im);
+	return r > 1e-150 && r < 1e150 ? r : std::hypot(re, im);
+}
+
+template<typename T>
+inline void complex_abs(const int n, const std::complex<T> x[], T result[])
+{
+	const auto* in = reinterpret_cast<const T*>(x);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = complex_modulus(in[2 * i], in[2 * i + 1]);
+		}
+	});
+}
+
+template<typename T>
+inline void complex_arg(const int n, const std::complex<T> x[], T result[])
+{
+	const auto* in = reinterpret_cast<const T*>(x);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = std::atan2(in[2 * i + 1], in[2 * i]);
+		}
+	});
+}
+
+template<typename T>
+inline void complex_from_polar(const int n, const T magnitude[], const T phase[], std::complex<T> result[])
+{
+	auto* out = reinterpret_cast<T*>(result);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			out[2 * i] = magnitude[i] * std::cos(phase[i]);
+			out[2 * i + 1] = magnitude[i] * std::sin(phase[i]);
+		}
+	});
+}
+
+template<typename T>
+inline void complex_split(const int n, const std::complex<T> x[], T real[], T imaginary[])
+{
+	const auto* in = reinterpret_cast<const T*>(x);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			real[i] = in[2 * i];
+			imaginary[i] = in[2 * i + 1];
+		}
+	});
+}
+
+template<typename T>
+inline void complex_merge(const int n, const T real[], const T imaginary[], std::complex<T> result[])
+{
+	auto* out = reinterpret_cast<T*>(result);
+
+	parallel_for(n, COMPLEX_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			out[2 * i] = real[i];
+			out[2 * i + 1] = imaginary[i];
+		}
+	});
+}
+
+extern "C" {
+
+	DLLEXPORT void c_conjugate(const int n, const lapack_complex_float x[], lapack_complex_float result[])
+	{
+#ifdef PROVIDER_MKL
+		vcConj(n, x, result);
+#else
+		complex_conjugate(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void z_conjugate(const int n, const lapack_complex_double x[], lapack_complex_double result[])
+	{
+#ifdef PROVIDER_MKL
+		vzConj(n, x, result);
+#else
+		complex_conjugate(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void c_abs(const int n, const lapack_complex_float x[], float result[])
+	{
+#ifdef PROVIDER_MKL
+		vcAbs(n, x, result);
+#else
+		complex_abs(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void z_abs(const int n, const lapack_complex_double x[], double result[])
+	{
+#ifdef PROVIDER_MKL
+		vzAbs(n, x, result);
+#else
+		complex_abs(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void c_arg(const int n, const lapack_complex_float x[], float result[])
+	{
+#ifdef PROVIDER_MKL
+		vcArg(n, x, result);
+#else
+		complex_arg(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void z_arg(const int n, const lapack_complex_double x[], double result[])
+	{
+#ifdef PROVIDER_MKL
+		vzArg(n, x, result);
+#else
+		complex_arg(n, x, result);
+#endif
+	}
+
+	DLLEXPORT void c_from_polar(const int n, const float magnitude[], const float phase[], lapack_complex_float result[])
+	{
+		complex_from_polar(n, magnitude, phase, result);
+	}
+
+	DLLEXPORT void z_from_polar(const int n, const double magnitude[], const double phase[], lapack_complex_double result[])
+	{
+		complex_from_polar(n, magnitude, phase, result);
+	}
+
+	DLLEXPORT void c_split(const int n, const lapack_complex_float x[], float real[], float imaginary[])
+	{
+		complex_split(n, x, real, imaginary);
+	}
+
+	DLLEXPORT void z_split(const int n, const lapack_complex_double x[], double real[], double imaginary[])
+	{
+		complex_split(n, x, real, imaginary);
+	}
+
+	DLLEXPORT void c_merge(const int n, const float real[], const float imaginary[], lapack_complex_float result[])
+	{
+		complex_merge(n, real, imaginary, result);
+	}
+
+	DLLEXPORT void z_merge(const int n, const double real[], const double imaginary[], lapack_complex_double result[])
+	{
+		complex_merge(n, real, imaginary, result);
+	}
+}
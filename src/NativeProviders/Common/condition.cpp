@@ -0,0 +1,44 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+
+/*
+	Condition number estimate from an LU factorization that is already
+	available, instead of forming the inverse.
+
+	x_lu_rcond works on the output of x_lu_factor and returns the reciprocal
+	condition number in rcond, in the 1-norm ('1' or 'O') or the
+	infinity-norm ('I'). ?gecon also needs the same norm of the original
+	matrix, anorm, which must be taken before factoring (x_matrix_norm);
+	the estimate itself costs O(n^2).
+*/
+
+template<typename T, typename R, typename GECON>
+inline lapack_int lu_rcond(char norm, lapack_int n, const T a[], R anorm, R* rcond, GECON gecon)
+{
+	return gecon(LAPACK_COL_MAJOR, norm, n, a, n, anorm, rcond);
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_lu_rcond(char norm, lapack_int n, float a[], float anorm, float* rcond)
+	{
+		return lu_rcond(norm, n, a, anorm, rcond, LAPACKE_sgecon);
+	}
+
+	DLLEXPORT lapack_int d_lu_rcond(char norm, lapack_int n, double a[], double anorm, double* rcond)
+	{
+		return lu_rcond(norm, n, a, anorm, rcond, LAPACKE_dgecon);
+	}
+
+	DLLEXPORT lapack_int c_lu_rcond(char norm, lapack_int n, lapack_complex_float a[], float anorm, float* rcond)
+	{
+		return lu_rcond(norm, n, a, anorm, rcond, LAPACKE_cgecon);
+	}
+
+	DLLEXPORT lapack_int z_lu_rcond(char norm, lapack_int n, lapack_complex_double a[], double anorm, double* rcond)
+	{
+		return lu_rcond(norm, n, a, anorm, rcond, LAPACKE_zgecon);
+	}
+}
@@ -0,0 +1,407 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "parallel.h"
+#include <algorithm>
+
+/*
+	Fused element-wise kernels. Expressions such as r = a*x + b*y - z are
+	evaluated in a single pass over the inputs instead of one BLAS/VML call
+	(and one full sweep through memory) per operator.
+
+	fused_evaluate runs a small stack program over cache-sized blocks. The
+	program is a sequence of (opcode, operand) pairs:
+
+		FUSED_LOAD   i   push input array i
+		FUSED_CONST  k   push constants[k]
+		FUSED_ADD    -   pop b, pop a, push a + b
+		FUSED_SUB    -   pop b, pop a, push a - b
+		FUSED_MUL    -   pop b, pop a, push a * b
+		FUSED_DIV    -   pop b, pop a, push a / b
+		FUSED_NEG    -   pop a, push -a
+		FUSED_FMA    -   pop c, pop b, pop a, push a * b + c
+
+	The program must leave exactly one value on the stack. Bad arguments
+	return the usual -(argument index); a bad program returns -(9 + k) for
+	its instruction k, or -(9 + instructions) if the stack does not end
+	with a single value.
+*/
+
+const int FUSED_BLOCK = 512;
+const int FUSED_MAX_STACK = 8;
+const int FUSED_PARALLEL_GRAIN = 1 << 16;
+const int FUSED_FIRST_INSTRUCTION = 9;
+
+enum fused_opcode
+{
+	FUSED_LOAD = 1,
+	FUSED_CONST = 2,
+	FUSED_ADD = 3,
+	FUSED_SUB = 4,
+	FUSED_MUL = 5,
+	FUSED_DIV = 6,
+	FUSED_NEG = 7,
+	FUSED_FMA = 8
+};
+
+template<typename T>
+inline void fused_axpby(const int n, const T alpha, const T x[], const T beta, const T y[], T result[])
+{
+	parallel_for(n, FUSED_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = alpha * x[i] + beta * y[i];
+		}
+	});
+}
+
+template<typename T>
+inline void fused_axpbypcz(const int n, const T alpha, const T x[], const T beta, const T y[], const T gamma, const T z[], T result[])
+{
+	parallel_for(n, FUSED_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = alpha * x[i] + beta * y[i] + gamma * z[i];
+		}
+	});
+}
+
+template<typename T>
+inline void fused_multiply_add(const int n, const T x[], const T y[], const T z[], T result[])
+{
+	parallel_for(n, FUSED_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = x[i] * y[i] + z[i];
+		}
+	});
+}
+
+template<typename T>
+inline void fused_linear_frac(const int n, const T x[], const T y[], const T scale_x, const T shift_x, const T scale_y, const T shift_y, T result[])
+{
+	parallel_for(n, FUSED_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			result[i] = (scale_x * x[i] + shift_x) / (scale_y * y[i] + shift_y);
+		}
+	});
+}
+
+// A stack entry is either a stride-1 block or a broadcast scalar.
+template<typename T>
+struct fused_operand
+{
+	const T* data;
+	T scalar;
+	bool is_scalar;
+};
+
+template<typename T, typename Op>
+inline void fused_binary(const int len, const fused_operand<T>& a, const fused_operand<T>& b, T out[], Op op)
+{
+	if (a.is_scalar && b.is_scalar)
+	{
+		const auto s = op(a.scalar, b.scalar);
+		std::fill(out, out + len, s);
+	}
+	else if (a.is_scalar)
+	{
+		const auto s = a.scalar;
+		const auto* pb = b.data;
+		for (auto i = 0; i < len; ++i)
+		{
+			out[i] = op(s, pb[i]);
+		}
+	}
+	else if (b.is_scalar)
+	{
+		const auto* pa = a.data;
+		const auto s = b.scalar;
+		for (auto i = 0; i < len; ++i)
+		{
+			out[i] = op(pa[i], s);
+		}
+	}
+	else
+	{
+		const auto* pa = a.data;
+		const auto* pb = b.data;
+		for (auto i = 0; i < len; ++i)
+		{
+			out[i] = op(pa[i], pb[i]);
+		}
+	}
+}
+
+template<typename T>
+inline T fused_at(const fused_operand<T>& a, const int i)
+{
+	return a.is_scalar ? a.scalar : a.data[i];
+}
+
+// Returns 0 if the program is valid, otherwise -(FUSED_FIRST_INSTRUCTION + index of the first bad instruction).
+inline int fused_validate(const int instructions, const int program[], const int constants, const int inputs)
+{
+	auto depth = 0;
+
+	for (auto k = 0; k < instructions; ++k)
+	{
+		auto op = program[2 * k];
+		auto arg = program[2 * k + 1];
+
+		switch (op)
+		{
+		case FUSED_LOAD:
+			if (arg < 0 || arg >= inputs || ++depth > FUSED_MAX_STACK) return -(FUSED_FIRST_INSTRUCTION + k);
+			break;
+		case FUSED_CONST:
+			if (arg < 0 || arg >= constants || ++depth > FUSED_MAX_STACK) return -(FUSED_FIRST_INSTRUCTION + k);
+			break;
+		case FUSED_ADD:
+		case FUSED_SUB:
+		case FUSED_MUL:
+		case FUSED_DIV:
+			if (depth < 2) return -(FUSED_FIRST_INSTRUCTION + k);
+			--depth;
+			break;
+		case FUSED_NEG:
+			if (depth < 1) return -(FUSED_FIRST_INSTRUCTION + k);
+			break;
+		case FUSED_FMA:
+			if (depth < 3) return -(FUSED_FIRST_INSTRUCTION + k);
+			depth -= 2;
+			break;
+		default:
+			return -(FUSED_FIRST_INSTRUCTION + k);
+		}
+	}
+
+	return depth == 1 ? 0 : -(FUSED_FIRST_INSTRUCTION + instructions);
+}
+
+template<typename T>
+inline void fused_evaluate_block(const int offset, const int len, const int instructions, const int program[], const T constants[], const T* const inputs[], T buffers[], T result[])
+{
+	fused_operand<T> stack[FUSED_MAX_STACK];
+	auto top = -1;
+
+	for (auto k = 0; k < instructions; ++k)
+	{
+		auto op = program[2 * k];
+		auto arg = program[2 * k + 1];
+
+		if (op == FUSED_LOAD)
+		{
+			++top;
+			stack[top].data = inputs[arg] + offset;
+			stack[top].is_scalar = false;
+			continue;
+		}
+
+		if (op == FUSED_CONST)
+		{
+			++top;
+			stack[top].data = nullptr;
+			stack[top].scalar = constants[arg];
+			stack[top].is_scalar = true;
+			continue;
+		}
+
+		auto arity = op == FUSED_NEG ? 1 : op == FUSED_FMA ? 3 : 2;
+		auto target = top - arity + 1;
+
+		// the last instruction writes straight into the output
+		auto* out = k == instructions - 1 ? result + offset : buffers + target * FUSED_BLOCK;
+
+		switch (op)
+		{
+		case FUSED_ADD:
+			fused_binary(len, stack[target], stack[top], out, [](T a, T b) { return a + b; });
+			break;
+		case FUSED_SUB:
+			fused_binary(len, stack[target], stack[top], out, [](T a, T b) { return a - b; });
+			break;
+		case FUSED_MUL:
+			fused_binary(len, stack[target], stack[top], out, [](T a, T b) { return a * b; });
+			break;
+		case FUSED_DIV:
+			fused_binary(len, stack[target], stack[top], out, [](T a, T b) { return a / b; });
+			break;
+		case FUSED_NEG:
+			for (auto i = 0; i < len; ++i)
+			{
+				out[i] = -fused_at(stack[target], i);
+			}
+			break;
+		case FUSED_FMA:
+			{
+				const auto& a = stack[target];
+				const auto& b = stack[target + 1];
+				const auto& c = stack[target + 2];
+
+				if (!a.is_scalar && !b.is_scalar && !c.is_scalar)
+				{
+					for (auto i = 0; i < len; ++i)
+					{
+						out[i] = a.data[i] * b.data[i] + c.data[i];
+					}
+				}
+				else
+				{
+					for (auto i = 0; i < len; ++i)
+					{
+						out[i] = fused_at(a, i) * fused_at(b, i) + fused_at(c, i);
+					}
+				}
+			}
+			break;
+		}
+
+		top = target;
+		stack[top].data = out;
+		stack[top].is_scalar = false;
+	}
+
+	// degenerate programs without any arithmetic (a single load or constant)
+	if (program[2 * (instructions - 1)] == FUSED_LOAD || program[2 * (instructions - 1)] == FUSED_CONST)
+	{
+		for (auto i = 0; i < len; ++i)
+		{
+			result[offset + i] = fused_at(stack[0], i);
+		}
+	}
+}
+
+template<typename T>
+inline int fused_evaluate(const int n, const int instructions, const int program[], const int constant_count, const T constants[], const int input_count, const T* const inputs[], T result[])
+{
+	if (n < 0) return -1;
+	if (instructions < 1) return -2;
+	if (constant_count < 0) return -4;
+	if (input_count < 0) return -6;
+
+	auto info = fused_validate(instructions, program, constant_count, input_count);
+	if (info != 0)
+	{
+		return info;
+	}
+
+	const auto blocks = (n + FUSED_BLOCK - 1) / FUSED_BLOCK;
+	const auto chunks = parallel_chunk_count(n, FUSED_PARALLEL_GRAIN);
+
+	std::vector<array_ptr<T>> buffers;
+	try
+	{
+		for (auto c = 0; c < chunks; ++c)
+		{
+			buffers.push_back(array_new<T>(FUSED_MAX_STACK * FUSED_BLOCK));
+		}
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+
+	parallel_for_chunks(blocks, std::min(chunks, blocks), [&](int chunk, int begin, int end)
+	{
+		auto* scratch = buffers[chunk].get();
+
+		for (auto block = begin; block < end; ++block)
+		{
+			auto offset = block * FUSED_BLOCK;
+			auto len = std::min(FUSED_BLOCK, n - offset);
+			fused_evaluate_block(offset, len, instructions, program, constants, inputs, scratch, result);
+		}
+	});
+
+	return 0;
+}
+
+extern "C" {
+
+	DLLEXPORT void s_fused_axpby(const int n, const float alpha, const float x[], const float beta, const float y[], float result[])
+	{
+		fused_axpby(n, alpha, x, beta, y, result);
+	}
+
+	DLLEXPORT void d_fused_axpby(const int n, const double alpha, const double x[], const double beta, const double y[], double result[])
+	{
+		fused_axpby(n, alpha, x, beta, y, result);
+	}
+
+	DLLEXPORT void c_fused_axpby(const int n, const lapack_complex_float alpha, const lapack_complex_float x[], const lapack_complex_float beta, const lapack_complex_float y[], lapack_complex_float result[])
+	{
+		fused_axpby(n, alpha, x, beta, y, result);
+	}
+
+	DLLEXPORT void z_fused_axpby(const int n, const lapack_complex_double alpha, const lapack_complex_double x[], const lapack_complex_double beta, const lapack_complex_double y[], lapack_complex_double result[])
+	{
+		fused_axpby(n, alpha, x, beta, y, result);
+	}
+
+	DLLEXPORT void s_fused_axpbypcz(const int n, const float alpha, const float x[], const float beta, const float y[], const float gamma, const float z[], float result[])
+	{
+		fused_axpbypcz(n, alpha, x, beta, y, gamma, z, result);
+	}
+
+	DLLEXPORT void d_fused_axpbypcz(const int n, const double alpha, const double x[], const double beta, const double y[], const double gamma, const double z[], double result[])
+	{
+		fused_axpbypcz(n, alpha, x, beta, y, gamma, z, result);
+	}
+
+	DLLEXPORT void c_fused_axpbypcz(const int n, const lapack_complex_float alpha, const lapack_complex_float x[], const lapack_complex_float beta, const lapack_complex_float y[], const lapack_complex_float gamma, const lapack_complex_float z[], lapack_complex_float result[])
+	{
+		fused_axpbypcz(n, alpha, x, beta, y, gamma, z, result);
+	}
+
+	DLLEXPORT void z_fused_axpbypcz(const int n, const lapack_complex_double alpha, const lapack_complex_double x[], const lapack_complex_double beta, const lapack_complex_double y[], const lapack_complex_double gamma, const lapack_complex_double z[], lapack_complex_double result[])
+	{
+		fused_axpbypcz(n, alpha, x, beta, y, gamma, z, result);
+	}
+
+	DLLEXPORT void s_fused_multiply_add(const int n, const float x[], const float y[], const float z[], float result[])
+	{
+		fused_multiply_add(n, x, y, z, result);
+	}
+
+	DLLEXPORT void d_fused_multiply_add(const int n, const double x[], const double y[], const double z[], double result[])
+	{
+		fused_multiply_add(n, x, y, z, result);
+	}
+
+	DLLEXPORT void c_fused_multiply_add(const int n, const lapack_complex_float x[], const lapack_complex_float y[], const lapack_complex_float z[], lapack_complex_float result[])
+	{
+		fused_multiply_add(n, x, y, z, result);
+	}
+
+	DLLEXPORT void z_fused_multiply_add(const int n, const lapack_complex_double x[], const lapack_complex_double y[], const lapack_complex_double z[], lapack_complex_double result[])
+	{
+		fused_multiply_add(n, x, y, z, result);
+	}
+
+	DLLEXPORT void s_fused_linear_frac(const int n, const float x[], const float y[], const float scale_x, const float shift_x, const float scale_y, const float shift_y, float result[])
+	{
+		fused_linear_frac(n, x, y, scale_x, shift_x, scale_y, shift_y, result);
+	}
+
+	DLLEXPORT void d_fused_linear_frac(const int n, const double x[], const double y[], const double scale_x, const double shift_x, const double scale_y, const double shift_y, double result[])
+	{
+		fused_linear_frac(n, x, y, scale_x, shift_x, scale_y, shift_y, result);
+	}
+
+	DLLEXPORT int s_fused_evaluate(const int n, const int instructions, const int program[], const int constant_count, const float constants[], const int input_count, const float* const inputs[], float result[])
+	{
+		return fused_evaluate(n, instructions, program, constant_count, constants, input_count, inputs, result);
+	}
+
+	DLLEXPORT int d_fused_evaluate(const int n, const int instructions, const int program[], const int constant_count, const double constants[], const int input_count, const double* const inputs[], double result[])
+	{
+		return fused_evaluate(n, instructions, program, constant_count, constants, input_count, inputs, result);
+	}
+}
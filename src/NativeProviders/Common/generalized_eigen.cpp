@@ -0,0 +1,245 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include <algorithm>
+#include <cstring>
+
+/*
+	Generalized eigenproblems A*x = lambda*B*x, solved on the pencil directly
+	instead of forming inv(B)*A: one pass, no loss of symmetry, and B may be
+	singular in the general case.
+
+	- x_symmetric_generalized_eigen (s/d) and x_hermitian_generalized_eigen
+	  (c/z): ?sygvd / ?hegvd for symmetric-definite pencils, B positive
+	  definite. itype selects A*x = l*B*x (1), A*B*x = l*x (2) or
+	  B*A*x = l*x (3). Values are real and ascending, vectors are
+	  B-orthonormal. Only the upper triangles are referenced. info > n means
+	  B is not positive definite.
+	- x_generalized_eigen: ?ggev for general pencils. The eigenvalues are
+	  alpha/beta and are returned as the pair, since beta may be zero
+	  (infinite eigenvalue). For the real types a complex pair is stored in
+	  consecutive vector columns as (re, im), as in x_eigen.
+	- x_qz_factor: ?gges, the generalized Schur (QZ) decomposition
+	  A = Q*S*Z', B = Q*T*Z' with S, T overwriting A, B.
+
+	With computeVectors false, vectors is not referenced and may be null.
+	A and B are left untouched except by x_qz_factor.
+*/
+
+template<typename T, typename R, typename SYGVD>
+inline lapack_int symmetric_generalized_eigen(bool computeVectors, lapack_int itype, lapack_int n, T a[], T b[], R values[], T vectors[], SYGVD sygvd)
+{
+	if (itype < 1 || itype > 3)
+	{
+		return -2;
+	}
+
+	try
+	{
+		auto clone_a = array_clone(n * n, a);
+		auto clone_b = array_clone(n * n, b);
+
+		auto info = sygvd(LAPACK_COL_MAJOR, itype, computeVectors ? 'V' : 'N', 'U', n, clone_a.get(), n, clone_b.get(), n, values);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		if (computeVectors)
+		{
+			std::memcpy(vectors, clone_a.get(), n * n * sizeof(T));
+		}
+
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GGEV>
+inline lapack_int generalized_eigen(bool computeVectors, lapack_int n, T a[], T b[], lapack_complex_double alpha[], lapack_complex_double beta[], T vectors[], GGEV ggev)
+{
+	try
+	{
+		auto clone_a = array_clone(n * n, a);
+		auto clone_b = array_clone(n * n, b);
+		auto ar = array_new<T>(std::max(1, n));
+		auto ai = array_new<T>(std::max(1, n));
+		auto br = array_new<T>(std::max(1, n));
+
+		auto info = ggev(LAPACK_COL_MAJOR, 'N', computeVectors ? 'V' : 'N', n, clone_a.get(), n, clone_b.get(), n,
+			ar.get(), ai.get(), br.get(), nullptr, n, computeVectors ? vectors : nullptr, n);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			alpha[i] = lapack_complex_double(ar.get()[i], ai.get()[i]);
+			beta[i] = lapack_complex_double(br.get()[i]);
+		}
+
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GGEV>
+inline lapack_int generalized_eigen_complex(bool computeVectors, lapack_int n, T a[], T b[], lapack_complex_double alpha[], lapack_complex_double beta[], T vectors[], GGEV ggev)
+{
+	try
+	{
+		auto clone_a = array_clone(n * n, a);
+		auto clone_b = array_clone(n * n, b);
+		auto wa = array_new<T>(std::max(1, n));
+		auto wb = array_new<T>(std::max(1, n));
+
+		auto info = ggev(LAPACK_COL_MAJOR, 'N', computeVectors ? 'V' : 'N', n, clone_a.get(), n, clone_b.get(), n,
+			wa.get(), wb.get(), nullptr, n, computeVectors ? vectors : nullptr, n);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			alpha[i] = wa.get()[i];
+			beta[i] = wb.get()[i];
+		}
+
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GGES>
+inline lapack_int qz_factor(lapack_int n, T a[], T b[], T q[], T z[], lapack_complex_double alpha[], lapack_complex_double beta[], GGES gges)
+{
+	try
+	{
+		auto ar = array_new<T>(std::max(1, n));
+		auto ai = array_new<T>(std::max(1, n));
+		auto br = array_new<T>(std::max(1, n));
+
+		lapack_int sdim;
+		auto info = gges(LAPACK_COL_MAJOR, 'V', 'V', 'N', nullptr, n, a, n, b, n, &sdim, ar.get(), ai.get(), br.get(), q, n, z, n);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			alpha[i] = lapack_complex_double(ar.get()[i], ai.get()[i]);
+			beta[i] = lapack_complex_double(br.get()[i]);
+		}
+
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GGES>
+inline lapack_int qz_factor_complex(lapack_int n, T a[], T b[], T q[], T z[], lapack_complex_double alpha[], lapack_complex_double beta[], GGES gges)
+{
+	try
+	{
+		auto wa = array_new<T>(std::max(1, n));
+		auto wb = array_new<T>(std::max(1, n));
+
+		lapack_int sdim;
+		auto info = gges(LAPACK_COL_MAJOR, 'V', 'V', 'N', nullptr, n, a, n, b, n, &sdim, wa.get(), wb.get(), q, n, z, n);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			alpha[i] = wa.get()[i];
+			beta[i] = wb.get()[i];
+		}
+
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_symmetric_generalized_eigen(bool computeVectors, lapack_int itype, lapack_int n, float a[], float b[], float values[], float vectors[])
+	{
+		return symmetric_generalized_eigen(computeVectors, itype, n, a, b, values, vectors, LAPACKE_ssygvd);
+	}
+
+	DLLEXPORT lapack_int d_symmetric_generalized_eigen(bool computeVectors, lapack_int itype, lapack_int n, double a[], double b[], double values[], double vectors[])
+	{
+		return symmetric_generalized_eigen(computeVectors, itype, n, a, b, values, vectors, LAPACKE_dsygvd);
+	}
+
+	DLLEXPORT lapack_int c_hermitian_generalized_eigen(bool computeVectors, lapack_int itype, lapack_int n, lapack_complex_float a[], lapack_complex_float b[], float values[], lapack_complex_float vectors[])
+	{
+		return symmetric_generalized_eigen(computeVectors, itype, n, a, b, values, vectors, LAPACKE_chegvd);
+	}
+
+	DLLEXPORT lapack_int z_hermitian_generalized_eigen(bool computeVectors, lapack_int itype, lapack_int n, lapack_complex_double a[], lapack_complex_double b[], double values[], lapack_complex_double vectors[])
+	{
+		return symmetric_generalized_eigen(computeVectors, itype, n, a, b, values, vectors, LAPACKE_zhegvd);
+	}
+
+	DLLEXPORT lapack_int s_generalized_eigen(bool computeVectors, lapack_int n, float a[], float b[], lapack_complex_double alpha[], lapack_complex_double beta[], float vectors[])
+	{
+		return generalized_eigen(computeVectors, n, a, b, alpha, beta, vectors, LAPACKE_sggev);
+	}
+
+	DLLEXPORT lapack_int d_generalized_eigen(bool computeVectors, lapack_int n, double a[], double b[], lapack_complex_double alpha[], lapack_complex_double beta[], double vectors[])
+	{
+		return generalized_eigen(computeVectors, n, a, b, alpha, beta, vectors, LAPACKE_dggev);
+	}
+
+	DLLEXPORT lapack_int c_generalized_eigen(bool computeVectors, lapack_int n, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_double alpha[], lapack_complex_double beta[], lapack_complex_float vectors[])
+	{
+		return generalized_eigen_complex(computeVectors, n, a, b, alpha, beta, vectors, LAPACKE_cggev);
+	}
+
+	DLLEXPORT lapack_int z_generalized_eigen(bool computeVectors, lapack_int n, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double alpha[], lapack_complex_double beta[], lapack_complex_double vectors[])
+	{
+		return generalized_eigen_complex(computeVectors, n, a, b, alpha, beta, vectors, LAPACKE_zggev);
+	}
+
+	DLLEXPORT lapack_int s_qz_factor(lapack_int n, float a[], float b[], float q[], float z[], lapack_complex_double alpha[], lapack_complex_double beta[])
+	{
+		return qz_factor(n, a, b, q, z, alpha, beta, LAPACKE_sgges);
+	}
+
+	DLLEXPORT lapack_int d_qz_factor(lapack_int n, double a[], double b[], double q[], double z[], lapack_complex_double alpha[], lapack_complex_double beta[])
+	{
+		return qz_factor(n, a, b, q, z, alpha, beta, LAPACKE_dgges);
+	}
+
+	DLLEXPORT lapack_int c_qz_factor(lapack_int n, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float q[], lapack_complex_float z[], lapack_complex_double alpha[], lapack_complex_double beta[])
+	{
+		return qz_factor_complex(n, a, b, q, z, alpha, beta, LAPACKE_cgges);
+	}
+
+	DLLEXPORT lapack_int z_qz_factor(lapack_int n, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double q[], lapack_complex_double z[], lapack_complex_double alpha[], lapack_complex_double beta[])
+	{
+		return qz_factor_complex(n, a, b, q, z, alpha, beta, LAPACKE_zgges);
+	}
+}
@@ -4,11 +4,25 @@
 #include "lapack_common.h"
 #include <algorithm>
 #include <cstring>
+#include <limits>
+
+/*
+	The factor and solve templates take the storage order as a trailing
+	layout argument, LAPACK_COL_MAJOR by default. The x_*_rm exports pass
+	LAPACK_ROW_MAJOR so that row-major buffers go straight to LAPACKE; the
+	right-hand sides are then n x nrhs by rows and pivots stay zero-based.
+*/
+
+// Leading dimension of a rows x cols matrix stored in the given layout.
+inline lapack_int leading_dimension(int layout, lapack_int rows, lapack_int cols)
+{
+	return layout == LAPACK_ROW_MAJOR ? cols : rows;
+}
 
 template<typename T, typename GETRF>
-inline lapack_int lu_factor(lapack_int m, T a[], lapack_int ipiv[], GETRF getrf)
+inline lapack_int lu_factor(lapack_int m, T a[], lapack_int ipiv[], GETRF getrf, int layout = LAPACK_COL_MAJOR)
 {
-	auto info = getrf(LAPACK_COL_MAJOR, m, m, a, m, ipiv);
+	auto info = getrf(layout, m, m, a, m, ipiv);
 	shift_ipiv_down(m, ipiv);
 	return info;
 }
@@ -45,29 +59,43 @@ inline lapack_int lu_inverse_factored(lapack_int n, T a[], lapack_int ipiv[], GE
 }
 
 template<typename T, typename GETRS>
-inline lapack_int lu_solve_factored(lapack_int n, lapack_int nrhs, T a[], lapack_int ipiv[], T b[], GETRS getrs)
+inline lapack_int lu_solve_factored(lapack_int n, lapack_int nrhs, T a[], lapack_int ipiv[], T b[], GETRS getrs, int layout = LAPACK_COL_MAJOR)
 {
 	shift_ipiv_up(n, ipiv);
-	auto info = getrs(LAPACK_COL_MAJOR, 'N', n, nrhs, a, n, ipiv, b, n);
+	auto info = getrs(layout, 'N', n, nrhs, a, n, ipiv, b, leading_dimension(layout, n, nrhs));
 	shift_ipiv_down(n, ipiv);
 	return info;
 }
 
+// Overwrites a with its LU factors; for callers that do not need a afterwards.
 template<typename T, typename GETRF, typename GETRS>
-inline lapack_int lu_solve(lapack_int n, lapack_int nrhs, T a[], T b[], GETRF getrf, GETRS getrs)
+inline lapack_int lu_solve_inplace(lapack_int n, lapack_int nrhs, T a[], T b[], GETRF getrf, GETRS getrs, int layout = LAPACK_COL_MAJOR)
 {
 	try
 	{
-		auto clone = array_clone(n * n, a);
 		auto ipiv = array_new<lapack_int>(n);
-		auto info = getrf(LAPACK_COL_MAJOR, n, n, clone.get(), n, ipiv.get());
+		auto info = getrf(layout, n, n, a, n, ipiv.get());
 
 		if (info != 0)
 		{
 			return info;
 		}
 
-		return getrs(LAPACK_COL_MAJOR, 'N', n, nrhs, clone.get(), n, ipiv.get(), b, n);
+		return getrs(layout, 'N', n, nrhs, a, n, ipiv.get(), b, leading_dimension(layout, n, nrhs));
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GETRF, typename GETRS>
+inline lapack_int lu_solve(lapack_int n, lapack_int nrhs, T a[], T b[], GETRF getrf, GETRS getrs, int layout = LAPACK_COL_MAJOR)
+{
+	try
+	{
+		auto clone = array_clone(n * n, a);
+		return lu_solve_inplace(n, nrhs, clone.get(), b, getrf, getrs, layout);
 	}
 	catch (std::bad_alloc&)
 	{
@@ -76,38 +104,44 @@ inline lapack_int lu_solve(lapack_int n, lapack_int nrhs, T a[], T b[], GETRF ge
 }
 
 template<typename T, typename POTRF>
-inline lapack_int cholesky_factor(lapack_int n, T* a, POTRF potrf)
+inline lapack_int cholesky_factor(lapack_int n, T* a, POTRF potrf, int layout = LAPACK_COL_MAJOR)
 {
-	auto info = potrf(LAPACK_COL_MAJOR, 'L', n, a, n);
+	auto info = potrf(layout, 'L', n, a, n);
 	auto zero = T();
 
+	// Clear the strict upper triangle: a(j, i) for j < i.
 	for (auto i = 0; i < n; ++i)
 	{
-		auto index = i * n;
-
 		for (auto j = 0; j < n && i > j; ++j)
 		{
-			a[index + j] = zero;
+			a[layout == LAPACK_ROW_MAJOR ? j * n + i : i * n + j] = zero;
 		}
 	}
 
 	return info;
 }
 
+// Overwrites the lower triangle of a with its Cholesky factor.
 template<typename T, typename POTRF, typename POTRS>
-inline lapack_int cholesky_solve(lapack_int n, lapack_int nrhs, T a[], T b[], POTRF potrf, POTRS potrs)
+inline lapack_int cholesky_solve_inplace(lapack_int n, lapack_int nrhs, T a[], T b[], POTRF potrf, POTRS potrs, int layout = LAPACK_COL_MAJOR)
 {
-	try
+	auto info = potrf(layout, 'L', n, a, n);
+
+	if (info != 0)
 	{
-		auto clone = array_clone(n * n, a);
-		auto info = potrf(LAPACK_COL_MAJOR, 'L', n, clone.get(), n);
+		return info;
+	}
 
-		if (info != 0)
-		{
-			return info;
-		}
+	return potrs(layout, 'L', n, nrhs, a, n, b, leading_dimension(layout, n, nrhs));
+}
 
-		return potrs(LAPACK_COL_MAJOR, 'L', n, nrhs, clone.get(), n, b, n);
+template<typename T, typename POTRF, typename POTRS>
+inline lapack_int cholesky_solve(lapack_int n, lapack_int nrhs, T a[], T b[], POTRF potrf, POTRS potrs, int layout = LAPACK_COL_MAJOR)
+{
+	try
+	{
+		auto clone = array_clone(n * n, a);
+		return cholesky_solve_inplace(n, nrhs, clone.get(), b, potrf, potrs, layout);
 	}
 	catch (std::bad_alloc&)
 	{
@@ -175,21 +209,137 @@ inline lapack_int qr_thin_factor(lapack_int m, lapack_int n, T q[], T tau[], T r
 	return info;
 }
 
+// Number of leading diagonal entries of a column-pivoted R above tolerance * |r(0,0)|; tolerance <= 0 selects max(m,n) * eps.
+template<typename T, typename R>
+inline lapack_int qr_pivot_rank(lapack_int m, lapack_int n, const T r[], lapack_int ldr, R tolerance)
+{
+	auto k = std::min(m, n);
+
+	if (k == 0)
+	{
+		return 0;
+	}
+
+	if (tolerance <= 0)
+	{
+		tolerance = std::max(m, n) * std::numeric_limits<R>::epsilon();
+	}
+
+	auto threshold = tolerance * std::abs(r[0]);
+	auto rank = 0;
+
+	while (rank < k && std::abs(r[rank * ldr + rank]) > threshold)
+	{
+		++rank;
+	}
+
+	return rank;
+}
+
+template<typename T, typename R, typename GEQP3, typename ORGQR>
+inline lapack_int qr_pivot_factor(lapack_int m, lapack_int n, T q[], T tau[], T r[], lapack_int jpvt[], R tolerance, lapack_int* rank, GEQP3 geqp3, ORGQR orgqr)
+{
+	auto k = std::min(m, n);
+	std::fill(jpvt, jpvt + n, 0);
+
+	auto info = geqp3(LAPACK_COL_MAJOR, m, n, q, m, jpvt, tau);
+	shift_ipiv_down(n, jpvt);
+
+	for (auto j = 0; j < n; ++j)
+	{
+		for (auto i = 0; i < k && i <= j; ++i)
+		{
+			r[j * k + i] = q[j * m + i];
+		}
+	}
+
+	if (info != 0)
+	{
+		return info;
+	}
+
+	*rank = qr_pivot_rank(m, n, r, k, tolerance);
+	info = orgqr(LAPACK_COL_MAJOR, m, k, k, q, m, tau);
+	return info;
+}
+
+// Overwrites a with its QR factors and b with Q'*b; x must not alias b.
+// Row-major b must hold max(m, n) rows: gels returns the minimum norm
+// solution of an underdetermined system in its first n rows.
 template<typename T, typename GELS>
-inline lapack_int qr_solve(lapack_int m, lapack_int n, lapack_int bn, T a[], T b[], T x[], GELS gels)
+inline lapack_int qr_solve_inplace(lapack_int m, lapack_int n, lapack_int bn, T a[], T b[], T x[], GELS gels, int layout = LAPACK_COL_MAJOR)
+{
+	auto info = gels(layout, 'N', m, n, bn, a, leading_dimension(layout, m, n), b, leading_dimension(layout, m, bn));
+
+	if (info != 0)
+	{
+		return info;
+	}
+
+	if (layout == LAPACK_ROW_MAJOR)
+	{
+		// The first n rows of b hold the solution, contiguously.
+		std::copy(b, b + n * bn, x);
+	}
+	else
+	{
+		copyBtoX(m, n, bn, b, x);
+	}
+
+	return info;
+}
+
+template<typename T, typename GELS>
+inline lapack_int qr_solve(lapack_int m, lapack_int n, lapack_int bn, T a[], T b[], T x[], GELS gels, int layout = LAPACK_COL_MAJOR)
 {
 	try
 	{
 		auto clone_a = array_clone(m * n, a);
+		if (layout == LAPACK_ROW_MAJOR && m < n)
+		{
+			auto clone_b = array_new<T>(n * bn);
+			std::copy(b, b + m * bn, clone_b.get());
+			return qr_solve_inplace(m, n, bn, clone_a.get(), clone_b.get(), x, gels, layout);
+		}
+
 		auto clone_b = array_clone(m * bn, b);
-		auto info = gels(LAPACK_COL_MAJOR, 'N', m, n, bn, clone_a.get(), m, clone_b.get(), m);
+		return qr_solve_inplace(m, n, bn, clone_a.get(), clone_b.get(), x, gels, layout);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename R, typename GELSY>
+inline lapack_int qr_solve_rank_revealing(lapack_int m, lapack_int n, lapack_int bn, T a[], T b[], T x[], R rcond, lapack_int* rank, GELSY gelsy)
+{
+	try
+	{
+		auto ldb = std::max(m, n);
+		auto clone_a = array_clone(m * n, a);
+		auto work_b = array_new<T>(ldb * bn);
+		auto jpvt = array_new<lapack_int>(n);
+		std::fill(jpvt.get(), jpvt.get() + n, 0);
+
+		for (auto j = 0; j < bn; ++j)
+		{
+			std::copy(b + j * m, b + (j + 1) * m, work_b.get() + j * ldb);
+		}
+
+		if (rcond <= 0)
+		{
+			rcond = ldb * std::numeric_limits<R>::epsilon();
+		}
+
+		auto info = gelsy(LAPACK_COL_MAJOR, m, n, bn, clone_a.get(), m, work_b.get(), ldb, jpvt.get(), rcond, rank);
 
 		if (info != 0)
 		{
 			return info;
 		}
 
-		copyBtoX(m, n, bn, clone_b.get(), x);
+		copyBtoX(ldb, n, bn, work_b.get(), x);
 		return info;
 	}
 	catch (std::bad_alloc&)
@@ -455,6 +605,26 @@ extern "C" {
 		return lu_factor(m, a, ipiv, LAPACKE_zgetrf);
 	}
 
+	DLLEXPORT lapack_int s_lu_factor_rm(lapack_int m, float a[], lapack_int ipiv[])
+	{
+		return lu_factor(m, a, ipiv, LAPACKE_sgetrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_lu_factor_rm(lapack_int m, double a[], lapack_int ipiv[])
+	{
+		return lu_factor(m, a, ipiv, LAPACKE_dgetrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_lu_factor_rm(lapack_int m, lapack_complex_float a[], lapack_int ipiv[])
+	{
+		return lu_factor(m, a, ipiv, LAPACKE_cgetrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_lu_factor_rm(lapack_int m, lapack_complex_double a[], lapack_int ipiv[])
+	{
+		return lu_factor(m, a, ipiv, LAPACKE_zgetrf, LAPACK_ROW_MAJOR);
+	}
+
 	DLLEXPORT lapack_int s_lu_inverse(lapack_int n, float a[], float work[], lapack_int lwork)
 	{
 		return lu_inverse(n, a, LAPACKE_sgetrf, LAPACKE_sgetri);
@@ -515,6 +685,26 @@ extern "C" {
 		return lu_solve_factored(n, nrhs, a, ipiv, b, LAPACKE_zgetrs);
 	}
 
+	DLLEXPORT lapack_int s_lu_solve_factored_rm(lapack_int n, lapack_int nrhs, float a[], lapack_int ipiv[], float b[])
+	{
+		return lu_solve_factored(n, nrhs, a, ipiv, b, LAPACKE_sgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_lu_solve_factored_rm(lapack_int n, lapack_int nrhs, double a[], lapack_int ipiv[], double b[])
+	{
+		return lu_solve_factored(n, nrhs, a, ipiv, b, LAPACKE_dgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_lu_solve_factored_rm(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_int ipiv[], lapack_complex_float b[])
+	{
+		return lu_solve_factored(n, nrhs, a, ipiv, b, LAPACKE_cgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_lu_solve_factored_rm(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_int ipiv[], lapack_complex_double b[])
+	{
+		return lu_solve_factored(n, nrhs, a, ipiv, b, LAPACKE_zgetrs, LAPACK_ROW_MAJOR);
+	}
+
 	DLLEXPORT lapack_int s_lu_solve(lapack_int n, lapack_int nrhs, float a[], float b[])
 	{
 		return lu_solve(n, nrhs, a, b, LAPACKE_sgetrf, LAPACKE_sgetrs);
@@ -535,6 +725,46 @@ extern "C" {
 		return lu_solve(n, nrhs, a, b, LAPACKE_zgetrf, LAPACKE_zgetrs);
 	}
 
+	DLLEXPORT lapack_int s_lu_solve_rm(lapack_int n, lapack_int nrhs, float a[], float b[])
+	{
+		return lu_solve(n, nrhs, a, b, LAPACKE_sgetrf, LAPACKE_sgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_lu_solve_rm(lapack_int n, lapack_int nrhs, double a[], double b[])
+	{
+		return lu_solve(n, nrhs, a, b, LAPACKE_dgetrf, LAPACKE_dgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_lu_solve_rm(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[])
+	{
+		return lu_solve(n, nrhs, a, b, LAPACKE_cgetrf, LAPACKE_cgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_lu_solve_rm(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[])
+	{
+		return lu_solve(n, nrhs, a, b, LAPACKE_zgetrf, LAPACKE_zgetrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int s_lu_solve_inplace(lapack_int n, lapack_int nrhs, float a[], float b[])
+	{
+		return lu_solve_inplace(n, nrhs, a, b, LAPACKE_sgetrf, LAPACKE_sgetrs);
+	}
+
+	DLLEXPORT lapack_int d_lu_solve_inplace(lapack_int n, lapack_int nrhs, double a[], double b[])
+	{
+		return lu_solve_inplace(n, nrhs, a, b, LAPACKE_dgetrf, LAPACKE_dgetrs);
+	}
+
+	DLLEXPORT lapack_int c_lu_solve_inplace(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[])
+	{
+		return lu_solve_inplace(n, nrhs, a, b, LAPACKE_cgetrf, LAPACKE_cgetrs);
+	}
+
+	DLLEXPORT lapack_int z_lu_solve_inplace(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[])
+	{
+		return lu_solve_inplace(n, nrhs, a, b, LAPACKE_zgetrf, LAPACKE_zgetrs);
+	}
+
 	DLLEXPORT lapack_int s_cholesky_factor(lapack_int n, float a[])
 	{
 		return cholesky_factor(n, a, LAPACKE_spotrf);
@@ -555,6 +785,26 @@ extern "C" {
 		return cholesky_factor(n, a, LAPACKE_zpotrf);
 	}
 
+	DLLEXPORT lapack_int s_cholesky_factor_rm(lapack_int n, float a[])
+	{
+		return cholesky_factor(n, a, LAPACKE_spotrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_factor_rm(lapack_int n, double a[])
+	{
+		return cholesky_factor(n, a, LAPACKE_dpotrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_factor_rm(lapack_int n, lapack_complex_float a[])
+	{
+		return cholesky_factor(n, a, LAPACKE_cpotrf, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_factor_rm(lapack_int n, lapack_complex_double a[])
+	{
+		return cholesky_factor(n, a, LAPACKE_zpotrf, LAPACK_ROW_MAJOR);
+	}
+
 	DLLEXPORT lapack_int s_cholesky_solve(lapack_int n, lapack_int nrhs, float a[], float b[])
 	{
 		return cholesky_solve(n, nrhs, a, b, LAPACKE_spotrf, LAPACKE_spotrs);
@@ -575,6 +825,46 @@ extern "C" {
 		return cholesky_solve(n, nrhs, a, b, LAPACKE_zpotrf, LAPACKE_zpotrs);
 	}
 
+	DLLEXPORT lapack_int s_cholesky_solve_rm(lapack_int n, lapack_int nrhs, float a[], float b[])
+	{
+		return cholesky_solve(n, nrhs, a, b, LAPACKE_spotrf, LAPACKE_spotrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_solve_rm(lapack_int n, lapack_int nrhs, double a[], double b[])
+	{
+		return cholesky_solve(n, nrhs, a, b, LAPACKE_dpotrf, LAPACKE_dpotrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_solve_rm(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[])
+	{
+		return cholesky_solve(n, nrhs, a, b, LAPACKE_cpotrf, LAPACKE_cpotrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_solve_rm(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[])
+	{
+		return cholesky_solve(n, nrhs, a, b, LAPACKE_zpotrf, LAPACKE_zpotrs, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int s_cholesky_solve_inplace(lapack_int n, lapack_int nrhs, float a[], float b[])
+	{
+		return cholesky_solve_inplace(n, nrhs, a, b, LAPACKE_spotrf, LAPACKE_spotrs);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_solve_inplace(lapack_int n, lapack_int nrhs, double a[], double b[])
+	{
+		return cholesky_solve_inplace(n, nrhs, a, b, LAPACKE_dpotrf, LAPACKE_dpotrs);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_solve_inplace(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[])
+	{
+		return cholesky_solve_inplace(n, nrhs, a, b, LAPACKE_cpotrf, LAPACKE_cpotrs);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_solve_inplace(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[])
+	{
+		return cholesky_solve_inplace(n, nrhs, a, b, LAPACKE_zpotrf, LAPACKE_zpotrs);
+	}
+
 	DLLEXPORT lapack_int s_cholesky_solve_factored(lapack_int n, lapack_int nrhs, float a[], float b[])
 	{
 		return LAPACKE_spotrs(LAPACK_COL_MAJOR, 'L', n, nrhs, a, n, b, n);
@@ -595,6 +885,26 @@ extern "C" {
 		return LAPACKE_zpotrs(LAPACK_COL_MAJOR, 'L', n, nrhs, a, n, b, n);
 	}
 
+	DLLEXPORT lapack_int s_cholesky_solve_factored_rm(lapack_int n, lapack_int nrhs, float a[], float b[])
+	{
+		return LAPACKE_spotrs(LAPACK_ROW_MAJOR, 'L', n, nrhs, a, n, b, nrhs);
+	}
+
+	DLLEXPORT lapack_int d_cholesky_solve_factored_rm(lapack_int n, lapack_int nrhs, double a[], double b[])
+	{
+		return LAPACKE_dpotrs(LAPACK_ROW_MAJOR, 'L', n, nrhs, a, n, b, nrhs);
+	}
+
+	DLLEXPORT lapack_int c_cholesky_solve_factored_rm(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[])
+	{
+		return LAPACKE_cpotrs(LAPACK_ROW_MAJOR, 'L', n, nrhs, a, n, b, nrhs);
+	}
+
+	DLLEXPORT lapack_int z_cholesky_solve_factored_rm(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[])
+	{
+		return LAPACKE_zpotrs(LAPACK_ROW_MAJOR, 'L', n, nrhs, a, n, b, nrhs);
+	}
+
 	DLLEXPORT lapack_int s_qr_factor(lapack_int m, lapack_int n, float r[], float tau[], float q[])
 	{
 		return qr_factor(m, n, r, tau, q, LAPACKE_sgeqrf, LAPACKE_sorgqr);
@@ -635,6 +945,26 @@ extern "C" {
 		return qr_thin_factor(m, n, q, tau, r, LAPACKE_zgeqrf, LAPACKE_zungqr);
 	}
 
+	DLLEXPORT lapack_int s_qr_pivot_factor(lapack_int m, lapack_int n, float q[], float tau[], float r[], lapack_int jpvt[], float tolerance, lapack_int* rank)
+	{
+		return qr_pivot_factor(m, n, q, tau, r, jpvt, tolerance, rank, LAPACKE_sgeqp3, LAPACKE_sorgqr);
+	}
+
+	DLLEXPORT lapack_int d_qr_pivot_factor(lapack_int m, lapack_int n, double q[], double tau[], double r[], lapack_int jpvt[], double tolerance, lapack_int* rank)
+	{
+		return qr_pivot_factor(m, n, q, tau, r, jpvt, tolerance, rank, LAPACKE_dgeqp3, LAPACKE_dorgqr);
+	}
+
+	DLLEXPORT lapack_int c_qr_pivot_factor(lapack_int m, lapack_int n, lapack_complex_float q[], lapack_complex_float tau[], lapack_complex_float r[], lapack_int jpvt[], float tolerance, lapack_int* rank)
+	{
+		return qr_pivot_factor(m, n, q, tau, r, jpvt, tolerance, rank, LAPACKE_cgeqp3, LAPACKE_cungqr);
+	}
+
+	DLLEXPORT lapack_int z_qr_pivot_factor(lapack_int m, lapack_int n, lapack_complex_double q[], lapack_complex_double tau[], lapack_complex_double r[], lapack_int jpvt[], double tolerance, lapack_int* rank)
+	{
+		return qr_pivot_factor(m, n, q, tau, r, jpvt, tolerance, rank, LAPACKE_zgeqp3, LAPACKE_zungqr);
+	}
+
 	DLLEXPORT lapack_int s_qr_solve(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float x[])
 	{
 		return qr_solve(m, n, bn, a, b, x, LAPACKE_sgels);
@@ -655,6 +985,66 @@ extern "C" {
 		return qr_solve(m, n, bn, a, b, x, LAPACKE_zgels);
 	}
 
+	DLLEXPORT lapack_int s_qr_solve_rm(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float x[])
+	{
+		return qr_solve(m, n, bn, a, b, x, LAPACKE_sgels, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int d_qr_solve_rm(lapack_int m, lapack_int n, lapack_int bn, double a[], double b[], double x[])
+	{
+		return qr_solve(m, n, bn, a, b, x, LAPACKE_dgels, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int c_qr_solve_rm(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float x[])
+	{
+		return qr_solve(m, n, bn, a, b, x, LAPACKE_cgels, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int z_qr_solve_rm(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double x[])
+	{
+		return qr_solve(m, n, bn, a, b, x, LAPACKE_zgels, LAPACK_ROW_MAJOR);
+	}
+
+	DLLEXPORT lapack_int s_qr_solve_inplace(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float x[])
+	{
+		return qr_solve_inplace(m, n, bn, a, b, x, LAPACKE_sgels);
+	}
+
+	DLLEXPORT lapack_int d_qr_solve_inplace(lapack_int m, lapack_int n, lapack_int bn, double a[], double b[], double x[])
+	{
+		return qr_solve_inplace(m, n, bn, a, b, x, LAPACKE_dgels);
+	}
+
+	DLLEXPORT lapack_int c_qr_solve_inplace(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float x[])
+	{
+		return qr_solve_inplace(m, n, bn, a, b, x, LAPACKE_cgels);
+	}
+
+	DLLEXPORT lapack_int z_qr_solve_inplace(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double x[])
+	{
+		return qr_solve_inplace(m, n, bn, a, b, x, LAPACKE_zgels);
+	}
+
+	DLLEXPORT lapack_int s_qr_solve_rank_revealing(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float x[], float rcond, lapack_int* rank)
+	{
+		return qr_solve_rank_revealing(m, n, bn, a, b, x, rcond, rank, LAPACKE_sgelsy);
+	}
+
+	DLLEXPORT lapack_int d_qr_solve_rank_revealing(lapack_int m, lapack_int n, lapack_int bn, double a[], double b[], double x[], double rcond, lapack_int* rank)
+	{
+		return qr_solve_rank_revealing(m, n, bn, a, b, x, rcond, rank, LAPACKE_dgelsy);
+	}
+
+	DLLEXPORT lapack_int c_qr_solve_rank_revealing(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float x[], float rcond, lapack_int* rank)
+	{
+		return qr_solve_rank_revealing(m, n, bn, a, b, x, rcond, rank, LAPACKE_cgelsy);
+	}
+
+	DLLEXPORT lapack_int z_qr_solve_rank_revealing(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double x[], double rcond, lapack_int* rank)
+	{
+		return qr_solve_rank_revealing(m, n, bn, a, b, x, rcond, rank, LAPACKE_zgelsy);
+	}
+
 	DLLEXPORT lapack_int s_qr_solve_factored(lapack_int m, lapack_int n, lapack_int bn, float r[], float b[], float tau[], float x[])
 	{
 		return qr_solve_factored(m, n, bn, r, b, tau, x, LAPACKE_sormqr, cblas_strsm);
@@ -0,0 +1,220 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	LDL' factorization of symmetric (and, for complex types, Hermitian)
+	indefinite matrices, e.g. KKT saddle-point systems where Cholesky fails.
+	Half the flops of LU and only the lower triangle is referenced.
+
+	variant selects the pivoting:
+	- LDL_BUNCH_KAUFMAN: ?sytrf / ?hetrf, 1x1 and 2x2 pivot blocks
+	- LDL_ROOK: ?sytrf_rook / ?hetrf_rook, bounded L entries, more accurate
+	- LDL_AASEN: ?sytrf_aa / ?hetrf_aa, L*T*L' with tridiagonal T
+	The factors use the LAPACK storage of the variant in the lower triangle,
+	and the same variant must be passed to the solve.
+
+	Pivots are zero-based: a row interchange with row p is stored as p, a 2x2
+	block (Bunch-Kaufman and rook only) as ~p = -p-1, which is the LAPACK
+	encoding of a negative one-based index unchanged.
+*/
+
+const lapack_int LDL_BUNCH_KAUFMAN = 0;
+const lapack_int LDL_ROOK = 1;
+const lapack_int LDL_AASEN = 2;
+
+inline void shift_ldl_ipiv_down(lapack_int n, lapack_int ipiv[])
+{
+	for (auto i = 0; i < n; ++i)
+	{
+		if (ipiv[i] > 0)
+		{
+			ipiv[i] -= 1;
+		}
+	}
+}
+
+inline void shift_ldl_ipiv_up(lapack_int n, lapack_int ipiv[])
+{
+	for (auto i = 0; i < n; ++i)
+	{
+		if (ipiv[i] >= 0)
+		{
+			ipiv[i] += 1;
+		}
+	}
+}
+
+template<typename T, typename TRF>
+inline lapack_int ldl_factor(lapack_int n, T a[], lapack_int ipiv[], lapack_int variant, TRF trf, TRF trf_rook, TRF trf_aa)
+{
+	lapack_int info;
+
+	switch (variant)
+	{
+	case LDL_BUNCH_KAUFMAN:
+		info = trf(LAPACK_COL_MAJOR, 'L', n, a, n, ipiv);
+		break;
+	case LDL_ROOK:
+		info = trf_rook(LAPACK_COL_MAJOR, 'L', n, a, n, ipiv);
+		break;
+	case LDL_AASEN:
+		info = trf_aa(LAPACK_COL_MAJOR, 'L', n, a, n, ipiv);
+		break;
+	default:
+		return -4;
+	}
+
+	shift_ldl_ipiv_down(n, ipiv);
+	return info;
+}
+
+template<typename T, typename TRS>
+inline lapack_int ldl_solve_factored(lapack_int n, lapack_int nrhs, T a[], lapack_int ipiv[], T b[], lapack_int variant, TRS trs, TRS trs_rook, TRS trs_aa)
+{
+	TRS solve;
+
+	switch (variant)
+	{
+	case LDL_BUNCH_KAUFMAN:
+		solve = trs;
+		break;
+	case LDL_ROOK:
+		solve = trs_rook;
+		break;
+	case LDL_AASEN:
+		solve = trs_aa;
+		break;
+	default:
+		return -6;
+	}
+
+	shift_ldl_ipiv_up(n, ipiv);
+	auto info = solve(LAPACK_COL_MAJOR, 'L', n, nrhs, a, n, ipiv, b, n);
+	shift_ldl_ipiv_down(n, ipiv);
+	return info;
+}
+
+template<typename T, typename TRF, typename TRS>
+inline lapack_int ldl_solve(lapack_int n, lapack_int nrhs, T a[], T b[], lapack_int variant,
+	TRF trf, TRF trf_rook, TRF trf_aa, TRS trs, TRS trs_rook, TRS trs_aa)
+{
+	if (variant < LDL_BUNCH_KAUFMAN || variant > LDL_AASEN)
+	{
+		return -5;
+	}
+
+	try
+	{
+		std::vector<T> clone(a, a + static_cast<size_t>(n) * n);
+		auto ipiv = array_new<lapack_int>(std::max(1, n));
+		auto info = ldl_factor(n, clone.data(), ipiv.get(), variant, trf, trf_rook, trf_aa);
+
+		if (info != 0)
+		{
+			return info;
+		}
+
+		return ldl_solve_factored(n, nrhs, clone.data(), ipiv.get(), b, variant, trs, trs_rook, trs_aa);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_ldl_factor(lapack_int n, float a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_ssytrf, LAPACKE_ssytrf_rook, LAPACKE_ssytrf_aa);
+	}
+
+	DLLEXPORT lapack_int d_ldl_factor(lapack_int n, double a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_dsytrf, LAPACKE_dsytrf_rook, LAPACKE_dsytrf_aa);
+	}
+
+	DLLEXPORT lapack_int c_ldl_factor(lapack_int n, lapack_complex_float a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_csytrf, LAPACKE_csytrf_rook, LAPACKE_csytrf_aa);
+	}
+
+	DLLEXPORT lapack_int z_ldl_factor(lapack_int n, lapack_complex_double a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_zsytrf, LAPACKE_zsytrf_rook, LAPACKE_zsytrf_aa);
+	}
+
+	DLLEXPORT lapack_int c_hermitian_ldl_factor(lapack_int n, lapack_complex_float a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_chetrf, LAPACKE_chetrf_rook, LAPACKE_chetrf_aa);
+	}
+
+	DLLEXPORT lapack_int z_hermitian_ldl_factor(lapack_int n, lapack_complex_double a[], lapack_int ipiv[], lapack_int variant)
+	{
+		return ldl_factor(n, a, ipiv, variant, LAPACKE_zhetrf, LAPACKE_zhetrf_rook, LAPACKE_zhetrf_aa);
+	}
+
+	DLLEXPORT lapack_int s_ldl_solve_factored(lapack_int n, lapack_int nrhs, float a[], lapack_int ipiv[], float b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_ssytrs, LAPACKE_ssytrs_rook, LAPACKE_ssytrs_aa);
+	}
+
+	DLLEXPORT lapack_int d_ldl_solve_factored(lapack_int n, lapack_int nrhs, double a[], lapack_int ipiv[], double b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_dsytrs, LAPACKE_dsytrs_rook, LAPACKE_dsytrs_aa);
+	}
+
+	DLLEXPORT lapack_int c_ldl_solve_factored(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_int ipiv[], lapack_complex_float b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_csytrs, LAPACKE_csytrs_rook, LAPACKE_csytrs_aa);
+	}
+
+	DLLEXPORT lapack_int z_ldl_solve_factored(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_int ipiv[], lapack_complex_double b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_zsytrs, LAPACKE_zsytrs_rook, LAPACKE_zsytrs_aa);
+	}
+
+	DLLEXPORT lapack_int c_hermitian_ldl_solve_factored(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_int ipiv[], lapack_complex_float b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_chetrs, LAPACKE_chetrs_rook, LAPACKE_chetrs_aa);
+	}
+
+	DLLEXPORT lapack_int z_hermitian_ldl_solve_factored(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_int ipiv[], lapack_complex_double b[], lapack_int variant)
+	{
+		return ldl_solve_factored(n, nrhs, a, ipiv, b, variant, LAPACKE_zhetrs, LAPACKE_zhetrs_rook, LAPACKE_zhetrs_aa);
+	}
+
+	DLLEXPORT lapack_int s_ldl_solve(lapack_int n, lapack_int nrhs, float a[], float b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_ssytrf, LAPACKE_ssytrf_rook, LAPACKE_ssytrf_aa, LAPACKE_ssytrs, LAPACKE_ssytrs_rook, LAPACKE_ssytrs_aa);
+	}
+
+	DLLEXPORT lapack_int d_ldl_solve(lapack_int n, lapack_int nrhs, double a[], double b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_dsytrf, LAPACKE_dsytrf_rook, LAPACKE_dsytrf_aa, LAPACKE_dsytrs, LAPACKE_dsytrs_rook, LAPACKE_dsytrs_aa);
+	}
+
+	DLLEXPORT lapack_int c_ldl_solve(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_csytrf, LAPACKE_csytrf_rook, LAPACKE_csytrf_aa, LAPACKE_csytrs, LAPACKE_csytrs_rook, LAPACKE_csytrs_aa);
+	}
+
+	DLLEXPORT lapack_int z_ldl_solve(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_zsytrf, LAPACKE_zsytrf_rook, LAPACKE_zsytrf_aa, LAPACKE_zsytrs, LAPACKE_zsytrs_rook, LAPACKE_zsytrs_aa);
+	}
+
+	DLLEXPORT lapack_int c_hermitian_ldl_solve(lapack_int n, lapack_int nrhs, lapack_complex_float a[], lapack_complex_float b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_chetrf, LAPACKE_chetrf_rook, LAPACKE_chetrf_aa, LAPACKE_chetrs, LAPACKE_chetrs_rook, LAPACKE_chetrs_aa);
+	}
+
+	DLLEXPORT lapack_int z_hermitian_ldl_solve(lapack_int n, lapack_int nrhs, lapack_complex_double a[], lapack_complex_double b[], lapack_int variant)
+	{
+		return ldl_solve(n, nrhs, a, b, variant, LAPACKE_zhetrf, LAPACKE_zhetrf_rook, LAPACKE_zhetrf_aa, LAPACKE_zhetrs, LAPACKE_zhetrs_rook, LAPACKE_zhetrs_aa);
+	}
+}
@@ -0,0 +1,691 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+/*
+	Dense matrix functions.
+
+	expm uses scaling and squaring with the [m/m] Pade approximants of
+	Higham (2005): the degree m in {3, 5, 7, 9, 13} and the number of
+	squarings s are chosen from the 1-norm, and r_m(A/2^s) is obtained with
+	gemm and one ?gesv solve, then squared s times.
+
+	The handle (x_expm_create / x_expm_compute / x_expm_free) keeps A, its
+	even powers A^2, A^4, A^6 (A^8 on demand) and the scratch matrices, so
+	that exp(t*A) for many t costs no allocation and no power recomputation:
+	(t*A)^k is t^k * A^k. A handle must not be used by several threads at
+	once. x_expm_batch runs many small independent exponentials in parallel.
+
+	sqrtm and logm work on the complex Schur form A = Q*T*Q' (?gees, as in
+	x_eigen) in double complex arithmetic: the principal square root of T by
+	the Bjorck-Hammarling recurrence, the principal logarithm by inverse
+	scaling and squaring (repeated square roots until ||T - I||_1 <= 1/4, then
+	8-point Gauss-Legendre quadrature of log(I + X)). For the real types the
+	result is real and returned only if A has no eigenvalues on the closed
+	negative real axis; otherwise, and when log(A) does not exist (singular
+	A), the return value is 1.
+*/
+
+// [m/m] Pade coefficients b_0..b_m for exp.
+const double EXPM_PADE3[] = { 120.0, 60.0, 12.0, 1.0 };
+const double EXPM_PADE5[] = { 30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0 };
+const double EXPM_PADE7[] = { 17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0 };
+const double EXPM_PADE9[] = { 17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0, 2162160.0, 110880.0, 3960.0, 90.0, 1.0 };
+const double EXPM_PADE13[] = { 64764752532480000.0, 32382376266240000.0, 7771770303897600.0, 1187353796428800.0, 129060195264000.0,
+	10559470521600.0, 670442572800.0, 33522128640.0, 1323241920.0, 40840800.0, 960960.0, 16380.0, 182.0, 1.0 };
+
+// Largest 1-norm for which the degree 3, 5, 7, 9 and 13 approximants are accurate to double precision.
+const double EXPM_THETA[] = { 1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0 };
+
+// Gauss-Legendre nodes and weights on [0, 1].
+const double LOGM_NODES[] = { 0.0198550717512319, 0.1016667612931866, 0.2372337950418355, 0.4082826787521751,
+	0.5917173212478249, 0.7627662049581645, 0.8983332387068134, 0.9801449282487681 };
+const double LOGM_WEIGHTS[] = { 0.0506142681451881, 0.1111905172266872, 0.1568533229389436, 0.1813418916891810,
+	0.1813418916891810, 0.1568533229389436, 0.1111905172266872, 0.0506142681451881 };
+
+const int LOGM_MAX_SQUARE_ROOTS = 64;
+
+template<typename T>
+inline double norm1(lapack_int n, const T a[])
+{
+	auto norm = 0.0;
+
+	for (auto j = 0; j < n; ++j)
+	{
+		auto sum = 0.0;
+		for (auto i = 0; i < n; ++i)
+		{
+			sum += std::abs(a[static_cast<size_t>(j) * n + i]);
+		}
+
+		norm = std::max(norm, sum);
+	}
+
+	return norm;
+}
+
+template<typename T>
+struct expm_workspace
+{
+	lapack_int n;
+	double norm;
+	bool has_a8;
+	array_ptr<T> a, a2, a4, a6, a8, p, u, v;
+	array_ptr<lapack_int> ipiv;
+
+	explicit expm_workspace(lapack_int order)
+		: n(order), norm(0.0), has_a8(false),
+		a(array_new<T>(std::max(1, order * order))), a2(array_new<T>(std::max(1, order * order))),
+		a4(array_new<T>(std::max(1, order * order))), a6(array_new<T>(std::max(1, order * order))),
+		a8(array_new<T>(std::max(1, order * order))), p(array_new<T>(std::max(1, order * order))),
+		u(array_new<T>(std::max(1, order * order))), v(array_new<T>(std::max(1, order * order))),
+		ipiv(array_new<lapack_int>(std::max(1, order)))
+	{
+	}
+};
+
+template<typename T>
+inline void expm_prepare(expm_workspace<T>& w, const T a[])
+{
+	const auto n = w.n;
+	std::copy(a, a + n * n, w.a.get());
+	w.norm = norm1(n, a);
+	w.has_a8 = false;
+
+	gemm(CblasNoTrans, CblasNoTrans, n, n, n, T(1), w.a.get(), n, w.a.get(), n, T(0), w.a2.get(), n);
+	gemm(CblasNoTrans, CblasNoTrans, n, n, n, T(1), w.a2.get(), n, w.a2.get(), n, T(0), w.a4.get(), n);
+	gemm(CblasNoTrans, CblasNoTrans, n, n, n, T(1), w.a4.get(), n, w.a2.get(), n, T(0), w.a6.get(), n);
+}
+
+// x = sum of c[k] * powers[k] over the given powers, plus c0 * I.
+template<typename T>
+inline void expm_combine(lapack_int n, T x[], T c0, int count, const T* powers[], const T c[])
+{
+	const auto size = n * n;
+
+	for (auto i = 0; i < size; ++i)
+	{
+		auto sum = T(0);
+		for (auto k = 0; k < count; ++k)
+		{
+			sum += c[k] * powers[k][i];
+		}
+
+		x[i] = sum;
+	}
+
+	for (auto i = 0; i < n; ++i)
+	{
+		x[i * n + i] += c0;
+	}
+}
+
+// result = exp(t * A) for the A held by the workspace.
+template<typename T, typename GESV>
+inline lapack_int expm_compute(expm_workspace<T>& w, T t, T result[], GESV gesv)
+{
+	const auto n = w.n;
+
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	const auto norm = std::abs(t) * w.norm;
+	auto degree = 4;
+	while (degree > 0 && norm <= EXPM_THETA[degree - 1])
+	{
+		--degree;
+	}
+
+	auto s = 0;
+	if (degree == 4 && norm > EXPM_THETA[4])
+	{
+		s = static_cast<int>(std::ceil(std::log2(norm / EXPM_THETA[4])));
+	}
+
+	// c = t / 2^s, the powers of A are scaled by c^k on the fly.
+	const auto c = t / T(std::ldexp(1.0, s));
+	const auto c2 = c * c;
+	const auto c4 = c2 * c2;
+	const auto c6 = c4 * c2;
+
+	auto* p = w.p.get();
+	auto* u = w.u.get();
+	auto* v = w.v.get();
+
+	if (degree == 4)
+	{
+		const double* b = EXPM_PADE13;
+		const T* high[] = { w.a6.get(), w.a4.get(), w.a2.get() };
+
+		const T uc[] = { T(b[13]) * c6, T(b[11]) * c4, T(b[9]) * c2 };
+		expm_combine(n, v, T(0), 3, high, uc);
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, c6, w.a6.get(), n, v, n, T(0), p, n);
+		const T ul[] = { T(b[7]) * c6, T(b[5]) * c4, T(b[3]) * c2 };
+		expm_combine(n, u, T(b[1]), 3, high, ul);
+		for (auto i = 0; i < n * n; ++i)
+		{
+			p[i] += u[i];
+		}
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, c, w.a.get(), n, p, n, T(0), u, n);
+
+		const T vc[] = { T(b[12]) * c6, T(b[10]) * c4, T(b[8]) * c2 };
+		expm_combine(n, p, T(0), 3, high, vc);
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, c6, w.a6.get(), n, p, n, T(0), v, n);
+		const T vl[] = { T(b[6]) * c6, T(b[4]) * c4, T(b[2]) * c2 };
+		expm_combine(n, p, T(b[0]), 3, high, vl);
+		for (auto i = 0; i < n * n; ++i)
+		{
+			v[i] += p[i];
+		}
+	}
+	else
+	{
+		static const double* pade[] = { EXPM_PADE3, EXPM_PADE5, EXPM_PADE7, EXPM_PADE9 };
+		const double* b = pade[degree];
+		const auto m = 2 * degree + 3;
+
+		if (m == 9 && !w.has_a8)
+		{
+			gemm(CblasNoTrans, CblasNoTrans, n, n, n, T(1), w.a4.get(), n, w.a4.get(), n, T(0), w.a8.get(), n);
+			w.has_a8 = true;
+		}
+
+		const T* powers[] = { w.a2.get(), w.a4.get(), w.a6.get(), w.a8.get() };
+		const T scale[] = { c2, c4, c6, c4 * c4 };
+		T odd[4], even[4];
+		const auto count = (m - 1) / 2;
+		for (auto k = 0; k < count; ++k)
+		{
+			odd[k] = T(b[2 * k + 3]) * scale[k];
+			even[k] = T(b[2 * k + 2]) * scale[k];
+		}
+
+		expm_combine(n, p, T(b[1]), count, powers, odd);
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, c, w.a.get(), n, p, n, T(0), u, n);
+		expm_combine(n, v, T(b[0]), count, powers, even);
+	}
+
+	// (V - U) * R = V + U
+	for (auto i = 0; i < n * n; ++i)
+	{
+		result[i] = v[i] + u[i];
+		p[i] = v[i] - u[i];
+	}
+
+	auto info = gesv(LAPACK_COL_MAJOR, n, n, p, n, w.ipiv.get(), result, n);
+	if (info != 0)
+	{
+		return info;
+	}
+
+	auto* current = result;
+	auto* next = u;
+	for (auto k = 0; k < s; ++k)
+	{
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, T(1), current, n, current, n, T(0), next, n);
+		std::swap(current, next);
+	}
+
+	if (current != result)
+	{
+		std::copy(current, current + n * n, result);
+	}
+
+	return 0;
+}
+
+template<typename T, typename GESV>
+inline lapack_int expm(lapack_int n, const T a[], T result[], GESV gesv)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	try
+	{
+		expm_workspace<T> w(n);
+		expm_prepare(w, a);
+		return expm_compute(w, T(1), result, gesv);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int expm_create(void** handle, lapack_int n, const T a[])
+{
+	if (n < 0)
+	{
+		return -2;
+	}
+
+	try
+	{
+		auto w = new expm_workspace<T>(n);
+		expm_prepare(*w, a);
+		*handle = w;
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		*handle = nullptr;
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int expm_free(void** handle)
+{
+	delete static_cast<expm_workspace<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+// count matrices of order n stored back to back; info[k] is the ?gesv info of matrix k.
+template<typename T, typename GESV>
+inline lapack_int expm_batch(lapack_int n, lapack_int count, const T a[], T result[], lapack_int info[], GESV gesv)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	if (count < 0)
+	{
+		return -2;
+	}
+
+	try
+	{
+		const auto size = static_cast<size_t>(n) * n;
+		const auto chunks = parallel_chunk_count(count, 1);
+		std::vector<expm_workspace<T>> workspaces;
+		workspaces.reserve(chunks);
+		for (auto chunk = 0; chunk < chunks; ++chunk)
+		{
+			workspaces.emplace_back(n);
+		}
+
+		auto* ws = workspaces.data();
+
+		parallel_for_chunks(count, chunks, [=](int chunk, int begin, int end)
+		{
+#ifdef PROVIDER_MKL
+			auto previous = mkl_set_num_threads_local(1);
+#endif
+			auto& w = ws[chunk];
+
+			for (auto k = begin; k < end; ++k)
+			{
+				expm_prepare(w, a + k * size);
+				info[k] = expm_compute(w, T(1), result + k * size, gesv);
+			}
+
+#ifdef PROVIDER_MKL
+			mkl_set_num_threads_local(previous);
+#endif
+		});
+
+		return static_cast<lapack_int>(std::count_if(info, info + count, [](lapack_int i) { return i != 0; }));
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+inline void assign_value(float& x, const lapack_complex_double& z) { x = static_cast<float>(z.real()); }
+inline void assign_value(double& x, const lapack_complex_double& z) { x = z.real(); }
+inline void assign_value(lapack_complex_float& x, const lapack_complex_double& z) { x = lapack_complex_float(static_cast<float>(z.real()), static_cast<float>(z.imag())); }
+inline void assign_value(lapack_complex_double& x, const lapack_complex_double& z) { x = z; }
+
+// Principal square root of the upper triangular t into r; false if it does not exist.
+inline bool triangular_sqrtm(lapack_int n, const lapack_complex_double t[], lapack_complex_double r[])
+{
+	std::fill(r, r + n * n, lapack_complex_double());
+
+	for (auto j = 0; j < n; ++j)
+	{
+		auto* rj = r + j * n;
+		const auto* tj = t + j * n;
+		rj[j] = std::sqrt(tj[j]);
+
+		for (auto i = j - 1; i >= 0; --i)
+		{
+			auto sum = tj[i];
+			for (auto k = i + 1; k < j; ++k)
+			{
+				sum -= r[k * n + i] * rj[k];
+			}
+
+			const auto denominator = r[i * n + i] + rj[j];
+			if (denominator == lapack_complex_double())
+			{
+				if (sum != lapack_complex_double())
+				{
+					return false;
+				}
+
+				rj[i] = lapack_complex_double();
+			}
+			else
+			{
+				rj[i] = sum / denominator;
+			}
+		}
+	}
+
+	return true;
+}
+
+// Principal logarithm of the upper triangular t (overwritten) into l; false if it does not exist.
+inline bool triangular_logm(lapack_int n, lapack_complex_double t[], lapack_complex_double l[], lapack_complex_double m[], lapack_complex_double y[])
+{
+	for (auto i = 0; i < n; ++i)
+	{
+		if (t[i * n + i] == lapack_complex_double())
+		{
+			return false;
+		}
+	}
+
+	auto roots = 0;
+	for (;;)
+	{
+		auto norm = 0.0;
+		for (auto j = 0; j < n; ++j)
+		{
+			auto sum = 0.0;
+			for (auto i = 0; i <= j; ++i)
+			{
+				sum += std::abs(t[j * n + i] - (i == j ? 1.0 : 0.0));
+			}
+
+			norm = std::max(norm, sum);
+		}
+
+		if (norm <= 0.25)
+		{
+			break;
+		}
+
+		if (roots == LOGM_MAX_SQUARE_ROOTS || !triangular_sqrtm(n, t, m))
+		{
+			return false;
+		}
+
+		std::copy(m, m + n * n, t);
+		++roots;
+	}
+
+	// t = X = T - I; log(I + X) = sum w_k * (I + x_k X)^-1 X
+	for (auto i = 0; i < n; ++i)
+	{
+		t[i * n + i] -= 1.0;
+	}
+
+	std::fill(l, l + n * n, lapack_complex_double());
+
+	for (auto k = 0; k < 8; ++k)
+	{
+		for (auto i = 0; i < n * n; ++i)
+		{
+			m[i] = LOGM_NODES[k] * t[i];
+			y[i] = t[i];
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			m[i * n + i] += 1.0;
+		}
+
+		if (LAPACKE_ztrtrs(LAPACK_COL_MAJOR, 'U', 'N', 'N', n, n, m, n, y, n) != 0)
+		{
+			return false;
+		}
+
+		for (auto i = 0; i < n * n; ++i)
+		{
+			l[i] += LOGM_WEIGHTS[k] * y[i];
+		}
+	}
+
+	const auto scale = std::ldexp(1.0, roots);
+	for (auto i = 0; i < n * n; ++i)
+	{
+		l[i] *= scale;
+	}
+
+	return true;
+}
+
+const int MATRIX_FUNCTION_SQRT = 0;
+const int MATRIX_FUNCTION_LOG = 1;
+
+template<typename T>
+inline lapack_int schur_matrix_function(lapack_int n, const T a[], T result[], bool real, int function)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	try
+	{
+		const auto size = n * n;
+		auto t = array_new<lapack_complex_double>(size);
+		auto q = array_new<lapack_complex_double>(size);
+		auto f = array_new<lapack_complex_double>(size);
+		auto m = array_new<lapack_complex_double>(size);
+		auto y = array_new<lapack_complex_double>(size);
+		auto values = array_new<lapack_complex_double>(n);
+
+		for (auto i = 0; i < size; ++i)
+		{
+			t.get()[i] = lapack_complex_double(a[i]);
+		}
+
+		lapack_int sdim;
+		auto info = LAPACKE_zgees(LAPACK_COL_MAJOR, 'V', 'N', nullptr, n, t.get(), n, &sdim, values.get(), q.get(), n);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		if (real)
+		{
+			for (auto i = 0; i < n; ++i)
+			{
+				const auto lambda = values.get()[i];
+				if (lambda.real() < 0.0 && std::abs(lambda.imag()) <= 1e-12 * std::abs(lambda))
+				{
+					return 1;
+				}
+			}
+		}
+
+		auto exists = function == MATRIX_FUNCTION_SQRT
+			? triangular_sqrtm(n, t.get(), f.get())
+			: triangular_logm(n, t.get(), f.get(), m.get(), y.get());
+		if (!exists)
+		{
+			return 1;
+		}
+
+		// Q * F * Q'
+		gemm(CblasNoTrans, CblasNoTrans, n, n, n, lapack_complex_double(1.0), q.get(), n, f.get(), n, lapack_complex_double(), m.get(), n);
+		gemm(CblasNoTrans, CblasConjTrans, n, n, n, lapack_complex_double(1.0), m.get(), n, q.get(), n, lapack_complex_double(), f.get(), n);
+
+		for (auto i = 0; i < size; ++i)
+		{
+			assign_value(result[i], f.get()[i]);
+		}
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_expm(lapack_int n, float a[], float result[])
+	{
+		return expm(n, a, result, LAPACKE_sgesv);
+	}
+
+	DLLEXPORT lapack_int d_expm(lapack_int n, double a[], double result[])
+	{
+		return expm(n, a, result, LAPACKE_dgesv);
+	}
+
+	DLLEXPORT lapack_int c_expm(lapack_int n, lapack_complex_float a[], lapack_complex_float result[])
+	{
+		return expm(n, a, result, LAPACKE_cgesv);
+	}
+
+	DLLEXPORT lapack_int z_expm(lapack_int n, lapack_complex_double a[], lapack_complex_double result[])
+	{
+		return expm(n, a, result, LAPACKE_zgesv);
+	}
+
+	DLLEXPORT lapack_int s_expm_create(void** handle, lapack_int n, float a[])
+	{
+		return expm_create(handle, n, a);
+	}
+
+	DLLEXPORT lapack_int d_expm_create(void** handle, lapack_int n, double a[])
+	{
+		return expm_create(handle, n, a);
+	}
+
+	DLLEXPORT lapack_int c_expm_create(void** handle, lapack_int n, lapack_complex_float a[])
+	{
+		return expm_create(handle, n, a);
+	}
+
+	DLLEXPORT lapack_int z_expm_create(void** handle, lapack_int n, lapack_complex_double a[])
+	{
+		return expm_create(handle, n, a);
+	}
+
+	DLLEXPORT lapack_int s_expm_compute(void* handle, float t, float result[])
+	{
+		return expm_compute(*static_cast<expm_workspace<float>*>(handle), t, result, LAPACKE_sgesv);
+	}
+
+	DLLEXPORT lapack_int d_expm_compute(void* handle, double t, double result[])
+	{
+		return expm_compute(*static_cast<expm_workspace<double>*>(handle), t, result, LAPACKE_dgesv);
+	}
+
+	DLLEXPORT lapack_int c_expm_compute(void* handle, lapack_complex_float t, lapack_complex_float result[])
+	{
+		return expm_compute(*static_cast<expm_workspace<lapack_complex_float>*>(handle), t, result, LAPACKE_cgesv);
+	}
+
+	DLLEXPORT lapack_int z_expm_compute(void* handle, lapack_complex_double t, lapack_complex_double result[])
+	{
+		return expm_compute(*static_cast<expm_workspace<lapack_complex_double>*>(handle), t, result, LAPACKE_zgesv);
+	}
+
+	DLLEXPORT lapack_int s_expm_free(void** handle)
+	{
+		return expm_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_expm_free(void** handle)
+	{
+		return expm_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_expm_free(void** handle)
+	{
+		return expm_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_expm_free(void** handle)
+	{
+		return expm_free<lapack_complex_double>(handle);
+	}
+
+	DLLEXPORT lapack_int s_expm_batch(lapack_int n, lapack_int count, float a[], float result[], lapack_int info[])
+	{
+		return expm_batch(n, count, a, result, info, LAPACKE_sgesv);
+	}
+
+	DLLEXPORT lapack_int d_expm_batch(lapack_int n, lapack_int count, double a[], double result[], lapack_int info[])
+	{
+		return expm_batch(n, count, a, result, info, LAPACKE_dgesv);
+	}
+
+	DLLEXPORT lapack_int c_expm_batch(lapack_int n, lapack_int count, lapack_complex_float a[], lapack_complex_float result[], lapack_int info[])
+	{
+		return expm_batch(n, count, a, result, info, LAPACKE_cgesv);
+	}
+
+	DLLEXPORT lapack_int z_expm_batch(lapack_int n, lapack_int count, lapack_complex_double a[], lapack_complex_double result[], lapack_int info[])
+	{
+		return expm_batch(n, count, a, result, info, LAPACKE_zgesv);
+	}
+
+	DLLEXPORT lapack_int s_sqrtm(lapack_int n, float a[], float result[])
+	{
+		return schur_matrix_function(n, a, result, true, MATRIX_FUNCTION_SQRT);
+	}
+
+	DLLEXPORT lapack_int d_sqrtm(lapack_int n, double a[], double result[])
+	{
+		return schur_matrix_function(n, a, result, true, MATRIX_FUNCTION_SQRT);
+	}
+
+	DLLEXPORT lapack_int c_sqrtm(lapack_int n, lapack_complex_float a[], lapack_complex_float result[])
+	{
+		return schur_matrix_function(n, a, result, false, MATRIX_FUNCTION_SQRT);
+	}
+
+	DLLEXPORT lapack_int z_sqrtm(lapack_int n, lapack_complex_double a[], lapack_complex_double result[])
+	{
+		return schur_matrix_function(n, a, result, false, MATRIX_FUNCTION_SQRT);
+	}
+
+	DLLEXPORT lapack_int s_logm(lapack_int n, float a[], float result[])
+	{
+		return schur_matrix_function(n, a, result, true, MATRIX_FUNCTION_LOG);
+	}
+
+	DLLEXPORT lapack_int d_logm(lapack_int n, double a[], double result[])
+	{
+		return schur_matrix_function(n, a, result, true, MATRIX_FUNCTION_LOG);
+	}
+
+	DLLEXPORT lapack_int c_logm(lapack_int n, lapack_complex_float a[], lapack_complex_float result[])
+	{
+		return schur_matrix_function(n, a, result, false, MATRIX_FUNCTION_LOG);
+	}
+
+	DLLEXPORT lapack_int z_logm(lapack_int n, lapack_complex_double a[], lapack_complex_double result[])
+	{
+		return schur_matrix_function(n, a, result, false, MATRIX_FUNCTION_LOG);
+	}
+}
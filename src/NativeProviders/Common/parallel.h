@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/*
+	Minimal fork-join helpers for the portable kernels. Work is split into
+	contiguous chunks, one per hardware thread at most, and run on a pool of
+	worker threads that is started on first use and kept for the lifetime of
+	the process, so a fork-join costs a wake-up rather than a thread spawn.
+	The calling thread takes chunks too. Calls made from inside a body, or
+	while another thread's job is running, run their chunks on the calling
+	thread. Bodies must not throw.
+*/
+
+// Upper bound on the number of threads, 0 for the hardware concurrency; set by set_max_threads.
+inline std::atomic<int>& parallel_thread_limit()
+{
+	static std::atomic<int> limit(0);
+	return limit;
+}
+
+inline int parallel_chunk_count(const int count, const int min_grain)
+{
+	if (count <= 0)
+	{
+		return 0;
+	}
+
+	auto threads = static_cast<int>(std::thread::hardware_concurrency());
+	auto limit = parallel_thread_limit().load();
+	if (limit > 0 && limit < threads)
+	{
+		threads = limit;
+	}
+
+	if (threads < 1)
+	{
+		threads = 1;
+	}
+
+	auto chunks = min_grain > 0 ? count / min_grain : threads;
+	return std::max(1, std::min(threads, chunks));
+}
+
+inline int parallel_chunk_begin(const int count, const int chunks, const int chunk)
+{
+	return static_cast<int>(static_cast<long long>(count) * chunk / chunks);
+}
+
+// One fork-join: chunks are claimed from next until all are taken.
+struct parallel_job
+{
+	void (*invoke)(void* context, int chunk);
+	void* context;
+	int chunks;
+	std::atomic<int> next;
+	std::atomic<int> remaining;
+	int attached;
+
+	void work()
+	{
+		for (auto chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1))
+		{
+			invoke(context, chunk);
+			remaining.fetch_sub(1);
+		}
+	}
+};
+
+inline bool& parallel_inside_job()
+{
+	static thread_local bool inside = false;
+	return inside;
+}
+
+class parallel_pool
+{
+public:
+	// Never destroyed: joining workers while the library unloads can deadlock.
+	static parallel_pool& instance()
+	{
+		static auto* pool = new parallel_pool();
+		return *pool;
+	}
+
+	// Runs invoke(context, chunk) for every chunk in [0, chunks) and returns when all are done.
+	void run(int chunks, void (*invoke)(void*, int), void* context)
+	{
+		auto& inside = parallel_inside_job();
+		std::unique_lock<std::mutex> busy(busy_, std::defer_lock);
+		if (inside || !busy.try_lock() || !grow(chunks - 1))
+		{
+			for (auto chunk = 0; chunk < chunks; ++chunk)
+			{
+				invoke(context, chunk);
+			}
+
+			return;
+		}
+
+		parallel_job job;
+		job.invoke = invoke;
+		job.context = context;
+		job.chunks = chunks;
+		job.next = 0;
+		job.remaining = chunks;
+		job.attached = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job_ = &job;
+			++generation_;
+		}
+
+		wake_.notify_all();
+
+		inside = true;
+		job.work();
+		inside = false;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		done_.wait(lock, [&] { return job.remaining.load() == 0 && job.attached == 0; });
+		job_ = nullptr;
+	}
+
+private:
+	parallel_pool()
+		: job_(nullptr), generation_(0), workers_(0)
+	{
+	}
+
+	// Starts workers up to the given count, bounded by the hardware; false if none could be started.
+	bool grow(int wanted)
+	{
+		const auto hardware = static_cast<int>(std::thread::hardware_concurrency());
+		wanted = std::min(wanted, std::max(1, hardware - 1));
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		while (workers_ < wanted)
+		{
+			try
+			{
+				std::thread(&parallel_pool::worker, this, generation_).detach();
+				++workers_;
+			}
+			catch (std::system_error&)
+			{
+				break;
+			}
+		}
+
+		return workers_ > 0;
+	}
+
+	void worker(unsigned long long seen)
+	{
+		parallel_inside_job() = true;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (true)
+		{
+			wake_.wait(lock, [&] { return job_ != nullptr && generation_ != seen; });
+			seen = generation_;
+
+			auto* job = job_;
+			++job->attached;
+			lock.unlock();
+
+			job->work();
+
+			lock.lock();
+			--job->attached;
+			done_.notify_all();
+		}
+	}
+
+	std::mutex busy_;
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	parallel_job* job_;
+	unsigned long long generation_;
+	int workers_;
+};
+
+// Calls body(chunk, begin, end) for each of the given number of chunks of [0, count).
+template<typename Body>
+inline void parallel_for_chunks(const int count, const int chunks, Body body)
+{
+	if (chunks <= 1)
+	{
+		if (count > 0)
+		{
+			body(0, 0, count);
+		}
+
+		return;
+	}
+
+	struct context_type
+	{
+		Body* body;
+		int count;
+		int chunks;
+	} context = { &body, count, chunks };
+
+	parallel_pool::instance().run(chunks, [](void* p, int chunk)
+	{
+		auto* c = static_cast<context_type*>(p);
+		(*c->body)(chunk, parallel_chunk_begin(c->count, c->chunks, chunk), parallel_chunk_begin(c->count, c->chunks, chunk + 1));
+	}, &context);
+}
+
+// Calls body(begin, end) over [0, count), in parallel if there are at least 2 * min_grain items.
+template<typename Body>
+inline void parallel_for(const int count, const int min_grain, Body body)
+{
+	parallel_for_chunks(count, parallel_chunk_count(count, min_grain), [&body](int, int begin, int end) { body(begin, end); });
+}
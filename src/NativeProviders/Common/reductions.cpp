@@ -0,0 +1,211 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "parallel.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/*
+	Reductions that BLAS does not provide (norms, asum and i?amax live in blas.c).
+
+	Sums are pairwise: the error grows with log(n) instead of n, which keeps
+	single precision usable on 1e8-element vectors. Large inputs are split
+	into fixed-size pieces whose partial sums are combined pairwise as well,
+	so the result does not depend on the number of threads. The complex
+	sums are returned through a pointer rather than by value, since a C
+	export returning std::complex has no portable ABI.
+*/
+
+const int REDUCTION_BLOCK = 128;
+const int REDUCTION_PIECE = 1 << 16;
+
+template<typename T>
+inline T pairwise_sum(const T x[], const int n)
+{
+	if (n <= REDUCTION_BLOCK)
+	{
+		T acc[8] = { T(), T(), T(), T(), T(), T(), T(), T() };
+		auto i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			for (auto j = 0; j < 8; ++j)
+			{
+				acc[j] += x[i + j];
+			}
+		}
+
+		for (auto j = 0; i < n; ++i, ++j)
+		{
+			acc[j] += x[i];
+		}
+
+		return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+	}
+
+	auto half = (n / 2 + 7) & ~7;
+	return pairwise_sum(x, half) + pairwise_sum(x + half, n - half);
+}
+
+template<typename T>
+inline T reduce_sum(const int n, const T x[])
+{
+	if (n <= REDUCTION_PIECE)
+	{
+		return n > 0 ? pairwise_sum(x, n) : T();
+	}
+
+	const auto pieces = (n + REDUCTION_PIECE - 1) / REDUCTION_PIECE;
+	std::vector<T> partial(pieces);
+	auto* partial_sums = partial.data();
+
+	parallel_for(pieces, 2, [=](int begin, int end)
+	{
+		for (auto piece = begin; piece < end; ++piece)
+		{
+			auto offset = piece * REDUCTION_PIECE;
+			partial_sums[piece] = pairwise_sum(x + offset, std::min(REDUCTION_PIECE, n - offset));
+		}
+	});
+
+	return pairwise_sum(partial_sums, pieces);
+}
+
+// Index of the first extreme element; Better(a, b) is true if a should replace b.
+template<typename T, typename Better>
+inline int arg_extreme(const int begin, const int end, const T x[], Better better)
+{
+	auto index = begin;
+	auto value = x[begin];
+
+	for (auto i = begin + 1; i < end; ++i)
+	{
+		if (better(x[i], value))
+		{
+			value = x[i];
+			index = i;
+		}
+	}
+
+	return index;
+}
+
+template<typename T, typename Better>
+inline int parallel_arg_extreme(const int n, const T x[], Better better)
+{
+	if (n <= 0)
+	{
+		return -1;
+	}
+
+	const auto chunks = parallel_chunk_count(n, REDUCTION_PIECE);
+	std::vector<int> partial(chunks);
+	auto* partial_index = partial.data();
+
+	parallel_for_chunks(n, chunks, [=](int chunk, int begin, int end)
+	{
+		partial_index[chunk] = arg_extreme(begin, end, x, better);
+	});
+
+	// chunks are ordered, so strict comparison keeps the first occurrence
+	auto index = partial_index[0];
+	for (auto chunk = 1; chunk < chunks; ++chunk)
+	{
+		if (better(x[partial_index[chunk]], x[index]))
+		{
+			index = partial_index[chunk];
+		}
+	}
+
+	return index;
+}
+
+template<typename T>
+inline int reduce_argmax(const int n, const T x[])
+{
+	return parallel_arg_extreme(n, x, [](T a, T b) { return a > b; });
+}
+
+template<typename T>
+inline int reduce_argmin(const int n, const T x[])
+{
+	return parallel_arg_extreme(n, x, [](T a, T b) { return a < b; });
+}
+
+template<typename T>
+inline T reduce_max(const int n, const T x[])
+{
+	auto index = reduce_argmax(n, x);
+	return index < 0 ? std::numeric_limits<T>::quiet_NaN() : x[index];
+}
+
+template<typename T>
+inline T reduce_min(const int n, const T x[])
+{
+	auto index = reduce_argmin(n, x);
+	return index < 0 ? std::numeric_limits<T>::quiet_NaN() : x[index];
+}
+
+extern "C" {
+
+	DLLEXPORT float s_sum(const int n, const float x[])
+	{
+		return reduce_sum(n, x);
+	}
+
+	DLLEXPORT double d_sum(const int n, const double x[])
+	{
+		return reduce_sum(n, x);
+	}
+
+	DLLEXPORT void c_sum(const int n, const lapack_complex_float x[], lapack_complex_float* result)
+	{
+		*result = reduce_sum(n, x);
+	}
+
+	DLLEXPORT void z_sum(const int n, const lapack_complex_double x[], lapack_complex_double* result)
+	{
+		*result = reduce_sum(n, x);
+	}
+
+	DLLEXPORT float s_max(const int n, const float x[])
+	{
+		return reduce_max(n, x);
+	}
+
+	DLLEXPORT double d_max(const int n, const double x[])
+	{
+		return reduce_max(n, x);
+	}
+
+	DLLEXPORT float s_min(const int n, const float x[])
+	{
+		return reduce_min(n, x);
+	}
+
+	DLLEXPORT double d_min(const int n, const double x[])
+	{
+		return reduce_min(n, x);
+	}
+
+	DLLEXPORT int s_argmax(const int n, const float x[])
+	{
+		return reduce_argmax(n, x);
+	}
+
+	DLLEXPORT int d_argmax(const int n, const double x[])
+	{
+		return reduce_argmax(n, x);
+	}
+
+	DLLEXPORT int s_argmin(const int n, const float x[])
+	{
+		return reduce_argmin(n, x);
+	}
+
+	DLLEXPORT int d_argmin(const int n, const double x[])
+	{
+		return reduce_argmin(n, x);
+	}
+}
@@ -0,0 +1,362 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "sparse_common.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	Block sparse row (BSR) storage for matrices made of small dense blocks,
+	such as multi-DOF finite element matrices: one column index per
+	block x block block instead of one per nonzero, and each block stored
+	row-major (MKL's SPARSE_LAYOUT_ROW_MAJOR), zero-based.
+
+	- sparse_bsr_count takes an m x n CSR pattern and writes the
+	  ceil(m/block) + 1 block row pointers, so the caller can allocate
+	  bsr_row_ptr[mb] block column indices and block^2 times as many values.
+	- x_sparse_csr_to_bsr fills the block column indices, sorted in each
+	  block row, and the block values. Entries not in A, including the
+	  padding of a partial last block, are zero; duplicates are summed.
+	- x_sparse_bsr_mv computes y = A*x and x_sparse_bsr_mm Y = A*X for a
+	  column-major X with the given number of columns; x has nb*block rows
+	  and y mb*block.
+
+	The MKL provider multiplies through mkl_sparse_?_create_bsr. The
+	portable kernel is specialized for blocks of 2, 3, 4 and 6 so that the
+	block row accumulates in registers, with block rows split across
+	threads by their block count.
+*/
+
+// Sorted, distinct block columns of block row ib.
+inline void bsr_block_columns(lapack_int m, lapack_int block, lapack_int ib, const lapack_int row_ptr[], const lapack_int col_idx[], std::vector<lapack_int>& columns)
+{
+	columns.clear();
+	const auto last = std::min(m, (ib + 1) * block);
+	for (auto i = ib * block; i < last; ++i)
+	{
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			columns.push_back(col_idx[p] / block);
+		}
+	}
+
+	std::sort(columns.begin(), columns.end());
+	columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+}
+
+inline lapack_int bsr_check(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[])
+{
+	if (m < 0) return -1;
+	if (n < 0) return -2;
+	if (block < 1) return -3;
+
+	for (auto p = 0; p < row_ptr[m]; ++p)
+	{
+		if (col_idx[p] < 0 || col_idx[p] >= n) return -5;
+	}
+
+	return 0;
+}
+
+inline lapack_int sparse_bsr_structure(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int bsr_row_ptr[])
+{
+	const auto info = bsr_check(m, n, block, row_ptr, col_idx);
+	if (info != 0) return info;
+
+	try
+	{
+		const auto mb = (m + block - 1) / block;
+		std::vector<lapack_int> columns;
+		bsr_row_ptr[0] = 0;
+		for (auto ib = 0; ib < mb; ++ib)
+		{
+			bsr_block_columns(m, block, ib, row_ptr, col_idx, columns);
+			bsr_row_ptr[ib + 1] = bsr_row_ptr[ib] + static_cast<lapack_int>(columns.size());
+		}
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int sparse_csr_to_bsr(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	const lapack_int bsr_row_ptr[], lapack_int bsr_col_idx[], T bsr_values[])
+{
+	const auto info = bsr_check(m, n, block, row_ptr, col_idx);
+	if (info != 0) return info;
+
+	try
+	{
+		const auto mb = (m + block - 1) / block;
+		const auto size = block * block;
+		std::vector<int> bounds;
+		const auto chunks = sparse_row_chunks(mb, bsr_row_ptr, bounds);
+		std::vector<std::vector<lapack_int>> workspaces(chunks);
+
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			auto& columns = workspaces[chunk];
+			for (auto ib = bounds[chunk]; ib < bounds[chunk + 1]; ++ib)
+			{
+				bsr_block_columns(m, block, ib, row_ptr, col_idx, columns);
+				auto* row_cols = bsr_col_idx + bsr_row_ptr[ib];
+				auto* row_values = bsr_values + static_cast<size_t>(bsr_row_ptr[ib]) * size;
+				std::copy(columns.begin(), columns.end(), row_cols);
+				std::fill(row_values, row_values + columns.size() * size, T(0));
+
+				const auto last = std::min(m, (ib + 1) * block);
+				for (auto i = ib * block; i < last; ++i)
+				{
+					const auto r = i - ib * block;
+					for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+					{
+						const auto j = col_idx[p];
+						const auto q = std::lower_bound(columns.begin(), columns.end(), j / block) - columns.begin();
+						row_values[q * size + r * block + j % block] += values[p];
+					}
+				}
+			}
+		});
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+// Y = A*X for block rows [begin, end), with the block row of every column
+// of X accumulated in registers.
+template<typename T, int B>
+inline void bsr_rows_fixed(lapack_int begin, lapack_int end, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int columns, const T x[], lapack_int ldx, T y[], lapack_int ldy)
+{
+	for (auto ib = begin; ib < end; ++ib)
+	{
+		for (auto k = 0; k < columns; ++k)
+		{
+			const auto* xk = x + static_cast<size_t>(k) * ldx;
+			T sum[B];
+			for (auto r = 0; r < B; ++r) sum[r] = T(0);
+
+			for (auto p = row_ptr[ib]; p < row_ptr[ib + 1]; ++p)
+			{
+				const auto* a = values + static_cast<size_t>(p) * (B * B);
+				const auto* xb = xk + static_cast<size_t>(col_idx[p]) * B;
+				for (auto r = 0; r < B; ++r)
+				{
+					for (auto c = 0; c < B; ++c)
+					{
+						sum[r] += a[r * B + c] * xb[c];
+					}
+				}
+			}
+
+			auto* yb = y + static_cast<size_t>(k) * ldy + static_cast<size_t>(ib) * B;
+			for (auto r = 0; r < B; ++r) yb[r] = sum[r];
+		}
+	}
+}
+
+template<typename T>
+inline void bsr_rows(lapack_int begin, lapack_int end, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int columns, const T x[], lapack_int ldx, T y[], lapack_int ldy)
+{
+	switch (block)
+	{
+	case 2:
+		bsr_rows_fixed<T, 2>(begin, end, row_ptr, col_idx, values, columns, x, ldx, y, ldy);
+		return;
+	case 3:
+		bsr_rows_fixed<T, 3>(begin, end, row_ptr, col_idx, values, columns, x, ldx, y, ldy);
+		return;
+	case 4:
+		bsr_rows_fixed<T, 4>(begin, end, row_ptr, col_idx, values, columns, x, ldx, y, ldy);
+		return;
+	case 6:
+		bsr_rows_fixed<T, 6>(begin, end, row_ptr, col_idx, values, columns, x, ldx, y, ldy);
+		return;
+	}
+
+	const auto size = static_cast<size_t>(block) * block;
+	for (auto ib = begin; ib < end; ++ib)
+	{
+		for (auto k = 0; k < columns; ++k)
+		{
+			const auto* xk = x + static_cast<size_t>(k) * ldx;
+			auto* yb = y + static_cast<size_t>(k) * ldy + static_cast<size_t>(ib) * block;
+			std::fill(yb, yb + block, T(0));
+
+			for (auto p = row_ptr[ib]; p < row_ptr[ib + 1]; ++p)
+			{
+				const auto* a = values + p * size;
+				const auto* xb = xk + static_cast<size_t>(col_idx[p]) * block;
+				for (auto r = 0; r < block; ++r)
+				{
+					auto sum = yb[r];
+					for (auto c = 0; c < block; ++c)
+					{
+						sum += a[r * block + c] * xb[c];
+					}
+
+					yb[r] = sum;
+				}
+			}
+		}
+	}
+}
+
+#ifdef PROVIDER_MKL
+inline sparse_status_t sparse_create_bsr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT block, MKL_INT row_ptr[], MKL_INT col_idx[], float values[])
+{
+	return mkl_sparse_s_create_bsr(a, SPARSE_INDEX_BASE_ZERO, SPARSE_LAYOUT_ROW_MAJOR, rows, cols, block, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_bsr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT block, MKL_INT row_ptr[], MKL_INT col_idx[], double values[])
+{
+	return mkl_sparse_d_create_bsr(a, SPARSE_INDEX_BASE_ZERO, SPARSE_LAYOUT_ROW_MAJOR, rows, cols, block, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_bsr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT block, MKL_INT row_ptr[], MKL_INT col_idx[], MKL_Complex8 values[])
+{
+	return mkl_sparse_c_create_bsr(a, SPARSE_INDEX_BASE_ZERO, SPARSE_LAYOUT_ROW_MAJOR, rows, cols, block, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_bsr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT block, MKL_INT row_ptr[], MKL_INT col_idx[], MKL_Complex16 values[])
+{
+	return mkl_sparse_z_create_bsr(a, SPARSE_INDEX_BASE_ZERO, SPARSE_LAYOUT_ROW_MAJOR, rows, cols, block, row_ptr, row_ptr + 1, col_idx, values);
+}
+#endif
+
+template<typename T>
+inline lapack_int sparse_bsr_multiply(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int columns, const T x[], T y[])
+{
+	if (mb < 0) return -1;
+	if (nb < 0) return -2;
+	if (block < 1) return -3;
+	if (columns < 0) return -7;
+
+	const auto ldx = nb * block;
+	const auto ldy = mb * block;
+	if (mb == 0 || columns == 0) return 0;
+	if (nb == 0)
+	{
+		std::fill(y, y + static_cast<size_t>(ldy) * columns, T(0));
+		return 0;
+	}
+
+	try
+	{
+#ifdef PROVIDER_MKL
+		sparse_matrix_t a;
+		auto status = sparse_create_bsr(&a, mb, nb, block, const_cast<MKL_INT*>(row_ptr), const_cast<MKL_INT*>(col_idx), const_cast<T*>(values));
+		if (status != SPARSE_STATUS_SUCCESS) return sparse_status_info(status);
+
+		matrix_descr descr;
+		descr.type = SPARSE_MATRIX_TYPE_GENERAL;
+		status = columns == 1 ? sparse_mv(a, descr, x, y) : sparse_mm(a, descr, columns, x, ldx, y, ldy);
+		mkl_sparse_destroy(a);
+		return status == SPARSE_STATUS_SUCCESS ? 0 : sparse_status_info(status);
+#else
+		std::vector<int> bounds;
+		const auto chunks = sparse_row_chunks(mb, row_ptr, bounds);
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			bsr_rows(bounds[chunk], bounds[chunk + 1], block, row_ptr, col_idx, values, columns, x, ldx, y, ldy);
+		});
+
+		return 0;
+#endif
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int sparse_bsr_count(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int bsr_row_ptr[])
+	{
+		return sparse_bsr_structure(m, n, block, row_ptr, col_idx, bsr_row_ptr);
+	}
+
+	DLLEXPORT lapack_int s_sparse_csr_to_bsr(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[],
+		const lapack_int bsr_row_ptr[], lapack_int bsr_col_idx[], float bsr_values[])
+	{
+		return sparse_csr_to_bsr(m, n, block, row_ptr, col_idx, values, bsr_row_ptr, bsr_col_idx, bsr_values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_to_bsr(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[],
+		const lapack_int bsr_row_ptr[], lapack_int bsr_col_idx[], double bsr_values[])
+	{
+		return sparse_csr_to_bsr(m, n, block, row_ptr, col_idx, values, bsr_row_ptr, bsr_col_idx, bsr_values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_to_bsr(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[],
+		const lapack_int bsr_row_ptr[], lapack_int bsr_col_idx[], lapack_complex_float bsr_values[])
+	{
+		return sparse_csr_to_bsr(m, n, block, row_ptr, col_idx, values, bsr_row_ptr, bsr_col_idx, bsr_values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_to_bsr(lapack_int m, lapack_int n, lapack_int block, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[],
+		const lapack_int bsr_row_ptr[], lapack_int bsr_col_idx[], lapack_complex_double bsr_values[])
+	{
+		return sparse_csr_to_bsr(m, n, block, row_ptr, col_idx, values, bsr_row_ptr, bsr_col_idx, bsr_values);
+	}
+
+	DLLEXPORT lapack_int s_sparse_bsr_mv(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const float bsr_values[],
+		const float x[], float y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, 1, x, y);
+	}
+
+	DLLEXPORT lapack_int d_sparse_bsr_mv(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const double bsr_values[],
+		const double x[], double y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, 1, x, y);
+	}
+
+	DLLEXPORT lapack_int c_sparse_bsr_mv(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const lapack_complex_float bsr_values[],
+		const lapack_complex_float x[], lapack_complex_float y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, 1, x, y);
+	}
+
+	DLLEXPORT lapack_int z_sparse_bsr_mv(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const lapack_complex_double bsr_values[],
+		const lapack_complex_double x[], lapack_complex_double y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, 1, x, y);
+	}
+
+	DLLEXPORT lapack_int s_sparse_bsr_mm(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const float bsr_values[],
+		lapack_int columns, const float x[], float y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, columns, x, y);
+	}
+
+	DLLEXPORT lapack_int d_sparse_bsr_mm(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const double bsr_values[],
+		lapack_int columns, const double x[], double y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, columns, x, y);
+	}
+
+	DLLEXPORT lapack_int c_sparse_bsr_mm(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const lapack_complex_float bsr_values[],
+		lapack_int columns, const lapack_complex_float x[], lapack_complex_float y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, columns, x, y);
+	}
+
+	DLLEXPORT lapack_int z_sparse_bsr_mm(lapack_int mb, lapack_int nb, lapack_int block, const lapack_int bsr_row_ptr[], const lapack_int bsr_col_idx[], const lapack_complex_double bsr_values[],
+		lapack_int columns, const lapack_complex_double x[], lapack_complex_double y[])
+	{
+		return sparse_bsr_multiply(mb, nb, block, bsr_row_ptr, bsr_col_idx, bsr_values, columns, x, y);
+	}
+}
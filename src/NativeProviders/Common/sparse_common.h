@@ -0,0 +1,457 @@
+#pragma once
+
+#include "parallel.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	Shared helpers for the native sparse kernels. Matrices are zero-based
+	CSR: row_ptr has rows + 1 entries, row i holds col_idx/values
+	[row_ptr[i], row_ptr[i + 1]).
+*/
+
+const int SPARSE_PARALLEL_GRAIN = 1 << 12;
+
+// Splits rows into chunks of about equal work, where work_prefix[i] is the
+// work of rows [0, i) (rows + 1 entries). bounds receives chunks + 1 row indices.
+template<typename W>
+inline void sparse_balanced_bounds(const int rows, const W work_prefix[], const int chunks, std::vector<int>& bounds)
+{
+	bounds.assign(chunks + 1, rows);
+	bounds[0] = 0;
+
+	const auto total = work_prefix[rows];
+	for (auto c = 1; c < chunks; ++c)
+	{
+		const auto target = static_cast<W>(static_cast<double>(total) * c / chunks);
+		auto at = static_cast<int>(std::lower_bound(work_prefix, work_prefix + rows + 1, target) - work_prefix);
+		at = std::min(at, rows);
+		if (at > 0 && target - work_prefix[at - 1] < work_prefix[at] - target)
+		{
+			--at;
+		}
+
+		bounds[c] = std::max(bounds[c - 1], at);
+	}
+}
+
+// Chunks for rows with nonzero counts row_ptr: balanced by nonzeros, at most one per thread.
+template<typename I>
+inline int sparse_row_chunks(const int rows, const I row_ptr[], std::vector<int>& bounds)
+{
+	const auto chunks = std::max(1, parallel_chunk_count(static_cast<int>(std::min<long long>(row_ptr[rows], 1LL << 30)), SPARSE_PARALLEL_GRAIN));
+	sparse_balanced_bounds(rows, row_ptr, chunks, bounds);
+	return chunks;
+}
+
+#ifdef PROVIDER_MKL
+// Type-overloaded wrappers over the MKL inspector-executor API; the handle
+// references the arrays passed in, which must outlive it.
+inline sparse_status_t sparse_create_csr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT row_ptr[], MKL_INT col_idx[], float values[])
+{
+	return mkl_sparse_s_create_csr(a, SPARSE_INDEX_BASE_ZERO, rows, cols, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_csr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT row_ptr[], MKL_INT col_idx[], double values[])
+{
+	return mkl_sparse_d_create_csr(a, SPARSE_INDEX_BASE_ZERO, rows, cols, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_csr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT row_ptr[], MKL_INT col_idx[], MKL_Complex8 values[])
+{
+	return mkl_sparse_c_create_csr(a, SPARSE_INDEX_BASE_ZERO, rows, cols, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_create_csr(sparse_matrix_t* a, MKL_INT rows, MKL_INT cols, MKL_INT row_ptr[], MKL_INT col_idx[], MKL_Complex16 values[])
+{
+	return mkl_sparse_z_create_csr(a, SPARSE_INDEX_BASE_ZERO, rows, cols, row_ptr, row_ptr + 1, col_idx, values);
+}
+
+inline sparse_status_t sparse_export_csr(sparse_matrix_t a, MKL_INT* rows, MKL_INT** row_start, MKL_INT** row_end, MKL_INT** col_idx, float** values)
+{
+	sparse_index_base_t base;
+	MKL_INT cols;
+	return mkl_sparse_s_export_csr(a, &base, rows, &cols, row_start, row_end, col_idx, values);
+}
+
+inline sparse_status_t sparse_export_csr(sparse_matrix_t a, MKL_INT* rows, MKL_INT** row_start, MKL_INT** row_end, MKL_INT** col_idx, double** values)
+{
+	sparse_index_base_t base;
+	MKL_INT cols;
+	return mkl_sparse_d_export_csr(a, &base, rows, &cols, row_start, row_end, col_idx, values);
+}
+
+inline sparse_status_t sparse_export_csr(sparse_matrix_t a, MKL_INT* rows, MKL_INT** row_start, MKL_INT** row_end, MKL_INT** col_idx, MKL_Complex8** values)
+{
+	sparse_index_base_t base;
+	MKL_INT cols;
+	return mkl_sparse_c_export_csr(a, &base, rows, &cols, row_start, row_end, col_idx, values);
+}
+
+inline sparse_status_t sparse_export_csr(sparse_matrix_t a, MKL_INT* rows, MKL_INT** row_start, MKL_INT** row_end, MKL_INT** col_idx, MKL_Complex16** values)
+{
+	sparse_index_base_t base;
+	MKL_INT cols;
+	return mkl_sparse_z_export_csr(a, &base, rows, &cols, row_start, row_end, col_idx, values);
+}
+
+inline sparse_status_t sparse_trsv(sparse_matrix_t a, matrix_descr descr, const float x[], float y[])
+{
+	return mkl_sparse_s_trsv(SPARSE_OPERATION_NON_TRANSPOSE, 1.0f, a, descr, x, y);
+}
+
+inline sparse_status_t sparse_trsv(sparse_matrix_t a, matrix_descr descr, const double x[], double y[])
+{
+	return mkl_sparse_d_trsv(SPARSE_OPERATION_NON_TRANSPOSE, 1.0, a, descr, x, y);
+}
+
+inline sparse_status_t sparse_trsv(sparse_matrix_t a, matrix_descr descr, const MKL_Complex8 x[], MKL_Complex8 y[])
+{
+	return mkl_sparse_c_trsv(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex8(1.0f), a, descr, x, y);
+}
+
+inline sparse_status_t sparse_trsv(sparse_matrix_t a, matrix_descr descr, const MKL_Complex16 x[], MKL_Complex16 y[])
+{
+	return mkl_sparse_z_trsv(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex16(1.0), a, descr, x, y);
+}
+
+inline sparse_status_t sparse_mv(sparse_matrix_t a, matrix_descr descr, const float x[], float y[])
+{
+	return mkl_sparse_s_mv(SPARSE_OPERATION_NON_TRANSPOSE, 1.0f, a, descr, x, 0.0f, y);
+}
+
+inline sparse_status_t sparse_mv(sparse_matrix_t a, matrix_descr descr, const double x[], double y[])
+{
+	return mkl_sparse_d_mv(SPARSE_OPERATION_NON_TRANSPOSE, 1.0, a, descr, x, 0.0, y);
+}
+
+inline sparse_status_t sparse_mv(sparse_matrix_t a, matrix_descr descr, const MKL_Complex8 x[], MKL_Complex8 y[])
+{
+	return mkl_sparse_c_mv(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex8(1.0f), a, descr, x, MKL_Complex8(0.0f), y);
+}
+
+inline sparse_status_t sparse_mv(sparse_matrix_t a, matrix_descr descr, const MKL_Complex16 x[], MKL_Complex16 y[])
+{
+	return mkl_sparse_z_mv(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex16(1.0), a, descr, x, MKL_Complex16(0.0), y);
+}
+
+inline sparse_status_t sparse_mm(sparse_matrix_t a, matrix_descr descr, MKL_INT columns, const float x[], MKL_INT ldx, float y[], MKL_INT ldy)
+{
+	return mkl_sparse_s_mm(SPARSE_OPERATION_NON_TRANSPOSE, 1.0f, a, descr, SPARSE_LAYOUT_COLUMN_MAJOR, x, columns, ldx, 0.0f, y, ldy);
+}
+
+inline sparse_status_t sparse_mm(sparse_matrix_t a, matrix_descr descr, MKL_INT columns, const double x[], MKL_INT ldx, double y[], MKL_INT ldy)
+{
+	return mkl_sparse_d_mm(SPARSE_OPERATION_NON_TRANSPOSE, 1.0, a, descr, SPARSE_LAYOUT_COLUMN_MAJOR, x, columns, ldx, 0.0, y, ldy);
+}
+
+inline sparse_status_t sparse_mm(sparse_matrix_t a, matrix_descr descr, MKL_INT columns, const MKL_Complex8 x[], MKL_INT ldx, MKL_Complex8 y[], MKL_INT ldy)
+{
+	return mkl_sparse_c_mm(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex8(1.0f), a, descr, SPARSE_LAYOUT_COLUMN_MAJOR, x, columns, ldx, MKL_Complex8(0.0f), y, ldy);
+}
+
+inline sparse_status_t sparse_mm(sparse_matrix_t a, matrix_descr descr, MKL_INT columns, const MKL_Complex16 x[], MKL_INT ldx, MKL_Complex16 y[], MKL_INT ldy)
+{
+	return mkl_sparse_z_mm(SPARSE_OPERATION_NON_TRANSPOSE, MKL_Complex16(1.0), a, descr, SPARSE_LAYOUT_COLUMN_MAJOR, x, columns, ldx, MKL_Complex16(0.0), y, ldy);
+}
+
+// sparse_status_t failures are returned as positive info values.
+inline int sparse_status_info(sparse_status_t status)
+{
+	return status == SPARSE_STATUS_ALLOC_FAILED ? INSUFFICIENT_MEMORY : static_cast<int>(status);
+}
+#endif
+
+// Rows of a triangular CSR matrix grouped into levels: every row depends
+// only on rows of earlier levels, so the rows of one level can be solved
+// in parallel.
+const int SPARSE_LEVEL_GRAIN = 1 << 10;
+
+// Level sets of the lower (or upper) triangle of a CSR pattern: level_ptr
+// receives levels + 1 offsets into rows, which lists the rows level by level.
+template<typename I>
+inline void sparse_levels(lapack_int n, bool lower, const I row_ptr[], const I col_idx[], std::vector<lapack_int>& level_ptr, std::vector<lapack_int>& rows)
+{
+	std::vector<lapack_int> level(n, 0);
+	lapack_int levels = 0;
+
+	// Forward for lower, backward for upper, so dependencies come first.
+	for (auto k = 0; k < n; ++k)
+	{
+		const auto i = lower ? k : n - 1 - k;
+		lapack_int depth = 0;
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			if (lower ? j < i : j > i)
+			{
+				depth = std::max(depth, level[j] + 1);
+			}
+		}
+
+		level[i] = depth;
+		levels = std::max(levels, depth + 1);
+	}
+
+	level_ptr.assign(levels + 1, 0);
+	for (auto i = 0; i < n; ++i)
+	{
+		++level_ptr[level[i] + 1];
+	}
+
+	for (auto l = 0; l < levels; ++l)
+	{
+		level_ptr[l + 1] += level_ptr[l];
+	}
+
+	rows.resize(n);
+	std::vector<lapack_int> next(level_ptr.begin(), level_ptr.end() - 1);
+	for (auto i = 0; i < n; ++i)
+	{
+		rows[next[level[i]]++] = i;
+	}
+}
+
+/*
+	Analysed triangular factor for repeated solves T*x = b. The portable
+	path stores the strictly triangular part with rows renumbered in level
+	order, so each level is a contiguous block, and the inverted diagonal
+	separately; the MKL path keeps a CSR copy in row_ptr/col_idx/values
+	behind an inspector-executor handle optimized for mkl_sparse_?_trsv.
+	Not safe for concurrent solves.
+*/
+template<typename T>
+struct sparse_triangular
+{
+	lapack_int n;
+	bool lower, unit;
+	std::vector<lapack_int> level_ptr, rows;
+	std::vector<lapack_int> row_ptr, col_idx;
+	std::vector<T> values, inverse_diagonal;
+#ifdef PROVIDER_MKL
+	std::vector<T> work;
+	sparse_matrix_t handle;
+	matrix_descr descr;
+#endif
+
+	sparse_triangular()
+		: n(0), lower(true), unit(false)
+#ifdef PROVIDER_MKL
+		, handle(nullptr)
+#endif
+	{
+	}
+
+	~sparse_triangular()
+	{
+#ifdef PROVIDER_MKL
+		if (handle) mkl_sparse_destroy(handle);
+#endif
+	}
+
+	sparse_triangular(const sparse_triangular&) = delete;
+	sparse_triangular& operator=(const sparse_triangular&) = delete;
+};
+
+/*
+	Builds the solve structure for the lower or upper triangle of a CSR
+	matrix of order n; entries of the other triangle are ignored. Returns
+	0, or i + 1 if the diagonal of row i is zero or missing (non-unit only).
+	May throw std::bad_alloc.
+*/
+template<typename T>
+inline lapack_int sparse_triangular_analyse(sparse_triangular<T>& t, lapack_int n, bool lower, bool unit,
+	const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+{
+	t.n = n;
+	t.lower = lower;
+	t.unit = unit;
+
+	std::vector<T> diagonal(n, T(0));
+	for (auto i = 0; i < n; ++i)
+	{
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			diagonal[i] += col_idx[p] == i ? values[p] : T(0);
+		}
+	}
+
+	if (!unit)
+	{
+		for (auto i = 0; i < n; ++i)
+		{
+			if (diagonal[i] == T(0))
+			{
+				return i + 1;
+			}
+		}
+	}
+
+	sparse_levels(n, lower, row_ptr, col_idx, t.level_ptr, t.rows);
+
+	t.row_ptr.assign(n + 1, 0);
+	t.inverse_diagonal.resize(n);
+	for (auto r = 0; r < n; ++r)
+	{
+		const auto i = t.rows[r];
+		lapack_int count = 0;
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			count += (lower ? j < i : j > i) ? 1 : 0;
+		}
+
+		t.row_ptr[r + 1] = t.row_ptr[r] + count;
+		t.inverse_diagonal[r] = unit ? T(1) : T(1) / diagonal[i];
+	}
+
+	t.col_idx.resize(t.row_ptr[n]);
+	t.values.resize(t.row_ptr[n]);
+	for (auto r = 0; r < n; ++r)
+	{
+		const auto i = t.rows[r];
+		auto q = t.row_ptr[r];
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			if (lower ? j < i : j > i)
+			{
+				t.col_idx[q] = j;
+				t.values[q++] = values[p];
+			}
+		}
+	}
+
+	return 0;
+}
+
+template<typename T>
+inline void sparse_triangular_rows(const sparse_triangular<T>& t, lapack_int begin, lapack_int end, const T b[], T x[])
+{
+	const auto* rows = t.rows.data();
+	const auto* row_ptr = t.row_ptr.data();
+	const auto* col_idx = t.col_idx.data();
+	const auto* values = t.values.data();
+	const auto* inverse_diagonal = t.inverse_diagonal.data();
+
+	for (auto r = begin; r < end; ++r)
+	{
+		const auto i = rows[r];
+		auto sum = b[i];
+		for (auto p = row_ptr[r]; p < row_ptr[r + 1]; ++p)
+		{
+			sum -= values[p] * x[col_idx[p]];
+		}
+
+		x[i] = sum * inverse_diagonal[r];
+	}
+}
+
+// x = inv(T)*b level by level; x may alias b.
+template<typename T>
+inline void sparse_triangular_levels(const sparse_triangular<T>& t, const T b[], T x[])
+{
+	const auto levels = static_cast<lapack_int>(t.level_ptr.size()) - 1;
+
+	for (auto l = 0; l < levels; ++l)
+	{
+		const auto begin = t.level_ptr[l];
+		const auto count = t.level_ptr[l + 1] - begin;
+
+		if (count < 2 * SPARSE_LEVEL_GRAIN)
+		{
+			sparse_triangular_rows(t, begin, begin + count, b, x);
+		}
+		else
+		{
+			parallel_for(count, SPARSE_LEVEL_GRAIN, [&](int first, int last)
+			{
+				sparse_triangular_rows(t, begin + first, begin + last, b, x);
+			});
+		}
+	}
+}
+
+// Analyses for the native kernel or, on MKL, creates the optimized handle.
+template<typename T>
+inline lapack_int sparse_triangular_prepare(sparse_triangular<T>& t, lapack_int n, bool lower, bool unit,
+	const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+{
+#ifdef PROVIDER_MKL
+	t.n = n;
+	t.lower = lower;
+	t.unit = unit;
+
+	if (!unit)
+	{
+		for (auto i = 0; i < n; ++i)
+		{
+			auto diagonal = T(0);
+			for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+			{
+				diagonal += col_idx[p] == i ? values[p] : T(0);
+			}
+
+			if (diagonal == T(0))
+			{
+				return i + 1;
+			}
+		}
+	}
+
+	t.row_ptr.assign(row_ptr, row_ptr + n + 1);
+	t.col_idx.assign(col_idx, col_idx + row_ptr[n]);
+	t.values.assign(values, values + row_ptr[n]);
+	t.work.resize(n);
+
+	t.descr.type = SPARSE_MATRIX_TYPE_TRIANGULAR;
+	t.descr.mode = lower ? SPARSE_FILL_MODE_LOWER : SPARSE_FILL_MODE_UPPER;
+	t.descr.diag = unit ? SPARSE_DIAG_UNIT : SPARSE_DIAG_NON_UNIT;
+
+	auto status = sparse_create_csr(&t.handle, n, n, t.row_ptr.data(), t.col_idx.data(), t.values.data());
+	if (status == SPARSE_STATUS_SUCCESS)
+	{
+		status = mkl_sparse_set_sv_hint(t.handle, SPARSE_OPERATION_NON_TRANSPOSE, t.descr, 1000);
+	}
+
+	if (status == SPARSE_STATUS_SUCCESS)
+	{
+		status = mkl_sparse_optimize(t.handle);
+	}
+
+	return status == SPARSE_STATUS_SUCCESS ? 0 : sparse_status_info(status);
+#else
+	return sparse_triangular_analyse(t, n, lower, unit, row_ptr, col_idx, values);
+#endif
+}
+
+// x = inv(T)*b; x may alias b.
+template<typename T>
+inline lapack_int sparse_triangular_solve(sparse_triangular<T>& t, const T b[], T x[])
+{
+#ifdef PROVIDER_MKL
+	if (x == b)
+	{
+		std::copy(b, b + t.n, t.work.begin());
+		b = t.work.data();
+	}
+
+	auto status = sparse_trsv(t.handle, t.descr, b, x);
+	return status == SPARSE_STATUS_SUCCESS ? 0 : sparse_status_info(status);
+#else
+	sparse_triangular_levels(t, b, x);
+	return 0;
+#endif
+}
+
+/*
+	Preconditioner applied by the native Krylov solvers, x = inv(M)*b, with
+	apply returning 0 or a LAPACK-style info. Handles of this type are passed
+	around as void* pointing at the base, and freed through it.
+*/
+template<typename T>
+struct sparse_preconditioner
+{
+	virtual ~sparse_preconditioner() {}
+	virtual lapack_int apply(const T b[], T x[]) = 0;
+};
@@ -0,0 +1,539 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "sparse_common.h"
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/*
+	Products of a zero-based CSR matrix with a matrix descriptor, so that a
+	symmetric, Hermitian or triangular matrix can be stored as one triangle.
+	matrix_type is 0 general, 1 symmetric, 2 Hermitian (symmetric on the
+	real types) or 3 triangular; for types 1-3 the matrix must be square,
+	fill_mode (0 lower, 1 upper) selects the triangle that is read, entries
+	of the other one are ignored, and diag_type 1 takes the diagonal as
+	unit instead of reading it.
+
+	- x_sparse_csr_create copies the matrix into a handle for repeated
+	  products. On MKL it is an inspector-executor handle with an mv hint
+	  for expected_calls products, run through mkl_sparse_optimize. The
+	  portable path keeps the matrix as given: symmetric and Hermitian
+	  types are applied from the stored triangle, each off-diagonal a_ij
+	  adding a_ij * x_j to y_i and a_ij' * x_i to y_j, so memory and
+	  traffic stay those of one triangle.
+	- x_sparse_csr_mv computes y = A*x on the handle; calls on one handle
+	  must not overlap.
+	- x_sparse_csr_free releases the handle.
+	- x_sparse_csr_mv_descr and x_sparse_csr_mm_descr compute y = A*x and
+	  C = A*B (B and C column-major) in one call without keeping anything;
+	  both paths only read the caller's arrays. nnz must equal row_ptr[m].
+
+	Arguments are checked as everywhere else: a negative return is the
+	index of the bad argument, a positive one an MKL sparse status.
+*/
+
+const int CSR_GENERAL = 0;
+const int CSR_SYMMETRIC = 1;
+const int CSR_HERMITIAN = 2;
+const int CSR_TRIANGULAR = 3;
+
+template<typename T>
+struct sparse_csr_operator
+{
+	lapack_int m, n, type;
+	bool lower, unit;
+	std::vector<lapack_int> row_ptr, col_idx;
+	std::vector<T> values;
+	const lapack_int* rows;
+	const lapack_int* cols;
+	const T* vals;
+	std::vector<int> bounds;
+	std::vector<lapack_int> window, offsets;
+	std::vector<T> scatter;
+#ifdef PROVIDER_MKL
+	sparse_matrix_t handle;
+	matrix_descr descr;
+#endif
+
+	sparse_csr_operator()
+		: m(0), n(0), type(CSR_GENERAL), lower(true), unit(false), rows(nullptr), cols(nullptr), vals(nullptr)
+#ifdef PROVIDER_MKL
+		, handle(nullptr)
+#endif
+	{
+	}
+
+	~sparse_csr_operator()
+	{
+#ifdef PROVIDER_MKL
+		if (handle) mkl_sparse_destroy(handle);
+#endif
+	}
+
+	sparse_csr_operator(const sparse_csr_operator&) = delete;
+	sparse_csr_operator& operator=(const sparse_csr_operator&) = delete;
+};
+
+// 0, or the negative index of the first bad descriptor argument, matrix_type being argument first.
+inline lapack_int csr_check_descriptor(lapack_int m, lapack_int n, lapack_int type, lapack_int fill, lapack_int diag, lapack_int first)
+{
+	if (type < CSR_GENERAL || type > CSR_TRIANGULAR || (type != CSR_GENERAL && m != n)) return -first;
+	if (fill != 0 && fill != 1) return -(first + 1);
+	if (diag != 0 && diag != 1) return -(first + 2);
+	return 0;
+}
+
+template<typename T>
+inline void csr_describe(sparse_csr_operator<T>& a, lapack_int m, lapack_int n, lapack_int type, lapack_int fill, lapack_int diag)
+{
+	a.m = m;
+	a.n = n;
+	a.type = type;
+	a.lower = fill == 0;
+	a.unit = type != CSR_GENERAL && diag == 1;
+}
+
+// Whether entry (i, j) is read under the descriptor: the selected triangle, less a unit diagonal.
+template<typename T>
+inline bool csr_reads(const sparse_csr_operator<T>& a, lapack_int i, lapack_int j)
+{
+	if (a.type == CSR_GENERAL) return true;
+	if (a.unit && j == i) return false;
+	return a.lower ? j <= i : j >= i;
+}
+
+// Points the operator at the CSR arrays and splits its rows into chunks.
+template<typename T>
+inline void csr_attach(sparse_csr_operator<T>& a, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+{
+	a.rows = row_ptr;
+	a.cols = col_idx;
+	a.vals = values;
+	sparse_row_chunks(a.m, row_ptr, a.bounds);
+}
+
+/*
+	For symmetric and Hermitian types each stored off-diagonal a_ij also
+	adds a_ij' * x_i to y_j. Targets inside the chunk that owns row i are
+	updated in place; the others go to the chunk's private window, the
+	row range [window[2c], window[2c + 1]) those targets span, which is
+	added to y once all chunks are done. Windows are sized here, in one
+	pass over the structure. May throw std::bad_alloc.
+*/
+template<typename T>
+inline void csr_mirror_windows(sparse_csr_operator<T>& a)
+{
+	const auto chunks = static_cast<int>(a.bounds.size()) - 1;
+	a.window.assign(2 * chunks, 0);
+	a.offsets.assign(chunks + 1, 0);
+	if (a.type != CSR_SYMMETRIC && a.type != CSR_HERMITIAN) return;
+
+	for (auto c = 0; c < chunks; ++c)
+	{
+		const auto begin = a.bounds[c], end = a.bounds[c + 1];
+		auto low = a.m, high = 0;
+		for (auto i = begin; i < end; ++i)
+		{
+			for (auto p = a.rows[i]; p < a.rows[i + 1]; ++p)
+			{
+				const auto j = a.cols[p];
+				if (j == i || !csr_reads(a, i, j) || (j >= begin && j < end)) continue;
+
+				low = std::min(low, j);
+				high = std::max(high, j + 1);
+			}
+		}
+
+		if (low < high)
+		{
+			a.window[2 * c] = low;
+			a.window[2 * c + 1] = high;
+		}
+
+		a.offsets[c + 1] = a.offsets[c] + (a.window[2 * c + 1] - a.window[2 * c]);
+	}
+
+	a.scatter.resize(a.offsets[chunks]);
+}
+
+// y = A*x on rows [begin, end) of a general or triangular matrix.
+template<typename T>
+inline void csr_rows(const sparse_csr_operator<T>& a, lapack_int begin, lapack_int end, const T x[], T y[])
+{
+	const auto* row_ptr = a.rows;
+	const auto* col_idx = a.cols;
+	const auto* values = a.vals;
+
+	for (auto i = begin; i < end; ++i)
+	{
+		auto sum = a.unit ? x[i] : T(0);
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			if (!csr_reads(a, i, col_idx[p])) continue;
+			sum += values[p] * x[col_idx[p]];
+		}
+
+		y[i] = sum;
+	}
+}
+
+// Rows [begin, end) of chunk c of y = A*x for a symmetric or Hermitian A stored as one triangle.
+template<typename T>
+inline void csr_mirror_rows(sparse_csr_operator<T>& a, int c, lapack_int begin, lapack_int end, const T x[], T y[])
+{
+	const auto* row_ptr = a.rows;
+	const auto* col_idx = a.cols;
+	const auto* values = a.vals;
+	const auto hermitian = a.type == CSR_HERMITIAN;
+	const auto low = a.window[2 * c];
+	auto* window = a.scatter.data() + a.offsets[c] - low;
+
+	std::fill(y + begin, y + end, T(0));
+	std::fill(window + low, window + a.window[2 * c + 1], T(0));
+
+	for (auto i = begin; i < end; ++i)
+	{
+		const auto xi = x[i];
+		auto sum = a.unit ? xi : T(0);
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			if (!csr_reads(a, i, j)) continue;
+
+			const auto v = values[p];
+			sum += v * x[j];
+			if (j == i) continue;
+
+			const auto t = (hermitian ? conj_value(v) : v) * xi;
+			if (j >= begin && j < end)
+			{
+				y[j] += t;
+			}
+			else
+			{
+				window[j] += t;
+			}
+		}
+
+		y[i] += sum;
+	}
+}
+
+// Y = A*X, X and Y column-major with leading dimensions n and m. Uses the
+// operator's windows, so products on one operator must not run concurrently.
+template<typename T>
+inline void csr_multiply(sparse_csr_operator<T>& a, lapack_int columns, const T x[], T y[])
+{
+	const auto chunks = static_cast<int>(a.bounds.size()) - 1;
+	if (a.type != CSR_SYMMETRIC && a.type != CSR_HERMITIAN)
+	{
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			for (auto k = 0; k < columns; ++k)
+			{
+				csr_rows(a, a.bounds[chunk], a.bounds[chunk + 1], x + static_cast<size_t>(k) * a.n, y + static_cast<size_t>(k) * a.m);
+			}
+		});
+
+		return;
+	}
+
+	for (auto k = 0; k < columns; ++k)
+	{
+		const auto* xk = x + static_cast<size_t>(k) * a.n;
+		auto* yk = y + static_cast<size_t>(k) * a.m;
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			csr_mirror_rows(a, chunk, a.bounds[chunk], a.bounds[chunk + 1], xk, yk);
+		});
+
+		if (a.scatter.empty()) continue;
+
+		// Each chunk adds the overlapping part of every window to its own rows.
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			const auto begin = a.bounds[chunk], end = a.bounds[chunk + 1];
+			for (auto c = 0; c < chunks; ++c)
+			{
+				const auto low = std::max(begin, a.window[2 * c]);
+				const auto high = std::min(end, a.window[2 * c + 1]);
+				const auto* window = a.scatter.data() + a.offsets[c] - a.window[2 * c];
+				for (auto i = low; i < high; ++i)
+				{
+					yk[i] += window[i];
+				}
+			}
+		});
+	}
+}
+
+#ifdef PROVIDER_MKL
+template<typename T>
+inline matrix_descr csr_mkl_descriptor(const sparse_csr_operator<T>& a)
+{
+	matrix_descr descr;
+	switch (a.type)
+	{
+	case CSR_SYMMETRIC:
+		descr.type = SPARSE_MATRIX_TYPE_SYMMETRIC;
+		break;
+	case CSR_HERMITIAN:
+		descr.type = std::is_floating_point<T>::value ? SPARSE_MATRIX_TYPE_SYMMETRIC : SPARSE_MATRIX_TYPE_HERMITIAN;
+		break;
+	case CSR_TRIANGULAR:
+		descr.type = SPARSE_MATRIX_TYPE_TRIANGULAR;
+		break;
+	default:
+		descr.type = SPARSE_MATRIX_TYPE_GENERAL;
+		break;
+	}
+
+	descr.mode = a.lower ? SPARSE_FILL_MODE_LOWER : SPARSE_FILL_MODE_UPPER;
+	descr.diag = a.unit ? SPARSE_DIAG_UNIT : SPARSE_DIAG_NON_UNIT;
+	return descr;
+}
+#endif
+
+template<typename T>
+inline lapack_int sparse_csr_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type, lapack_int expected_calls)
+{
+	*handle = nullptr;
+	if (m < 0) return -2;
+	if (n < 0) return -3;
+
+	const auto info = csr_check_descriptor(m, n, matrix_type, fill_mode, diag_type, 7);
+	if (info != 0) return info;
+	if (expected_calls < 0) return -10;
+
+	try
+	{
+		std::unique_ptr<sparse_csr_operator<T>> a(new sparse_csr_operator<T>());
+		csr_describe(*a, m, n, matrix_type, fill_mode, diag_type);
+
+#ifdef PROVIDER_MKL
+		// The handle references these copies, not the caller's arrays.
+		a->row_ptr.assign(row_ptr, row_ptr + m + 1);
+		a->col_idx.assign(col_idx, col_idx + row_ptr[m]);
+		a->values.assign(values, values + row_ptr[m]);
+		a->descr = csr_mkl_descriptor(*a);
+
+		auto status = sparse_create_csr(&a->handle, m, n, a->row_ptr.data(), a->col_idx.data(), a->values.data());
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_set_mv_hint(a->handle, SPARSE_OPERATION_NON_TRANSPOSE, a->descr, std::max(expected_calls, 1));
+		}
+
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_optimize(a->handle);
+		}
+
+		if (status != SPARSE_STATUS_SUCCESS) return sparse_status_info(status);
+#else
+		// Only the MKL handle uses the hint.
+		(void)expected_calls;
+		a->row_ptr.assign(row_ptr, row_ptr + m + 1);
+		a->col_idx.assign(col_idx, col_idx + row_ptr[m]);
+		a->values.assign(values, values + row_ptr[m]);
+		csr_attach(*a, a->row_ptr.data(), a->col_idx.data(), a->values.data());
+		csr_mirror_windows(*a);
+#endif
+
+		*handle = a.release();
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int sparse_csr_mv(void* handle, const T x[], T y[])
+{
+	if (!handle) return -1;
+
+	auto& a = *static_cast<sparse_csr_operator<T>*>(handle);
+#ifdef PROVIDER_MKL
+	const auto status = sparse_mv(a.handle, a.descr, x, y);
+	return status == SPARSE_STATUS_SUCCESS ? 0 : sparse_status_info(status);
+#else
+	csr_multiply(a, 1, x, y);
+	return 0;
+#endif
+}
+
+template<typename T>
+inline lapack_int sparse_csr_free(void** handle)
+{
+	delete static_cast<sparse_csr_operator<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+// C = A*B for an m x k matrix A and k x columns B in one call, or y = A*x if vector.
+template<typename T>
+inline lapack_int sparse_csr_multiply_once(bool vector, lapack_int m, lapack_int k, lapack_int columns, const T values[], const lapack_int row_ptr[], const lapack_int col_idx[],
+	lapack_int nnz, const T b[], T c[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+{
+	if (m < 0) return -1;
+	if (k < 0) return -2;
+	if (columns < 0) return -3;
+
+	// Arguments after the dimensions shift by one for mm.
+	if (nnz != row_ptr[m]) return vector ? -6 : -7;
+	const auto info = csr_check_descriptor(m, k, matrix_type, fill_mode, diag_type, vector ? 9 : 10);
+	if (info != 0) return info;
+	if (m == 0 || columns == 0) return 0;
+	if (k == 0)
+	{
+		std::fill(c, c + static_cast<size_t>(m) * columns, T(0));
+		return 0;
+	}
+
+	try
+	{
+		sparse_csr_operator<T> a;
+		csr_describe(a, m, k, matrix_type, fill_mode, diag_type);
+
+#ifdef PROVIDER_MKL
+		const auto descr = csr_mkl_descriptor(a);
+		auto status = sparse_create_csr(&a.handle, m, k, const_cast<lapack_int*>(row_ptr), const_cast<lapack_int*>(col_idx), const_cast<T*>(values));
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = vector ? sparse_mv(a.handle, descr, b, c) : sparse_mm(a.handle, descr, columns, b, k, c, m);
+		}
+
+		return status == SPARSE_STATUS_SUCCESS ? 0 : sparse_status_info(status);
+#else
+		csr_attach(a, row_ptr, col_idx, values);
+		csr_mirror_windows(a);
+		csr_multiply(a, columns, b, c);
+		return 0;
+#endif
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_csr_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[],
+		lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type, lapack_int expected_calls)
+	{
+		return sparse_csr_create(handle, m, n, row_ptr, col_idx, values, matrix_type, fill_mode, diag_type, expected_calls);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[],
+		lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type, lapack_int expected_calls)
+	{
+		return sparse_csr_create(handle, m, n, row_ptr, col_idx, values, matrix_type, fill_mode, diag_type, expected_calls);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[],
+		lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type, lapack_int expected_calls)
+	{
+		return sparse_csr_create(handle, m, n, row_ptr, col_idx, values, matrix_type, fill_mode, diag_type, expected_calls);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[],
+		lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type, lapack_int expected_calls)
+	{
+		return sparse_csr_create(handle, m, n, row_ptr, col_idx, values, matrix_type, fill_mode, diag_type, expected_calls);
+	}
+
+	DLLEXPORT lapack_int s_sparse_csr_mv(void* handle, const float x[], float y[])
+	{
+		return sparse_csr_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_mv(void* handle, const double x[], double y[])
+	{
+		return sparse_csr_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_mv(void* handle, const lapack_complex_float x[], lapack_complex_float y[])
+	{
+		return sparse_csr_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_mv(void* handle, const lapack_complex_double x[], lapack_complex_double y[])
+	{
+		return sparse_csr_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int s_sparse_csr_free(void** handle)
+	{
+		return sparse_csr_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_free(void** handle)
+	{
+		return sparse_csr_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_free(void** handle)
+	{
+		return sparse_csr_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_free(void** handle)
+	{
+		return sparse_csr_free<lapack_complex_double>(handle);
+	}
+
+	DLLEXPORT lapack_int s_sparse_csr_mv_descr(lapack_int m, lapack_int n, const float values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const float x[], float y[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(true, m, n, 1, values, row_ptr, col_idx, nnz, x, y, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_mv_descr(lapack_int m, lapack_int n, const double values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const double x[], double y[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(true, m, n, 1, values, row_ptr, col_idx, nnz, x, y, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_mv_descr(lapack_int m, lapack_int n, const lapack_complex_float values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const lapack_complex_float x[], lapack_complex_float y[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(true, m, n, 1, values, row_ptr, col_idx, nnz, x, y, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_mv_descr(lapack_int m, lapack_int n, const lapack_complex_double values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const lapack_complex_double x[], lapack_complex_double y[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(true, m, n, 1, values, row_ptr, col_idx, nnz, x, y, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int s_sparse_csr_mm_descr(lapack_int m, lapack_int k, lapack_int n, const float values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const float b[], float c[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(false, m, k, n, values, row_ptr, col_idx, nnz, b, c, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int d_sparse_csr_mm_descr(lapack_int m, lapack_int k, lapack_int n, const double values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const double b[], double c[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(false, m, k, n, values, row_ptr, col_idx, nnz, b, c, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int c_sparse_csr_mm_descr(lapack_int m, lapack_int k, lapack_int n, const lapack_complex_float values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const lapack_complex_float b[], lapack_complex_float c[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(false, m, k, n, values, row_ptr, col_idx, nnz, b, c, matrix_type, fill_mode, diag_type);
+	}
+
+	DLLEXPORT lapack_int z_sparse_csr_mm_descr(lapack_int m, lapack_int k, lapack_int n, const lapack_complex_double values[], const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int nnz,
+		const lapack_complex_double b[], lapack_complex_double c[], lapack_int matrix_type, lapack_int fill_mode, lapack_int diag_type)
+	{
+		return sparse_csr_multiply_once(false, m, k, n, values, row_ptr, col_idx, nnz, b, c, matrix_type, fill_mode, diag_type);
+	}
+}
@@ -0,0 +1,1167 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "sparse_common.h"
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+/*
+	A few eigenpairs of a large sparse Hermitian matrix by thick-restart
+	Lanczos (Wu and Simon), the symmetric form of Krylov-Schur: the basis
+	is fully reorthogonalized with two classical Gram-Schmidt passes, and
+	each restart keeps the wanted Ritz vectors plus the residual direction,
+	so the projected matrix is an arrowhead followed by a tridiagonal.
+
+	which selects the eigenvalues:
+	- 0, the k smallest (algebraic) and 1, the k largest, iterating on A;
+	- 2, the k nearest sigma, and 3, all of them in [lower, upper], at most
+	  k, iterating on inv(A - sigma*I) (shift-invert), with sigma the middle
+	  of the interval for 3. Eigenvalues in the interval are searched a few
+	  at a time, doubling up to k + 1, until the farthest one found lies
+	  outside it; the extra one tells an interval holding exactly k from one
+	  holding more.
+
+	x_sparse_eigen takes a zero-based CSR matrix with both triangles stored.
+	The shifted matrix is factored once and the factorization is reused for
+	every solve: on MKL by DSS (upper triangle, Bunch-Kaufman pivoting), on
+	other providers by an up-looking sparse LDL' on the minimum degree
+	ordering of sparse_reorder_amd, without pivoting. A pivot below
+	sqrt(eps) times the largest entry of its row of A - sigma*I is rejected
+	and the factorization retried with sigma moved by 4*sqrt(eps)*max|a_ij|
+	(alternating sides, doubling), since a shift near an eigenvalue of a
+	leading block breaks it down even when it is none of A; the eigenvalues
+	are then those nearest the moved shift. Pivots that pass can still grow
+	the factors and cost digits in the solves, so every returned pair is
+	checked against A itself: ||A*x - lambda*x|| must be at most
+	100 * tolerance * ||A - sigma*I||_inf * max(c, eps^(2/3) * |lambda - sigma|),
+	where c = ||A - sigma*I||_inf / min|lambda_j - sigma| over the returned
+	pairs estimates the condition of A - sigma*I: the bound a converged pair
+	of backward stable solves meets. If one is not, other providers refactor
+	A - sigma*I as a sparse LU with threshold partial pivoting
+	(Gilbert-Peierls, same column ordering) and run the iteration again; the
+	call fails with 3 if the pairs still miss the bound (they are returned
+	all the same). x_matrix_free_eigen
+	instead calls apply(context, x, y) with y = A*x for 0 and 1, or
+	y = inv(A - sigma*I)*x for 2 and 3, so the caller can bring its own
+	operator or factorization.
+
+	subspace is the basis size (0 for max(2k + 1, k + 20)), capped at n.
+	A Ritz pair is converged when its residual is at most
+	tolerance * max(|theta|, eps^(2/3)) for the Ritz value theta of the
+	iterated operator (0 for machine precision). eigenvalues receives the
+	eigenvalues found in ascending order and eigenvectors, if not null, the
+	orthonormal eigenvectors as n x k column-major; found receives their
+	number and restarts the restarts done. Returns 0 when converged, 1 when
+	max_restarts was reached (the converged pairs are returned), 2 when the
+	interval holds more than k eigenvalues (the k nearest its middle are
+	returned), and 3 if the factorization, a solve, a callback or the
+	residual check above failed.
+*/
+
+const int EIGEN_SMALLEST = 0;
+const int EIGEN_LARGEST = 1;
+const int EIGEN_NEAREST = 2;
+const int EIGEN_INTERVAL = 3;
+
+const int EIGEN_CONVERGED = 0;
+const int EIGEN_RESTART_LIMIT = 1;
+const int EIGEN_INTERVAL_FULL = 2;
+const int EIGEN_FAILED = 3;
+
+const int EIGEN_SHIFT_RETRIES = 4;
+
+extern "C" DLLEXPORT lapack_int sparse_reorder_amd(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int perm[], lapack_int inverse[]);
+
+template<typename T>
+using eigen_callback = lapack_int (*)(void* context, const T x[], T y[]);
+
+inline lapack_int eigen_syev(lapack_int n, float a[], float w[])
+{
+	return LAPACKE_ssyev(LAPACK_COL_MAJOR, 'V', 'U', n, a, n, w);
+}
+
+inline lapack_int eigen_syev(lapack_int n, double a[], double w[])
+{
+	return LAPACKE_dsyev(LAPACK_COL_MAJOR, 'V', 'U', n, a, n, w);
+}
+
+template<typename R>
+inline void eigen_random(R& x, unsigned long long& state)
+{
+	state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+	x = static_cast<R>(static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5);
+}
+
+template<typename R>
+inline void eigen_random(std::complex<R>& x, unsigned long long& state)
+{
+	R re, im;
+	eigen_random(re, state);
+	eigen_random(im, state);
+	x = std::complex<R>(re, im);
+}
+
+// y = A*x for a CSR matrix.
+template<typename T>
+struct eigen_csr
+{
+	lapack_int n;
+	const lapack_int* row_ptr;
+	const lapack_int* col_idx;
+	const T* values;
+	int chunks;
+	std::vector<int> bounds;
+#ifdef PROVIDER_MKL
+	sparse_matrix_t handle;
+	matrix_descr descr;
+#endif
+
+	eigen_csr(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+		: n(n), row_ptr(row_ptr), col_idx(col_idx), values(values), chunks(1)
+#ifdef PROVIDER_MKL
+		, handle(nullptr)
+#endif
+	{
+	}
+
+	~eigen_csr()
+	{
+#ifdef PROVIDER_MKL
+		if (handle) mkl_sparse_destroy(handle);
+#endif
+	}
+
+	eigen_csr(const eigen_csr&) = delete;
+	eigen_csr& operator=(const eigen_csr&) = delete;
+
+	lapack_int prepare()
+	{
+#ifdef PROVIDER_MKL
+		descr.type = SPARSE_MATRIX_TYPE_GENERAL;
+		auto status = sparse_create_csr(&handle, n, n, const_cast<lapack_int*>(row_ptr), const_cast<lapack_int*>(col_idx), const_cast<T*>(values));
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_set_mv_hint(handle, SPARSE_OPERATION_NON_TRANSPOSE, descr, 1000);
+		}
+
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_optimize(handle);
+		}
+
+		return status == SPARSE_STATUS_SUCCESS ? 0 : EIGEN_FAILED;
+#else
+		chunks = sparse_row_chunks(n, row_ptr, bounds);
+		return 0;
+#endif
+	}
+
+	lapack_int apply(const T x[], T y[])
+	{
+#ifdef PROVIDER_MKL
+		return sparse_mv(handle, descr, x, y) == SPARSE_STATUS_SUCCESS ? 0 : EIGEN_FAILED;
+#else
+		const auto* row_ptr = this->row_ptr;
+		const auto* col_idx = this->col_idx;
+		const auto* values = this->values;
+		const auto* bounds = this->bounds.data();
+
+		parallel_for_chunks(chunks, chunks, [=](int chunk, int, int)
+		{
+			for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+			{
+				auto yi = T(0);
+				for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+				{
+					yi += values[p] * x[col_idx[p]];
+				}
+
+				y[i] = yi;
+			}
+		});
+
+		return 0;
+#endif
+	}
+};
+
+#ifdef PROVIDER_MKL
+inline MKL_INT eigen_dss_precision(float) { return MKL_DSS_SINGLE_PRECISION; }
+inline MKL_INT eigen_dss_precision(double) { return 0; }
+inline MKL_INT eigen_dss_precision(const MKL_Complex8&) { return MKL_DSS_SINGLE_PRECISION; }
+inline MKL_INT eigen_dss_precision(const MKL_Complex16&) { return 0; }
+
+inline MKL_INT eigen_dss_factor(_MKL_DSS_HANDLE_t& handle, const float values[])
+{
+	MKL_INT type = MKL_DSS_INDEFINITE;
+	return dss_factor_real(handle, type, values);
+}
+
+inline MKL_INT eigen_dss_factor(_MKL_DSS_HANDLE_t& handle, const double values[])
+{
+	MKL_INT type = MKL_DSS_INDEFINITE;
+	return dss_factor_real(handle, type, values);
+}
+
+inline MKL_INT eigen_dss_factor(_MKL_DSS_HANDLE_t& handle, const MKL_Complex8 values[])
+{
+	MKL_INT type = MKL_DSS_HERMITIAN_INDEFINITE;
+	return dss_factor_complex(handle, type, values);
+}
+
+inline MKL_INT eigen_dss_factor(_MKL_DSS_HANDLE_t& handle, const MKL_Complex16 values[])
+{
+	MKL_INT type = MKL_DSS_HERMITIAN_INDEFINITE;
+	return dss_factor_complex(handle, type, values);
+}
+
+template<typename T>
+inline MKL_INT eigen_dss_solve(_MKL_DSS_HANDLE_t& handle, const T b[], T x[])
+{
+	MKL_INT opt = MKL_DSS_DEFAULTS;
+	MKL_INT rhs = 1;
+	return dss_solve_real(handle, opt, b, rhs, x);
+}
+
+template<typename R>
+inline MKL_INT eigen_dss_solve(_MKL_DSS_HANDLE_t& handle, const std::complex<R> b[], std::complex<R> x[])
+{
+	MKL_INT opt = MKL_DSS_DEFAULTS;
+	MKL_INT rhs = 1;
+	return dss_solve_complex(handle, opt, b, rhs, x);
+}
+#endif
+
+/*
+	y = inv(A - sigma*I)*x from a factorization made once in prepare: MKL
+	DSS on the upper triangle, or the native LDL' = P*(A - sigma*I)*P' with
+	L stored by columns.
+*/
+template<typename T>
+struct eigen_shift_invert
+{
+	typedef decltype(real_value(T())) R;
+
+	lapack_int n;
+	const lapack_int* row_ptr;
+	const lapack_int* col_idx;
+	const T* values;
+	R sigma;
+#ifdef PROVIDER_MKL
+	std::vector<MKL_INT> upper_ptr, upper_idx;
+	std::vector<T> upper_values;
+	_MKL_DSS_HANDLE_t handle;
+	bool created;
+#else
+	std::vector<lapack_int> perm, inverse, l_ptr, l_idx;
+	std::vector<T> l_values, d, work;
+	std::vector<lapack_int> lu_pinv, lu_l_ptr, lu_l_idx, lu_u_ptr, lu_u_idx;
+	std::vector<T> lu_l_values, lu_u_values;
+	bool pivoted;
+#endif
+
+	eigen_shift_invert(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[], R sigma)
+		: n(n), row_ptr(row_ptr), col_idx(col_idx), values(values), sigma(sigma)
+#ifdef PROVIDER_MKL
+		, handle(nullptr), created(false)
+#else
+		, pivoted(false)
+#endif
+	{
+	}
+
+	~eigen_shift_invert()
+	{
+#ifdef PROVIDER_MKL
+		if (created)
+		{
+			MKL_INT opt = MKL_DSS_DEFAULTS;
+			dss_delete(handle, opt);
+		}
+#endif
+	}
+
+	eigen_shift_invert(const eigen_shift_invert&) = delete;
+	eigen_shift_invert& operator=(const eigen_shift_invert&) = delete;
+
+#ifdef PROVIDER_MKL
+	lapack_int prepare()
+	{
+		// Upper triangle with every diagonal entry present and columns sorted.
+		std::vector<lapack_int> row;
+		upper_ptr.assign(1, 0);
+		for (auto i = 0; i < n; ++i)
+		{
+			auto diagonal = T(-sigma);
+			row.clear();
+			for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+			{
+				if (col_idx[p] == i) diagonal += values[p];
+				else if (col_idx[p] > i) row.push_back(p);
+			}
+
+			std::sort(row.begin(), row.end(), [&](lapack_int a, lapack_int b) { return col_idx[a] < col_idx[b]; });
+			upper_idx.push_back(i);
+			upper_values.push_back(diagonal);
+			for (auto p : row)
+			{
+				upper_idx.push_back(col_idx[p]);
+				upper_values.push_back(values[p]);
+			}
+
+			upper_ptr.push_back(static_cast<MKL_INT>(upper_idx.size()));
+		}
+
+		MKL_INT opt = MKL_DSS_MSG_LVL_WARNING + MKL_DSS_TERM_LVL_ERROR + MKL_DSS_ZERO_BASED_INDEXING + eigen_dss_precision(T());
+		if (dss_create(handle, opt) != MKL_DSS_SUCCESS) return EIGEN_FAILED;
+		created = true;
+
+		MKL_INT structure = is_complex() ? MKL_DSS_SYMMETRIC_COMPLEX : MKL_DSS_SYMMETRIC;
+		MKL_INT rows = n;
+		MKL_INT nnz = upper_ptr[n];
+		if (dss_define_structure(handle, structure, upper_ptr.data(), rows, rows, upper_idx.data(), nnz) != MKL_DSS_SUCCESS) return EIGEN_FAILED;
+
+		MKL_INT order = MKL_DSS_AUTO_ORDER;
+		if (dss_reorder(handle, order, 0) != MKL_DSS_SUCCESS) return EIGEN_FAILED;
+		if (eigen_dss_factor(handle, upper_values.data()) != MKL_DSS_SUCCESS) return EIGEN_FAILED;
+
+		return 0;
+	}
+
+	lapack_int apply(const T x[], T y[])
+	{
+		return eigen_dss_solve(handle, x, y) == MKL_DSS_SUCCESS ? 0 : EIGEN_FAILED;
+	}
+
+	// DSS already pivots (Bunch-Kaufman).
+	bool pivot()
+	{
+		return false;
+	}
+
+	static bool is_complex()
+	{
+		return sizeof(T) == 2 * sizeof(R);
+	}
+#else
+	lapack_int prepare()
+	{
+		perm.resize(n);
+		inverse.resize(n);
+		if (sparse_reorder_amd(n, row_ptr, col_idx, perm.data(), inverse.data()) != 0) return EIGEN_FAILED;
+
+		// Elimination tree and column counts of L. Column k of the permuted
+		// upper triangle is row perm[k] of A restricted to inverse[j] < k.
+		std::vector<lapack_int> parent(n), flag(n), counts(n);
+		for (auto k = 0; k < n; ++k)
+		{
+			parent[k] = -1;
+			flag[k] = k;
+			counts[k] = 0;
+			const auto r = perm[k];
+			for (auto p = row_ptr[r]; p < row_ptr[r + 1]; ++p)
+			{
+				for (auto i = inverse[col_idx[p]]; i < k && flag[i] != k; i = parent[i])
+				{
+					if (parent[i] == -1) parent[i] = k;
+					++counts[i];
+					flag[i] = k;
+				}
+			}
+		}
+
+		l_ptr.resize(n + 1);
+		l_ptr[0] = 0;
+		for (auto k = 0; k < n; ++k)
+		{
+			l_ptr[k + 1] = l_ptr[k] + counts[k];
+		}
+
+		l_idx.resize(l_ptr[n]);
+		l_values.resize(l_ptr[n]);
+		d.resize(n);
+		work.resize(n);
+
+		R largest = 0;
+		for (auto p = 0; p < row_ptr[n]; ++p)
+		{
+			largest = std::max(largest, static_cast<R>(std::abs(values[p])));
+		}
+
+		// A pivot moves at least as far as sigma does, so a few thresholds are enough.
+		const auto shift = sigma;
+		auto offset = 4 * std::sqrt(std::numeric_limits<R>::epsilon()) * std::max(largest, std::abs(shift));
+		for (auto retry = 0; retry <= EIGEN_SHIFT_RETRIES; ++retry)
+		{
+			if (factor(parent, flag, counts))
+			{
+				return 0;
+			}
+
+			sigma = shift + offset;
+			offset *= -2;
+		}
+
+		return EIGEN_FAILED;
+	}
+
+	// Up-looking numeric factorization: row k of L from a sparse triangular
+	// solve over the reach of row k in the elimination tree. False on a
+	// pivot too small for the solves to be trusted.
+	bool factor(const std::vector<lapack_int>& parent, std::vector<lapack_int>& flag, std::vector<lapack_int>& counts)
+	{
+		const auto threshold = std::sqrt(std::numeric_limits<R>::epsilon());
+		std::vector<lapack_int> pattern(n);
+		auto& y = work;
+		std::fill(y.begin(), y.end(), T(0));
+		for (auto k = 0; k < n; ++k)
+		{
+			y[k] = T(-sigma);
+			auto top = n;
+			flag[k] = k;
+			counts[k] = 0;
+
+			R scale = 0;
+			const auto r = perm[k];
+			for (auto p = row_ptr[r]; p < row_ptr[r + 1]; ++p)
+			{
+				auto i = inverse[col_idx[p]];
+				if (i != k) scale = std::max(scale, static_cast<R>(std::abs(values[p])));
+				if (i > k) continue;
+
+				// A is Hermitian, so column k above the diagonal is the conjugate of row k.
+				y[i] += i == k ? values[p] : conj_value(values[p]);
+				auto length = 0;
+				for (; flag[i] != k; i = parent[i])
+				{
+					pattern[length++] = i;
+					flag[i] = k;
+				}
+
+				while (length > 0)
+				{
+					pattern[--top] = pattern[--length];
+				}
+			}
+
+			scale = std::max(scale, static_cast<R>(std::abs(y[k])));
+			d[k] = y[k];
+			y[k] = T(0);
+			for (; top < n; ++top)
+			{
+				const auto i = pattern[top];
+				const auto yi = y[i];
+				y[i] = T(0);
+
+				const auto end = l_ptr[i] + counts[i];
+				for (auto p = l_ptr[i]; p < end; ++p)
+				{
+					y[l_idx[p]] -= l_values[p] * yi;
+				}
+
+				const auto lki = conj_value(yi) / d[i];
+				d[k] -= lki * yi;
+				l_idx[end] = k;
+				l_values[end] = lki;
+				++counts[i];
+			}
+
+			d[k] = T(real_value(d[k]));
+			if (!(std::abs(d[k]) > threshold * scale))
+			{
+				std::fill(y.begin(), y.end(), T(0));
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Switches to y = inv(A - sigma*I)*x by a left-looking sparse LU,
+	// P*(A - sigma*I)*Q = L*U with Q the minimum degree order and P from
+	// partial pivoting that keeps the diagonal while it is within a factor
+	// 10 of the largest candidate. False if already switched or singular.
+	bool pivot()
+	{
+		if (pivoted) return false;
+
+		std::vector<lapack_int> pinv(n, -1), stack(n), next(n), mark(n, -1), reach(n);
+		std::vector<T> x(n, T(0));
+		lu_l_ptr.assign(1, 0);
+		lu_u_ptr.assign(1, 0);
+		lu_l_idx.clear();
+		lu_u_idx.clear();
+		lu_l_values.clear();
+		lu_u_values.clear();
+
+		for (auto k = 0; k < n; ++k)
+		{
+			// Pattern of L \ A(:, column): the rows reachable from those of the
+			// column through the columns of L so far, in topological order.
+			// L holds original row numbers until the end.
+			const auto column = perm[k];
+			auto top = n;
+			auto visit = [&](lapack_int start)
+			{
+				if (mark[start] == k) return;
+				auto head = 0;
+				stack[0] = start;
+				mark[start] = k;
+				next[start] = pinv[start] >= 0 ? lu_l_ptr[pinv[start]] + 1 : 0;
+				while (head >= 0)
+				{
+					const auto j = stack[head];
+					const auto end = pinv[j] >= 0 ? lu_l_ptr[pinv[j] + 1] : 0;
+					while (next[j] < end && mark[lu_l_idx[next[j]]] == k) ++next[j];
+					if (next[j] < end)
+					{
+						const auto i = lu_l_idx[next[j]++];
+						mark[i] = k;
+						next[i] = pinv[i] >= 0 ? lu_l_ptr[pinv[i]] + 1 : 0;
+						stack[++head] = i;
+					}
+					else
+					{
+						reach[--top] = j;
+						--head;
+					}
+				}
+			};
+
+			// A is Hermitian, so column j is the conjugate of row j.
+			visit(column);
+			for (auto p = row_ptr[column]; p < row_ptr[column + 1]; ++p)
+			{
+				visit(col_idx[p]);
+			}
+
+			x[column] = T(-sigma);
+			for (auto p = row_ptr[column]; p < row_ptr[column + 1]; ++p)
+			{
+				x[col_idx[p]] += conj_value(values[p]);
+			}
+
+			for (auto p = top; p < n; ++p)
+			{
+				const auto j = reach[p];
+				if (pinv[j] < 0) continue;
+				const auto xj = x[j];
+				for (auto q = lu_l_ptr[pinv[j]] + 1; q < lu_l_ptr[pinv[j] + 1]; ++q)
+				{
+					x[lu_l_idx[q]] -= lu_l_values[q] * xj;
+				}
+			}
+
+			lapack_int row = -1;
+			R largest = 0;
+			for (auto p = top; p < n; ++p)
+			{
+				const auto j = reach[p];
+				if (pinv[j] >= 0)
+				{
+					lu_u_idx.push_back(pinv[j]);
+					lu_u_values.push_back(x[j]);
+				}
+				else if (std::abs(x[j]) > largest)
+				{
+					largest = std::abs(x[j]);
+					row = j;
+				}
+			}
+
+			if (row < 0)
+			{
+				return false;
+			}
+
+			if (pinv[column] < 0 && std::abs(x[column]) >= largest / 10)
+			{
+				row = column;
+			}
+
+			const auto pivot = x[row];
+			lu_u_idx.push_back(k);
+			lu_u_values.push_back(pivot);
+			lu_u_ptr.push_back(static_cast<lapack_int>(lu_u_idx.size()));
+			pinv[row] = k;
+
+			lu_l_idx.push_back(row);
+			lu_l_values.push_back(T(1));
+			for (auto p = top; p < n; ++p)
+			{
+				const auto j = reach[p];
+				if (pinv[j] < 0)
+				{
+					lu_l_idx.push_back(j);
+					lu_l_values.push_back(x[j] / pivot);
+				}
+
+				x[j] = T(0);
+			}
+
+			lu_l_ptr.push_back(static_cast<lapack_int>(lu_l_idx.size()));
+		}
+
+		for (auto& i : lu_l_idx)
+		{
+			i = pinv[i];
+		}
+
+		lu_pinv.swap(pinv);
+		pivoted = true;
+		return true;
+	}
+
+	lapack_int apply_lu(const T x[], T y[])
+	{
+		auto* z = work.data();
+		for (auto i = 0; i < n; ++i)
+		{
+			z[lu_pinv[i]] = x[i];
+		}
+
+		for (auto j = 0; j < n; ++j)
+		{
+			const auto zj = z[j];
+			for (auto p = lu_l_ptr[j] + 1; p < lu_l_ptr[j + 1]; ++p)
+			{
+				z[lu_l_idx[p]] -= lu_l_values[p] * zj;
+			}
+		}
+
+		for (auto j = n - 1; j >= 0; --j)
+		{
+			const auto zj = z[j] /= lu_u_values[lu_u_ptr[j + 1] - 1];
+			for (auto p = lu_u_ptr[j]; p < lu_u_ptr[j + 1] - 1; ++p)
+			{
+				z[lu_u_idx[p]] -= lu_u_values[p] * zj;
+			}
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			y[perm[i]] = z[i];
+		}
+
+		return 0;
+	}
+
+	lapack_int apply(const T x[], T y[])
+	{
+		if (pivoted) return apply_lu(x, y);
+
+		auto* z = work.data();
+		for (auto i = 0; i < n; ++i)
+		{
+			z[i] = x[perm[i]];
+		}
+
+		for (auto j = 0; j < n; ++j)
+		{
+			const auto zj = z[j];
+			for (auto p = l_ptr[j]; p < l_ptr[j + 1]; ++p)
+			{
+				z[l_idx[p]] -= l_values[p] * zj;
+			}
+		}
+
+		for (auto j = 0; j < n; ++j)
+		{
+			z[j] /= d[j];
+		}
+
+		for (auto j = n - 1; j >= 0; --j)
+		{
+			auto zj = z[j];
+			for (auto p = l_ptr[j]; p < l_ptr[j + 1]; ++p)
+			{
+				zj -= conj_value(l_values[p]) * z[l_idx[p]];
+			}
+
+			z[j] = zj;
+		}
+
+		for (auto i = 0; i < n; ++i)
+		{
+			y[perm[i]] = z[i];
+		}
+
+		return 0;
+	}
+#endif
+};
+
+template<typename T>
+struct eigen_callback_operator
+{
+	eigen_callback<T> callback;
+	void* user;
+
+	eigen_callback_operator(eigen_callback<T> callback, void* user)
+		: callback(callback), user(user)
+	{
+	}
+
+	lapack_int apply(const T x[], T y[])
+	{
+		return callback(user, x, y) == 0 ? 0 : EIGEN_FAILED;
+	}
+};
+
+template<typename R>
+inline lapack_int eigen_check(lapack_int n, lapack_int which, lapack_int k, R lower, R upper,
+	lapack_int subspace, lapack_int max_restarts, R tolerance, lapack_int offset)
+{
+	if (n < 0) return -1;
+	if (which < EIGEN_SMALLEST || which > EIGEN_INTERVAL) return -(offset + 1);
+	if (k < 1 || k > n) return -(offset + 2);
+	if (which == EIGEN_INTERVAL && !(lower <= upper)) return -(offset + 5);
+	if (subspace < 0 || (subspace > 0 && subspace <= k && subspace < n)) return -(offset + 6);
+	if (max_restarts < 0) return -(offset + 7);
+	if (tolerance < 0) return -(offset + 8);
+	return 0;
+}
+
+/*
+	Thick-restart Lanczos on op, which applies A or inv(A - sigma*I). V holds
+	the m + 1 basis vectors column-major and H the m x m projection, rebuilt
+	as diag(theta) with an arrow in column keep at every restart.
+*/
+template<typename T, typename Op>
+inline lapack_int eigen_lanczos(Op& op, lapack_int n, lapack_int which, lapack_int k, decltype(real_value(T())) sigma,
+	decltype(real_value(T())) lower, decltype(real_value(T())) upper, lapack_int subspace, lapack_int max_restarts,
+	decltype(real_value(T())) tolerance, decltype(real_value(T()))* eigenvalues, T eigenvectors[], lapack_int* found, lapack_int* restarts)
+{
+	typedef decltype(real_value(T())) R;
+
+	const auto shift_invert = which == EIGEN_NEAREST || which == EIGEN_INTERVAL;
+	const auto eps = std::numeric_limits<R>::epsilon();
+	const auto smallest = std::pow(eps, R(2) / R(3));
+	const auto radius = std::max(upper - sigma, sigma - lower);
+	if (tolerance == 0) tolerance = eps;
+
+	// Wanted first: the largest theta for 1, the smallest for 0, the
+	// largest |theta| (nearest sigma) under shift-invert.
+	auto score = [=](R theta) { return which == EIGEN_SMALLEST ? -theta : which == EIGEN_LARGEST ? theta : std::abs(theta); };
+	auto basis_size = [=](lapack_int wanted) { return std::min(n, subspace > 0 ? std::max(subspace, wanted + 1) : std::max(2 * wanted + 1, wanted + 20)); };
+
+	// One more than k in the interval to tell exactly k from more.
+	const auto most = which == EIGEN_INTERVAL ? std::min(k + 1, n) : k;
+	auto wanted = which == EIGEN_INTERVAL ? std::min(most, 16) : k;
+	auto m = basis_size(wanted);
+
+	std::vector<T> v(static_cast<size_t>(n) * (m + 1)), h(m + 1), c(m + 1), ritz;
+	std::vector<R> projection(m * m), y(m * m), theta(m), residual(m);
+	std::vector<lapack_int> order(m);
+
+	auto norm = [=](const T x[])
+	{
+		R s = 0;
+		for (auto i = 0; i < n; ++i) s += abs2(x[i]);
+		return std::sqrt(s);
+	};
+
+	// Two classical Gram-Schmidt passes of w against columns [0, j]; h
+	// receives the coefficients.
+	auto orthogonalize = [&](lapack_int j, T w[])
+	{
+		gemm(CblasConjTrans, CblasNoTrans, j + 1, 1, n, T(1), v.data(), n, w, n, T(0), h.data(), j + 1);
+		gemm(CblasNoTrans, CblasNoTrans, n, 1, j + 1, T(-1), v.data(), n, h.data(), j + 1, T(1), w, n);
+		gemm(CblasConjTrans, CblasNoTrans, j + 1, 1, n, T(1), v.data(), n, w, n, T(0), c.data(), j + 1);
+		gemm(CblasNoTrans, CblasNoTrans, n, 1, j + 1, T(-1), v.data(), n, c.data(), j + 1, T(1), w, n);
+		for (auto i = 0; i <= j; ++i) h[i] += c[i];
+	};
+
+	auto state = 0x9E3779B97F4A7C15ULL;
+	for (auto i = 0; i < n; ++i) eigen_random(v[i], state);
+	auto start = norm(v.data());
+	for (auto i = 0; i < n; ++i) v[i] /= start;
+
+	*restarts = 0;
+	lapack_int keep = 0, converged = 0, info = EIGEN_CONVERGED;
+	R beta = 0;
+	while (true)
+	{
+		// Extend the basis from column keep to m.
+		for (auto j = keep; j < m; ++j)
+		{
+			auto* w = v.data() + static_cast<size_t>(j + 1) * n;
+			if (op.apply(v.data() + static_cast<size_t>(j) * n, w) != 0)
+			{
+				return EIGEN_FAILED;
+			}
+
+			const auto before = norm(w);
+			orthogonalize(j, w);
+			projection[j * m + j] = real_value(h[j]);
+
+			beta = norm(w);
+			if (beta <= std::sqrt(eps) * before || j + 1 == n)
+			{
+				// Invariant subspace: continue from a random vector orthogonal to the basis.
+				beta = 0;
+				if (j + 1 < n)
+				{
+					for (auto i = 0; i < n; ++i) eigen_random(w[i], state);
+					orthogonalize(j, w);
+					orthogonalize(j, w);
+					const auto scale = norm(w);
+					for (auto i = 0; i < n; ++i) w[i] /= scale;
+				}
+			}
+			else
+			{
+				for (auto i = 0; i < n; ++i) w[i] /= beta;
+			}
+
+			if (j + 1 < m)
+			{
+				projection[j * m + j + 1] = beta;
+				projection[(j + 1) * m + j] = beta;
+			}
+		}
+
+		// Rayleigh-Ritz on the projection, wanted Ritz values first.
+		std::copy(projection.begin(), projection.end(), y.begin());
+		if (eigen_syev(m, y.data(), theta.data()) != 0)
+		{
+			return EIGEN_FAILED;
+		}
+
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](lapack_int a, lapack_int b) { return score(theta[a]) > score(theta[b]); });
+
+		converged = 0;
+		for (auto i = 0; i < m; ++i)
+		{
+			residual[i] = std::abs(beta * y[i * m + m - 1]);
+		}
+
+		for (auto i = 0; i < wanted; ++i)
+		{
+			const auto t = theta[order[i]];
+			if (residual[order[i]] <= tolerance * std::max(std::abs(t), smallest)) ++converged;
+		}
+
+		auto grow = false;
+		if (converged == wanted)
+		{
+			if (which != EIGEN_INTERVAL || wanted == n)
+			{
+				break;
+			}
+
+			// Covered once the farthest of the nearest eigenvalues lies outside the interval.
+			const auto farthest = std::abs(theta[order[wanted - 1]]);
+			if (farthest * radius < 1)
+			{
+				break;
+			}
+
+			if (wanted == most)
+			{
+				info = EIGEN_INTERVAL_FULL;
+				break;
+			}
+
+			grow = true;
+		}
+
+		if (*restarts == max_restarts)
+		{
+			info = EIGEN_RESTART_LIMIT;
+			break;
+		}
+
+		// Thick restart: keep the wanted Ritz vectors, some more while few
+		// have converged, and the residual direction as the next column.
+		keep = std::min(m - 1, wanted + std::min(converged, (m - wanted) / 2));
+		ritz.resize(static_cast<size_t>(n) * keep);
+		std::vector<T> kept(static_cast<size_t>(m) * keep);
+		for (auto i = 0; i < keep; ++i)
+		{
+			for (auto r = 0; r < m; ++r)
+			{
+				kept[i * m + r] = T(y[order[i] * m + r]);
+			}
+		}
+
+		gemm(CblasNoTrans, CblasNoTrans, n, keep, m, T(1), v.data(), n, kept.data(), m, T(0), ritz.data(), n);
+		std::copy(ritz.begin(), ritz.end(), v.begin());
+		std::copy(v.begin() + static_cast<size_t>(m) * n, v.begin() + static_cast<size_t>(m + 1) * n, v.begin() + static_cast<size_t>(keep) * n);
+
+		std::vector<R> kept_theta(keep), arrow(keep);
+		for (auto i = 0; i < keep; ++i)
+		{
+			kept_theta[i] = theta[order[i]];
+			arrow[i] = beta * y[order[i] * m + m - 1];
+		}
+
+		if (grow)
+		{
+			wanted = std::min(most, 2 * wanted);
+			m = basis_size(wanted);
+			v.resize(static_cast<size_t>(n) * (m + 1));
+			h.resize(m + 1);
+			c.resize(m + 1);
+			y.resize(m * m);
+			theta.resize(m);
+			residual.resize(m);
+			order.resize(m);
+		}
+
+		projection.assign(m * m, R(0));
+		for (auto i = 0; i < keep; ++i)
+		{
+			projection[i * m + i] = kept_theta[i];
+			projection[keep * m + i] = arrow[i];
+			projection[i * m + keep] = arrow[i];
+		}
+
+		++*restarts;
+	}
+
+	// Converged wanted pairs, in the interval for 3, by ascending eigenvalue.
+	std::vector<lapack_int> selected;
+	for (auto i = 0; i < wanted; ++i)
+	{
+		const auto index = order[i];
+		if (residual[index] > tolerance * std::max(std::abs(theta[index]), smallest)) continue;
+		const auto lambda = shift_invert ? sigma + 1 / theta[index] : theta[index];
+		if (which == EIGEN_INTERVAL && (lambda < lower || lambda > upper)) continue;
+		selected.push_back(index);
+	}
+
+	// order is nearest sigma first, so this keeps the k nearest when the interval holds more.
+	if (static_cast<lapack_int>(selected.size()) > k)
+	{
+		selected.resize(k);
+	}
+
+	auto eigenvalue = [&](lapack_int index) { return shift_invert ? sigma + 1 / theta[index] : theta[index]; };
+	std::sort(selected.begin(), selected.end(), [&](lapack_int a, lapack_int b) { return eigenvalue(a) < eigenvalue(b); });
+
+	const auto count = static_cast<lapack_int>(selected.size());
+	for (auto i = 0; i < count; ++i)
+	{
+		eigenvalues[i] = eigenvalue(selected[i]);
+	}
+
+	if (eigenvectors && count > 0)
+	{
+		std::vector<T> kept(static_cast<size_t>(m) * count);
+		for (auto i = 0; i < count; ++i)
+		{
+			for (auto r = 0; r < m; ++r)
+			{
+				kept[i * m + r] = T(y[selected[i] * m + r]);
+			}
+		}
+
+		gemm(CblasNoTrans, CblasNoTrans, n, count, m, T(1), v.data(), n, kept.data(), m, T(0), eigenvectors, n);
+	}
+
+	*found = count;
+	return info;
+}
+
+/*
+	Whether every pair returned under shift-invert meets the residual bound
+	on A described at the top; the eigenvectors are orthonormal.
+*/
+template<typename T>
+inline bool eigen_accurate(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	decltype(real_value(T())) sigma, decltype(real_value(T())) tolerance, const decltype(real_value(T()))* eigenvalues, const T eigenvectors[], lapack_int count)
+{
+	typedef decltype(real_value(T())) R;
+
+	const auto eps = std::numeric_limits<R>::epsilon();
+	const auto smallest = std::pow(eps, R(2) / R(3));
+	if (tolerance == 0) tolerance = eps;
+
+	R norm = 0;
+	for (auto i = 0; i < n; ++i)
+	{
+		R row = 0;
+		auto diagonal = T(-sigma);
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			if (col_idx[p] == i) diagonal += values[p];
+			else row += std::abs(values[p]);
+		}
+
+		norm = std::max(norm, row + std::abs(diagonal));
+	}
+
+	// A backward stable solve is still off by up to the condition number of
+	// A - sigma*I, about its norm over the distance to the nearest eigenvalue.
+	auto nearest = std::numeric_limits<R>::max();
+	for (auto j = 0; j < count; ++j)
+	{
+		nearest = std::min(nearest, std::abs(eigenvalues[j] - sigma));
+	}
+
+	for (auto j = 0; j < count; ++j)
+	{
+		const auto lambda = eigenvalues[j];
+		const auto* x = eigenvectors + static_cast<size_t>(j) * n;
+		R sum = 0;
+		for (auto i = 0; i < n; ++i)
+		{
+			auto ri = -lambda * x[i];
+			for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+			{
+				ri += values[p] * x[col_idx[p]];
+			}
+
+			sum += abs2(ri);
+		}
+
+		const auto condition = nearest > 0 ? norm / nearest : std::numeric_limits<R>::infinity();
+		if (!(std::sqrt(sum) <= 100 * tolerance * norm * std::max(condition, smallest * std::abs(lambda - sigma))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T>
+inline lapack_int sparse_eigen(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int which, lapack_int k, decltype(real_value(T())) sigma, decltype(real_value(T())) lower, decltype(real_value(T())) upper,
+	lapack_int subspace, lapack_int max_restarts, decltype(real_value(T())) tolerance,
+	decltype(real_value(T()))* eigenvalues, T eigenvectors[], lapack_int* found, lapack_int* restarts)
+{
+	*found = 0;
+	*restarts = 0;
+	if (n == 0 && which >= EIGEN_SMALLEST && which <= EIGEN_INTERVAL) return 0;
+
+	auto info = eigen_check(n, which, k, lower, upper, subspace, max_restarts, tolerance, 4);
+	if (info != 0) return info;
+
+	try
+	{
+		if (which == EIGEN_INTERVAL)
+		{
+			sigma = (lower + upper) / 2;
+		}
+
+		if (which == EIGEN_NEAREST || which == EIGEN_INTERVAL)
+		{
+			eigen_shift_invert<T> op(n, row_ptr, col_idx, values, sigma);
+			info = op.prepare();
+			if (info != 0) return info;
+
+			// The check needs the eigenvectors, also when the caller does not.
+			std::vector<T> vectors(eigenvectors ? 0 : static_cast<size_t>(n) * k);
+			auto* x = eigenvectors ? eigenvectors : vectors.data();
+			while (true)
+			{
+				info = eigen_lanczos(op, n, which, k, op.sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, x, found, restarts);
+				if (info == EIGEN_FAILED || eigen_accurate(n, row_ptr, col_idx, values, op.sigma, tolerance, eigenvalues, x, *found)) return info;
+				if (!op.pivot()) return EIGEN_FAILED;
+			}
+		}
+
+		eigen_csr<T> op(n, row_ptr, col_idx, values);
+		info = op.prepare();
+		return info != 0 ? info : eigen_lanczos(op, n, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int matrix_free_eigen(lapack_int n, eigen_callback<T> apply, void* user,
+	lapack_int which, lapack_int k, decltype(real_value(T())) sigma, decltype(real_value(T())) lower, decltype(real_value(T())) upper,
+	lapack_int subspace, lapack_int max_restarts, decltype(real_value(T())) tolerance,
+	decltype(real_value(T()))* eigenvalues, T eigenvectors[], lapack_int* found, lapack_int* restarts)
+{
+	*found = 0;
+	*restarts = 0;
+	if (!apply) return -2;
+	if (n == 0 && which >= EIGEN_SMALLEST && which <= EIGEN_INTERVAL) return 0;
+
+	auto info = eigen_check(n, which, k, lower, upper, subspace, max_restarts, tolerance, 3);
+	if (info != 0) return info;
+
+	try
+	{
+		if (which == EIGEN_INTERVAL)
+		{
+			sigma = (lower + upper) / 2;
+		}
+
+		eigen_callback_operator<T> op(apply, user);
+		return eigen_lanczos(op, n, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_eigen(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[],
+		lapack_int which, lapack_int k, float sigma, float lower, float upper, lapack_int subspace, lapack_int max_restarts, float tolerance,
+		float eigenvalues[], float eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return sparse_eigen(n, row_ptr, col_idx, values, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int d_sparse_eigen(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[],
+		lapack_int which, lapack_int k, double sigma, double lower, double upper, lapack_int subspace, lapack_int max_restarts, double tolerance,
+		double eigenvalues[], double eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return sparse_eigen(n, row_ptr, col_idx, values, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int c_sparse_eigen(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[],
+		lapack_int which, lapack_int k, float sigma, float lower, float upper, lapack_int subspace, lapack_int max_restarts, float tolerance,
+		float eigenvalues[], lapack_complex_float eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return sparse_eigen(n, row_ptr, col_idx, values, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int z_sparse_eigen(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[],
+		lapack_int which, lapack_int k, double sigma, double lower, double upper, lapack_int subspace, lapack_int max_restarts, double tolerance,
+		double eigenvalues[], lapack_complex_double eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return sparse_eigen(n, row_ptr, col_idx, values, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int s_matrix_free_eigen(lapack_int n, eigen_callback<float> apply, void* context,
+		lapack_int which, lapack_int k, float sigma, float lower, float upper, lapack_int subspace, lapack_int max_restarts, float tolerance,
+		float eigenvalues[], float eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return matrix_free_eigen(n, apply, context, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int d_matrix_free_eigen(lapack_int n, eigen_callback<double> apply, void* context,
+		lapack_int which, lapack_int k, double sigma, double lower, double upper, lapack_int subspace, lapack_int max_restarts, double tolerance,
+		double eigenvalues[], double eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return matrix_free_eigen(n, apply, context, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int c_matrix_free_eigen(lapack_int n, eigen_callback<lapack_complex_float> apply, void* context,
+		lapack_int which, lapack_int k, float sigma, float lower, float upper, lapack_int subspace, lapack_int max_restarts, float tolerance,
+		float eigenvalues[], lapack_complex_float eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return matrix_free_eigen(n, apply, context, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+
+	DLLEXPORT lapack_int z_matrix_free_eigen(lapack_int n, eigen_callback<lapack_complex_double> apply, void* context,
+		lapack_int which, lapack_int k, double sigma, double lower, double upper, lapack_int subspace, lapack_int max_restarts, double tolerance,
+		double eigenvalues[], lapack_complex_double eigenvectors[], lapack_int* found, lapack_int* restarts)
+	{
+		return matrix_free_eigen(n, apply, context, which, k, sigma, lower, upper, subspace, max_restarts, tolerance, eigenvalues, eigenvectors, found, restarts);
+	}
+}
@@ -0,0 +1,475 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "sparse_common.h"
+#include <cmath>
+#include <memory>
+
+/*
+	Zero fill-in incomplete factorizations of a square zero-based CSR matrix,
+	for use as preconditioners.
+
+	x_sparse_ilu0_create computes A ~ L*U on the pattern of A, with L unit
+	lower and U upper triangular stored together in that pattern.
+	x_sparse_ic0_create computes A ~ L*L^H on the lower triangle of a
+	symmetric (Hermitian) positive definite A; entries above the diagonal are
+	ignored. Rows of one level of the lower triangle do not depend on each
+	other, so the portable kernel factors them in parallel, level by level;
+	on MKL the double ILU(0) goes through dcsrilu0.
+
+	The handle keeps the factor and both triangles analysed for the native
+	triangular solves, so x_sparse_preconditioner_apply (x = inv(L*U)*b) and
+	the native Krylov solvers use it without another copy.
+	x_sparse_incomplete_export copies the factor out with sorted column
+	indices; nnz from create is its number of entries. Info is i + 1 if the
+	diagonal of row i is missing, or the pivot of row i is zero (ILU) or not
+	positive (IC).
+*/
+
+template<typename T>
+struct sparse_incomplete : sparse_preconditioner<T>
+{
+	lapack_int n;
+	std::vector<lapack_int> row_ptr, col_idx, diagonal;
+	std::vector<T> values, work;
+	sparse_triangular<T> lower, upper;
+
+	lapack_int apply(const T b[], T x[]) override
+	{
+		auto info = sparse_triangular_solve(lower, b, work.data());
+		return info == 0 ? sparse_triangular_solve(upper, work.data(), x) : info;
+	}
+};
+
+// Copies the rows of A with sorted columns, keeping only the lower triangle
+// for IC(0), and records the position of each diagonal.
+template<typename T>
+inline lapack_int incomplete_copy(sparse_incomplete<T>& f, bool lower_only,
+	const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+{
+	const auto n = f.n;
+	std::vector<std::pair<lapack_int, T>> row;
+
+	f.row_ptr.assign(n + 1, 0);
+	f.diagonal.assign(n, -1);
+	f.col_idx.reserve(row_ptr[n]);
+	f.values.reserve(row_ptr[n]);
+
+	for (auto i = 0; i < n; ++i)
+	{
+		row.clear();
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			if (!lower_only || col_idx[p] <= i)
+			{
+				row.emplace_back(col_idx[p], values[p]);
+			}
+		}
+
+		std::sort(row.begin(), row.end(), [](const std::pair<lapack_int, T>& a, const std::pair<lapack_int, T>& b) { return a.first < b.first; });
+
+		for (const auto& entry : row)
+		{
+			if (entry.first == i)
+			{
+				f.diagonal[i] = static_cast<lapack_int>(f.col_idx.size());
+			}
+
+			f.col_idx.push_back(entry.first);
+			f.values.push_back(entry.second);
+		}
+
+		f.row_ptr[i + 1] = static_cast<lapack_int>(f.col_idx.size());
+
+		if (f.diagonal[i] < 0)
+		{
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+// Row i of the ILU(0) factor. Rows are sorted, so the update of row i by
+// row k is a merge of the two column lists.
+template<typename T>
+inline lapack_int ilu0_row(sparse_incomplete<T>& f, lapack_int i)
+{
+	const auto* row_ptr = f.row_ptr.data();
+	const auto* col_idx = f.col_idx.data();
+	const auto* diagonal = f.diagonal.data();
+	auto* values = f.values.data();
+	const auto end = row_ptr[i + 1];
+
+	for (auto p = row_ptr[i]; p < diagonal[i]; ++p)
+	{
+		const auto k = col_idx[p];
+		const auto l = values[p] / values[diagonal[k]];
+		values[p] = l;
+
+		auto at = p + 1;
+		for (auto q = diagonal[k] + 1; q < row_ptr[k + 1] && at < end; ++q)
+		{
+			const auto j = col_idx[q];
+			while (at < end && col_idx[at] < j) ++at;
+			if (at < end && col_idx[at] == j)
+			{
+				values[at] -= l * values[q];
+			}
+		}
+	}
+
+	return values[diagonal[i]] == T(0) ? i + 1 : 0;
+}
+
+// Row i of the IC(0) factor, which holds only the lower triangle, so the
+// diagonal is the last entry of each row.
+template<typename T>
+inline lapack_int ic0_row(sparse_incomplete<T>& f, lapack_int i)
+{
+	const auto* row_ptr = f.row_ptr.data();
+	const auto* col_idx = f.col_idx.data();
+	const auto* diagonal = f.diagonal.data();
+	auto* values = f.values.data();
+
+	auto d = real_value(values[diagonal[i]]);
+	for (auto p = row_ptr[i]; p < diagonal[i]; ++p)
+	{
+		const auto k = col_idx[p];
+		auto sum = values[p];
+
+		auto at = row_ptr[i];
+		for (auto q = row_ptr[k]; q < diagonal[k] && at < p; ++q)
+		{
+			const auto j = col_idx[q];
+			while (at < p && col_idx[at] < j) ++at;
+			if (at < p && col_idx[at] == j)
+			{
+				sum -= values[at] * conj_value(values[q]);
+			}
+		}
+
+		sum /= values[diagonal[k]];
+		values[p] = sum;
+		d -= abs2(sum);
+	}
+
+	if (!(d > 0))
+	{
+		return i + 1;
+	}
+
+	values[diagonal[i]] = T(std::sqrt(d));
+	return 0;
+}
+
+// Factors f in place, level by level over the lower triangle. Returns the
+// first failing row + 1 of the first level that fails.
+template<typename T, typename Row>
+inline lapack_int incomplete_levels(sparse_incomplete<T>& f, Row factor_row)
+{
+	const auto n = f.n;
+	std::vector<lapack_int> level_ptr, rows;
+	sparse_levels(n, true, f.row_ptr.data(), f.col_idx.data(), level_ptr, rows);
+
+	std::vector<lapack_int> failed(parallel_chunk_count(n, SPARSE_LEVEL_GRAIN), 0);
+
+	const auto levels = static_cast<lapack_int>(level_ptr.size()) - 1;
+	for (auto l = 0; l < levels; ++l)
+	{
+		const auto begin = level_ptr[l];
+		const auto count = level_ptr[l + 1] - begin;
+		const auto chunks = count < 2 * SPARSE_LEVEL_GRAIN ? 1 : parallel_chunk_count(count, SPARSE_LEVEL_GRAIN);
+
+		auto body = [&](int chunk, int first, int last)
+		{
+			for (auto r = begin + first; r < begin + last; ++r)
+			{
+				const auto info = factor_row(f, rows[r]);
+				if (info != 0 && (failed[chunk] == 0 || info < failed[chunk]))
+				{
+					failed[chunk] = info;
+				}
+			}
+		};
+
+		if (chunks == 1)
+		{
+			body(0, 0, count);
+		}
+		else
+		{
+			parallel_for_chunks(count, chunks, body);
+		}
+
+		lapack_int info = 0;
+		for (auto c = 0; c < chunks; ++c)
+		{
+			if (failed[c] != 0 && (info == 0 || failed[c] < info))
+			{
+				info = failed[c];
+			}
+		}
+
+		if (info != 0)
+		{
+			return info;
+		}
+	}
+
+	return 0;
+}
+
+template<typename T>
+inline lapack_int ilu0_factor(sparse_incomplete<T>& f)
+{
+	return incomplete_levels(f, ilu0_row<T>);
+}
+
+#ifdef PROVIDER_MKL
+// dcsrilu0 takes one-based indices and sorted columns; if it stops on a
+// zero pivot the portable kernel reports the row.
+inline lapack_int ilu0_factor(sparse_incomplete<double>& f)
+{
+	const MKL_INT n = f.n;
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	std::vector<MKL_INT> row_ptr(f.row_ptr.begin(), f.row_ptr.end());
+	std::vector<MKL_INT> col_idx(f.col_idx.begin(), f.col_idx.end());
+	for (auto& p : row_ptr) ++p;
+	for (auto& j : col_idx) ++j;
+
+	std::vector<double> lu(f.values.size());
+	MKL_INT ipar[128] = { 0 };
+	double dpar[128] = { 0 };
+	MKL_INT ierr = 0;
+	dcsrilu0(&n, f.values.data(), row_ptr.data(), col_idx.data(), lu.data(), ipar, dpar, &ierr);
+
+	if (ierr != 0)
+	{
+		return incomplete_levels(f, ilu0_row<double>);
+	}
+
+	f.values.swap(lu);
+	return 0;
+}
+#endif
+
+template<typename T>
+inline lapack_int ic0_factor(sparse_incomplete<T>& f)
+{
+	return incomplete_levels(f, ic0_row<T>);
+}
+
+// Builds the triangular solves: L unit lower and U upper from the combined
+// ILU factor, or L and L^H from the IC factor.
+template<typename T>
+inline lapack_int incomplete_prepare(sparse_incomplete<T>& f, bool cholesky)
+{
+	const auto n = f.n;
+	f.work.resize(n);
+
+	auto info = sparse_triangular_prepare(f.lower, n, true, !cholesky, f.row_ptr.data(), f.col_idx.data(), f.values.data());
+	if (info != 0)
+	{
+		return info;
+	}
+
+	if (!cholesky)
+	{
+		return sparse_triangular_prepare(f.upper, n, false, false, f.row_ptr.data(), f.col_idx.data(), f.values.data());
+	}
+
+	const auto nnz = f.row_ptr[n];
+	std::vector<lapack_int> t_row_ptr(n + 1, 0), t_col_idx(nnz);
+	std::vector<T> t_values(nnz);
+
+	for (auto p = 0; p < nnz; ++p)
+	{
+		++t_row_ptr[f.col_idx[p] + 1];
+	}
+
+	for (auto j = 0; j < n; ++j)
+	{
+		t_row_ptr[j + 1] += t_row_ptr[j];
+	}
+
+	std::vector<lapack_int> next(t_row_ptr.begin(), t_row_ptr.end() - 1);
+	for (auto i = 0; i < n; ++i)
+	{
+		for (auto p = f.row_ptr[i]; p < f.row_ptr[i + 1]; ++p)
+		{
+			const auto at = next[f.col_idx[p]]++;
+			t_col_idx[at] = i;
+			t_values[at] = conj_value(f.values[p]);
+		}
+	}
+
+	return sparse_triangular_prepare(f.upper, n, false, false, t_row_ptr.data(), t_col_idx.data(), t_values.data());
+}
+
+template<typename T>
+inline lapack_int sparse_incomplete_create(void** handle, bool cholesky, lapack_int n,
+	const lapack_int row_ptr[], const lapack_int col_idx[], const T values[], lapack_int* nnz)
+{
+	*handle = nullptr;
+	*nnz = 0;
+
+	if (n < 0) return -2;
+
+	try
+	{
+		std::unique_ptr<sparse_incomplete<T>> f(new sparse_incomplete<T>());
+		f->n = n;
+
+		auto info = incomplete_copy(*f, cholesky, row_ptr, col_idx, values);
+		if (info == 0)
+		{
+			info = cholesky ? ic0_factor(*f) : ilu0_factor(*f);
+		}
+
+		if (info == 0)
+		{
+			info = incomplete_prepare(*f, cholesky);
+		}
+
+		if (info != 0)
+		{
+			return info;
+		}
+
+		*nnz = f->row_ptr[n];
+		*handle = static_cast<sparse_preconditioner<T>*>(f.release());
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int sparse_incomplete_export(void* handle, lapack_int row_ptr[], lapack_int col_idx[], T values[])
+{
+	const auto& f = *static_cast<sparse_incomplete<T>*>(static_cast<sparse_preconditioner<T>*>(handle));
+	std::copy(f.row_ptr.begin(), f.row_ptr.end(), row_ptr);
+	std::copy(f.col_idx.begin(), f.col_idx.end(), col_idx);
+	std::copy(f.values.begin(), f.values.end(), values);
+	return 0;
+}
+
+template<typename T>
+inline lapack_int sparse_preconditioner_free(void** handle)
+{
+	delete static_cast<sparse_preconditioner<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_ilu0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, false, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int d_sparse_ilu0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, false, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int c_sparse_ilu0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, false, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int z_sparse_ilu0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, false, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int s_sparse_ic0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, true, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int d_sparse_ic0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, true, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int c_sparse_ic0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, true, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int z_sparse_ic0_create(void** handle, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], lapack_int* nnz)
+	{
+		return sparse_incomplete_create(handle, true, n, row_ptr, col_idx, values, nnz);
+	}
+
+	DLLEXPORT lapack_int s_sparse_incomplete_export(void* handle, lapack_int row_ptr[], lapack_int col_idx[], float values[])
+	{
+		return sparse_incomplete_export(handle, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_incomplete_export(void* handle, lapack_int row_ptr[], lapack_int col_idx[], double values[])
+	{
+		return sparse_incomplete_export(handle, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_incomplete_export(void* handle, lapack_int row_ptr[], lapack_int col_idx[], lapack_complex_float values[])
+	{
+		return sparse_incomplete_export(handle, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_incomplete_export(void* handle, lapack_int row_ptr[], lapack_int col_idx[], lapack_complex_double values[])
+	{
+		return sparse_incomplete_export(handle, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int s_sparse_preconditioner_apply(void* handle, const float b[], float x[])
+	{
+		return static_cast<sparse_preconditioner<float>*>(handle)->apply(b, x);
+	}
+
+	DLLEXPORT lapack_int d_sparse_preconditioner_apply(void* handle, const double b[], double x[])
+	{
+		return static_cast<sparse_preconditioner<double>*>(handle)->apply(b, x);
+	}
+
+	DLLEXPORT lapack_int c_sparse_preconditioner_apply(void* handle, const lapack_complex_float b[], lapack_complex_float x[])
+	{
+		return static_cast<sparse_preconditioner<lapack_complex_float>*>(handle)->apply(b, x);
+	}
+
+	DLLEXPORT lapack_int z_sparse_preconditioner_apply(void* handle, const lapack_complex_double b[], lapack_complex_double x[])
+	{
+		return static_cast<sparse_preconditioner<lapack_complex_double>*>(handle)->apply(b, x);
+	}
+
+	DLLEXPORT lapack_int s_sparse_preconditioner_free(void** handle)
+	{
+		return sparse_preconditioner_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_sparse_preconditioner_free(void** handle)
+	{
+		return sparse_preconditioner_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_sparse_preconditioner_free(void** handle)
+	{
+		return sparse_preconditioner_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_sparse_preconditioner_free(void** handle)
+	{
+		return sparse_preconditioner_free<lapack_complex_double>(handle);
+	}
+}
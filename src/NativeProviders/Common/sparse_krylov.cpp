@@ -0,0 +1,973 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "sparse_common.h"
+#include <chrono>
+#include <cmath>
+
+/*
+	Krylov solvers for A*x = b with A a square zero-based CSR matrix, each
+	running the whole solve in one call: conjugate gradients for Hermitian
+	positive definite A, BiCGStab, and GMRES(restart) with classical
+	Gram-Schmidt and reorthogonalization, so each orthogonalization is two
+	passes over the basis rather than one per vector.
+
+	preconditioner is an optional handle from x_sparse_ilu0_create or
+	x_sparse_ic0_create (null for none); CG applies it as M^-1 on the
+	left, BiCGStab and GMRES on the right, so the monitored residual is
+	always ||b - A*x||. x holds the initial guess on entry. The solve stops
+	once that norm is at most max(tolerance * ||b||, absolute_tolerance), or
+	after max_iterations iterations (inner Arnoldi steps for GMRES, so the
+	residual recomputed at each restart is not counted).
+
+	All vectors are allocated before the first iteration. Vector updates are
+	fused with the reductions that follow them, and the portable SpMV with
+	the dot product of its result, over row chunks balanced by nonzeros; on
+	MKL the product is mkl_sparse_?_mv on a handle with an mv hint.
+
+	iterations receives the iterations done, residuals (optional, at least
+	max_iterations + 1 entries) the residual norm before the first and after
+	each iteration (the recurrence or GMRES estimate), and seconds the wall
+	time of the call. A converged recurrence is confirmed with the true
+	residual; if it drifted, the solve continues from the true residual.
+	Returns 0 when converged, 1 when the iteration limit was reached, 2 on
+	breakdown and 3 if the preconditioner or an MKL call failed.
+*/
+
+const int KRYLOV_CONVERGED = 0;
+const int KRYLOV_ITERATION_LIMIT = 1;
+const int KRYLOV_BREAKDOWN = 2;
+const int KRYLOV_FAILED = 3;
+
+// Row chunks shared by the operator and the vector kernels, with room for
+// per-chunk partial sums of up to width values.
+template<typename T>
+struct krylov_context
+{
+	lapack_int n;
+	int chunks, width;
+	std::vector<int> bounds;
+	std::vector<T> partial;
+
+	krylov_context(lapack_int n, const lapack_int row_ptr[], int width)
+		: n(n), width(width)
+	{
+		chunks = sparse_row_chunks(n, row_ptr, bounds);
+		partial.resize(chunks * width);
+	}
+
+	// Equal chunks, for operators without a sparsity pattern.
+	krylov_context(lapack_int n, int width)
+		: n(n), width(width)
+	{
+		chunks = std::max(1, parallel_chunk_count(n, SPARSE_PARALLEL_GRAIN));
+		bounds.resize(chunks + 1);
+		for (auto chunk = 0; chunk <= chunks; ++chunk)
+		{
+			bounds[chunk] = parallel_chunk_begin(n, chunks, chunk);
+		}
+
+		partial.resize(chunks * width);
+	}
+
+	// body(begin, end) over the rows of every chunk.
+	template<typename Body>
+	void run(Body body)
+	{
+		if (chunks == 1)
+		{
+			body(0, n);
+			return;
+		}
+
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			body(bounds[chunk], bounds[chunk + 1]);
+		});
+	}
+
+	// body(begin, end, acc) accumulates count sums into acc; result
+	// receives their totals, added up in chunk order.
+	template<typename Body>
+	void sums(int count, T result[], Body body)
+	{
+		auto* acc = partial.data();
+		auto chunk_body = [&](int chunk, int, int)
+		{
+			auto* out = acc + chunk * width;
+			std::fill(out, out + count, T(0));
+			body(bounds[chunk], bounds[chunk + 1], out);
+		};
+
+		if (chunks == 1)
+		{
+			chunk_body(0, 0, 0);
+		}
+		else
+		{
+			parallel_for_chunks(chunks, chunks, chunk_body);
+		}
+
+		std::fill(result, result + count, T(0));
+		for (auto chunk = 0; chunk < chunks; ++chunk)
+		{
+			for (auto i = 0; i < count; ++i)
+			{
+				result[i] += acc[chunk * width + i];
+			}
+		}
+	}
+
+	template<typename Body>
+	T sum(Body body)
+	{
+		T result;
+		sums(1, &result, [&](int begin, int end, T* acc) { *acc = body(begin, end); });
+		return result;
+	}
+
+	// conj(w)'*y
+	T dot(const T w[], const T y[])
+	{
+		return sum([=](int begin, int end)
+		{
+			auto s = T(0);
+			for (auto i = begin; i < end; ++i)
+			{
+				s += conj_value(w[i]) * y[i];
+			}
+
+			return s;
+		});
+	}
+};
+
+// y = A*x for a CSR matrix, optionally fused with conj(w)'*y.
+template<typename T>
+struct krylov_csr
+{
+	const lapack_int* row_ptr;
+	const lapack_int* col_idx;
+	const T* values;
+	krylov_context<T>& context;
+#ifdef PROVIDER_MKL
+	sparse_matrix_t handle;
+	matrix_descr descr;
+#endif
+
+	krylov_csr(krylov_context<T>& context, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+		: row_ptr(row_ptr), col_idx(col_idx), values(values), context(context)
+#ifdef PROVIDER_MKL
+		, handle(nullptr)
+#endif
+	{
+	}
+
+	~krylov_csr()
+	{
+#ifdef PROVIDER_MKL
+		if (handle) mkl_sparse_destroy(handle);
+#endif
+	}
+
+	krylov_csr(const krylov_csr&) = delete;
+	krylov_csr& operator=(const krylov_csr&) = delete;
+
+	lapack_int prepare(lapack_int expected_calls)
+	{
+#ifdef PROVIDER_MKL
+		// The handle only reads the caller's arrays.
+		const auto n = context.n;
+		descr.type = SPARSE_MATRIX_TYPE_GENERAL;
+		auto status = sparse_create_csr(&handle, n, n, const_cast<lapack_int*>(row_ptr), const_cast<lapack_int*>(col_idx), const_cast<T*>(values));
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_set_mv_hint(handle, SPARSE_OPERATION_NON_TRANSPOSE, descr, std::max(expected_calls, 1));
+		}
+
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_optimize(handle);
+		}
+
+		return status == SPARSE_STATUS_SUCCESS ? 0 : KRYLOV_FAILED;
+#else
+		// Only the MKL handle uses the hint.
+		(void)expected_calls;
+		return 0;
+#endif
+	}
+
+	lapack_int multiply(const T x[], T y[])
+	{
+		T dot;
+		return multiply_dot(nullptr, x, y, dot);
+	}
+
+	lapack_int multiply_dot(const T w[], const T x[], T y[], T& dot)
+	{
+#ifdef PROVIDER_MKL
+		if (sparse_mv(handle, descr, x, y) != SPARSE_STATUS_SUCCESS)
+		{
+			return KRYLOV_FAILED;
+		}
+
+		dot = w ? context.dot(w, y) : T(0);
+#else
+		const auto* row_ptr = this->row_ptr;
+		const auto* col_idx = this->col_idx;
+		const auto* values = this->values;
+
+		dot = context.sum([=](int begin, int end)
+		{
+			auto s = T(0);
+			for (auto i = begin; i < end; ++i)
+			{
+				auto yi = T(0);
+				for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+				{
+					yi += values[p] * x[col_idx[p]];
+				}
+
+				y[i] = yi;
+				if (w) s += conj_value(w[i]) * yi;
+			}
+
+			return s;
+		});
+#endif
+		return 0;
+	}
+};
+
+// Iteration count and residual history against the stopping target.
+template<typename R>
+struct krylov_monitor
+{
+	R target;
+	lapack_int max_iterations, iterations;
+	R* residuals;
+
+	bool record(R norm)
+	{
+		if (residuals) residuals[iterations] = norm;
+		return norm <= target;
+	}
+
+	bool exhausted() const
+	{
+		return iterations >= max_iterations;
+	}
+};
+
+// z = inv(M)*r; callers skip it, and use r itself, without a preconditioner.
+template<typename T>
+inline lapack_int krylov_precondition(sparse_preconditioner<T>* m, const T r[], T z[])
+{
+	return m->apply(r, z) == 0 ? 0 : KRYLOV_FAILED;
+}
+
+// r = b - A*x; returns ||r||^2 through norm2.
+template<typename T, typename Op>
+inline lapack_int krylov_residual(Op& a, krylov_context<T>& c, const T b[], const T x[], T r[], T& norm2)
+{
+	auto info = a.multiply(x, r);
+	if (info != 0)
+	{
+		return info;
+	}
+
+	norm2 = c.sum([=](int begin, int end)
+	{
+		auto s = T(0);
+		for (auto i = begin; i < end; ++i)
+		{
+			r[i] = b[i] - r[i];
+			s += abs2(r[i]);
+		}
+
+		return s;
+	});
+
+	return 0;
+}
+
+template<typename T, typename Op>
+inline lapack_int krylov_cg(Op& a, krylov_context<T>& c, sparse_preconditioner<T>* m, const T b[], T x[],
+	krylov_monitor<decltype(real_value(T()))>& monitor)
+{
+	const auto n = c.n;
+	std::vector<T> r(n), p(n), q(n), z(m ? n : 0);
+	auto* rp = r.data();
+	auto* pp = p.data();
+	auto* qp = q.data();
+	auto* zp = m ? z.data() : rp;
+
+	T rr;
+	auto info = krylov_residual(a, c, b, x, rp, rr);
+	if (info != 0) return info;
+	if (monitor.record(std::sqrt(real_value(rr)))) return KRYLOV_CONVERGED;
+
+	if (m && (info = krylov_precondition(m, rp, zp)) != 0) return info;
+	auto rz = m ? c.dot(rp, zp) : rr;
+	c.run([=](int begin, int end) { std::copy(zp + begin, zp + end, pp + begin); });
+
+	while (!monitor.exhausted())
+	{
+		T pq;
+		if ((info = a.multiply_dot(pp, pp, qp, pq)) != 0) return info;
+		if (pq == T(0)) return KRYLOV_BREAKDOWN;
+
+		const auto alpha = rz / pq;
+		rr = c.sum([=](int begin, int end)
+		{
+			auto s = T(0);
+			for (auto i = begin; i < end; ++i)
+			{
+				x[i] += alpha * pp[i];
+				rp[i] -= alpha * qp[i];
+				s += abs2(rp[i]);
+			}
+
+			return s;
+		});
+
+		++monitor.iterations;
+		if (monitor.record(std::sqrt(real_value(rr))))
+		{
+			// Confirm with the true residual and carry on from it if the recurrence drifted.
+			if ((info = krylov_residual(a, c, b, x, rp, rr)) != 0) return info;
+			if (monitor.record(std::sqrt(real_value(rr)))) return KRYLOV_CONVERGED;
+		}
+
+		if (m && (info = krylov_precondition(m, rp, zp)) != 0) return info;
+		const auto rz_next = m ? c.dot(rp, zp) : rr;
+		if (rz == T(0)) return KRYLOV_BREAKDOWN;
+
+		const auto beta = rz_next / rz;
+		rz = rz_next;
+		c.run([=](int begin, int end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				pp[i] = zp[i] + beta * pp[i];
+			}
+		});
+	}
+
+	return KRYLOV_ITERATION_LIMIT;
+}
+
+template<typename T, typename Op>
+inline lapack_int krylov_bicgstab(Op& a, krylov_context<T>& c, sparse_preconditioner<T>* m, const T b[], T x[],
+	krylov_monitor<decltype(real_value(T()))>& monitor)
+{
+	const auto n = c.n;
+	std::vector<T> r(n), r0(n), p(n), v(n), s(n), t(n), ph(m ? n : 0), sh(m ? n : 0);
+	auto* rp = r.data();
+	auto* r0p = r0.data();
+	auto* pp = p.data();
+	auto* vp = v.data();
+	auto* sp = s.data();
+	auto* tp = t.data();
+	auto* php = m ? ph.data() : pp;
+	auto* shp = m ? sh.data() : sp;
+
+	T rr;
+	auto info = krylov_residual(a, c, b, x, rp, rr);
+	if (info != 0) return info;
+	if (monitor.record(std::sqrt(real_value(rr)))) return KRYLOV_CONVERGED;
+
+	// Starts over from the current residual, also when the recurrence drifted.
+	auto rho = T(1), alpha = T(1), omega = T(1);
+	auto restart = [&]()
+	{
+		c.run([=](int begin, int end)
+		{
+			std::copy(rp + begin, rp + end, r0p + begin);
+			std::fill(pp + begin, pp + end, T(0));
+			std::fill(vp + begin, vp + end, T(0));
+		});
+
+		rho = alpha = omega = T(1);
+	};
+
+	restart();
+
+	while (!monitor.exhausted())
+	{
+		const auto rho_next = c.dot(r0p, rp);
+		if (rho_next == T(0)) return KRYLOV_BREAKDOWN;
+
+		const auto beta = (rho_next / rho) * (alpha / omega);
+		rho = rho_next;
+		c.run([=](int begin, int end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				pp[i] = rp[i] + beta * (pp[i] - omega * vp[i]);
+			}
+		});
+
+		if (m && (info = krylov_precondition(m, pp, php)) != 0) return info;
+
+		T r0v;
+		if ((info = a.multiply_dot(r0p, php, vp, r0v)) != 0) return info;
+		if (r0v == T(0)) return KRYLOV_BREAKDOWN;
+
+		alpha = rho / r0v;
+		const auto ss = c.sum([=](int begin, int end)
+		{
+			auto sum = T(0);
+			for (auto i = begin; i < end; ++i)
+			{
+				sp[i] = rp[i] - alpha * vp[i];
+				sum += abs2(sp[i]);
+			}
+
+			return sum;
+		});
+
+		++monitor.iterations;
+		if (monitor.record(std::sqrt(real_value(ss))))
+		{
+			c.run([=](int begin, int end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					x[i] += alpha * php[i];
+				}
+			});
+
+			if ((info = krylov_residual(a, c, b, x, rp, rr)) != 0) return info;
+			if (monitor.record(std::sqrt(real_value(rr)))) return KRYLOV_CONVERGED;
+			restart();
+			continue;
+		}
+
+		if (m && (info = krylov_precondition(m, sp, shp)) != 0) return info;
+		if ((info = a.multiply(shp, tp)) != 0) return info;
+
+		T ts_tt[2];
+		c.sums(2, ts_tt, [=](int begin, int end, T* acc)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				acc[0] += conj_value(tp[i]) * sp[i];
+				acc[1] += abs2(tp[i]);
+			}
+		});
+
+		if (ts_tt[1] == T(0)) return KRYLOV_BREAKDOWN;
+		omega = ts_tt[0] / ts_tt[1];
+
+		rr = c.sum([=](int begin, int end)
+		{
+			auto sum = T(0);
+			for (auto i = begin; i < end; ++i)
+			{
+				x[i] += alpha * php[i] + omega * shp[i];
+				rp[i] = sp[i] - omega * tp[i];
+				sum += abs2(rp[i]);
+			}
+
+			return sum;
+		});
+
+		if (monitor.record(std::sqrt(real_value(rr))))
+		{
+			if ((info = krylov_residual(a, c, b, x, rp, rr)) != 0) return info;
+			if (monitor.record(std::sqrt(real_value(rr)))) return KRYLOV_CONVERGED;
+			restart();
+			continue;
+		}
+
+		if (omega == T(0)) return KRYLOV_BREAKDOWN;
+	}
+
+	return KRYLOV_ITERATION_LIMIT;
+}
+
+template<typename T, typename Op>
+inline lapack_int krylov_gmres(Op& a, krylov_context<T>& c, sparse_preconditioner<T>* m, lapack_int restart, const T b[], T x[],
+	krylov_monitor<decltype(real_value(T()))>& monitor)
+{
+	typedef decltype(real_value(T())) R;
+	const auto n = c.n;
+	const auto ld = restart + 1;
+	std::vector<T> basis(static_cast<size_t>(ld) * n), w(n), z(m ? n : 0);
+	std::vector<T> hessenberg(static_cast<size_t>(ld) * restart), g(ld), h(ld), sines(restart);
+	std::vector<R> cosines(restart);
+	auto* vp = basis.data();
+	auto* wp = w.data();
+	auto* zp = z.data();
+	auto* hp = h.data();
+
+	// Each cycle starts from the true residual, which also confirms the
+	// estimate the previous cycle stopped on.
+	for (;;)
+	{
+		T rr;
+		auto info = krylov_residual(a, c, b, x, vp, rr);
+		if (info != 0) return info;
+
+		const auto beta = std::sqrt(real_value(rr));
+		if (monitor.record(beta)) return KRYLOV_CONVERGED;
+		if (monitor.exhausted()) return KRYLOV_ITERATION_LIMIT;
+
+		const auto scale = T(1) / T(beta);
+		c.run([=](int begin, int end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				vp[i] *= scale;
+			}
+		});
+
+		std::fill(g.begin(), g.end(), T(0));
+		g[0] = T(beta);
+
+		auto converged = false;
+		auto columns = 0;
+		R norm = 0;
+		for (auto j = 0; j < restart; ++j)
+		{
+			const auto* vj = vp + static_cast<size_t>(j) * n;
+			if (m && (info = krylov_precondition(m, vj, zp)) != 0) return info;
+			if ((info = a.multiply(m ? zp : vj, wp)) != 0) return info;
+
+			// Classical Gram-Schmidt, twice.
+			auto* column = hessenberg.data() + static_cast<size_t>(j) * ld;
+			std::fill(column, column + j + 2, T(0));
+			for (auto pass = 0; pass < 2; ++pass)
+			{
+				c.sums(j + 1, hp, [=](int begin, int end, T* acc)
+				{
+					for (auto k = 0; k <= j; ++k)
+					{
+						const auto* vk = vp + static_cast<size_t>(k) * n;
+						auto sum = T(0);
+						for (auto i = begin; i < end; ++i)
+						{
+							sum += conj_value(vk[i]) * wp[i];
+						}
+
+						acc[k] = sum;
+					}
+				});
+
+				const auto ww = c.sum([=](int begin, int end)
+				{
+					auto sum = T(0);
+					for (auto i = begin; i < end; ++i)
+					{
+						auto wi = wp[i];
+						for (auto k = 0; k <= j; ++k)
+						{
+							wi -= hp[k] * vp[static_cast<size_t>(k) * n + i];
+						}
+
+						wp[i] = wi;
+						sum += abs2(wi);
+					}
+
+					return sum;
+				});
+
+				for (auto k = 0; k <= j; ++k)
+				{
+					column[k] += hp[k];
+				}
+
+				norm = std::sqrt(real_value(ww));
+			}
+
+			column[j + 1] = T(norm);
+
+			for (auto k = 0; k < j; ++k)
+			{
+				const auto upper = column[k];
+				column[k] = cosines[k] * upper + sines[k] * column[k + 1];
+				column[k + 1] = -conj_value(sines[k]) * upper + cosines[k] * column[k + 1];
+			}
+
+			const auto diagonal_abs = std::abs(column[j]);
+			const auto radius = std::sqrt(abs2(column[j]) + abs2(column[j + 1]));
+			if (radius == R(0)) return KRYLOV_BREAKDOWN;
+
+			const auto phase = diagonal_abs == R(0) ? T(1) : column[j] / T(diagonal_abs);
+			cosines[j] = diagonal_abs / radius;
+			sines[j] = phase * conj_value(column[j + 1]) / T(radius);
+			column[j] = phase * T(radius);
+			column[j + 1] = T(0);
+
+			g[j + 1] = -conj_value(sines[j]) * g[j];
+			g[j] = cosines[j] * g[j];
+
+			columns = j + 1;
+			++monitor.iterations;
+			converged = monitor.record(std::abs(g[j + 1]));
+			if (converged || monitor.exhausted() || norm == R(0))
+			{
+				break;
+			}
+
+			auto* next = vp + static_cast<size_t>(j + 1) * n;
+			const auto inverse = T(1) / T(norm);
+			c.run([=](int begin, int end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					next[i] = wp[i] * inverse;
+				}
+			});
+		}
+
+		// Solve the triangular least-squares system and update x = x + inv(M)*V*y.
+		for (auto k = columns - 1; k >= 0; --k)
+		{
+			auto sum = g[k];
+			for (auto l = k + 1; l < columns; ++l)
+			{
+				sum -= hessenberg[static_cast<size_t>(l) * ld + k] * hp[l];
+			}
+
+			const auto diagonal = hessenberg[static_cast<size_t>(k) * ld + k];
+			if (diagonal == T(0)) return KRYLOV_BREAKDOWN;
+			hp[k] = sum / diagonal;
+		}
+
+		c.run([=](int begin, int end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				auto sum = T(0);
+				for (auto k = 0; k < columns; ++k)
+				{
+					sum += hp[k] * vp[static_cast<size_t>(k) * n + i];
+				}
+
+				wp[i] = sum;
+			}
+		});
+
+		if (m && (info = krylov_precondition(m, wp, zp)) != 0) return info;
+		const auto* update = m ? zp : wp;
+		c.run([=](int begin, int end)
+		{
+			for (auto i = begin; i < end; ++i)
+			{
+				x[i] += update[i];
+			}
+		});
+
+		if (!converged && norm == R(0)) return KRYLOV_BREAKDOWN;
+	}
+}
+
+const int KRYLOV_CG = 0;
+const int KRYLOV_BICGSTAB = 1;
+const int KRYLOV_GMRES = 2;
+
+template<typename T, typename Op>
+inline lapack_int krylov_run(int method, Op& a, krylov_context<T>& context, sparse_preconditioner<T>* m, const T b[], T x[],
+	lapack_int max_iterations, lapack_int restart, decltype(real_value(T())) tolerance, decltype(real_value(T())) absolute_tolerance,
+	lapack_int* iterations, decltype(real_value(T()))* residuals)
+{
+	krylov_monitor<decltype(real_value(T()))> monitor;
+	monitor.max_iterations = max_iterations;
+	monitor.iterations = 0;
+	monitor.residuals = residuals;
+	monitor.target = std::max(tolerance * std::sqrt(real_value(context.dot(b, b))), absolute_tolerance);
+
+	lapack_int info;
+	switch (method)
+	{
+	case KRYLOV_CG:
+		info = krylov_cg(a, context, m, b, x, monitor);
+		break;
+	case KRYLOV_BICGSTAB:
+		info = krylov_bicgstab(a, context, m, b, x, monitor);
+		break;
+	default:
+		info = krylov_gmres(a, context, m, restart, b, x, monitor);
+		break;
+	}
+
+	*iterations = monitor.iterations;
+	return info;
+}
+
+template<typename T>
+inline lapack_int sparse_krylov(int method, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	void* preconditioner, const T b[], T x[], lapack_int max_iterations, lapack_int restart,
+	decltype(real_value(T())) tolerance, decltype(real_value(T())) absolute_tolerance,
+	lapack_int* iterations, decltype(real_value(T()))* residuals, double* seconds)
+{
+	const auto start = std::chrono::steady_clock::now();
+	*iterations = 0;
+	if (seconds) *seconds = 0;
+
+	if (n < 0) return -1;
+	if (max_iterations < 0) return -8;
+	if (method == KRYLOV_GMRES && restart < 1) return -9;
+
+	try
+	{
+		krylov_context<T> context(n, row_ptr, method == KRYLOV_GMRES ? restart + 1 : 2);
+		krylov_csr<T> a(context, row_ptr, col_idx, values);
+		auto info = a.prepare(max_iterations + 1);
+		if (info == 0)
+		{
+			info = krylov_run(method, a, context, static_cast<sparse_preconditioner<T>*>(preconditioner), b, x,
+				max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals);
+		}
+
+		if (seconds) *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+/*
+	Matrix-free variants, x_matrix_free_cg/bicgstab/gmres: the caller
+	supplies y = A*x, and optionally z = inv(M)*r, as callbacks that get the
+	user context and arrays of n entries. This is the same split as MKL's
+	reverse communication (RCI) dcg and dfgmres, but the solver calls out
+	rather than returning to the caller for every step. Callbacks run one at
+	a time on the calling thread; a nonzero return stops the solve with 3.
+	Vector work is split into equal chunks.
+*/
+template<typename T>
+using krylov_callback = lapack_int (*)(void* context, const T x[], T y[]);
+
+template<typename T>
+struct krylov_callback_operator
+{
+	krylov_callback<T> callback;
+	void* user;
+	krylov_context<T>& context;
+
+	krylov_callback_operator(krylov_context<T>& context, krylov_callback<T> callback, void* user)
+		: callback(callback), user(user), context(context)
+	{
+	}
+
+	lapack_int multiply(const T x[], T y[])
+	{
+		return callback(user, x, y) == 0 ? 0 : KRYLOV_FAILED;
+	}
+
+	lapack_int multiply_dot(const T w[], const T x[], T y[], T& dot)
+	{
+		if (callback(user, x, y) != 0)
+		{
+			return KRYLOV_FAILED;
+		}
+
+		dot = context.dot(w, y);
+		return 0;
+	}
+};
+
+template<typename T>
+struct krylov_callback_preconditioner : sparse_preconditioner<T>
+{
+	krylov_callback<T> callback;
+	void* user;
+
+	krylov_callback_preconditioner(krylov_callback<T> callback, void* user)
+		: callback(callback), user(user)
+	{
+	}
+
+	lapack_int apply(const T b[], T x[]) override
+	{
+		return callback(user, b, x);
+	}
+};
+
+template<typename T>
+inline lapack_int matrix_free_krylov(int method, lapack_int n, krylov_callback<T> multiply, krylov_callback<T> precondition, void* user,
+	const T b[], T x[], lapack_int max_iterations, lapack_int restart,
+	decltype(real_value(T())) tolerance, decltype(real_value(T())) absolute_tolerance,
+	lapack_int* iterations, decltype(real_value(T()))* residuals, double* seconds)
+{
+	const auto start = std::chrono::steady_clock::now();
+	*iterations = 0;
+	if (seconds) *seconds = 0;
+
+	if (n < 0) return -1;
+	if (!multiply) return -2;
+	if (max_iterations < 0) return -7;
+	if (method == KRYLOV_GMRES && restart < 1) return -8;
+
+	try
+	{
+		krylov_context<T> context(n, method == KRYLOV_GMRES ? restart + 1 : 2);
+		krylov_callback_operator<T> a(context, multiply, user);
+		krylov_callback_preconditioner<T> m(precondition, user);
+
+		auto info = krylov_run(method, a, context, precondition ? &m : nullptr, b, x,
+			max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals);
+
+		if (seconds) *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_cg(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], void* preconditioner, const float b[], float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_CG, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_sparse_cg(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], void* preconditioner, const double b[], double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_CG, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_sparse_cg(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], void* preconditioner, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_CG, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_sparse_cg(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], void* preconditioner, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_CG, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int s_sparse_bicgstab(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], void* preconditioner, const float b[], float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_BICGSTAB, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_sparse_bicgstab(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], void* preconditioner, const double b[], double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_BICGSTAB, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_sparse_bicgstab(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], void* preconditioner, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_BICGSTAB, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_sparse_bicgstab(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], void* preconditioner, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_BICGSTAB, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int s_sparse_gmres(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], void* preconditioner, const float b[], float x[],
+		lapack_int max_iterations, lapack_int restart, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_GMRES, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_sparse_gmres(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], void* preconditioner, const double b[], double x[],
+		lapack_int max_iterations, lapack_int restart, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_GMRES, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_sparse_gmres(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], void* preconditioner, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, lapack_int restart, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_GMRES, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_sparse_gmres(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], void* preconditioner, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, lapack_int restart, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return sparse_krylov(KRYLOV_GMRES, n, row_ptr, col_idx, values, preconditioner, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int s_matrix_free_cg(lapack_int n, krylov_callback<float> multiply, krylov_callback<float> precondition, void* context, const float b[], float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_CG, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_matrix_free_cg(lapack_int n, krylov_callback<double> multiply, krylov_callback<double> precondition, void* context, const double b[], double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_CG, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_matrix_free_cg(lapack_int n, krylov_callback<lapack_complex_float> multiply, krylov_callback<lapack_complex_float> precondition, void* context, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_CG, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_matrix_free_cg(lapack_int n, krylov_callback<lapack_complex_double> multiply, krylov_callback<lapack_complex_double> precondition, void* context, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_CG, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int s_matrix_free_bicgstab(lapack_int n, krylov_callback<float> multiply, krylov_callback<float> precondition, void* context, const float b[], float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_BICGSTAB, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_matrix_free_bicgstab(lapack_int n, krylov_callback<double> multiply, krylov_callback<double> precondition, void* context, const double b[], double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_BICGSTAB, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_matrix_free_bicgstab(lapack_int n, krylov_callback<lapack_complex_float> multiply, krylov_callback<lapack_complex_float> precondition, void* context, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_BICGSTAB, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_matrix_free_bicgstab(lapack_int n, krylov_callback<lapack_complex_double> multiply, krylov_callback<lapack_complex_double> precondition, void* context, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_BICGSTAB, n, multiply, precondition, context, b, x, max_iterations, 0, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int s_matrix_free_gmres(lapack_int n, krylov_callback<float> multiply, krylov_callback<float> precondition, void* context, const float b[], float x[],
+		lapack_int max_iterations, lapack_int restart, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_GMRES, n, multiply, precondition, context, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int d_matrix_free_gmres(lapack_int n, krylov_callback<double> multiply, krylov_callback<double> precondition, void* context, const double b[], double x[],
+		lapack_int max_iterations, lapack_int restart, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_GMRES, n, multiply, precondition, context, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int c_matrix_free_gmres(lapack_int n, krylov_callback<lapack_complex_float> multiply, krylov_callback<lapack_complex_float> precondition, void* context, const lapack_complex_float b[], lapack_complex_float x[],
+		lapack_int max_iterations, lapack_int restart, float tolerance, float absolute_tolerance, lapack_int* iterations, float residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_GMRES, n, multiply, precondition, context, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+
+	DLLEXPORT lapack_int z_matrix_free_gmres(lapack_int n, krylov_callback<lapack_complex_double> multiply, krylov_callback<lapack_complex_double> precondition, void* context, const lapack_complex_double b[], lapack_complex_double x[],
+		lapack_int max_iterations, lapack_int restart, double tolerance, double absolute_tolerance, lapack_int* iterations, double residuals[], double* seconds)
+	{
+		return matrix_free_krylov(KRYLOV_GMRES, n, multiply, precondition, context, b, x, max_iterations, restart, tolerance, absolute_tolerance, iterations, residuals, seconds);
+	}
+}
@@ -0,0 +1,651 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "sparse_common.h"
+#include <cmath>
+
+/*
+	Symmetric reorderings of a square zero-based CSR pattern, computed on
+	the graph of A + A^T without the diagonal, so only the structure is read:
+
+	- sparse_reorder_rcm: reverse Cuthill-McKee from a pseudo-peripheral
+	  node of each connected component, to reduce bandwidth and improve the
+	  locality of SpMV.
+	- sparse_reorder_amd: approximate minimum degree on the quotient graph,
+	  with element absorption and the AMD external degree bound; rows
+	  denser than 10*sqrt(n) are ordered last.
+	- sparse_reorder_nested_dissection: recursive bisection by vertex
+	  separators from the middle level of a pseudo-peripheral level
+	  structure, trimmed to the nodes that touch the far side, with the
+	  separators ordered last and small parts ordered by minimum degree.
+	  This is METIS_NodeND in shape, without the multilevel refinement.
+
+	perm[k] receives the row that goes to position k and, if not null,
+	inverse[i] the position of row i, so B = A(perm, perm) in either
+	convention; MKL DSS/PARDISO user orderings take inverse.
+	x_sparse_permute forms B with sorted columns.
+*/
+
+// Adjacency of A + A^T without the diagonal, duplicates removed.
+struct ordering_graph
+{
+	lapack_int n;
+	std::vector<lapack_int> ptr, adj;
+
+	lapack_int degree(lapack_int i) const
+	{
+		return ptr[i + 1] - ptr[i];
+	}
+};
+
+inline lapack_int ordering_graph_build(ordering_graph& g, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[])
+{
+	g.n = n;
+	std::vector<lapack_int> count(n + 1, 0);
+	for (auto i = 0; i < n; ++i)
+	{
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			if (j < 0 || j >= n) return -3;
+			if (j != i)
+			{
+				++count[i + 1];
+				++count[j + 1];
+			}
+		}
+	}
+
+	for (auto i = 0; i < n; ++i)
+	{
+		count[i + 1] += count[i];
+	}
+
+	std::vector<lapack_int> raw(count[n]);
+	std::vector<lapack_int> next(count.begin(), count.end() - 1);
+	for (auto i = 0; i < n; ++i)
+	{
+		for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+		{
+			const auto j = col_idx[p];
+			if (j != i)
+			{
+				raw[next[i]++] = j;
+				raw[next[j]++] = i;
+			}
+		}
+	}
+
+	std::vector<lapack_int> mark(n, -1);
+	g.ptr.assign(n + 1, 0);
+	g.adj.clear();
+	g.adj.reserve(raw.size());
+	for (auto i = 0; i < n; ++i)
+	{
+		mark[i] = i;
+		for (auto p = count[i]; p < count[i + 1]; ++p)
+		{
+			const auto j = raw[p];
+			if (mark[j] != i)
+			{
+				mark[j] = i;
+				g.adj.push_back(j);
+			}
+		}
+
+		g.ptr[i + 1] = static_cast<lapack_int>(g.adj.size());
+	}
+
+	return 0;
+}
+
+// Breadth-first level structure from root over the nodes with
+// inside[v] == id. nodes receives the nodes level by level and level_ptr
+// the offsets of the levels; level[] must be -1 on entry for those nodes
+// and is left holding their levels.
+inline void ordering_levels(const ordering_graph& g, lapack_int root, const std::vector<lapack_int>& inside, lapack_int id,
+	std::vector<lapack_int>& level, std::vector<lapack_int>& nodes, std::vector<lapack_int>& level_ptr)
+{
+	nodes.clear();
+	level_ptr.assign(1, 0);
+
+	nodes.push_back(root);
+	level[root] = 0;
+	size_t begin = 0;
+	lapack_int depth = 0;
+	while (begin < nodes.size())
+	{
+		const auto end = nodes.size();
+		for (auto k = begin; k < end; ++k)
+		{
+			const auto v = nodes[k];
+			for (auto p = g.ptr[v]; p < g.ptr[v + 1]; ++p)
+			{
+				const auto w = g.adj[p];
+				if (inside[w] == id && level[w] < 0)
+				{
+					level[w] = depth + 1;
+					nodes.push_back(w);
+				}
+			}
+		}
+
+		level_ptr.push_back(static_cast<lapack_int>(end));
+		begin = end;
+		++depth;
+	}
+}
+
+inline void ordering_levels_reset(const std::vector<lapack_int>& nodes, std::vector<lapack_int>& level)
+{
+	for (auto v : nodes)
+	{
+		level[v] = -1;
+	}
+}
+
+// George-Liu pseudo-peripheral node of the component of start; leaves the
+// level structure of the returned node in nodes/level_ptr/level.
+inline lapack_int ordering_peripheral(const ordering_graph& g, lapack_int start, const std::vector<lapack_int>& inside, lapack_int id,
+	std::vector<lapack_int>& level, std::vector<lapack_int>& nodes, std::vector<lapack_int>& level_ptr)
+{
+	ordering_levels(g, start, inside, id, level, nodes, level_ptr);
+
+	for (;;)
+	{
+		const auto depth = level_ptr.size();
+		const auto last = level_ptr[depth - 2];
+		auto candidate = nodes[last];
+		for (auto k = last + 1; k < level_ptr[depth - 1]; ++k)
+		{
+			if (g.degree(nodes[k]) < g.degree(candidate)) candidate = nodes[k];
+		}
+
+		ordering_levels_reset(nodes, level);
+		ordering_levels(g, candidate, inside, id, level, nodes, level_ptr);
+		if (level_ptr.size() <= depth)
+		{
+			return candidate;
+		}
+	}
+}
+
+inline void ordering_rcm(const ordering_graph& g, lapack_int perm[])
+{
+	const auto n = g.n;
+	std::vector<lapack_int> inside(n, 0), level(n, -1), nodes, level_ptr;
+	std::vector<char> placed(n, 0);
+	lapack_int position = 0;
+
+	for (auto start = 0; start < n; ++start)
+	{
+		if (placed[start]) continue;
+
+		const auto root = ordering_peripheral(g, start, inside, 0, level, nodes, level_ptr);
+		ordering_levels_reset(nodes, level);
+
+		// Cuthill-McKee: neighbours in order of increasing degree.
+		const auto first = position;
+		perm[position++] = root;
+		placed[root] = 1;
+		for (auto k = first; k < position; ++k)
+		{
+			const auto v = perm[k];
+			const auto begin = position;
+			for (auto p = g.ptr[v]; p < g.ptr[v + 1]; ++p)
+			{
+				const auto w = g.adj[p];
+				if (!placed[w])
+				{
+					placed[w] = 1;
+					perm[position++] = w;
+				}
+			}
+
+			std::stable_sort(perm + begin, perm + position, [&](lapack_int a, lapack_int b) { return g.degree(a) < g.degree(b); });
+		}
+
+		// Components stay apart, so only mark them as used for the search.
+		for (auto k = first; k < position; ++k)
+		{
+			inside[perm[k]] = -1;
+		}
+	}
+
+	std::reverse(perm, perm + n);
+}
+
+/*
+	Approximate minimum degree on the quotient graph. Each uneliminated
+	variable i keeps the variables A_i and elements E_i it is adjacent to;
+	an eliminated pivot p becomes an element with members L_p, absorbing
+	the elements adjacent to it. Degrees use the AMD bound
+	|A_i| + |L_p \ i| + sum over e in E_i \ p of |L_e \ L_p|.
+*/
+inline void ordering_minimum_degree(const ordering_graph& g, lapack_int order[])
+{
+	const auto n = g.n;
+	if (n == 0) return;
+
+	std::vector<std::vector<lapack_int>> variables(n), elements(n), members(n);
+	std::vector<lapack_int> degree(n), head(n, -1), next(n, -1), prev(n, -1), weight(n, -1), mark(n, -1);
+	std::vector<char> eliminated(n, 0), absorbed(n, 0);
+
+	// Dense rows are left out and ordered last.
+	const auto dense = std::max(16, static_cast<lapack_int>(10 * std::sqrt(static_cast<double>(n))));
+	std::vector<lapack_int> dense_rows;
+	for (auto i = 0; i < n; ++i)
+	{
+		if (g.degree(i) > dense)
+		{
+			eliminated[i] = 1;
+			dense_rows.push_back(i);
+		}
+	}
+
+	auto remove = [&](lapack_int i)
+	{
+		if (prev[i] >= 0) next[prev[i]] = next[i]; else head[degree[i]] = next[i];
+		if (next[i] >= 0) prev[next[i]] = prev[i];
+	};
+
+	auto insert = [&](lapack_int i)
+	{
+		prev[i] = -1;
+		next[i] = head[degree[i]];
+		if (next[i] >= 0) prev[next[i]] = i;
+		head[degree[i]] = i;
+	};
+
+	for (auto i = 0; i < n; ++i)
+	{
+		if (eliminated[i]) continue;
+		for (auto p = g.ptr[i]; p < g.ptr[i + 1]; ++p)
+		{
+			if (!eliminated[g.adj[p]]) variables[i].push_back(g.adj[p]);
+		}
+
+		degree[i] = static_cast<lapack_int>(variables[i].size());
+		insert(i);
+	}
+
+	const auto count = n - static_cast<lapack_int>(dense_rows.size());
+	lapack_int minimum = 0;
+	for (auto k = 0; k < count; ++k)
+	{
+		while (head[minimum] < 0) ++minimum;
+		const auto p = head[minimum];
+		remove(p);
+		order[k] = p;
+		eliminated[p] = 1;
+
+		// L_p: the variables of A_p and of the elements of E_p, which p absorbs.
+		auto& lp = members[p];
+		mark[p] = k;
+		for (auto j : variables[p])
+		{
+			if (!eliminated[j] && mark[j] != k)
+			{
+				mark[j] = k;
+				lp.push_back(j);
+			}
+		}
+
+		for (auto e : elements[p])
+		{
+			if (absorbed[e]) continue;
+			for (auto j : members[e])
+			{
+				if (!eliminated[j] && mark[j] != k)
+				{
+					mark[j] = k;
+					lp.push_back(j);
+				}
+			}
+
+			absorbed[e] = 1;
+			std::vector<lapack_int>().swap(members[e]);
+		}
+
+		std::vector<lapack_int>().swap(variables[p]);
+		std::vector<lapack_int>().swap(elements[p]);
+
+		const auto size = static_cast<lapack_int>(lp.size());
+		for (auto i : lp)
+		{
+			auto& e_i = elements[i];
+			e_i.erase(std::remove_if(e_i.begin(), e_i.end(), [&](lapack_int e) { return absorbed[e] != 0; }), e_i.end());
+			e_i.push_back(p);
+
+			auto& a_i = variables[i];
+			a_i.erase(std::remove_if(a_i.begin(), a_i.end(), [&](lapack_int j) { return eliminated[j] || mark[j] == k; }), a_i.end());
+		}
+
+		// |L_e \ L_p| for the other elements next to L_p.
+		for (auto i : lp)
+		{
+			for (auto e : elements[i])
+			{
+				if (e == p) continue;
+				if (weight[e] < 0) weight[e] = static_cast<lapack_int>(members[e].size());
+				--weight[e];
+			}
+		}
+
+		for (auto i : lp)
+		{
+			auto d = static_cast<lapack_int>(variables[i].size()) + size - 1;
+			for (auto e : elements[i])
+			{
+				if (e == p || absorbed[e]) continue;
+				if (weight[e] == 0)
+				{
+					// L_e is inside L_p: absorb it.
+					absorbed[e] = 1;
+					std::vector<lapack_int>().swap(members[e]);
+				}
+				else
+				{
+					d += weight[e];
+				}
+			}
+
+			d = std::min(d, std::min(count - k - 1, degree[i] + size - 1));
+			remove(i);
+			degree[i] = d;
+			insert(i);
+			minimum = std::min(minimum, d);
+		}
+
+		for (auto i : lp)
+		{
+			for (auto e : elements[i])
+			{
+				weight[e] = -1;
+			}
+		}
+	}
+
+	std::copy(dense_rows.begin(), dense_rows.end(), order + count);
+}
+
+// Minimum degree ordering of the subgraph induced by nodes.
+inline void ordering_minimum_degree_subset(const ordering_graph& g, const std::vector<lapack_int>& nodes, std::vector<lapack_int>& local, lapack_int order[])
+{
+	ordering_graph sub;
+	sub.n = static_cast<lapack_int>(nodes.size());
+	sub.ptr.assign(1, 0);
+	for (auto k = 0; k < sub.n; ++k)
+	{
+		local[nodes[k]] = k;
+	}
+
+	for (auto k = 0; k < sub.n; ++k)
+	{
+		const auto v = nodes[k];
+		for (auto p = g.ptr[v]; p < g.ptr[v + 1]; ++p)
+		{
+			if (local[g.adj[p]] >= 0) sub.adj.push_back(local[g.adj[p]]);
+		}
+
+		sub.ptr.push_back(static_cast<lapack_int>(sub.adj.size()));
+	}
+
+	ordering_minimum_degree(sub, order);
+	for (auto k = 0; k < sub.n; ++k)
+	{
+		local[nodes[k]] = -1;
+		order[k] = nodes[order[k]];
+	}
+}
+
+const int ORDERING_LEAF = 200;
+
+inline void ordering_nested_dissection(const ordering_graph& g, lapack_int perm[])
+{
+	struct part
+	{
+		std::vector<lapack_int> nodes;
+		lapack_int begin;
+	};
+
+	const auto n = g.n;
+	std::vector<lapack_int> inside(n, 0), level(n, -1), local(n, -1), nodes, level_ptr;
+	std::vector<part> stack(1);
+	stack[0].nodes.resize(n);
+	for (auto i = 0; i < n; ++i) stack[0].nodes[i] = i;
+	stack[0].begin = 0;
+	lapack_int id = 0;
+
+	while (!stack.empty())
+	{
+		auto current = std::move(stack.back());
+		stack.pop_back();
+		const auto size = static_cast<lapack_int>(current.nodes.size());
+		if (size == 0) continue;
+
+		if (size <= ORDERING_LEAF)
+		{
+			ordering_minimum_degree_subset(g, current.nodes, local, perm + current.begin);
+			continue;
+		}
+
+		++id;
+		for (auto v : current.nodes) inside[v] = id;
+		ordering_peripheral(g, current.nodes[0], inside, id, level, nodes, level_ptr);
+		const auto reached = static_cast<lapack_int>(nodes.size());
+		const auto depth = static_cast<lapack_int>(level_ptr.size()) - 1;
+
+		if (reached < size)
+		{
+			// Disconnected: the component and the rest are independent.
+			part rest;
+			rest.begin = current.begin + reached;
+			for (auto v : current.nodes)
+			{
+				if (level[v] < 0) rest.nodes.push_back(v);
+			}
+
+			part component;
+			component.begin = current.begin;
+			component.nodes = nodes;
+			ordering_levels_reset(nodes, level);
+			stack.push_back(std::move(rest));
+			stack.push_back(std::move(component));
+			continue;
+		}
+
+		if (depth < 3)
+		{
+			ordering_levels_reset(nodes, level);
+			ordering_minimum_degree_subset(g, current.nodes, local, perm + current.begin);
+			continue;
+		}
+
+		// Separator: the level holding the median node, not the first or last.
+		auto middle = 1;
+		while (middle < depth - 2 && level_ptr[middle + 1] <= size / 2) ++middle;
+
+		part first, second;
+		std::vector<lapack_int> separator;
+		for (auto v : nodes)
+		{
+			if (level[v] < middle)
+			{
+				first.nodes.push_back(v);
+			}
+			else if (level[v] > middle)
+			{
+				second.nodes.push_back(v);
+			}
+			else
+			{
+				// Only nodes next to the far side need to separate.
+				auto touches = false;
+				for (auto p = g.ptr[v]; p < g.ptr[v + 1] && !touches; ++p)
+				{
+					touches = inside[g.adj[p]] == id && level[g.adj[p]] == middle + 1;
+				}
+
+				if (touches) separator.push_back(v); else first.nodes.push_back(v);
+			}
+		}
+
+		ordering_levels_reset(nodes, level);
+
+		first.begin = current.begin;
+		second.begin = first.begin + static_cast<lapack_int>(first.nodes.size());
+		std::copy(separator.begin(), separator.end(), perm + second.begin + second.nodes.size());
+		stack.push_back(std::move(second));
+		stack.push_back(std::move(first));
+	}
+}
+
+const int ORDERING_RCM = 0;
+const int ORDERING_AMD = 1;
+const int ORDERING_NESTED_DISSECTION = 2;
+
+inline lapack_int sparse_reorder(int method, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int perm[], lapack_int inverse[])
+{
+	if (n < 0) return -1;
+
+	try
+	{
+		ordering_graph g;
+		auto info = ordering_graph_build(g, n, row_ptr, col_idx);
+		if (info != 0) return info;
+
+		switch (method)
+		{
+		case ORDERING_RCM:
+			ordering_rcm(g, perm);
+			break;
+		case ORDERING_AMD:
+			ordering_minimum_degree(g, perm);
+			break;
+		default:
+			ordering_nested_dissection(g, perm);
+			break;
+		}
+
+		if (inverse)
+		{
+			for (auto k = 0; k < n; ++k)
+			{
+				inverse[perm[k]] = k;
+			}
+		}
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+// B = A(perm, perm) with sorted columns; b_row_ptr has n + 1 entries and
+// b_col_idx, b_values row_ptr[n].
+template<typename T>
+inline lapack_int sparse_permute(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[], const lapack_int perm[],
+	lapack_int b_row_ptr[], lapack_int b_col_idx[], T b_values[])
+{
+	if (n < 0) return -1;
+
+	try
+	{
+		std::vector<lapack_int> inverse(n, -1);
+		for (auto k = 0; k < n; ++k)
+		{
+			if (perm[k] < 0 || perm[k] >= n || inverse[perm[k]] >= 0) return -5;
+			inverse[perm[k]] = k;
+		}
+
+		lapack_int longest = 0;
+		b_row_ptr[0] = 0;
+		for (auto k = 0; k < n; ++k)
+		{
+			const auto length = row_ptr[perm[k] + 1] - row_ptr[perm[k]];
+			b_row_ptr[k + 1] = b_row_ptr[k] + length;
+			longest = std::max(longest, length);
+		}
+
+		std::vector<int> bounds;
+		const auto chunks = sparse_row_chunks(n, b_row_ptr, bounds);
+		std::vector<std::vector<std::pair<lapack_int, T>>> rows(chunks, std::vector<std::pair<lapack_int, T>>(longest));
+		const auto* inv = inverse.data();
+
+		parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+		{
+			auto& row = rows[chunk];
+			for (auto k = bounds[chunk]; k < bounds[chunk + 1]; ++k)
+			{
+				const auto i = perm[k];
+				const auto length = row_ptr[i + 1] - row_ptr[i];
+				for (auto p = 0; p < length; ++p)
+				{
+					row[p].first = inv[col_idx[row_ptr[i] + p]];
+					row[p].second = values[row_ptr[i] + p];
+				}
+
+				std::sort(row.begin(), row.begin() + length, [](const std::pair<lapack_int, T>& a, const std::pair<lapack_int, T>& b) { return a.first < b.first; });
+
+				auto q = b_row_ptr[k];
+				for (auto p = 0; p < length; ++p, ++q)
+				{
+					b_col_idx[q] = row[p].first;
+					b_values[q] = row[p].second;
+				}
+			}
+		});
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int sparse_reorder_rcm(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int perm[], lapack_int inverse[])
+	{
+		return sparse_reorder(ORDERING_RCM, n, row_ptr, col_idx, perm, inverse);
+	}
+
+	DLLEXPORT lapack_int sparse_reorder_amd(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int perm[], lapack_int inverse[])
+	{
+		return sparse_reorder(ORDERING_AMD, n, row_ptr, col_idx, perm, inverse);
+	}
+
+	DLLEXPORT lapack_int sparse_reorder_nested_dissection(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], lapack_int perm[], lapack_int inverse[])
+	{
+		return sparse_reorder(ORDERING_NESTED_DISSECTION, n, row_ptr, col_idx, perm, inverse);
+	}
+
+	DLLEXPORT lapack_int s_sparse_permute(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[], const lapack_int perm[],
+		lapack_int b_row_ptr[], lapack_int b_col_idx[], float b_values[])
+	{
+		return sparse_permute(n, row_ptr, col_idx, values, perm, b_row_ptr, b_col_idx, b_values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_permute(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[], const lapack_int perm[],
+		lapack_int b_row_ptr[], lapack_int b_col_idx[], double b_values[])
+	{
+		return sparse_permute(n, row_ptr, col_idx, values, perm, b_row_ptr, b_col_idx, b_values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_permute(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[], const lapack_int perm[],
+		lapack_int b_row_ptr[], lapack_int b_col_idx[], lapack_complex_float b_values[])
+	{
+		return sparse_permute(n, row_ptr, col_idx, values, perm, b_row_ptr, b_col_idx, b_values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_permute(lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[], const lapack_int perm[],
+		lapack_int b_row_ptr[], lapack_int b_col_idx[], lapack_complex_double b_values[])
+	{
+		return sparse_permute(n, row_ptr, col_idx, values, perm, b_row_ptr, b_col_idx, b_values);
+	}
+}
@@ -0,0 +1,458 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "sparse_common.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/*
+	Sparse-sparse product C = A*B of zero-based CSR matrices, A m x k and
+	B k x n, in two phases so that repeated products with the same patterns
+	(Galerkin products P'*A*P in multigrid setup, time stepping) pay for the
+	structure once:
+
+	- x_sparse_product_symbolic copies the structures of A and B into a new
+	  handle, computes the structure of C and returns its nonzero count, so
+	  the caller can allocate col_idx and values for C.
+	- x_sparse_product_numeric takes the values of A and B (same patterns
+	  as at the symbolic phase), and writes the row pointers, sorted column
+	  indices and values of C. It can be called any number of times, but
+	  not concurrently on the same handle: the column maps of the portable
+	  kernel live in the handle, so the numeric phase does not allocate.
+	- x_sparse_product_free releases the handle.
+
+	The MKL provider runs the phases as mkl_sparse_sp2m stages
+	(SPARSE_STAGE_FULL_MULT_NO_VAL, then SPARSE_STAGE_FINALIZE_MULT). The
+	portable kernel is Gustavson's row-by-row algorithm, with rows split
+	across threads by their multiply count and a private column map per
+	thread. Structural zeros are kept, so C's pattern does not depend on
+	the values.
+
+	x_sparse_transpose forms the CSR of A' (equivalently the CSC of A), for
+	products such as P'*(A*P).
+
+	Info is 0, a negative argument index, INSUFFICIENT_MEMORY or, on MKL, a
+	positive sparse_status_t.
+*/
+
+template<typename T>
+struct sparse_product_plan
+{
+	lapack_int m, k, n;
+	std::vector<lapack_int> a_row_ptr, a_col_idx, b_row_ptr, b_col_idx;
+	std::vector<lapack_int> c_row_ptr, c_col_idx;
+	std::vector<int> bounds;
+	std::vector<std::vector<lapack_int>> positions;
+#ifdef PROVIDER_MKL
+	std::vector<T> a_values, b_values;
+	sparse_matrix_t a, b, c;
+#endif
+
+	sparse_product_plan(lapack_int rows, lapack_int inner, lapack_int cols,
+		const lapack_int a_rows[], const lapack_int a_cols[], const lapack_int b_rows[], const lapack_int b_cols[])
+		: m(rows), k(inner), n(cols),
+		a_row_ptr(a_rows, a_rows + rows + 1), a_col_idx(a_cols, a_cols + a_rows[rows]),
+		b_row_ptr(b_rows, b_rows + inner + 1), b_col_idx(b_cols, b_cols + b_rows[inner]),
+		c_row_ptr(rows + 1, 0)
+#ifdef PROVIDER_MKL
+		, a_values(a_rows[rows]), b_values(b_rows[inner]), a(nullptr), b(nullptr), c(nullptr)
+#endif
+	{
+	}
+
+	~sparse_product_plan()
+	{
+#ifdef PROVIDER_MKL
+		if (c) mkl_sparse_destroy(c);
+		if (b) mkl_sparse_destroy(b);
+		if (a) mkl_sparse_destroy(a);
+#endif
+	}
+};
+
+// Structure of C, with rows split by their multiply count.
+template<typename T>
+inline void gustavson_symbolic(sparse_product_plan<T>& plan)
+{
+	const auto m = plan.m;
+	const auto* a_row_ptr = plan.a_row_ptr.data();
+	const auto* a_col_idx = plan.a_col_idx.data();
+	const auto* b_row_ptr = plan.b_row_ptr.data();
+	const auto* b_col_idx = plan.b_col_idx.data();
+
+	std::vector<long long> flops(m + 1, 0);
+	for (auto i = 0; i < m; ++i)
+	{
+		auto count = 0LL;
+		for (auto p = a_row_ptr[i]; p < a_row_ptr[i + 1]; ++p)
+		{
+			count += b_row_ptr[a_col_idx[p] + 1] - b_row_ptr[a_col_idx[p]];
+		}
+
+		flops[i + 1] = flops[i] + count;
+	}
+
+	const auto chunks = std::max(1, parallel_chunk_count(static_cast<int>(std::min(flops[m], 1LL << 30)), SPARSE_PARALLEL_GRAIN));
+	sparse_balanced_bounds(m, flops.data(), chunks, plan.bounds);
+	const auto* bounds = plan.bounds.data();
+
+	// The column maps are kept for the numeric phase.
+	plan.positions.assign(chunks, std::vector<lapack_int>(plan.n));
+	auto& markers = plan.positions;
+	auto* c_row_ptr = plan.c_row_ptr.data();
+
+	parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+	{
+		auto& marker = markers[chunk];
+		std::fill(marker.begin(), marker.end(), -1);
+
+		for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+		{
+			lapack_int count = 0;
+			for (auto p = a_row_ptr[i]; p < a_row_ptr[i + 1]; ++p)
+			{
+				const auto row = a_col_idx[p];
+				for (auto q = b_row_ptr[row]; q < b_row_ptr[row + 1]; ++q)
+				{
+					if (marker[b_col_idx[q]] != i)
+					{
+						marker[b_col_idx[q]] = i;
+						++count;
+					}
+				}
+			}
+
+			c_row_ptr[i + 1] = count;
+		}
+	});
+
+	for (auto i = 0; i < m; ++i)
+	{
+		c_row_ptr[i + 1] += c_row_ptr[i];
+	}
+
+	plan.c_col_idx.resize(c_row_ptr[m]);
+	auto* c_col_idx = plan.c_col_idx.data();
+
+	parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+	{
+		auto& marker = markers[chunk];
+		std::fill(marker.begin(), marker.end(), -1);
+
+		for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+		{
+			auto next = c_row_ptr[i];
+			for (auto p = a_row_ptr[i]; p < a_row_ptr[i + 1]; ++p)
+			{
+				const auto row = a_col_idx[p];
+				for (auto q = b_row_ptr[row]; q < b_row_ptr[row + 1]; ++q)
+				{
+					if (marker[b_col_idx[q]] != i)
+					{
+						marker[b_col_idx[q]] = i;
+						c_col_idx[next++] = b_col_idx[q];
+					}
+				}
+			}
+
+			std::sort(c_col_idx + c_row_ptr[i], c_col_idx + c_row_ptr[i + 1]);
+		}
+	});
+}
+
+template<typename T>
+inline void gustavson_numeric(sparse_product_plan<T>& plan, const T a_values[], const T b_values[], T c_values[])
+{
+	const auto* a_row_ptr = plan.a_row_ptr.data();
+	const auto* a_col_idx = plan.a_col_idx.data();
+	const auto* b_row_ptr = plan.b_row_ptr.data();
+	const auto* b_col_idx = plan.b_col_idx.data();
+	const auto* c_row_ptr = plan.c_row_ptr.data();
+	const auto* c_col_idx = plan.c_col_idx.data();
+	const auto* bounds = plan.bounds.data();
+	const auto chunks = static_cast<int>(plan.bounds.size()) - 1;
+	auto& positions = plan.positions;
+
+	parallel_for_chunks(chunks, chunks, [&](int chunk, int, int)
+	{
+		auto* position = positions[chunk].data();
+
+		for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+		{
+			for (auto p = c_row_ptr[i]; p < c_row_ptr[i + 1]; ++p)
+			{
+				position[c_col_idx[p]] = p;
+				c_values[p] = T(0);
+			}
+
+			for (auto p = a_row_ptr[i]; p < a_row_ptr[i + 1]; ++p)
+			{
+				const auto row = a_col_idx[p];
+				const auto value = a_values[p];
+				for (auto q = b_row_ptr[row]; q < b_row_ptr[row + 1]; ++q)
+				{
+					c_values[position[b_col_idx[q]]] += value * b_values[q];
+				}
+			}
+		}
+	});
+}
+
+template<typename T>
+inline lapack_int sparse_product_symbolic(void** handle, lapack_int m, lapack_int k, lapack_int n,
+	const lapack_int a_row_ptr[], const lapack_int a_col_idx[], const lapack_int b_row_ptr[], const lapack_int b_col_idx[], lapack_int* nnz)
+{
+	if (m < 0) return -2;
+	if (k < 0) return -3;
+	if (n < 0) return -4;
+
+	*handle = nullptr;
+
+	try
+	{
+		std::unique_ptr<sparse_product_plan<T>> plan(new sparse_product_plan<T>(m, k, n, a_row_ptr, a_col_idx, b_row_ptr, b_col_idx));
+
+#ifdef PROVIDER_MKL
+		matrix_descr general;
+		general.type = SPARSE_MATRIX_TYPE_GENERAL;
+
+		auto status = sparse_create_csr(&plan->a, m, k, plan->a_row_ptr.data(), plan->a_col_idx.data(), plan->a_values.data());
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = sparse_create_csr(&plan->b, k, n, plan->b_row_ptr.data(), plan->b_col_idx.data(), plan->b_values.data());
+		}
+
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = mkl_sparse_sp2m(SPARSE_OPERATION_NON_TRANSPOSE, general, plan->a, SPARSE_OPERATION_NON_TRANSPOSE, general, plan->b, SPARSE_STAGE_FULL_MULT_NO_VAL, &plan->c);
+		}
+
+		MKL_INT rows;
+		MKL_INT *row_start, *row_end, *col_idx;
+		T* values;
+		if (status == SPARSE_STATUS_SUCCESS)
+		{
+			status = sparse_export_csr(plan->c, &rows, &row_start, &row_end, &col_idx, &values);
+		}
+
+		if (status != SPARSE_STATUS_SUCCESS)
+		{
+			return sparse_status_info(status);
+		}
+
+		// The exported rows need not be contiguous, so count each one from its own bounds.
+		*nnz = 0;
+		for (auto i = 0; i < m; ++i)
+		{
+			*nnz += row_end[i] - row_start[i];
+		}
+#else
+		gustavson_symbolic(*plan);
+		*nnz = plan->c_row_ptr[m];
+#endif
+
+		*handle = plan.release();
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int sparse_product_numeric(void* handle, const T a_values[], const T b_values[], lapack_int c_row_ptr[], lapack_int c_col_idx[], T c_values[])
+{
+	auto& plan = *static_cast<sparse_product_plan<T>*>(handle);
+
+#ifdef PROVIDER_MKL
+	std::copy(a_values, a_values + plan.a_values.size(), plan.a_values.begin());
+	std::copy(b_values, b_values + plan.b_values.size(), plan.b_values.begin());
+
+	matrix_descr general;
+	general.type = SPARSE_MATRIX_TYPE_GENERAL;
+
+	auto status = mkl_sparse_sp2m(SPARSE_OPERATION_NON_TRANSPOSE, general, plan.a, SPARSE_OPERATION_NON_TRANSPOSE, general, plan.b, SPARSE_STAGE_FINALIZE_MULT, &plan.c);
+	if (status == SPARSE_STATUS_SUCCESS)
+	{
+		status = mkl_sparse_order(plan.c);
+	}
+
+	MKL_INT rows;
+	MKL_INT *row_start, *row_end, *col_idx;
+	T* values;
+	if (status == SPARSE_STATUS_SUCCESS)
+	{
+		status = sparse_export_csr(plan.c, &rows, &row_start, &row_end, &col_idx, &values);
+	}
+
+	if (status != SPARSE_STATUS_SUCCESS)
+	{
+		return sparse_status_info(status);
+	}
+
+	c_row_ptr[0] = 0;
+	for (auto i = 0; i < plan.m; ++i)
+	{
+		const auto count = row_end[i] - row_start[i];
+		std::copy(col_idx + row_start[i], col_idx + row_end[i], c_col_idx + c_row_ptr[i]);
+		std::copy(values + row_start[i], values + row_end[i], c_values + c_row_ptr[i]);
+		c_row_ptr[i + 1] = c_row_ptr[i] + count;
+	}
+
+	return 0;
+#else
+	try
+	{
+		gustavson_numeric(plan, a_values, b_values, c_values);
+		std::copy(plan.c_row_ptr.begin(), plan.c_row_ptr.end(), c_row_ptr);
+		std::copy(plan.c_col_idx.begin(), plan.c_col_idx.end(), c_col_idx);
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+#endif
+}
+
+template<typename T>
+inline lapack_int sparse_product_free(void** handle)
+{
+	delete static_cast<sparse_product_plan<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+// Counting sort by column: row j of A' lists the rows of A with an entry in column j, ascending.
+template<typename T>
+inline lapack_int sparse_transpose(lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int t_row_ptr[], lapack_int t_col_idx[], T t_values[])
+{
+	if (m < 0) return -1;
+	if (n < 0) return -2;
+
+	std::fill(t_row_ptr, t_row_ptr + n + 1, 0);
+	for (auto p = 0; p < row_ptr[m]; ++p)
+	{
+		++t_row_ptr[col_idx[p] + 1];
+	}
+
+	for (auto j = 0; j < n; ++j)
+	{
+		t_row_ptr[j + 1] += t_row_ptr[j];
+	}
+
+	try
+	{
+		std::vector<lapack_int> next(t_row_ptr, t_row_ptr + n);
+		for (auto i = 0; i < m; ++i)
+		{
+			for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+			{
+				const auto q = next[col_idx[p]]++;
+				t_col_idx[q] = i;
+				t_values[q] = values[p];
+			}
+		}
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_product_symbolic(void** handle, lapack_int m, lapack_int k, lapack_int n,
+		const lapack_int a_row_ptr[], const lapack_int a_col_idx[], const lapack_int b_row_ptr[], const lapack_int b_col_idx[], lapack_int* nnz)
+	{
+		return sparse_product_symbolic<float>(handle, m, k, n, a_row_ptr, a_col_idx, b_row_ptr, b_col_idx, nnz);
+	}
+
+	DLLEXPORT lapack_int d_sparse_product_symbolic(void** handle, lapack_int m, lapack_int k, lapack_int n,
+		const lapack_int a_row_ptr[], const lapack_int a_col_idx[], const lapack_int b_row_ptr[], const lapack_int b_col_idx[], lapack_int* nnz)
+	{
+		return sparse_product_symbolic<double>(handle, m, k, n, a_row_ptr, a_col_idx, b_row_ptr, b_col_idx, nnz);
+	}
+
+	DLLEXPORT lapack_int c_sparse_product_symbolic(void** handle, lapack_int m, lapack_int k, lapack_int n,
+		const lapack_int a_row_ptr[], const lapack_int a_col_idx[], const lapack_int b_row_ptr[], const lapack_int b_col_idx[], lapack_int* nnz)
+	{
+		return sparse_product_symbolic<lapack_complex_float>(handle, m, k, n, a_row_ptr, a_col_idx, b_row_ptr, b_col_idx, nnz);
+	}
+
+	DLLEXPORT lapack_int z_sparse_product_symbolic(void** handle, lapack_int m, lapack_int k, lapack_int n,
+		const lapack_int a_row_ptr[], const lapack_int a_col_idx[], const lapack_int b_row_ptr[], const lapack_int b_col_idx[], lapack_int* nnz)
+	{
+		return sparse_product_symbolic<lapack_complex_double>(handle, m, k, n, a_row_ptr, a_col_idx, b_row_ptr, b_col_idx, nnz);
+	}
+
+	DLLEXPORT lapack_int s_sparse_product_numeric(void* handle, const float a_values[], const float b_values[], lapack_int c_row_ptr[], lapack_int c_col_idx[], float c_values[])
+	{
+		return sparse_product_numeric(handle, a_values, b_values, c_row_ptr, c_col_idx, c_values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_product_numeric(void* handle, const double a_values[], const double b_values[], lapack_int c_row_ptr[], lapack_int c_col_idx[], double c_values[])
+	{
+		return sparse_product_numeric(handle, a_values, b_values, c_row_ptr, c_col_idx, c_values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_product_numeric(void* handle, const lapack_complex_float a_values[], const lapack_complex_float b_values[], lapack_int c_row_ptr[], lapack_int c_col_idx[], lapack_complex_float c_values[])
+	{
+		return sparse_product_numeric(handle, a_values, b_values, c_row_ptr, c_col_idx, c_values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_product_numeric(void* handle, const lapack_complex_double a_values[], const lapack_complex_double b_values[], lapack_int c_row_ptr[], lapack_int c_col_idx[], lapack_complex_double c_values[])
+	{
+		return sparse_product_numeric(handle, a_values, b_values, c_row_ptr, c_col_idx, c_values);
+	}
+
+	DLLEXPORT lapack_int s_sparse_product_free(void** handle)
+	{
+		return sparse_product_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_sparse_product_free(void** handle)
+	{
+		return sparse_product_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_sparse_product_free(void** handle)
+	{
+		return sparse_product_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_sparse_product_free(void** handle)
+	{
+		return sparse_product_free<lapack_complex_double>(handle);
+	}
+
+	DLLEXPORT lapack_int s_sparse_transpose(lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[],
+		lapack_int t_row_ptr[], lapack_int t_col_idx[], float t_values[])
+	{
+		return sparse_transpose(m, n, row_ptr, col_idx, values, t_row_ptr, t_col_idx, t_values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_transpose(lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[],
+		lapack_int t_row_ptr[], lapack_int t_col_idx[], double t_values[])
+	{
+		return sparse_transpose(m, n, row_ptr, col_idx, values, t_row_ptr, t_col_idx, t_values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_transpose(lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[],
+		lapack_int t_row_ptr[], lapack_int t_col_idx[], lapack_complex_float t_values[])
+	{
+		return sparse_transpose(m, n, row_ptr, col_idx, values, t_row_ptr, t_col_idx, t_values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_transpose(lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[],
+		lapack_int t_row_ptr[], lapack_int t_col_idx[], lapack_complex_double t_values[])
+	{
+		return sparse_transpose(m, n, row_ptr, col_idx, values, t_row_ptr, t_col_idx, t_values);
+	}
+}
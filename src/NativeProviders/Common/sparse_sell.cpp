@@ -0,0 +1,480 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "sparse_common.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SELL_X86
+#define SELL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SELL_TARGET_AVX512 __attribute__((target("avx512f")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SELL_X86
+#define SELL_TARGET_AVX2
+#define SELL_TARGET_AVX512
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+/*
+	SELL-C-sigma storage of a zero-based m x n CSR matrix for SpMV with
+	SIMD: rows are sorted by length within windows of sigma rows, cut into
+	chunks of C rows, and each chunk is stored column-major and padded to
+	its longest row, so that one SIMD lane works on one row. Padding
+	repeats the last column of the row with a zero value.
+
+	- x_sparse_sell_create builds the handle. chunk is C (0 picks the
+	  vector width of the kernel, at most SELL_MAX_CHUNK) and sigma the
+	  sorting window (0 picks 32*C, 1 keeps the row order); it is rounded
+	  up to a multiple of C. padded receives the number of stored entries
+	  including padding, to compare with nnz.
+	- x_sparse_sell_mv computes y = A*x, with chunks split across threads
+	  by stored entries.
+	- x_sparse_sell_free releases the handle.
+
+	The kernel is chosen at run time: AVX-512F (8 doubles or 16 floats per
+	gather) or AVX2 with FMA (4 doubles or 8 floats), the widest that the
+	CPU supports and C is a multiple of, otherwise a portable loop that
+	also covers the complex types. sparse_sell_instruction_set reports the choice: 0
+	portable, 1 AVX2, 2 AVX-512. The same kernels are used in both
+	providers; MKL has no SELL format.
+*/
+
+const int SELL_PORTABLE = 0;
+const int SELL_AVX2 = 1;
+const int SELL_AVX512 = 2;
+const int SELL_MAX_CHUNK = 64;
+
+inline int sell_instruction_set()
+{
+#if defined(SELL_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return SELL_PORTABLE;
+
+	__cpuid(info, 1);
+	const auto fma = (info[2] & (1 << 12)) != 0;
+	if ((info[2] & (1 << 27)) == 0) return SELL_PORTABLE;
+
+	// The OS must save the YMM (and for AVX-512 the ZMM) state.
+	const auto xcr0 = _xgetbv(0);
+	if ((xcr0 & 0x6) != 0x6) return SELL_PORTABLE;
+
+	__cpuidex(info, 7, 0);
+	if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6) return SELL_AVX512;
+	if ((info[1] & (1 << 5)) != 0 && fma) return SELL_AVX2;
+	return SELL_PORTABLE;
+#elif defined(SELL_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return SELL_AVX512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SELL_AVX2;
+	return SELL_PORTABLE;
+#else
+	return SELL_PORTABLE;
+#endif
+}
+
+// Values per SIMD register for the instruction set, 0 if T has no kernel.
+template<typename T>
+inline int sell_width(int)
+{
+	return 0;
+}
+
+template<>
+inline int sell_width<double>(int isa)
+{
+	return isa == SELL_AVX512 ? 8 : isa == SELL_AVX2 ? 4 : 0;
+}
+
+template<>
+inline int sell_width<float>(int isa)
+{
+	return isa == SELL_AVX512 ? 16 : isa == SELL_AVX2 ? 8 : 0;
+}
+
+template<typename T>
+struct sparse_sell
+{
+	lapack_int m, n, chunk, chunks;
+	int kernel;
+	std::vector<lapack_int> chunk_ptr, chunk_len, rows;
+	std::vector<int> col_idx, bounds;
+	std::vector<T> values;
+};
+
+template<typename T>
+inline lapack_int sparse_sell_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const T values[],
+	lapack_int chunk, lapack_int sigma, lapack_int* padded)
+{
+	*handle = nullptr;
+	if (m < 0) return -2;
+	if (n < 0) return -3;
+	if (chunk < 0 || chunk > SELL_MAX_CHUNK) return -7;
+	if (sigma < 0) return -8;
+
+	try
+	{
+		std::unique_ptr<sparse_sell<T>> a(new sparse_sell<T>());
+		a->m = m;
+		a->n = n;
+
+		const auto isa = sell_instruction_set();
+		const auto width = sell_width<T>(isa);
+		a->chunk = chunk > 0 ? chunk : width > 0 ? width : 8;
+		a->kernel = SELL_PORTABLE;
+		for (auto kernel = isa; kernel > SELL_PORTABLE && a->kernel == SELL_PORTABLE; --kernel)
+		{
+			if (sell_width<T>(kernel) > 0 && a->chunk % sell_width<T>(kernel) == 0) a->kernel = kernel;
+		}
+
+		const auto c = a->chunk;
+		a->chunks = (m + c - 1) / c;
+
+		if (sigma == 0) sigma = 32 * c;
+		sigma = (sigma + c - 1) / c * c;
+
+		// Sort by decreasing length within each window.
+		a->rows.resize(static_cast<size_t>(a->chunks) * c, -1);
+		for (auto i = 0; i < m; ++i)
+		{
+			a->rows[i] = i;
+		}
+
+		if (sigma > c)
+		{
+			for (auto begin = 0; begin < m; begin += sigma)
+			{
+				const auto end = std::min(m, begin + sigma);
+				std::stable_sort(a->rows.begin() + begin, a->rows.begin() + end,
+					[&](lapack_int p, lapack_int q) { return row_ptr[p + 1] - row_ptr[p] > row_ptr[q + 1] - row_ptr[q]; });
+			}
+		}
+
+		a->chunk_ptr.assign(a->chunks + 1, 0);
+		a->chunk_len.assign(a->chunks, 0);
+		for (auto k = 0; k < a->chunks; ++k)
+		{
+			lapack_int length = 0;
+			for (auto r = 0; r < c; ++r)
+			{
+				const auto i = a->rows[static_cast<size_t>(k) * c + r];
+				if (i >= 0) length = std::max(length, row_ptr[i + 1] - row_ptr[i]);
+			}
+
+			a->chunk_len[k] = length;
+			a->chunk_ptr[k + 1] = a->chunk_ptr[k] + length * c;
+		}
+
+		a->col_idx.resize(a->chunk_ptr[a->chunks]);
+		a->values.resize(a->chunk_ptr[a->chunks]);
+		a->bounds.clear();
+		const auto threads = std::max(1, parallel_chunk_count(std::min(a->chunk_ptr[a->chunks], 1 << 30), SPARSE_PARALLEL_GRAIN));
+		sparse_balanced_bounds(a->chunks, a->chunk_ptr.data(), threads, a->bounds);
+
+		parallel_for_chunks(threads, threads, [&](int thread, int, int)
+		{
+			for (auto k = a->bounds[thread]; k < a->bounds[thread + 1]; ++k)
+			{
+				const auto base = a->chunk_ptr[k];
+				for (auto r = 0; r < c; ++r)
+				{
+					const auto i = a->rows[static_cast<size_t>(k) * c + r];
+					const auto begin = i >= 0 ? row_ptr[i] : 0;
+					const auto length = i >= 0 ? row_ptr[i + 1] - begin : 0;
+					const auto last = length > 0 ? static_cast<int>(col_idx[begin + length - 1]) : 0;
+					for (auto j = 0; j < a->chunk_len[k]; ++j)
+					{
+						const auto q = base + j * c + r;
+						a->col_idx[q] = j < length ? static_cast<int>(col_idx[begin + j]) : last;
+						a->values[q] = j < length ? values[begin + j] : T(0);
+					}
+				}
+			}
+		});
+
+		if (padded) *padded = a->chunk_ptr[a->chunks];
+		*handle = a.release();
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline void sell_chunks(const sparse_sell<T>& a, lapack_int begin, lapack_int end, const T x[], T y[])
+{
+	const auto c = a.chunk;
+	T sum[SELL_MAX_CHUNK];
+	for (auto k = begin; k < end; ++k)
+	{
+		std::fill(sum, sum + c, T(0));
+		for (auto j = 0; j < a.chunk_len[k]; ++j)
+		{
+			const auto offset = a.chunk_ptr[k] + j * c;
+			const auto* v = a.values.data() + offset;
+			const auto* col = a.col_idx.data() + offset;
+			for (auto r = 0; r < c; ++r)
+			{
+				sum[r] += v[r] * x[col[r]];
+			}
+		}
+
+		for (auto r = 0; r < c; ++r)
+		{
+			const auto i = a.rows[static_cast<size_t>(k) * c + r];
+			if (i >= 0) y[i] = sum[r];
+		}
+	}
+}
+
+#ifdef SELL_X86
+SELL_TARGET_AVX2 inline void sell_chunks_avx2(const sparse_sell<double>& a, lapack_int begin, lapack_int end, const double x[], double y[])
+{
+	const auto c = a.chunk;
+	// Masked gathers with every lane set, as the unmasked forms leave the
+	// source operand undefined.
+	const auto zero = _mm256_setzero_pd();
+	const auto all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+	double sum[4];
+	for (auto k = begin; k < end; ++k)
+	{
+		for (auto s = 0; s < c; s += 4)
+		{
+			auto acc = zero;
+			for (auto j = 0; j < a.chunk_len[k]; ++j)
+			{
+				const auto offset = a.chunk_ptr[k] + j * c + s;
+				const auto index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.col_idx.data() + offset));
+				acc = _mm256_fmadd_pd(_mm256_loadu_pd(a.values.data() + offset), _mm256_mask_i32gather_pd(zero, x, index, all, 8), acc);
+			}
+
+			_mm256_storeu_pd(sum, acc);
+			for (auto r = 0; r < 4; ++r)
+			{
+				const auto i = a.rows[static_cast<size_t>(k) * c + s + r];
+				if (i >= 0) y[i] = sum[r];
+			}
+		}
+	}
+}
+
+SELL_TARGET_AVX2 inline void sell_chunks_avx2(const sparse_sell<float>& a, lapack_int begin, lapack_int end, const float x[], float y[])
+{
+	const auto c = a.chunk;
+	const auto zero = _mm256_setzero_ps();
+	const auto all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	float sum[8];
+	for (auto k = begin; k < end; ++k)
+	{
+		for (auto s = 0; s < c; s += 8)
+		{
+			auto acc = zero;
+			for (auto j = 0; j < a.chunk_len[k]; ++j)
+			{
+				const auto offset = a.chunk_ptr[k] + j * c + s;
+				const auto index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.col_idx.data() + offset));
+				acc = _mm256_fmadd_ps(_mm256_loadu_ps(a.values.data() + offset), _mm256_mask_i32gather_ps(zero, x, index, all, 4), acc);
+			}
+
+			_mm256_storeu_ps(sum, acc);
+			for (auto r = 0; r < 8; ++r)
+			{
+				const auto i = a.rows[static_cast<size_t>(k) * c + s + r];
+				if (i >= 0) y[i] = sum[r];
+			}
+		}
+	}
+}
+
+SELL_TARGET_AVX512 inline void sell_chunks_avx512(const sparse_sell<double>& a, lapack_int begin, lapack_int end, const double x[], double y[])
+{
+	const auto c = a.chunk;
+	const auto zero = _mm512_setzero_pd();
+	double sum[8];
+	for (auto k = begin; k < end; ++k)
+	{
+		for (auto s = 0; s < c; s += 8)
+		{
+			auto acc = zero;
+			for (auto j = 0; j < a.chunk_len[k]; ++j)
+			{
+				const auto offset = a.chunk_ptr[k] + j * c + s;
+				const auto index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.col_idx.data() + offset));
+				acc = _mm512_fmadd_pd(_mm512_loadu_pd(a.values.data() + offset), _mm512_mask_i32gather_pd(zero, 0xff, index, x, 8), acc);
+			}
+
+			_mm512_storeu_pd(sum, acc);
+			for (auto r = 0; r < 8; ++r)
+			{
+				const auto i = a.rows[static_cast<size_t>(k) * c + s + r];
+				if (i >= 0) y[i] = sum[r];
+			}
+		}
+	}
+}
+
+SELL_TARGET_AVX512 inline void sell_chunks_avx512(const sparse_sell<float>& a, lapack_int begin, lapack_int end, const float x[], float y[])
+{
+	const auto c = a.chunk;
+	const auto zero = _mm512_setzero_ps();
+	float sum[16];
+	for (auto k = begin; k < end; ++k)
+	{
+		for (auto s = 0; s < c; s += 16)
+		{
+			auto acc = zero;
+			for (auto j = 0; j < a.chunk_len[k]; ++j)
+			{
+				const auto offset = a.chunk_ptr[k] + j * c + s;
+				const auto index = _mm512_loadu_si512(a.col_idx.data() + offset);
+				acc = _mm512_fmadd_ps(_mm512_loadu_ps(a.values.data() + offset), _mm512_mask_i32gather_ps(zero, 0xffff, index, x, 4), acc);
+			}
+
+			_mm512_storeu_ps(sum, acc);
+			for (auto r = 0; r < 16; ++r)
+			{
+				const auto i = a.rows[static_cast<size_t>(k) * c + s + r];
+				if (i >= 0) y[i] = sum[r];
+			}
+		}
+	}
+}
+#endif
+
+template<typename T>
+inline void sell_dispatch(const sparse_sell<T>& a, lapack_int begin, lapack_int end, const T x[], T y[])
+{
+	sell_chunks(a, begin, end, x, y);
+}
+
+template<typename T>
+inline void sell_dispatch_real(const sparse_sell<T>& a, lapack_int begin, lapack_int end, const T x[], T y[])
+{
+#ifdef SELL_X86
+	switch (a.kernel)
+	{
+	case SELL_AVX512:
+		sell_chunks_avx512(a, begin, end, x, y);
+		return;
+	case SELL_AVX2:
+		sell_chunks_avx2(a, begin, end, x, y);
+		return;
+	}
+#endif
+
+	sell_chunks(a, begin, end, x, y);
+}
+
+template<>
+inline void sell_dispatch<double>(const sparse_sell<double>& a, lapack_int begin, lapack_int end, const double x[], double y[])
+{
+	sell_dispatch_real(a, begin, end, x, y);
+}
+
+template<>
+inline void sell_dispatch<float>(const sparse_sell<float>& a, lapack_int begin, lapack_int end, const float x[], float y[])
+{
+	sell_dispatch_real(a, begin, end, x, y);
+}
+
+template<typename T>
+inline lapack_int sparse_sell_mv(void* handle, const T x[], T y[])
+{
+	if (!handle) return -1;
+
+	const auto& a = *static_cast<sparse_sell<T>*>(handle);
+	const auto threads = static_cast<int>(a.bounds.size()) - 1;
+	parallel_for_chunks(threads, threads, [&](int thread, int, int)
+	{
+		sell_dispatch(a, a.bounds[thread], a.bounds[thread + 1], x, y);
+	});
+
+	return 0;
+}
+
+template<typename T>
+inline lapack_int sparse_sell_free(void** handle)
+{
+	delete static_cast<sparse_sell<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int sparse_sell_instruction_set()
+	{
+		return sell_instruction_set();
+	}
+
+	DLLEXPORT lapack_int s_sparse_sell_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[],
+		lapack_int chunk, lapack_int sigma, lapack_int* padded)
+	{
+		return sparse_sell_create(handle, m, n, row_ptr, col_idx, values, chunk, sigma, padded);
+	}
+
+	DLLEXPORT lapack_int d_sparse_sell_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[],
+		lapack_int chunk, lapack_int sigma, lapack_int* padded)
+	{
+		return sparse_sell_create(handle, m, n, row_ptr, col_idx, values, chunk, sigma, padded);
+	}
+
+	DLLEXPORT lapack_int c_sparse_sell_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[],
+		lapack_int chunk, lapack_int sigma, lapack_int* padded)
+	{
+		return sparse_sell_create(handle, m, n, row_ptr, col_idx, values, chunk, sigma, padded);
+	}
+
+	DLLEXPORT lapack_int z_sparse_sell_create(void** handle, lapack_int m, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[],
+		lapack_int chunk, lapack_int sigma, lapack_int* padded)
+	{
+		return sparse_sell_create(handle, m, n, row_ptr, col_idx, values, chunk, sigma, padded);
+	}
+
+	DLLEXPORT lapack_int s_sparse_sell_mv(void* handle, const float x[], float y[])
+	{
+		return sparse_sell_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int d_sparse_sell_mv(void* handle, const double x[], double y[])
+	{
+		return sparse_sell_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int c_sparse_sell_mv(void* handle, const lapack_complex_float x[], lapack_complex_float y[])
+	{
+		return sparse_sell_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int z_sparse_sell_mv(void* handle, const lapack_complex_double x[], lapack_complex_double y[])
+	{
+		return sparse_sell_mv(handle, x, y);
+	}
+
+	DLLEXPORT lapack_int s_sparse_sell_free(void** handle)
+	{
+		return sparse_sell_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_sparse_sell_free(void** handle)
+	{
+		return sparse_sell_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_sparse_sell_free(void** handle)
+	{
+		return sparse_sell_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_sparse_sell_free(void** handle)
+	{
+		return sparse_sell_free<lapack_complex_double>(handle);
+	}
+}
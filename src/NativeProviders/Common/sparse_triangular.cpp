@@ -0,0 +1,119 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "sparse_common.h"
+#include <memory>
+
+/*
+	Sparse triangular solves T*x = b with T the lower ('L') or upper ('U')
+	triangle of a zero-based CSR matrix, unit ('U') or non-unit ('N')
+	diagonal, for preconditioners that apply the same factor every
+	iteration.
+
+	x_sparse_triangular_create does the analysis once and keeps it, with a
+	copy of the matrix, on the handle: level sets with the rows renumbered
+	level by level on the portable path, an mkl_sparse_?_trsv handle with
+	an sv hint and mkl_sparse_optimize on MKL. x_sparse_triangular_solve
+	then applies it; b and x may be the same array. Info is i + 1 if the
+	diagonal of row i is zero or missing.
+*/
+
+template<typename T>
+inline lapack_int sparse_triangular_create(void** handle, char uplo, char diag, lapack_int n,
+	const lapack_int row_ptr[], const lapack_int col_idx[], const T values[])
+{
+	*handle = nullptr;
+
+	if (uplo != 'L' && uplo != 'l' && uplo != 'U' && uplo != 'u') return -2;
+	if (diag != 'N' && diag != 'n' && diag != 'U' && diag != 'u') return -3;
+	if (n < 0) return -4;
+
+	try
+	{
+		std::unique_ptr<sparse_triangular<T>> t(new sparse_triangular<T>());
+		auto info = sparse_triangular_prepare(*t, n, uplo == 'L' || uplo == 'l', diag == 'U' || diag == 'u', row_ptr, col_idx, values);
+		if (info != 0)
+		{
+			return info;
+		}
+
+		*handle = t.release();
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T>
+inline lapack_int sparse_triangular_free(void** handle)
+{
+	delete static_cast<sparse_triangular<T>*>(*handle);
+	*handle = nullptr;
+	return 0;
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sparse_triangular_create(void** handle, char uplo, char diag, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const float values[])
+	{
+		return sparse_triangular_create(handle, uplo, diag, n, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int d_sparse_triangular_create(void** handle, char uplo, char diag, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const double values[])
+	{
+		return sparse_triangular_create(handle, uplo, diag, n, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int c_sparse_triangular_create(void** handle, char uplo, char diag, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_float values[])
+	{
+		return sparse_triangular_create(handle, uplo, diag, n, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int z_sparse_triangular_create(void** handle, char uplo, char diag, lapack_int n, const lapack_int row_ptr[], const lapack_int col_idx[], const lapack_complex_double values[])
+	{
+		return sparse_triangular_create(handle, uplo, diag, n, row_ptr, col_idx, values);
+	}
+
+	DLLEXPORT lapack_int s_sparse_triangular_solve(void* handle, const float b[], float x[])
+	{
+		return sparse_triangular_solve(*static_cast<sparse_triangular<float>*>(handle), b, x);
+	}
+
+	DLLEXPORT lapack_int d_sparse_triangular_solve(void* handle, const double b[], double x[])
+	{
+		return sparse_triangular_solve(*static_cast<sparse_triangular<double>*>(handle), b, x);
+	}
+
+	DLLEXPORT lapack_int c_sparse_triangular_solve(void* handle, const lapack_complex_float b[], lapack_complex_float x[])
+	{
+		return sparse_triangular_solve(*static_cast<sparse_triangular<lapack_complex_float>*>(handle), b, x);
+	}
+
+	DLLEXPORT lapack_int z_sparse_triangular_solve(void* handle, const lapack_complex_double b[], lapack_complex_double x[])
+	{
+		return sparse_triangular_solve(*static_cast<sparse_triangular<lapack_complex_double>*>(handle), b, x);
+	}
+
+	DLLEXPORT lapack_int s_sparse_triangular_free(void** handle)
+	{
+		return sparse_triangular_free<float>(handle);
+	}
+
+	DLLEXPORT lapack_int d_sparse_triangular_free(void** handle)
+	{
+		return sparse_triangular_free<double>(handle);
+	}
+
+	DLLEXPORT lapack_int c_sparse_triangular_free(void** handle)
+	{
+		return sparse_triangular_free<lapack_complex_float>(handle);
+	}
+
+	DLLEXPORT lapack_int z_sparse_triangular_free(void** handle)
+	{
+		return sparse_triangular_free<lapack_complex_double>(handle);
+	}
+}
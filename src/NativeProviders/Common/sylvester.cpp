@@ -0,0 +1,365 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include <algorithm>
+
+/*
+	Sylvester A*X + X*B = C and continuous Lyapunov A*X + X*A' + Q = 0
+	equations by Bartels-Stewart: Schur forms A = U*S*U' and B = V*T*V'
+	(?gees), the triangular equation S*Y + Y*T = U'*C*V (?trsyl), and
+	X = U*Y*V'. O(n^3) instead of the O(n^6) of the vectorized n^2 x n^2
+	system. For the Lyapunov equation only one Schur form is needed, and
+	the triangular equation is S*Y + Y*S' = -U'*Q*U.
+
+	The _recursive variants solve the triangular equation by recursive
+	splitting of the larger dimension (Jonsson and Kagstrom), which turns
+	most of the work of the level-2 ?trsyl into gemm updates; leaves of
+	at most SYLVESTER_BLOCK rows and columns go to ?trsyl. Splits never
+	cut a 2x2 block of the real quasi-triangular Schur form.
+
+	C (or Q) is overwritten with X. The return value is the ?gees info or,
+	when A and -B have close eigenvalues and the solution was obtained
+	with perturbed values, 1 from ?trsyl.
+*/
+
+const lapack_int SYLVESTER_BLOCK = 64;
+
+inline CBLAS_TRANSPOSE adjoint_transpose(float) { return CblasTrans; }
+inline CBLAS_TRANSPOSE adjoint_transpose(double) { return CblasTrans; }
+inline CBLAS_TRANSPOSE adjoint_transpose(lapack_complex_float) { return CblasConjTrans; }
+inline CBLAS_TRANSPOSE adjoint_transpose(lapack_complex_double) { return CblasConjTrans; }
+
+inline char adjoint_char(float) { return 'T'; }
+inline char adjoint_char(double) { return 'T'; }
+inline char adjoint_char(lapack_complex_float) { return 'C'; }
+inline char adjoint_char(lapack_complex_double) { return 'C'; }
+
+inline lapack_int schur_factor(lapack_int n, float a[], float u[])
+{
+	auto wr = array_new<float>(std::max(1, n));
+	auto wi = array_new<float>(std::max(1, n));
+	lapack_int sdim;
+	return LAPACKE_sgees(LAPACK_COL_MAJOR, 'V', 'N', nullptr, n, a, n, &sdim, wr.get(), wi.get(), u, n);
+}
+
+inline lapack_int schur_factor(lapack_int n, double a[], double u[])
+{
+	auto wr = array_new<double>(std::max(1, n));
+	auto wi = array_new<double>(std::max(1, n));
+	lapack_int sdim;
+	return LAPACKE_dgees(LAPACK_COL_MAJOR, 'V', 'N', nullptr, n, a, n, &sdim, wr.get(), wi.get(), u, n);
+}
+
+inline lapack_int schur_factor(lapack_int n, lapack_complex_float a[], lapack_complex_float u[])
+{
+	auto w = array_new<lapack_complex_float>(std::max(1, n));
+	lapack_int sdim;
+	return LAPACKE_cgees(LAPACK_COL_MAJOR, 'V', 'N', nullptr, n, a, n, &sdim, w.get(), u, n);
+}
+
+inline lapack_int schur_factor(lapack_int n, lapack_complex_double a[], lapack_complex_double u[])
+{
+	auto w = array_new<lapack_complex_double>(std::max(1, n));
+	lapack_int sdim;
+	return LAPACKE_zgees(LAPACK_COL_MAJOR, 'V', 'N', nullptr, n, a, n, &sdim, w.get(), u, n);
+}
+
+// Split point of a quasi-triangular matrix that does not cut a 2x2 block.
+template<typename T>
+inline lapack_int quasi_triangular_split(lapack_int n, const T a[], lapack_int lda)
+{
+	auto k = n / 2;
+	if (a[(k - 1) * lda + k] != T(0))
+	{
+		++k;
+	}
+
+	return k;
+}
+
+template<typename T>
+inline void scale_block(lapack_int m, lapack_int n, T c[], lapack_int ldc, T scale)
+{
+	for (auto j = 0; j < n; ++j)
+	{
+		for (auto i = 0; i < m; ++i)
+		{
+			c[j * ldc + i] *= scale;
+		}
+	}
+}
+
+// S*Y + Y*op(T) = scale*C for upper (quasi-)triangular S, T; op is 'N' or the adjoint.
+template<typename T, typename R, typename TRSYL>
+inline lapack_int triangular_sylvester_recursive(char tranb, lapack_int m, lapack_int n, const T s[], lapack_int lds, const T t[], lapack_int ldt,
+	T c[], lapack_int ldc, R* scale, TRSYL trsyl)
+{
+	if (m <= SYLVESTER_BLOCK && n <= SYLVESTER_BLOCK)
+	{
+		return trsyl(LAPACK_COL_MAJOR, 'N', tranb, 1, m, n, s, lds, t, ldt, c, ldc, scale);
+	}
+
+	R scale1, scale2;
+	lapack_int info1, info2;
+
+	if (m >= n)
+	{
+		// [S11 S12; 0 S22]: bottom rows first, then the top rows.
+		auto k = quasi_triangular_split(m, s, lds);
+		auto* c1 = c;
+		auto* c2 = c + k;
+
+		info1 = triangular_sylvester_recursive(tranb, m - k, n, s + k * lds + k, lds, t, ldt, c2, ldc, &scale1, trsyl);
+		if (scale1 != R(1))
+		{
+			scale_block(k, n, c1, ldc, T(scale1));
+		}
+
+		gemm(CblasNoTrans, CblasNoTrans, k, n, m - k, T(-1), s + k * lds, lds, c2, ldc, T(1), c1, ldc);
+
+		info2 = triangular_sylvester_recursive(tranb, k, n, s, lds, t, ldt, c1, ldc, &scale2, trsyl);
+		if (scale2 != R(1))
+		{
+			scale_block(m - k, n, c2, ldc, T(scale2));
+		}
+	}
+	else
+	{
+		auto k = quasi_triangular_split(n, t, ldt);
+		auto* c1 = c;
+		auto* c2 = c + k * ldc;
+
+		if (tranb == 'N')
+		{
+			// Y*[T11 T12; 0 T22]: left columns first.
+			info1 = triangular_sylvester_recursive(tranb, m, k, s, lds, t, ldt, c1, ldc, &scale1, trsyl);
+			if (scale1 != R(1))
+			{
+				scale_block(m, n - k, c2, ldc, T(scale1));
+			}
+
+			gemm(CblasNoTrans, CblasNoTrans, m, n - k, k, T(-1), c1, ldc, t + k * ldt, ldt, T(1), c2, ldc);
+
+			info2 = triangular_sylvester_recursive(tranb, m, n - k, s, lds, t + k * ldt + k, ldt, c2, ldc, &scale2, trsyl);
+			if (scale2 != R(1))
+			{
+				scale_block(m, k, c1, ldc, T(scale2));
+			}
+		}
+		else
+		{
+			// Y*[T11 T12; 0 T22]': right columns first.
+			info1 = triangular_sylvester_recursive(tranb, m, n - k, s, lds, t + k * ldt + k, ldt, c2, ldc, &scale1, trsyl);
+			if (scale1 != R(1))
+			{
+				scale_block(m, k, c1, ldc, T(scale1));
+			}
+
+			gemm(CblasNoTrans, adjoint_transpose(T()), m, k, n - k, T(-1), c2, ldc, t + k * ldt, ldt, T(1), c1, ldc);
+
+			info2 = triangular_sylvester_recursive(tranb, m, k, s, lds, t, ldt, c1, ldc, &scale2, trsyl);
+			if (scale2 != R(1))
+			{
+				scale_block(m, n - k, c2, ldc, T(scale2));
+			}
+		}
+	}
+
+	*scale = scale1 * scale2;
+	return info1 < 0 ? info1 : (info2 < 0 ? info2 : std::max(info1, info2));
+}
+
+// Solves S*Y + Y*op(T) = C in place and returns X = U*Y*V' / scale in c.
+template<typename T, typename R, typename TRSYL>
+inline lapack_int bartels_stewart(char tranb, lapack_int m, lapack_int n, const T s[], const T u[], const T t[], const T v[], T c[], T w[], bool recursive, TRSYL trsyl)
+{
+	const auto adjoint = adjoint_transpose(T());
+
+	// C := U' * C * V
+	gemm(adjoint, CblasNoTrans, m, n, m, T(1), u, m, c, m, T(0), w, m);
+	gemm(CblasNoTrans, CblasNoTrans, m, n, n, T(1), w, m, v, n, T(0), c, m);
+
+	R scale = R(1);
+	auto info = recursive
+		? triangular_sylvester_recursive(tranb, m, n, s, m, t, n, c, m, &scale, trsyl)
+		: trsyl(LAPACK_COL_MAJOR, 'N', tranb, 1, m, n, s, m, t, n, c, m, &scale);
+	if (info < 0)
+	{
+		return info;
+	}
+
+	// X := U * Y * V' / scale
+	gemm(CblasNoTrans, CblasNoTrans, m, n, m, T(1), u, m, c, m, T(0), w, m);
+	gemm(CblasNoTrans, adjoint, m, n, n, T(R(1) / scale), w, m, v, n, T(0), c, m);
+
+	return info;
+}
+
+template<typename T, typename R, typename TRSYL>
+inline lapack_int sylvester_solve(lapack_int m, lapack_int n, const T a[], const T b[], T c[], bool recursive, TRSYL trsyl)
+{
+	if (m < 0)
+	{
+		return -1;
+	}
+
+	if (n < 0)
+	{
+		return -2;
+	}
+
+	if (m == 0 || n == 0)
+	{
+		return 0;
+	}
+
+	try
+	{
+		auto s = array_clone(m * m, a);
+		auto t = array_clone(n * n, b);
+		auto u = array_new<T>(m * m);
+		auto v = array_new<T>(n * n);
+		auto w = array_new<T>(m * n);
+
+		auto info = schur_factor(m, s.get(), u.get());
+		if (info != 0)
+		{
+			return info;
+		}
+
+		info = schur_factor(n, t.get(), v.get());
+		if (info != 0)
+		{
+			return info;
+		}
+
+		return bartels_stewart<T, R>('N', m, n, s.get(), u.get(), t.get(), v.get(), c, w.get(), recursive, trsyl);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename R, typename TRSYL>
+inline lapack_int lyapunov_solve(lapack_int n, const T a[], T q[], bool recursive, TRSYL trsyl)
+{
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	try
+	{
+		auto s = array_clone(n * n, a);
+		auto u = array_new<T>(n * n);
+		auto w = array_new<T>(n * n);
+
+		auto info = schur_factor(n, s.get(), u.get());
+		if (info != 0)
+		{
+			return info;
+		}
+
+		for (auto i = 0; i < n * n; ++i)
+		{
+			q[i] = -q[i];
+		}
+
+		return bartels_stewart<T, R>(adjoint_char(T()), n, n, s.get(), u.get(), s.get(), u.get(), q, w.get(), recursive, trsyl);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_sylvester_solve(lapack_int m, lapack_int n, float a[], float b[], float c[])
+	{
+		return sylvester_solve<float, float>(m, n, a, b, c, false, LAPACKE_strsyl);
+	}
+
+	DLLEXPORT lapack_int d_sylvester_solve(lapack_int m, lapack_int n, double a[], double b[], double c[])
+	{
+		return sylvester_solve<double, double>(m, n, a, b, c, false, LAPACKE_dtrsyl);
+	}
+
+	DLLEXPORT lapack_int c_sylvester_solve(lapack_int m, lapack_int n, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float c[])
+	{
+		return sylvester_solve<lapack_complex_float, float>(m, n, a, b, c, false, LAPACKE_ctrsyl);
+	}
+
+	DLLEXPORT lapack_int z_sylvester_solve(lapack_int m, lapack_int n, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double c[])
+	{
+		return sylvester_solve<lapack_complex_double, double>(m, n, a, b, c, false, LAPACKE_ztrsyl);
+	}
+
+	DLLEXPORT lapack_int s_sylvester_solve_recursive(lapack_int m, lapack_int n, float a[], float b[], float c[])
+	{
+		return sylvester_solve<float, float>(m, n, a, b, c, true, LAPACKE_strsyl);
+	}
+
+	DLLEXPORT lapack_int d_sylvester_solve_recursive(lapack_int m, lapack_int n, double a[], double b[], double c[])
+	{
+		return sylvester_solve<double, double>(m, n, a, b, c, true, LAPACKE_dtrsyl);
+	}
+
+	DLLEXPORT lapack_int c_sylvester_solve_recursive(lapack_int m, lapack_int n, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float c[])
+	{
+		return sylvester_solve<lapack_complex_float, float>(m, n, a, b, c, true, LAPACKE_ctrsyl);
+	}
+
+	DLLEXPORT lapack_int z_sylvester_solve_recursive(lapack_int m, lapack_int n, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double c[])
+	{
+		return sylvester_solve<lapack_complex_double, double>(m, n, a, b, c, true, LAPACKE_ztrsyl);
+	}
+
+	DLLEXPORT lapack_int s_lyapunov_solve(lapack_int n, float a[], float q[])
+	{
+		return lyapunov_solve<float, float>(n, a, q, false, LAPACKE_strsyl);
+	}
+
+	DLLEXPORT lapack_int d_lyapunov_solve(lapack_int n, double a[], double q[])
+	{
+		return lyapunov_solve<double, double>(n, a, q, false, LAPACKE_dtrsyl);
+	}
+
+	DLLEXPORT lapack_int c_lyapunov_solve(lapack_int n, lapack_complex_float a[], lapack_complex_float q[])
+	{
+		return lyapunov_solve<lapack_complex_float, float>(n, a, q, false, LAPACKE_ctrsyl);
+	}
+
+	DLLEXPORT lapack_int z_lyapunov_solve(lapack_int n, lapack_complex_double a[], lapack_complex_double q[])
+	{
+		return lyapunov_solve<lapack_complex_double, double>(n, a, q, false, LAPACKE_ztrsyl);
+	}
+
+	DLLEXPORT lapack_int s_lyapunov_solve_recursive(lapack_int n, float a[], float q[])
+	{
+		return lyapunov_solve<float, float>(n, a, q, true, LAPACKE_strsyl);
+	}
+
+	DLLEXPORT lapack_int d_lyapunov_solve_recursive(lapack_int n, double a[], double q[])
+	{
+		return lyapunov_solve<double, double>(n, a, q, true, LAPACKE_dtrsyl);
+	}
+
+	DLLEXPORT lapack_int c_lyapunov_solve_recursive(lapack_int n, lapack_complex_float a[], lapack_complex_float q[])
+	{
+		return lyapunov_solve<lapack_complex_float, float>(n, a, q, true, LAPACKE_ctrsyl);
+	}
+
+	DLLEXPORT lapack_int z_lyapunov_solve_recursive(lapack_int n, lapack_complex_double a[], lapack_complex_double q[])
+	{
+		return lyapunov_solve<lapack_complex_double, double>(n, a, q, true, LAPACKE_ztrsyl);
+	}
+}
@@ -0,0 +1,400 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "blas_common.h"
+#include "parallel.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	Scaled copy and transpose of column-major matrices:
+	b := alpha * op(a), with op selected by trans as in ?omatcopy:
+	'N' copy, 'T' transpose, 'C' conjugate transpose, 'R' conjugate.
+	a is rows x cols; b is cols x rows for 'T' and 'C', rows x cols else.
+
+	The MKL provider forwards to mkl_?omatcopy and mkl_?imatcopy. The
+	portable kernels work on TRANSPOSE_TILE x TRANSPOSE_TILE tiles, so that
+	both the rows read and the columns written stay in L1 instead of
+	missing the cache on every element, and split the tile columns across
+	threads. In place, square matrices swap mirrored tiles; rectangular
+	matrices follow the cycles of the index permutation, which needs one
+	bit per element but no second copy.
+
+	The return value is 0, -1 for an invalid trans, or INSUFFICIENT_MEMORY.
+*/
+
+const int TRANSPOSE_TILE = 32;
+const int TRANSPOSE_PARALLEL_GRAIN = 1 << 15;
+
+inline bool transpose_mode(const char trans, bool& transpose, bool& conjugate)
+{
+	switch (trans)
+	{
+	case 'N': case 'n': transpose = false; conjugate = false; return true;
+	case 'T': case 't': transpose = true; conjugate = false; return true;
+	case 'C': case 'c': transpose = true; conjugate = true; return true;
+	case 'R': case 'r': transpose = false; conjugate = true; return true;
+	default: return false;
+	}
+}
+
+template<bool Conjugate, typename T>
+inline T transpose_value(const T alpha, const T x)
+{
+	return alpha * (Conjugate ? conj_value(x) : x);
+}
+
+template<bool Conjugate, typename T>
+inline void scale_copy(const int count, const T alpha, const T a[], T b[])
+{
+	parallel_for(count, TRANSPOSE_PARALLEL_GRAIN, [=](int begin, int end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			b[i] = transpose_value<Conjugate>(alpha, a[i]);
+		}
+	});
+}
+
+template<bool Conjugate, typename T>
+inline void transpose_out_of_place(const int rows, const int cols, const T alpha, const T a[], T b[])
+{
+	const auto tiles = (cols + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+	const auto grain = std::max(1, TRANSPOSE_PARALLEL_GRAIN / std::max(1, rows * TRANSPOSE_TILE));
+
+	parallel_for(tiles, grain, [=](int begin, int end)
+	{
+		for (auto tj = begin; tj < end; ++tj)
+		{
+			const auto j0 = tj * TRANSPOSE_TILE;
+			const auto j1 = std::min(cols, j0 + TRANSPOSE_TILE);
+
+			for (auto i0 = 0; i0 < rows; i0 += TRANSPOSE_TILE)
+			{
+				const auto i1 = std::min(rows, i0 + TRANSPOSE_TILE);
+
+				for (auto i = i0; i < i1; ++i)
+				{
+					auto* bi = b + static_cast<size_t>(i) * cols;
+					for (auto j = j0; j < j1; ++j)
+					{
+						bi[j] = transpose_value<Conjugate>(alpha, a[static_cast<size_t>(j) * rows + i]);
+					}
+				}
+			}
+		}
+	});
+}
+
+template<bool Conjugate, typename T>
+inline void transpose_square_in_place(const int n, const T alpha, T a[])
+{
+	const auto tiles = (n + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+	const auto grain = std::max(1, TRANSPOSE_PARALLEL_GRAIN / std::max(1, n * TRANSPOSE_TILE));
+
+	parallel_for(tiles, grain, [=](int begin, int end)
+	{
+		for (auto ti = begin; ti < end; ++ti)
+		{
+			const auto i0 = ti * TRANSPOSE_TILE;
+			const auto i1 = std::min(n, i0 + TRANSPOSE_TILE);
+
+			// Diagonal tile.
+			for (auto j = i0; j < i1; ++j)
+			{
+				a[static_cast<size_t>(j) * n + j] = transpose_value<Conjugate>(alpha, a[static_cast<size_t>(j) * n + j]);
+
+				for (auto i = j + 1; i < i1; ++i)
+				{
+					auto& lower = a[static_cast<size_t>(j) * n + i];
+					auto& upper = a[static_cast<size_t>(i) * n + j];
+					const auto x = lower;
+					lower = transpose_value<Conjugate>(alpha, upper);
+					upper = transpose_value<Conjugate>(alpha, x);
+				}
+			}
+
+			// Tiles right of the diagonal swap with their mirror below it.
+			for (auto j0 = i1; j0 < n; j0 += TRANSPOSE_TILE)
+			{
+				const auto j1 = std::min(n, j0 + TRANSPOSE_TILE);
+
+				for (auto j = j0; j < j1; ++j)
+				{
+					for (auto i = i0; i < i1; ++i)
+					{
+						auto& upper = a[static_cast<size_t>(j) * n + i];
+						auto& lower = a[static_cast<size_t>(i) * n + j];
+						const auto x = upper;
+						upper = transpose_value<Conjugate>(alpha, lower);
+						lower = transpose_value<Conjugate>(alpha, x);
+					}
+				}
+			}
+		}
+	});
+}
+
+// Element (i, j) at p = i + j*rows moves to j + i*cols = p*cols mod (size - 1).
+template<bool Conjugate, typename T>
+inline void transpose_rectangular_in_place(const int rows, const int cols, const T alpha, T a[])
+{
+	const auto size = static_cast<size_t>(rows) * cols;
+	const auto last = size - 1;
+	std::vector<bool> moved(size, false);
+
+	a[0] = transpose_value<Conjugate>(alpha, a[0]);
+	if (size > 1)
+	{
+		a[last] = transpose_value<Conjugate>(alpha, a[last]);
+	}
+
+	for (size_t start = 1; start < last; ++start)
+	{
+		if (moved[start])
+		{
+			continue;
+		}
+
+		auto carried = a[start];
+		auto p = start;
+
+		do
+		{
+			const auto next = static_cast<size_t>((static_cast<unsigned long long>(p) * cols) % last);
+			const auto displaced = a[next];
+			a[next] = transpose_value<Conjugate>(alpha, carried);
+			moved[next] = true;
+			carried = displaced;
+			p = next;
+		} while (p != start);
+	}
+}
+
+template<typename T>
+inline int matrix_transpose(const char trans, const int rows, const int cols, const T alpha, const T a[], T b[])
+{
+	bool transpose, conjugate;
+	if (!transpose_mode(trans, transpose, conjugate))
+	{
+		return -1;
+	}
+
+	if (!transpose)
+	{
+		if (conjugate)
+		{
+			scale_copy<true>(rows * cols, alpha, a, b);
+		}
+		else
+		{
+			scale_copy<false>(rows * cols, alpha, a, b);
+		}
+	}
+	else if (conjugate)
+	{
+		transpose_out_of_place<true>(rows, cols, alpha, a, b);
+	}
+	else
+	{
+		transpose_out_of_place<false>(rows, cols, alpha, a, b);
+	}
+
+	return 0;
+}
+
+template<bool Conjugate, typename T>
+inline void transpose_in_place(const int rows, const int cols, const T alpha, T a[])
+{
+	if (rows == cols)
+	{
+		transpose_square_in_place<Conjugate>(rows, alpha, a);
+	}
+	else
+	{
+		transpose_rectangular_in_place<Conjugate>(rows, cols, alpha, a);
+	}
+}
+
+template<typename T>
+inline int matrix_transpose_inplace(const char trans, const int rows, const int cols, const T alpha, T a[])
+{
+	bool transpose, conjugate;
+	if (!transpose_mode(trans, transpose, conjugate))
+	{
+		return -1;
+	}
+
+	if (rows <= 0 || cols <= 0)
+	{
+		return 0;
+	}
+
+	try
+	{
+		if (!transpose)
+		{
+			if (conjugate)
+			{
+				scale_copy<true>(rows * cols, alpha, a, a);
+			}
+			else
+			{
+				scale_copy<false>(rows * cols, alpha, a, a);
+			}
+		}
+		else if (conjugate)
+		{
+			transpose_in_place<true>(rows, cols, alpha, a);
+		}
+		else
+		{
+			transpose_in_place<false>(rows, cols, alpha, a);
+		}
+
+		return 0;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+#ifdef PROVIDER_MKL
+inline int mkl_transpose_ld(const char trans, const int rows, const int cols)
+{
+	return trans == 'T' || trans == 't' || trans == 'C' || trans == 'c' ? std::max(1, cols) : std::max(1, rows);
+}
+#endif
+
+extern "C" {
+
+	DLLEXPORT int s_matrix_transpose(const char trans, const int rows, const int cols, const float alpha, const float a[], float b[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_somatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), b, mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose(trans, rows, cols, alpha, a, b);
+#endif
+	}
+
+	DLLEXPORT int d_matrix_transpose(const char trans, const int rows, const int cols, const double alpha, const double a[], double b[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_domatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), b, mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose(trans, rows, cols, alpha, a, b);
+#endif
+	}
+
+	DLLEXPORT int c_matrix_transpose(const char trans, const int rows, const int cols, const lapack_complex_float alpha, const lapack_complex_float a[], lapack_complex_float b[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_comatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), b, mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose(trans, rows, cols, alpha, a, b);
+#endif
+	}
+
+	DLLEXPORT int z_matrix_transpose(const char trans, const int rows, const int cols, const lapack_complex_double alpha, const lapack_complex_double a[], lapack_complex_double b[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_zomatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), b, mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose(trans, rows, cols, alpha, a, b);
+#endif
+	}
+
+	DLLEXPORT int s_matrix_transpose_inplace(const char trans, const int rows, const int cols, const float alpha, float a[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_simatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose_inplace(trans, rows, cols, alpha, a);
+#endif
+	}
+
+	DLLEXPORT int d_matrix_transpose_inplace(const char trans, const int rows, const int cols, const double alpha, double a[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_dimatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose_inplace(trans, rows, cols, alpha, a);
+#endif
+	}
+
+	DLLEXPORT int c_matrix_transpose_inplace(const char trans, const int rows, const int cols, const lapack_complex_float alpha, lapack_complex_float a[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_cimatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose_inplace(trans, rows, cols, alpha, a);
+#endif
+	}
+
+	DLLEXPORT int z_matrix_transpose_inplace(const char trans, const int rows, const int cols, const lapack_complex_double alpha, lapack_complex_double a[])
+	{
+#ifdef PROVIDER_MKL
+		bool transpose, conjugate;
+		if (!transpose_mode(trans, transpose, conjugate))
+		{
+			return -1;
+		}
+
+		mkl_zimatcopy('C', trans, rows, cols, alpha, a, std::max(1, rows), mkl_transpose_ld(trans, rows, cols));
+		return 0;
+#else
+		return matrix_transpose_inplace(trans, rows, cols, alpha, a);
+#endif
+	}
+}
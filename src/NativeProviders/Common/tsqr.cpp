@@ -0,0 +1,495 @@
+#include "wrapper_common.h"
+
+#include "lapack.h"
+#include "lapack_common.h"
+#include "parallel.h"
+#include <algorithm>
+#include <vector>
+
+/*
+	Tall-skinny QR (TSQR) of an m x n matrix with m >> n.
+
+	The rows are split into leaves of about TSQR_LEAF_ELEMENTS elements, small
+	enough to stay in cache while ?geqrf works on them, and the leaves are
+	factored independently in parallel. Their R factors are then combined
+	pairwise in a binary reduction tree, each node factoring two stacked
+	triangles [R_i; R_j]. Only n x n triangles move between threads, and A is
+	streamed from memory once instead of once per panel.
+
+	The leaf boundaries depend on m and n only, never on the thread count, so
+	the result is reproducible.
+
+	Implicit Q: a is overwritten with the leaf reflectors below the diagonal
+	of every leaf. The upper triangle on top of leaf j holds the reflectors of
+	the tree node that consumed R_j (for the first leaf: R itself). The
+	reflectors of [R_i; R_j] are zero below the diagonal of R_i and upper
+	triangular over R_j, so that triangle is all a node needs to store.
+	tau receives x_tsqr_tau_size(m, n) scalar factors, n per leaf and node.
+*/
+
+const int TSQR_LEAF_ELEMENTS = 1 << 17;
+
+inline lapack_int tsqr_leaf_count(const lapack_int m, const lapack_int n)
+{
+	const auto leaf_rows = std::max(2 * n, TSQR_LEAF_ELEMENTS / std::max(n, 1));
+	return std::max(1, m / leaf_rows);
+}
+
+inline lapack_int tsqr_tau_size(const lapack_int m, const lapack_int n)
+{
+	return (2 * tsqr_leaf_count(m, n) - 1) * n;
+}
+
+inline lapack_int tsqr_leaf_begin(const lapack_int m, const lapack_int leaves, const lapack_int leaf)
+{
+	return parallel_chunk_begin(m, leaves, leaf);
+}
+
+// The tree node whose right child is leaf j keeps its scalar factors after those of the leaves.
+template<typename T>
+inline T* tsqr_node_tau(T tau[], const lapack_int n, const lapack_int leaves, const lapack_int j)
+{
+	return tau + static_cast<size_t>(leaves + j - 1) * n;
+}
+
+// Calls body(workspace, item, info&) for every item in parallel, with one preallocated workspace per thread.
+// MKL is kept sequential inside the workers, where its own threads would only oversubscribe.
+template<typename T, typename Body>
+inline lapack_int tsqr_parallel(const lapack_int count, const size_t workspace, Body body)
+{
+	const auto chunks = parallel_chunk_count(count, 1);
+	auto work = array_new<T>(static_cast<int>(std::max<size_t>(1, chunks * workspace)));
+	std::vector<lapack_int> status(std::max(1, chunks), 0);
+	auto* w = work.get();
+	auto* info = status.data();
+
+	parallel_for_chunks(count, chunks, [=, &body](int chunk, int begin, int end)
+	{
+#ifdef PROVIDER_MKL
+		auto previous = mkl_set_num_threads_local(1);
+#endif
+
+		for (auto item = begin; item < end && info[chunk] == 0; ++item)
+		{
+			body(w + chunk * workspace, item, info[chunk]);
+		}
+
+#ifdef PROVIDER_MKL
+		mkl_set_num_threads_local(previous);
+#endif
+	});
+
+	for (auto chunk = 0; chunk < chunks; ++chunk)
+	{
+		if (status[chunk] != 0)
+		{
+			return status[chunk];
+		}
+	}
+
+	return 0;
+}
+
+// Calls node(i, j) for all nodes of one tree level, in parallel.
+template<typename T, typename Node>
+inline lapack_int tsqr_tree_level(const lapack_int leaves, const lapack_int step, const size_t workspace, Node node)
+{
+	const auto nodes = (leaves - step + 2 * step - 1) / (2 * step);
+	return tsqr_parallel<T>(nodes, workspace, [=, &node](T* w, lapack_int k, lapack_int& info)
+	{
+		info = node(w, 2 * step * k, 2 * step * k + step);
+	});
+}
+
+// Rebuilds the 2n x n reflectors of the node over [R_i; R_j] from the triangle stored on top of leaf j.
+template<typename T>
+inline void tsqr_node_reflectors(const lapack_int m, const lapack_int n, const T rj[], T v[])
+{
+	const auto ldv = 2 * n;
+	std::fill(v, v + static_cast<size_t>(ldv) * n, T());
+
+	for (auto c = 0; c < n; ++c)
+	{
+		std::copy(rj + static_cast<size_t>(c) * m, rj + static_cast<size_t>(c) * m + c + 1, v + static_cast<size_t>(c) * ldv + n);
+	}
+}
+
+// Applies the node over [R_i; R_j] to the stacked n x bn blocks [top; bottom].
+template<typename T, typename ORMQR>
+inline lapack_int tsqr_node_apply(const lapack_int m, const lapack_int n, const lapack_int bn, const T rj[], const T tau[],
+	T top[], const lapack_int ldtop, T bottom[], const lapack_int ldbottom, const char trans, T w[], ORMQR ormqr)
+{
+	const auto ldg = 2 * n;
+	auto* v = w;
+	auto* g = w + static_cast<size_t>(ldg) * n;
+	tsqr_node_reflectors(m, n, rj, v);
+
+	for (auto c = 0; c < bn; ++c)
+	{
+		std::copy(top + static_cast<size_t>(c) * ldtop, top + static_cast<size_t>(c) * ldtop + n, g + static_cast<size_t>(c) * ldg);
+		std::copy(bottom + static_cast<size_t>(c) * ldbottom, bottom + static_cast<size_t>(c) * ldbottom + n, g + static_cast<size_t>(c) * ldg + n);
+	}
+
+	auto info = ormqr(LAPACK_COL_MAJOR, 'L', trans, ldg, bn, n, v, ldg, tau, g, ldg);
+
+	for (auto c = 0; c < bn; ++c)
+	{
+		std::copy(g + static_cast<size_t>(c) * ldg, g + static_cast<size_t>(c) * ldg + n, top + static_cast<size_t>(c) * ldtop);
+		std::copy(g + static_cast<size_t>(c) * ldg + n, g + static_cast<size_t>(c + 1) * ldg, bottom + static_cast<size_t>(c) * ldbottom);
+	}
+
+	return info;
+}
+
+template<typename T, typename GEQRF>
+inline lapack_int tsqr_factor(const lapack_int m, const lapack_int n, T a[], T r[], T tau[], GEQRF geqrf)
+{
+	if (m < 0)
+	{
+		return -1;
+	}
+
+	if (n < 0 || n > m)
+	{
+		return -2;
+	}
+
+	if (n == 0)
+	{
+		return 0;
+	}
+
+	const auto leaves = tsqr_leaf_count(m, n);
+
+	auto info = tsqr_parallel<T>(leaves, 0, [=](T*, lapack_int leaf, lapack_int& status)
+	{
+		const auto begin = tsqr_leaf_begin(m, leaves, leaf);
+		const auto rows = tsqr_leaf_begin(m, leaves, leaf + 1) - begin;
+		status = geqrf(LAPACK_COL_MAJOR, rows, n, a + begin, m, tau + static_cast<size_t>(leaf) * n);
+	});
+
+	// [R_i; R_j] is factored in a 2n x n copy; the new R goes back on top of leaf i, the reflectors on top of leaf j
+	const auto ldw = 2 * n;
+	for (auto step = 1; step < leaves && info == 0; step *= 2)
+	{
+		info = tsqr_tree_level<T>(leaves, step, static_cast<size_t>(ldw) * n, [=](T* w, lapack_int i, lapack_int j)
+		{
+			auto* ri = a + tsqr_leaf_begin(m, leaves, i);
+			auto* rj = a + tsqr_leaf_begin(m, leaves, j);
+			std::fill(w, w + static_cast<size_t>(ldw) * n, T());
+
+			for (auto c = 0; c < n; ++c)
+			{
+				std::copy(ri + static_cast<size_t>(c) * m, ri + static_cast<size_t>(c) * m + c + 1, w + static_cast<size_t>(c) * ldw);
+				std::copy(rj + static_cast<size_t>(c) * m, rj + static_cast<size_t>(c) * m + c + 1, w + static_cast<size_t>(c) * ldw + n);
+			}
+
+			auto status = geqrf(LAPACK_COL_MAJOR, ldw, n, w, ldw, tsqr_node_tau(tau, n, leaves, j));
+
+			for (auto c = 0; c < n; ++c)
+			{
+				std::copy(w + static_cast<size_t>(c) * ldw, w + static_cast<size_t>(c) * ldw + c + 1, ri + static_cast<size_t>(c) * m);
+				std::copy(w + static_cast<size_t>(c) * ldw + n, w + static_cast<size_t>(c) * ldw + n + c + 1, rj + static_cast<size_t>(c) * m);
+			}
+
+			return status;
+		});
+	}
+
+	for (auto c = 0; c < n; ++c)
+	{
+		for (auto i = 0; i < n; ++i)
+		{
+			r[c * n + i] = i <= c ? a[static_cast<size_t>(c) * m + i] : T();
+		}
+	}
+
+	return info;
+}
+
+// Overwrites the implicit factorization in a with the explicit m x n Q.
+template<typename T, typename ORMQR>
+inline lapack_int tsqr_form_q(const lapack_int m, const lapack_int n, T a[], T tau[], ORMQR ormqr)
+{
+	const auto leaves = tsqr_leaf_count(m, n);
+	const auto block = static_cast<size_t>(n) * n;
+
+	// Q = diag(Q_leaf) * Q_tree * [I; 0]; first the n x n block c_k of Q_tree * [I; 0] for every leaf, top-down
+	auto coefficients = array_new<T>(static_cast<int>(leaves * block));
+	auto* c = coefficients.get();
+	std::fill(c, c + leaves * block, T());
+
+	for (auto d = 0; d < n; ++d)
+	{
+		c[d * n + d] = T(1);
+	}
+
+	auto top = 1;
+	while (top < leaves)
+	{
+		top *= 2;
+	}
+
+	lapack_int info = 0;
+	for (auto step = top / 2; step >= 1 && info == 0; step /= 2)
+	{
+		info = tsqr_tree_level<T>(leaves, step, static_cast<size_t>(2 * n) * (2 * n), [=](T* w, lapack_int i, lapack_int j)
+		{
+			auto* rj = a + tsqr_leaf_begin(m, leaves, j);
+			return tsqr_node_apply(m, n, n, rj, tsqr_node_tau(tau, n, leaves, j), c + i * block, n, c + j * block, n, 'N', w, ormqr);
+		});
+	}
+
+	if (info != 0)
+	{
+		return info;
+	}
+
+	// then every leaf becomes Q_leaf * [c_k; 0], built in a leaf-sized buffer and copied over the reflectors
+	const auto max_rows = tsqr_leaf_begin(m, leaves, 1) + 1;
+	return tsqr_parallel<T>(leaves, static_cast<size_t>(max_rows) * n, [=](T* w, lapack_int leaf, lapack_int& status)
+	{
+		const auto begin = tsqr_leaf_begin(m, leaves, leaf);
+		const auto rows = tsqr_leaf_begin(m, leaves, leaf + 1) - begin;
+		const auto* ck = c + leaf * block;
+		std::fill(w, w + static_cast<size_t>(rows) * n, T());
+
+		for (auto col = 0; col < n; ++col)
+		{
+			std::copy(ck + static_cast<size_t>(col) * n, ck + static_cast<size_t>(col + 1) * n, w + static_cast<size_t>(col) * rows);
+		}
+
+		status = ormqr(LAPACK_COL_MAJOR, 'L', 'N', rows, n, n, a + begin, m, tau + static_cast<size_t>(leaf) * n, w, rows);
+
+		for (auto col = 0; col < n; ++col)
+		{
+			std::copy(w + static_cast<size_t>(col) * rows, w + static_cast<size_t>(col + 1) * rows, a + static_cast<size_t>(col) * m + begin);
+		}
+	});
+}
+
+// b := Q' * b for the m x bn matrix b, bottom-up through the tree; the first n rows of b then hold the reduced right-hand side.
+template<typename T, typename ORMQR>
+inline lapack_int tsqr_apply_adjoint(const lapack_int m, const lapack_int n, const lapack_int bn, const T a[], const T tau[], T b[], const char adjoint, ORMQR ormqr)
+{
+	const auto leaves = tsqr_leaf_count(m, n);
+
+	auto info = tsqr_parallel<T>(leaves, 0, [=](T*, lapack_int leaf, lapack_int& status)
+	{
+		const auto begin = tsqr_leaf_begin(m, leaves, leaf);
+		const auto rows = tsqr_leaf_begin(m, leaves, leaf + 1) - begin;
+		status = ormqr(LAPACK_COL_MAJOR, 'L', adjoint, rows, bn, n, a + begin, m, tau + static_cast<size_t>(leaf) * n, b + begin, m);
+	});
+
+	for (auto step = 1; step < leaves && info == 0; step *= 2)
+	{
+		info = tsqr_tree_level<T>(leaves, step, static_cast<size_t>(2 * n) * (n + bn), [=](T* w, lapack_int i, lapack_int j)
+		{
+			const auto begin_i = tsqr_leaf_begin(m, leaves, i);
+			const auto begin_j = tsqr_leaf_begin(m, leaves, j);
+			return tsqr_node_apply(m, n, bn, a + begin_j, tsqr_node_tau(tau, n, leaves, j), b + begin_i, m, b + begin_j, m, adjoint, w, ormqr);
+		});
+	}
+
+	return info;
+}
+
+template<typename T, typename ORMQR, typename TRTRS>
+inline lapack_int tsqr_solve_factored(const lapack_int m, const lapack_int n, const lapack_int bn, const T a[], const T b[], const T tau[], T x[],
+	const char adjoint, ORMQR ormqr, TRTRS trtrs)
+{
+	if (m < 0)
+	{
+		return -1;
+	}
+
+	if (n < 0 || n > m)
+	{
+		return -2;
+	}
+
+	if (bn < 0)
+	{
+		return -3;
+	}
+
+	try
+	{
+		auto clone_b = array_clone(m * bn, b);
+		auto info = tsqr_apply_adjoint(m, n, bn, a, tau, clone_b.get(), adjoint, ormqr);
+
+		if (info != 0)
+		{
+			return info;
+		}
+
+		info = trtrs(LAPACK_COL_MAJOR, 'U', 'N', 'N', n, bn, a, m, clone_b.get(), m);
+		copyBtoX(m, n, bn, clone_b.get(), x);
+		return info;
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GEQRF>
+inline lapack_int tsqr_factor_checked(const lapack_int m, const lapack_int n, T a[], T r[], T tau[], GEQRF geqrf)
+{
+	try
+	{
+		return tsqr_factor(m, n, a, r, tau, geqrf);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GEQRF, typename ORMQR>
+inline lapack_int tsqr_thin_factor(const lapack_int m, const lapack_int n, T q[], T r[], GEQRF geqrf, ORMQR ormqr)
+{
+	try
+	{
+		auto tau = array_new<T>(std::max(1, tsqr_tau_size(m, std::max(n, 0))));
+		auto info = tsqr_factor(m, n, q, r, tau.get(), geqrf);
+
+		if (info != 0 || n == 0)
+		{
+			return info;
+		}
+
+		return tsqr_form_q(m, n, q, tau.get(), ormqr);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+template<typename T, typename GEQRF, typename ORMQR, typename TRTRS>
+inline lapack_int tsqr_solve(const lapack_int m, const lapack_int n, const lapack_int bn, const T a[], const T b[], T x[],
+	const char adjoint, GEQRF geqrf, ORMQR ormqr, TRTRS trtrs)
+{
+	try
+	{
+		auto clone_a = array_clone(m * n, a);
+		auto tau = array_new<T>(std::max(1, tsqr_tau_size(m, std::max(n, 0))));
+		auto r = array_new<T>(std::max(1, n * n));
+		auto info = tsqr_factor(m, n, clone_a.get(), r.get(), tau.get(), geqrf);
+
+		if (info != 0)
+		{
+			return info;
+		}
+
+		return tsqr_solve_factored(m, n, bn, clone_a.get(), b, tau.get(), x, adjoint, ormqr, trtrs);
+	}
+	catch (std::bad_alloc&)
+	{
+		return INSUFFICIENT_MEMORY;
+	}
+}
+
+extern "C" {
+
+	DLLEXPORT lapack_int s_tsqr_tau_size(lapack_int m, lapack_int n)
+	{
+		return tsqr_tau_size(m, n);
+	}
+
+	DLLEXPORT lapack_int d_tsqr_tau_size(lapack_int m, lapack_int n)
+	{
+		return tsqr_tau_size(m, n);
+	}
+
+	DLLEXPORT lapack_int c_tsqr_tau_size(lapack_int m, lapack_int n)
+	{
+		return tsqr_tau_size(m, n);
+	}
+
+	DLLEXPORT lapack_int z_tsqr_tau_size(lapack_int m, lapack_int n)
+	{
+		return tsqr_tau_size(m, n);
+	}
+
+	DLLEXPORT lapack_int s_tsqr_factor(lapack_int m, lapack_int n, float a[], float r[], float tau[])
+	{
+		return tsqr_factor_checked(m, n, a, r, tau, LAPACKE_sgeqrf);
+	}
+
+	DLLEXPORT lapack_int d_tsqr_factor(lapack_int m, lapack_int n, double a[], double r[], double tau[])
+	{
+		return tsqr_factor_checked(m, n, a, r, tau, LAPACKE_dgeqrf);
+	}
+
+	DLLEXPORT lapack_int c_tsqr_factor(lapack_int m, lapack_int n, lapack_complex_float a[], lapack_complex_float r[], lapack_complex_float tau[])
+	{
+		return tsqr_factor_checked(m, n, a, r, tau, LAPACKE_cgeqrf);
+	}
+
+	DLLEXPORT lapack_int z_tsqr_factor(lapack_int m, lapack_int n, lapack_complex_double a[], lapack_complex_double r[], lapack_complex_double tau[])
+	{
+		return tsqr_factor_checked(m, n, a, r, tau, LAPACKE_zgeqrf);
+	}
+
+	DLLEXPORT lapack_int s_tsqr_thin_factor(lapack_int m, lapack_int n, float q[], float r[])
+	{
+		return tsqr_thin_factor(m, n, q, r, LAPACKE_sgeqrf, LAPACKE_sormqr);
+	}
+
+	DLLEXPORT lapack_int d_tsqr_thin_factor(lapack_int m, lapack_int n, double q[], double r[])
+	{
+		return tsqr_thin_factor(m, n, q, r, LAPACKE_dgeqrf, LAPACKE_dormqr);
+	}
+
+	DLLEXPORT lapack_int c_tsqr_thin_factor(lapack_int m, lapack_int n, lapack_complex_float q[], lapack_complex_float r[])
+	{
+		return tsqr_thin_factor(m, n, q, r, LAPACKE_cgeqrf, LAPACKE_cunmqr);
+	}
+
+	DLLEXPORT lapack_int z_tsqr_thin_factor(lapack_int m, lapack_int n, lapack_complex_double q[], lapack_complex_double r[])
+	{
+		return tsqr_thin_factor(m, n, q, r, LAPACKE_zgeqrf, LAPACKE_zunmqr);
+	}
+
+	DLLEXPORT lapack_int s_tsqr_solve_factored(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float tau[], float x[])
+	{
+		return tsqr_solve_factored(m, n, bn, a, b, tau, x, 'T', LAPACKE_sormqr, LAPACKE_strtrs);
+	}
+
+	DLLEXPORT lapack_int d_tsqr_solve_factored(lapack_int m, lapack_int n, lapack_int bn, double a[], double b[], double tau[], double x[])
+	{
+		return tsqr_solve_factored(m, n, bn, a, b, tau, x, 'T', LAPACKE_dormqr, LAPACKE_dtrtrs);
+	}
+
+	DLLEXPORT lapack_int c_tsqr_solve_factored(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float tau[], lapack_complex_float x[])
+	{
+		return tsqr_solve_factored(m, n, bn, a, b, tau, x, 'C', LAPACKE_cunmqr, LAPACKE_ctrtrs);
+	}
+
+	DLLEXPORT lapack_int z_tsqr_solve_factored(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double tau[], lapack_complex_double x[])
+	{
+		return tsqr_solve_factored(m, n, bn, a, b, tau, x, 'C', LAPACKE_zunmqr, LAPACKE_ztrtrs);
+	}
+
+	DLLEXPORT lapack_int s_tsqr_solve(lapack_int m, lapack_int n, lapack_int bn, float a[], float b[], float x[])
+	{
+		return tsqr_solve(m, n, bn, a, b, x, 'T', LAPACKE_sgeqrf, LAPACKE_sormqr, LAPACKE_strtrs);
+	}
+
+	DLLEXPORT lapack_int d_tsqr_solve(lapack_int m, lapack_int n, lapack_int bn, double a[], double b[], double x[])
+	{
+		return tsqr_solve(m, n, bn, a, b, x, 'T', LAPACKE_dgeqrf, LAPACKE_dormqr, LAPACKE_dtrtrs);
+	}
+
+	DLLEXPORT lapack_int c_tsqr_solve(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_float a[], lapack_complex_float b[], lapack_complex_float x[])
+	{
+		return tsqr_solve(m, n, bn, a, b, x, 'C', LAPACKE_cgeqrf, LAPACKE_cunmqr, LAPACKE_ctrtrs);
+	}
+
+	DLLEXPORT lapack_int z_tsqr_solve(lapack_int m, lapack_int n, lapack_int bn, lapack_complex_double a[], lapack_complex_double b[], lapack_complex_double x[])
+	{
+		return tsqr_solve(m, n, bn, a, b, x, 'C', LAPACKE_zgeqrf, LAPACKE_zunmqr, LAPACKE_ztrtrs);
+	}
+}
@@ -8,10 +8,10 @@ export OUT=../../../out/MKL/Linux
 mkdir -p $OUT/x64
 mkdir -p $OUT/x86
 
-g++ -std=c++11 -D_M_X64 -DGCC -m64 --shared -fPIC -o $OUT/x64/libNumericsMKL.so -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../MKL/fft.cpp -Wl,--start-group  $MKL/lib/intel64/libmkl_intel_lp64.a $MKL/lib/intel64/libmkl_intel_thread.a $MKL/lib/intel64/libmkl_core.a -Wl,--end-group -L$OPENMP/intel64_lin -liomp5 -lpthread -lm
+g++ -std=c++11 -D_M_X64 -DGCC -m64 --shared -fPIC -o $OUT/x64/libNumericsMKL.so -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../Common/fused.cpp ../Common/reductions.cpp ../Common/complex.cpp ../Common/cholesky_update.cpp ../Common/tsqr.cpp ../Common/banded.cpp ../Common/ldl.cpp ../Common/condition.cpp ../Common/generalized_eigen.cpp ../Common/matrix_functions.cpp ../Common/sylvester.cpp ../Common/transpose.cpp ../Common/sparse_product.cpp ../Common/sparse_triangular.cpp ../Common/sparse_incomplete.cpp ../Common/sparse_krylov.cpp ../Common/sparse_ordering.cpp ../Common/sparse_block.cpp ../Common/sparse_csr.cpp ../Common/sparse_sell.cpp ../Common/sparse_eigen.cpp ../MKL/fft.cpp -Wl,--start-group  $MKL/lib/intel64/libmkl_intel_lp64.a $MKL/lib/intel64/libmkl_intel_thread.a $MKL/lib/intel64/libmkl_core.a -Wl,--end-group -L$OPENMP/intel64_lin -liomp5 -lpthread -lm
 
 cp $OPENMP/intel64_lin/libiomp5.so  $OUT/x64/
 
-g++ -std=c++11 -D_M_IX86 -DGCC -m32 --shared -fPIC -o $OUT/x86/libNumericsMKL.so -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../MKL/fft.cpp  -Wl,--start-group $MKL/lib/ia32/libmkl_intel.a $MKL/lib/ia32/libmkl_intel_thread.a $MKL/lib/ia32/libmkl_core.a -Wl,--end-group -L$OPENMP/ia32_lin -liomp5 -lpthread -lm
+g++ -std=c++11 -D_M_IX86 -DGCC -m32 --shared -fPIC -o $OUT/x86/libNumericsMKL.so -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../Common/fused.cpp ../Common/reductions.cpp ../Common/complex.cpp ../Common/cholesky_update.cpp ../Common/tsqr.cpp ../Common/banded.cpp ../Common/ldl.cpp ../Common/condition.cpp ../Common/generalized_eigen.cpp ../Common/matrix_functions.cpp ../Common/sylvester.cpp ../Common/transpose.cpp ../Common/sparse_product.cpp ../Common/sparse_triangular.cpp ../Common/sparse_incomplete.cpp ../Common/sparse_krylov.cpp ../Common/sparse_ordering.cpp ../Common/sparse_block.cpp ../Common/sparse_csr.cpp ../Common/sparse_sell.cpp ../Common/sparse_eigen.cpp ../MKL/fft.cpp  -Wl,--start-group $MKL/lib/ia32/libmkl_intel.a $MKL/lib/ia32/libmkl_intel_thread.a $MKL/lib/ia32/libmkl_core.a -Wl,--end-group -L$OPENMP/ia32_lin -liomp5 -lpthread -lm
 
 cp $OPENMP/ia32_lin/libiomp5.so  $OUT/x86/
@@ -1,5 +1,6 @@
 #include "wrapper_common.h"
 #include "mkl.h"
+#include "parallel.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,9 +74,9 @@ extern "C" {
 
 		// LINEAR ALGEBRA
 		case 128: return 2;	// basic dense linear algebra (major - breaking)
-		case 129: return 0;	// basic dense linear algebra (minor - non-breaking)
+		case 129: return 24;	// basic dense linear algebra (minor - non-breaking)
 		case 130: return 0;	// vector functions (major - breaking)
-		case 131: return 1;	// vector functions (minor - non-breaking)
+		case 131: return 3;	// vector functions (minor - non-breaking)
 
 		// OPTIMIZATION
 		case 256: return 0; // basic optimization
@@ -106,6 +107,7 @@ extern "C" {
 	DLLEXPORT void set_max_threads(const MKL_INT num_threads)
 	{
 		mkl_set_num_threads(num_threads);
+		parallel_thread_limit() = num_threads;
 	}
 
 	/* Obsolete, will be dropped in the next revision */
@@ -2,6 +2,48 @@
 #include "dss.h"
 #include <mkl_spblas.h>
 
+// Body of the x_dss_solve_ordered exports; isComplex selects the real or complex DSS
+// factor and solve. Every failure after dss_create still goes through dss_delete.
+static dss_int dss_solve_ordered(const dss_int isComplex, const dss_int matrixStructure, const dss_int matrixType, const dss_int systemType,
+    const dss_int nRows, const dss_int nCols, const dss_int nnz, const dss_int rowIdx[], const dss_int colPtr[], const void* values,
+    const dss_int nRhs, const void* rhsValues, void* solValues, const dss_int userOrder, dss_int perm[])
+{
+    _MKL_DSS_HANDLE_t handle;
+    dss_int error, cleanup;
+
+    dss_int opt = MKL_DSS_MSG_LVL_WARNING + MKL_DSS_TERM_LVL_ERROR + MKL_DSS_ZERO_BASED_INDEXING;
+    opt += systemType;
+
+    dss_int order = opt;
+    if (userOrder) order += MKL_DSS_MY_ORDER;
+    else if (perm) order += MKL_DSS_AUTO_ORDER + MKL_DSS_GET_ORDER;
+    else order += MKL_DSS_AUTO_ORDER;
+
+    // Initialize the solver
+    error = dss_create(handle, opt);
+    if (error != MKL_DSS_SUCCESS) return error;
+
+    // Define the non-zero structure of the matrix
+    error = dss_define_structure(handle, matrixStructure, rowIdx, nRows, nCols, colPtr, nnz);
+    if (error != MKL_DSS_SUCCESS) goto done;
+
+    // Reorder the matrix with, or into, perm[]
+    error = dss_reorder(handle, order, perm);
+    if (error != MKL_DSS_SUCCESS) goto done;
+
+    // Factor the matrix
+    error = isComplex ? dss_factor_complex(handle, matrixType, values) : dss_factor_real(handle, matrixType, values);
+    if (error != MKL_DSS_SUCCESS) goto done;
+
+    // Get the solution vector
+    error = isComplex ? dss_solve_complex(handle, opt, rhsValues, nRhs, solValues) : dss_solve_real(handle, opt, rhsValues, nRhs, solValues);
+
+done:
+    // Deallocate solver storage; the first error wins
+    cleanup = dss_delete(handle, opt);
+    return error != MKL_DSS_SUCCESS ? error : cleanup;
+}
+
 #if __cplusplus
 extern "C" {
 #endif
@@ -149,6 +191,42 @@ extern "C" {
     }
 
 
+    // Same as x_dss_solve, with the fill-reducing ordering exposed so it can be computed once and reused:
+    // if userOrder is nonzero, perm[] is used as the ordering (MKL_DSS_MY_ORDER); otherwise the automatic
+    // ordering is computed and, if perm is not null, returned in it (MKL_DSS_GET_ORDER). Row i of the matrix
+    // is row perm[i] of the reordered one, as in the inverse[] array returned by the sparse_reorder_* exports.
+
+    DLLEXPORT dss_int s_dss_solve_ordered(const dss_int matrixStructure, const dss_int matrixType, const dss_int systemType,
+        const dss_int nRows, const dss_int nCols, const dss_int nnz, const dss_int rowIdx[], const dss_int colPtr[], const float values[],
+        const dss_int nRhs, const float rhsValues[], float solValues[], const dss_int userOrder, dss_int perm[])
+    {
+        return dss_solve_ordered(0, matrixStructure, matrixType, systemType, nRows, nCols, nnz, rowIdx, colPtr, values,
+            nRhs, rhsValues, solValues, userOrder, perm);
+    }
+
+    DLLEXPORT dss_int d_dss_solve_ordered(const dss_int matrixStructure, const dss_int matrixType, const dss_int systemType,
+        const dss_int nRows, const dss_int nCols, const dss_int nnz, const dss_int rowIdx[], const dss_int colPtr[], const double values[],
+        const dss_int nRhs, const double rhsValues[], double solValues[], const dss_int userOrder, dss_int perm[])
+    {
+        return dss_solve_ordered(0, matrixStructure, matrixType, systemType, nRows, nCols, nnz, rowIdx, colPtr, values,
+            nRhs, rhsValues, solValues, userOrder, perm);
+    }
+
+    DLLEXPORT dss_int c_dss_solve_ordered(const dss_int matrixStructure, const dss_int matrixType, const dss_int systemType,
+        const dss_int nRows, const dss_int nCols, const dss_int nnz, const dss_int rowIdx[], const dss_int colPtr[], const dss_complex_float values[],
+        const dss_int nRhs, const dss_complex_float rhsValues[], dss_complex_float solValues[], const dss_int userOrder, dss_int perm[])
+    {
+        return dss_solve_ordered(1, matrixStructure, matrixType, systemType, nRows, nCols, nnz, rowIdx, colPtr, values,
+            nRhs, rhsValues, solValues, userOrder, perm);
+    }
+
+    DLLEXPORT dss_int z_dss_solve_ordered(const dss_int matrixStructure, const dss_int matrixType, const dss_int systemType,
+        const dss_int nRows, const dss_int nCols, const dss_int nnz, const dss_int rowIdx[], const dss_int colPtr[], const dss_complex_double values[],
+        const dss_int nRhs, const dss_complex_double rhsValues[], dss_complex_double solValues[], const dss_int userOrder, dss_int perm[])
+    {
+        return dss_solve_ordered(1, matrixStructure, matrixType, systemType, nRows, nCols, nnz, rowIdx, colPtr, values,
+            nRhs, rhsValues, solValues, userOrder, perm);
+    }
 
 #if __cplusplus
 }
@@ -6,6 +6,7 @@
 #define MKL_Complex8 std::complex<float>
 #define MKL_Complex16 std::complex<double>
 #define LAPACK_MEMORY
+#define PROVIDER_MKL
 
 #include "mkl.h"
 
@@ -6,10 +6,10 @@ export OUT=../../../out/MKL/OSX
 mkdir -p $OUT/x64
 mkdir -p $OUT/x86
 
-clang++ -std=c++11 -D_M_X64 -DGCC -m64 --shared -fPIC -o $OUT/x64/libNumericsMKL.dylib -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../MKL/fft.cpp  $MKL/lib/libmkl_intel_lp64.a $MKL/lib/libmkl_core.a $MKL/lib/libmkl_intel_thread.a -L$OPENMP -liomp5 -lpthread -lm
+clang++ -std=c++11 -D_M_X64 -DGCC -m64 --shared -fPIC -o $OUT/x64/libNumericsMKL.dylib -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../Common/fused.cpp ../Common/reductions.cpp ../Common/complex.cpp ../Common/cholesky_update.cpp ../Common/tsqr.cpp ../Common/banded.cpp ../Common/ldl.cpp ../Common/condition.cpp ../Common/generalized_eigen.cpp ../Common/matrix_functions.cpp ../Common/sylvester.cpp ../Common/transpose.cpp ../Common/sparse_product.cpp ../Common/sparse_triangular.cpp ../Common/sparse_incomplete.cpp ../Common/sparse_krylov.cpp ../Common/sparse_ordering.cpp ../Common/sparse_block.cpp ../Common/sparse_csr.cpp ../Common/sparse_sell.cpp ../Common/sparse_eigen.cpp ../MKL/fft.cpp  $MKL/lib/libmkl_intel_lp64.a $MKL/lib/libmkl_core.a $MKL/lib/libmkl_intel_thread.a -L$OPENMP -liomp5 -lpthread -lm
 
 cp $OPENMP/libiomp5.dylib  $OUT/x64/
 
-clang++ -std=c++11 -D_M_IX86 -DGCC -m32 --shared -fPIC -o $OUT/x86/libNumericsMKL.dylib -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../MKL/fft.cpp  $MKL/lib/libmkl_intel_lp64.a $MKL/lib/libmkl_core.a $MKL/lib/libmkl_intel_thread.a -L$OPENMP -liomp5 -lpthread -lm
+clang++ -std=c++11 -D_M_IX86 -DGCC -m32 --shared -fPIC -o $OUT/x86/libNumericsMKL.dylib -I$MKL/include -I../Common -I../MKL ../MKL/memory.c ../MKL/capabilities.cpp ../MKL/vector_functions.c ../Common/blas.c ../Common/lapack.cpp ../Common/fused.cpp ../Common/reductions.cpp ../Common/complex.cpp ../Common/cholesky_update.cpp ../Common/tsqr.cpp ../Common/banded.cpp ../Common/ldl.cpp ../Common/condition.cpp ../Common/generalized_eigen.cpp ../Common/matrix_functions.cpp ../Common/sylvester.cpp ../Common/transpose.cpp ../Common/sparse_product.cpp ../Common/sparse_triangular.cpp ../Common/sparse_incomplete.cpp ../Common/sparse_krylov.cpp ../Common/sparse_ordering.cpp ../Common/sparse_block.cpp ../Common/sparse_csr.cpp ../Common/sparse_sell.cpp ../Common/sparse_eigen.cpp ../MKL/fft.cpp  $MKL/lib/libmkl_intel_lp64.a $MKL/lib/libmkl_core.a $MKL/lib/libmkl_intel_thread.a -L$OPENMP -liomp5 -lpthread -lm
 
 cp $OPENMP/libiomp5.dylib  $OUT/x86/
@@ -1,5 +1,6 @@
 #include "wrapper_common.h"
 #include "cblas.h"
+#include "parallel.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,7 +47,7 @@ extern "C" {
 
 		// LINEAR ALGEBRA
 		case 128: return 1;	// basic dense linear algebra (major - breaking)
-		case 129: return 0;	// basic dense linear algebra (minor - non-breaking)
+		case 129: return 24;	// basic dense linear algebra (minor - non-breaking)
 
 		default: return 0; // unknown or not supported
 
@@ -56,6 +57,7 @@ extern "C" {
 	DLLEXPORT void set_max_threads(const blasint num_threads)
 	{
 		openblas_set_num_threads(num_threads);
+		parallel_thread_limit() = num_threads;
 	}
 
 	DLLEXPORT char* get_build_config()
@@ -31,6 +31,7 @@
 using AHSEsim.Numerics.LinearAlgebra.Complex;
 using AHSEsim.Numerics.LinearAlgebra.Complex.Factorization;
 using AHSEsim.Numerics.LinearAlgebra.Factorization;
+using AHSEsim.Numerics.Providers.LinearAlgebra;
 using NUnit.Framework;
 
 namespace AHSEsim.Numerics.Tests.LinearAlgebraTests.Complex.Factorization
@@ -719,5 +720,57 @@ public void CanSolveForVectorWithTallRandomMatrix(QRMethod method)
                 }
             }
         }
+
+        /// <summary>
+        /// Column pivoted QR returns the minimum norm solution of a rank deficient system.
+        /// </summary>
+        [Test]
+        public void ColumnPivotedQRSolveReturnsMinimumNormSolution()
+        {
+            var matrixA = Matrix<Complex>.Build.Random(12, 3, 1)*Matrix<Complex>.Build.Random(3, 5, 2);
+            var matrixB = Matrix<Complex>.Build.Random(12, 2, 3);
+
+            var factorQR = matrixA.QR(QRMethod.ColumnPivoted);
+            Assert.AreEqual(3, factorQR.Rank);
+
+            var resultX = factorQR.Solve(matrixB);
+            var expectedX = matrixA.PseudoInverse()*matrixB;
+            for (var i = 0; i < expectedX.RowCount; i++)
+            {
+                for (var j = 0; j < expectedX.ColumnCount; j++)
+                {
+                    AssertHelpers.AlmostEqual(expectedX[i, j], resultX[i, j], 10);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The managed rank revealing solver returns the minimum norm solution for tall and wide matrices.
+        /// </summary>
+        /// <param name="rows">Matrix row number.</param>
+        /// <param name="columns">Matrix column number.</param>
+        /// <param name="rank">Rank of the matrix.</param>
+        [TestCase(12, 5, 3)]
+        [TestCase(6, 6, 6)]
+        [TestCase(5, 12, 5)]
+        [TestCase(5, 12, 2)]
+        public void ManagedQRSolveRankRevealingReturnsMinimumNormSolution(int rows, int columns, int rank)
+        {
+            var matrixA = Matrix<Complex>.Build.Random(rows, rank, 1)*Matrix<Complex>.Build.Random(rank, columns, 2);
+            var matrixB = Matrix<Complex>.Build.Random(rows, 2, 3);
+            var matrixX = new DenseMatrix(columns, 2);
+
+            var result = ManagedLinearAlgebraProvider.Instance.QRSolveRankRevealing(((DenseMatrix) matrixA).Values, rows, columns, ((DenseMatrix) matrixB).Values, 2, matrixX.Values);
+            Assert.AreEqual(rank, result);
+
+            var expectedX = matrixA.PseudoInverse()*matrixB;
+            for (var i = 0; i < expectedX.RowCount; i++)
+            {
+                for (var j = 0; j < expectedX.ColumnCount; j++)
+                {
+                    AssertHelpers.AlmostEqual(expectedX[i, j], matrixX[i, j], 10);
+                }
+            }
+        }
     }
 }
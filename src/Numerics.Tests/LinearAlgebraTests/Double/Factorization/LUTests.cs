@@ -27,6 +27,7 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 // </copyright>
 
+using System;
 using AHSEsim.Numerics.LinearAlgebra;
 using AHSEsim.Numerics.LinearAlgebra.Double;
 using NUnit.Framework;
@@ -100,6 +101,54 @@ public void IdentityDeterminantIsOne(int order)
             Assert.AreEqual(1.0, lu.Determinant);
         }
 
+        /// <summary>
+        /// Log determinant does not overflow where the determinant does.
+        /// </summary>
+        [Test]
+        public void DeterminantLnDoesNotOverflow()
+        {
+            var matrix = Matrix<double>.Build.DenseDiagonal(200, 200, 1e5);
+            matrix.SetRow(0, Vector<double>.Build.Dense(200, j => j == 1 ? 1e5 : 0.0));
+            matrix.SetRow(1, Vector<double>.Build.Dense(200, j => j == 0 ? 1e5 : 0.0));
+            var lu = matrix.LU();
+            Assert.IsTrue(double.IsInfinity(lu.Determinant));
+            Assert.AreEqual(200*Math.Log(1e5), lu.DeterminantLn, 1e-10);
+            Assert.AreEqual(-1.0, lu.DeterminantSign);
+        }
+
+        /// <summary>
+        /// Sign and log determinant reproduce the determinant of a random matrix.
+        /// </summary>
+        /// <param name="order">Matrix order.</param>
+        [TestCase(1)]
+        [TestCase(5)]
+        [TestCase(10)]
+        public void DeterminantSignAndLnMatchDeterminant(int order)
+        {
+            var matrixX = Matrix<double>.Build.Random(order, order, 1);
+            var lu = matrixX.LU();
+            var det = lu.DeterminantSign*Math.Exp(lu.DeterminantLn);
+            Assert.AreEqual(lu.Determinant, det, 1e-10*Math.Abs(lu.Determinant));
+        }
+
+        /// <summary>
+        /// Reciprocal condition estimate is exact for a diagonal matrix and close to the exact value otherwise.
+        /// </summary>
+        [Test]
+        public void ReciprocalConditionNumberMatchesInverse()
+        {
+            var diagonal = Matrix<double>.Build.DenseDiagonal(4, 4, i => Math.Pow(10.0, i));
+            Assert.AreEqual(1e-3, diagonal.LU().ReciprocalConditionNumber, 1e-15);
+
+            var matrix = Matrix<double>.Build.Random(20, 20, 1);
+            var exact = 1.0/(matrix.L1Norm()*matrix.Inverse().L1Norm());
+            var estimate = matrix.LU().ReciprocalConditionNumber;
+            Assert.That(estimate, Is.InRange(exact*0.1, exact*10.0));
+
+            var singular = Matrix<double>.Build.Dense(3, 3, 1.0);
+            Assert.AreEqual(0.0, singular.LU().ReciprocalConditionNumber);
+        }
+
         /// <summary>
         /// Can factorize a random square matrix.
         /// </summary>
@@ -1,4 +1,4 @@
-// <copyright file="QRTests.cs" company="AHSEsim">
+﻿// <copyright file="QRTests.cs" company="AHSEsim">
 // AHSEsim Numerics, part of the AHSEsim Project
 // http://numerics.mathdotnet.com
 // http://github.com/mathnet/mathnet-numerics
@@ -32,6 +32,7 @@
 using AHSEsim.Numerics.LinearAlgebra.Double;
 using AHSEsim.Numerics.LinearAlgebra.Double.Factorization;
 using AHSEsim.Numerics.LinearAlgebra.Factorization;
+using AHSEsim.Numerics.Providers.LinearAlgebra;
 using NUnit.Framework;
 
 namespace AHSEsim.Numerics.Tests.LinearAlgebraTests.Double.Factorization
@@ -247,6 +248,139 @@ public void CanFactorizeRandomMatrixUsingThinQR(int row, int column)
             }
         }
 
+        /// <summary>
+        /// Can factorize a random matrix using column pivoted QR.
+        /// </summary>
+        /// <param name="row">Matrix row number.</param>
+        /// <param name="column">Matrix column number.</param>
+        [TestCase(1, 1)]
+        [TestCase(2, 2)]
+        [TestCase(5, 5)]
+        [TestCase(10, 6)]
+        [TestCase(50, 48)]
+        [TestCase(100, 98)]
+        public void CanFactorizeRandomMatrixUsingColumnPivotedQR(int row, int column)
+        {
+            var matrixA = Matrix<double>.Build.Random(row, column, 1);
+            var factorQR = matrixA.QR(QRMethod.ColumnPivoted);
+            var q = factorQR.Q;
+            var r = factorQR.R;
+
+            Assert.AreEqual(column, r.RowCount);
+            Assert.AreEqual(column, r.ColumnCount);
+            Assert.AreEqual(row, q.RowCount);
+            Assert.AreEqual(column, q.ColumnCount);
+            Assert.AreEqual(column, factorQR.Rank);
+
+            // Make sure the diagonal of R is non-increasing in magnitude.
+            for (var i = 1; i < r.RowCount; i++)
+            {
+                Assert.LessOrEqual(Math.Abs(r[i, i]), Math.Abs(r[i - 1, i - 1])*(1.0 + 1.0e-12));
+            }
+
+            // Make sure the Q*R is the column permuted original matrix.
+            var matrixAP = matrixA.Clone();
+            matrixAP.PermuteColumns(factorQR.P);
+            var matrixQfromR = q*r;
+            for (var i = 0; i < matrixQfromR.RowCount; i++)
+            {
+                for (var j = 0; j < matrixQfromR.ColumnCount; j++)
+                {
+                    Assert.AreEqual(matrixAP[i, j], matrixQfromR[i, j], 1.0e-11);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Column pivoted QR reveals the rank of a rank deficient matrix and still solves consistent systems.
+        /// </summary>
+        [Test]
+        public void CanSolveRankDeficientSystemUsingColumnPivotedQR()
+        {
+            var matrixA = Matrix<double>.Build.Random(20, 6, 1);
+            matrixA.SetColumn(4, matrixA.Column(0)*2.0 - matrixA.Column(1));
+            matrixA.SetColumn(5, matrixA.Column(2)*0.5);
+
+            var factorQR = matrixA.QR(QRMethod.ColumnPivoted);
+            Assert.AreEqual(4, factorQR.Rank);
+
+            var vectorb = matrixA*Vector<double>.Build.Random(6, 2);
+            var resultx = factorQR.Solve(vectorb);
+            var matrixBReconstruct = matrixA*resultx;
+
+            for (var i = 0; i < vectorb.Count; i++)
+            {
+                Assert.AreEqual(vectorb[i], matrixBReconstruct[i], 1.0e-10);
+            }
+        }
+
+        /// <summary>
+        /// Column pivoted QR returns the minimum norm solution of a rank deficient system.
+        /// </summary>
+        [Test]
+        public void ColumnPivotedQRSolveReturnsMinimumNormSolution()
+        {
+            var matrixA = Matrix<double>.Build.Random(12, 5, 1);
+            matrixA.SetColumn(3, matrixA.Column(0) + matrixA.Column(1));
+            matrixA.SetColumn(4, matrixA.Column(2)*-3.0);
+
+            var matrixB = Matrix<double>.Build.Random(12, 2, 2);
+            var resultX = matrixA.QR(QRMethod.ColumnPivoted).Solve(matrixB);
+            var expectedX = matrixA.PseudoInverse()*matrixB;
+
+            for (var i = 0; i < expectedX.RowCount; i++)
+            {
+                for (var j = 0; j < expectedX.ColumnCount; j++)
+                {
+                    Assert.AreEqual(expectedX[i, j], resultX[i, j], 1.0e-10);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The managed rank revealing solver returns the minimum norm solution for tall, square and wide matrices
+        /// of full and deficient rank.
+        /// </summary>
+        /// <param name="rows">Matrix row number.</param>
+        /// <param name="columns">Matrix column number.</param>
+        /// <param name="rank">Rank of the matrix.</param>
+        [TestCase(12, 5, 3)]
+        [TestCase(8, 8, 8)]
+        [TestCase(8, 8, 5)]
+        [TestCase(5, 12, 5)]
+        [TestCase(5, 12, 2)]
+        public void ManagedQRSolveRankRevealingReturnsMinimumNormSolution(int rows, int columns, int rank)
+        {
+            var matrixA = Matrix<double>.Build.Random(rows, rank, 1)*Matrix<double>.Build.Random(rank, columns, 2);
+            var matrixB = Matrix<double>.Build.Random(rows, 3, 3);
+            var matrixX = new DenseMatrix(columns, 3);
+            var values = ((DenseMatrix) matrixA).Values;
+            var copy = (double[]) values.Clone();
+
+            var result = ManagedLinearAlgebraProvider.Instance.QRSolveRankRevealing(values, rows, columns, ((DenseMatrix) matrixB).Values, 3, matrixX.Values);
+            Assert.AreEqual(rank, result);
+            Assert.AreEqual(copy, values);
+
+            var expectedX = matrixA.PseudoInverse()*matrixB;
+            for (var i = 0; i < expectedX.RowCount; i++)
+            {
+                for (var j = 0; j < expectedX.ColumnCount; j++)
+                {
+                    Assert.AreEqual(expectedX[i, j], matrixX[i, j], 1.0e-10);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Column pivoted QR of a wide matrix throws <c>ArgumentException</c>.
+        /// </summary>
+        [Test]
+        public void ColumnPivotedQRWideMatrixThrowsArgumentException()
+        {
+            Assert.That(() => Matrix<double>.Build.Random(3, 4, 1).QR(QRMethod.ColumnPivoted), Throws.ArgumentException);
+            Assert.That(() => LinearAlgebraControl.Provider.PivotedQRFactor(new double[12], 3, 4, new double[16], new double[3], new int[4]), Throws.ArgumentException);
+        }
+
         /// <summary>
         /// Can solve a system of linear equations for a random vector (Ax=b).
         /// </summary>
@@ -0,0 +1,293 @@
+﻿// <copyright file="BandedProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the band and tridiagonal solver exports against the same matrices stored densely.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class BandedProviderTests
+    {
+        const int Size = 30;
+        const int Rhs = 2;
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void BandLuSolvesSystem(char flavour)
+        {
+            const int n = Size, kl = 2, ku = 3, ldab = 2*kl + ku + 1;
+            var a = Banded(n, kl, ku, 1, flavour);
+            a[Index(0, 0, n, n)] = Complex.Zero; // forces a row interchange
+            var b = RandomValues(n*Rhs, 2, flavour);
+
+            var ab = new Complex[ldab*n];
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = Math.Max(0, j - ku); i <= Math.Min(n - 1, j + kl); i++)
+                {
+                    ab[kl + ku + i - j + j*ldab] = a[Index(i, j, n, n)];
+                }
+            }
+
+            var factors = Make(flavour, ab);
+            var packed = Make(flavour, ab);
+            var ipiv = new int[n];
+            var x1 = Make(flavour, b);
+            var x2 = Make(flavour, b);
+            int info1, info2, info3;
+            switch (flavour)
+            {
+                case 's':
+                    info1 = s_band_lu_factor(n, kl, ku, (float[])factors, ipiv);
+                    info2 = s_band_lu_solve_factored(n, kl, ku, Rhs, (float[])factors, ipiv, (float[])x1);
+                    info3 = s_band_lu_solve(n, kl, ku, Rhs, (float[])packed, (float[])x2);
+                    break;
+                case 'd':
+                    info1 = d_band_lu_factor(n, kl, ku, (double[])factors, ipiv);
+                    info2 = d_band_lu_solve_factored(n, kl, ku, Rhs, (double[])factors, ipiv, (double[])x1);
+                    info3 = d_band_lu_solve(n, kl, ku, Rhs, (double[])packed, (double[])x2);
+                    break;
+                case 'c':
+                    info1 = c_band_lu_factor(n, kl, ku, (Complex32[])factors, ipiv);
+                    info2 = c_band_lu_solve_factored(n, kl, ku, Rhs, (Complex32[])factors, ipiv, (Complex32[])x1);
+                    info3 = c_band_lu_solve(n, kl, ku, Rhs, (Complex32[])packed, (Complex32[])x2);
+                    break;
+                default:
+                    info1 = z_band_lu_factor(n, kl, ku, (Complex[])factors, ipiv);
+                    info2 = z_band_lu_solve_factored(n, kl, ku, Rhs, (Complex[])factors, ipiv, (Complex[])x1);
+                    info3 = z_band_lu_solve(n, kl, ku, Rhs, (Complex[])packed, (Complex[])x2);
+                    break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+            Assert.That(info3, Is.EqualTo(0));
+            Assert.That(ipiv[0], Is.Not.EqualTo(0));
+            Assert.That(ipiv.All(p => p >= 0 && p < n), Is.True);
+            Assert.That(RelativeError(Read(Make(flavour, ab)), Read(packed)), Is.EqualTo(0.0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x1))), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x2))), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void BandCholeskySolvesSystem(char flavour)
+        {
+            const int n = Size, kd = 2;
+            var a = HermitianBanded(n, kd, 3, flavour);
+            var b = RandomValues(n*Rhs, 4, flavour);
+
+            var ab = new Complex[(kd + 1)*n];
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = j; i <= Math.Min(n - 1, j + kd); i++)
+                {
+                    ab[i - j + j*(kd + 1)] = a[Index(i, j, n, n)];
+                }
+            }
+
+            var packed = Make(flavour, ab);
+            var x = Make(flavour, b);
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_band_cholesky_solve(n, kd, Rhs, (float[])packed, (float[])x); break;
+                case 'd': info = d_band_cholesky_solve(n, kd, Rhs, (double[])packed, (double[])x); break;
+                case 'c': info = c_band_cholesky_solve(n, kd, Rhs, (Complex32[])packed, (Complex32[])x); break;
+                default: info = z_band_cholesky_solve(n, kd, Rhs, (Complex[])packed, (Complex[])x); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(RelativeError(Read(Make(flavour, ab)), Read(packed)), Is.EqualTo(0.0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x))), Is.LessThan(Tolerance(flavour)));
+
+            // Not positive definite: the leading minor of order 1 is negative.
+            ab[0] = new Complex(-1.0, 0.0);
+            packed = Make(flavour, ab);
+            switch (flavour)
+            {
+                case 's': info = s_band_cholesky_solve(n, kd, Rhs, (float[])packed, (float[])x); break;
+                case 'd': info = d_band_cholesky_solve(n, kd, Rhs, (double[])packed, (double[])x); break;
+                case 'c': info = c_band_cholesky_solve(n, kd, Rhs, (Complex32[])packed, (Complex32[])x); break;
+                default: info = z_band_cholesky_solve(n, kd, Rhs, (Complex[])packed, (Complex[])x); break;
+            }
+
+            Assert.That(info, Is.EqualTo(1));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void TridiagonalSolvesSystem(char flavour)
+        {
+            const int n = Size;
+            var a = Banded(n, 1, 1, 5, flavour);
+            var dl = Make(flavour, Enumerable.Range(0, n - 1).Select(i => a[Index(i + 1, i, n, n)]).ToArray());
+            var d = Make(flavour, Enumerable.Range(0, n).Select(i => a[Index(i, i, n, n)]).ToArray());
+            var du = Make(flavour, Enumerable.Range(0, n - 1).Select(i => a[Index(i, i + 1, n, n)]).ToArray());
+            var b = RandomValues(n*Rhs, 6, flavour);
+
+            // Hermitian positive definite: real diagonal, conjugate pairs off the diagonal.
+            var h = HermitianBanded(n, 1, 7, flavour);
+            var e = Make(flavour, Enumerable.Range(0, n - 1).Select(i => h[Index(i + 1, i, n, n)]).ToArray());
+            var hd = Enumerable.Range(0, n).Select(i => h[Index(i, i, n, n)].Real).ToArray();
+
+            var x1 = Make(flavour, b);
+            var x2 = Make(flavour, b);
+            int info1, info2;
+            switch (flavour)
+            {
+                case 's':
+                    info1 = s_tridiagonal_solve(n, Rhs, (float[])dl, (float[])d, (float[])du, (float[])x1);
+                    info2 = s_tridiagonal_cholesky_solve(n, Rhs, hd.Select(v => (float)v).ToArray(), (float[])e, (float[])x2);
+                    break;
+                case 'd':
+                    info1 = d_tridiagonal_solve(n, Rhs, (double[])dl, (double[])d, (double[])du, (double[])x1);
+                    info2 = d_tridiagonal_cholesky_solve(n, Rhs, hd, (double[])e, (double[])x2);
+                    break;
+                case 'c':
+                    info1 = c_tridiagonal_solve(n, Rhs, (Complex32[])dl, (Complex32[])d, (Complex32[])du, (Complex32[])x1);
+                    info2 = c_tridiagonal_cholesky_solve(n, Rhs, hd.Select(v => (float)v).ToArray(), (Complex32[])e, (Complex32[])x2);
+                    break;
+                default:
+                    info1 = z_tridiagonal_solve(n, Rhs, (Complex[])dl, (Complex[])d, (Complex[])du, (Complex[])x1);
+                    info2 = z_tridiagonal_cholesky_solve(n, Rhs, hd, (Complex[])e, (Complex[])x2);
+                    break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x1))), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, h, Read(x2))), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void BatchSolvesEachSystemAndCountsSingularOnes(char flavour)
+        {
+            const int n = 8, count = 5, singular = 3;
+            var systems = Enumerable.Range(0, count).Select(s => Banded(n, 1, 1, 10 + s, flavour)).ToArray();
+            var b = RandomValues(n*count, 20, flavour);
+
+            // Zero column 0 of one system.
+            systems[singular][Index(0, 0, n, n)] = Complex.Zero;
+            systems[singular][Index(1, 0, n, n)] = Complex.Zero;
+
+            var dl = Make(flavour, systems.SelectMany(a => Enumerable.Range(0, n - 1).Select(i => a[Index(i + 1, i, n, n)])).ToArray());
+            var d = Make(flavour, systems.SelectMany(a => Enumerable.Range(0, n).Select(i => a[Index(i, i, n, n)])).ToArray());
+            var du = Make(flavour, systems.SelectMany(a => Enumerable.Range(0, n - 1).Select(i => a[Index(i, i + 1, n, n)])).ToArray());
+            var x = Make(flavour, b);
+            var info = new int[count];
+            int result;
+            switch (flavour)
+            {
+                case 's': result = s_tridiagonal_solve_batch(n, count, (float[])dl, (float[])d, (float[])du, (float[])x, info); break;
+                case 'd': result = d_tridiagonal_solve_batch(n, count, (double[])dl, (double[])d, (double[])du, (double[])x, info); break;
+                case 'c': result = c_tridiagonal_solve_batch(n, count, (Complex32[])dl, (Complex32[])d, (Complex32[])du, (Complex32[])x, info); break;
+                default: result = z_tridiagonal_solve_batch(n, count, (Complex[])dl, (Complex[])d, (Complex[])du, (Complex[])x, info); break;
+            }
+
+            Assert.That(result, Is.EqualTo(1));
+            var solutions = Read(x);
+            for (var s = 0; s < count; s++)
+            {
+                if (s == singular)
+                {
+                    Assert.That(info[s], Is.GreaterThan(0));
+                    continue;
+                }
+
+                Assert.That(info[s], Is.EqualTo(0));
+                var xs = solutions.Skip(s*n).Take(n).ToArray();
+                Assert.That(RelativeError(b.Skip(s*n).Take(n).ToArray(), Multiply(n, n, 1, systems[s], xs)), Is.LessThan(Tolerance(flavour)));
+            }
+
+            Assert.That(d_tridiagonal_solve_batch(-1, count, new double[0], new double[0], new double[0], new double[0], info), Is.EqualTo(-1));
+            Assert.That(d_tridiagonal_solve_batch(n, -1, new double[0], new double[0], new double[0], new double[0], info), Is.EqualTo(-2));
+        }
+
+        /// <summary>
+        /// Random n x n matrix with kl sub- and ku super-diagonals and a dominant diagonal.
+        /// </summary>
+        static Complex[] Banded(int n, int kl, int ku, int seed, char flavour)
+        {
+            var random = RandomValues(n*n, seed, flavour);
+            var a = new Complex[n*n];
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = Math.Max(0, j - ku); i <= Math.Min(n - 1, j + kl); i++)
+                {
+                    a[Index(i, j, n, n)] = i == j ? random[Index(i, j, n, n)] + (kl + ku + 1) : random[Index(i, j, n, n)];
+                }
+            }
+
+            return a;
+        }
+
+        /// <summary>
+        /// Random Hermitian positive definite n x n matrix with kd sub- and super-diagonals.
+        /// </summary>
+        static Complex[] HermitianBanded(int n, int kd, int seed, char flavour)
+        {
+            var a = Banded(n, kd, 0, seed, flavour);
+            for (var j = 0; j < n; j++)
+            {
+                a[Index(j, j, n, n)] = new Complex(a[Index(j, j, n, n)].Real + 2*kd, 0.0);
+                for (var i = j + 1; i <= Math.Min(n - 1, j + kd); i++)
+                {
+                    a[Index(j, i, n, n)] = Complex.Conjugate(a[Index(i, j, n, n)]);
+                }
+            }
+
+            return a;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,137 @@
+﻿// <copyright file="CholeskyUpdateProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the rank-k Cholesky update and downdate exports against L*L' +/- X*X'.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class CholeskyUpdateProviderTests
+    {
+        /// <summary>
+        /// The small case takes the unblocked path, the large one the panelled path.
+        /// </summary>
+        [TestCase('s', 10, 2)]
+        [TestCase('d', 10, 2)]
+        [TestCase('c', 10, 2)]
+        [TestCase('z', 10, 2)]
+        [TestCase('s', 150, 10)]
+        [TestCase('d', 150, 10)]
+        [TestCase('c', 150, 10)]
+        [TestCase('z', 150, 10)]
+        public void UpdateThenDowndateMatchesReference(char flavour, int n, int k)
+        {
+            var a = PositiveDefinite(n, 1, flavour);
+            var x = RandomValues(n*k, 2, flavour);
+            var l = Make(flavour, a);
+            Assert.That(Factor(flavour, n, l), Is.EqualTo(0));
+
+            // The columns of X are destroyed, so each call gets a fresh copy.
+            Assert.That(Update(flavour, false, n, k, l, Make(flavour, x)), Is.EqualTo(0));
+            var updated = a.Zip(Multiply(n, k, n, x, Adjoint(n, k, x)), (p, q) => p + q).ToArray();
+            Assert.That(RelativeError(updated, Gram(n, Read(l))), Is.LessThan(Tolerance(flavour)));
+
+            Assert.That(Update(flavour, true, n, k, l, Make(flavour, x)), Is.EqualTo(0));
+            Assert.That(RelativeError(a, Gram(n, Read(l))), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void DowndateReportsLossOfDefiniteness(char flavour)
+        {
+            const int n = 6;
+            var l = Make(flavour, PositiveDefinite(n, 3, flavour));
+            Factor(flavour, n, l);
+
+            // x = 2*l_00*e_0 turns the first pivot of L*L' - x*x' negative.
+            var x = new Complex[n];
+            x[0] = 2.0*Read(l)[0];
+            Assert.That(Update(flavour, true, n, 1, l, Make(flavour, x)), Is.EqualTo(1));
+
+            Assert.That(Update(flavour, false, -1, 1, l, Make(flavour, x)), Is.EqualTo(-1));
+            Assert.That(Update(flavour, true, n, -1, l, Make(flavour, x)), Is.EqualTo(-2));
+        }
+
+        static int Factor(char flavour, int n, Array a)
+        {
+            switch (flavour)
+            {
+                case 's': return s_cholesky_factor(n, (float[])a);
+                case 'd': return d_cholesky_factor(n, (double[])a);
+                case 'c': return c_cholesky_factor(n, (Complex32[])a);
+                default: return z_cholesky_factor(n, (Complex[])a);
+            }
+        }
+
+        static int Update(char flavour, bool downdate, int n, int k, Array a, Array x)
+        {
+            switch (flavour)
+            {
+                case 's': return downdate ? s_cholesky_downdate(n, k, (float[])a, (float[])x) : s_cholesky_update(n, k, (float[])a, (float[])x);
+                case 'd': return downdate ? d_cholesky_downdate(n, k, (double[])a, (double[])x) : d_cholesky_update(n, k, (double[])a, (double[])x);
+                case 'c': return downdate ? c_cholesky_downdate(n, k, (Complex32[])a, (Complex32[])x) : c_cholesky_update(n, k, (Complex32[])a, (Complex32[])x);
+                default: return downdate ? z_cholesky_downdate(n, k, (Complex[])a, (Complex[])x) : z_cholesky_update(n, k, (Complex[])a, (Complex[])x);
+            }
+        }
+
+        /// <summary>
+        /// L*L' from the lower triangle of l.
+        /// </summary>
+        static Complex[] Gram(int n, Complex[] l)
+        {
+            var lower = new Complex[n*n];
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = j; i < n; i++)
+                {
+                    lower[Index(i, j, n, n)] = l[Index(i, j, n, n)];
+                }
+            }
+
+            return Multiply(n, n, n, lower, Adjoint(n, n, lower));
+        }
+    }
+}
+
+#endif
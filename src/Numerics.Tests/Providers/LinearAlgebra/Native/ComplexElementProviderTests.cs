@@ -0,0 +1,158 @@
+﻿// <copyright file="ComplexElementProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the element-wise complex exports: conjugate, modulus and argument, polar form and split storage.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class ComplexElementProviderTests
+    {
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ElementFunctionsMatchReference(char flavour)
+        {
+            const int n = 1000;
+            var values = RandomValues(n, 1, flavour);
+            values[0] = Complex.Zero;
+            values[1] = new Complex(-1.0, 0.0);
+            var x = Make(flavour, values);
+            var read = Read(x);
+            var conjugate = Make(flavour, new Complex[n]);
+            var abs = new double[n];
+            var arg = new double[n];
+
+            if (flavour == 'c')
+            {
+                var absSingle = new float[n];
+                var argSingle = new float[n];
+                c_conjugate(n, (Complex32[])x, (Complex32[])conjugate);
+                c_abs(n, (Complex32[])x, absSingle);
+                c_arg(n, (Complex32[])x, argSingle);
+                abs = absSingle.Select(v => (double)v).ToArray();
+                arg = argSingle.Select(v => (double)v).ToArray();
+            }
+            else
+            {
+                z_conjugate(n, (Complex[])x, (Complex[])conjugate);
+                z_abs(n, (Complex[])x, abs);
+                z_arg(n, (Complex[])x, arg);
+            }
+
+            var tolerance = Tolerance(flavour);
+            Assert.That(RelativeError(read.Select(Complex.Conjugate).ToArray(), Read(conjugate)), Is.LessThan(tolerance));
+            for (var i = 0; i < n; i++)
+            {
+                Assert.That(abs[i], Is.EqualTo(read[i].Magnitude).Within(tolerance));
+                Assert.That(arg[i], Is.EqualTo(read[i].Phase).Within(tolerance));
+            }
+
+            Assert.That(arg[1], Is.EqualTo(Math.PI).Within(tolerance));
+        }
+
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ModulusKeepsRange(char flavour)
+        {
+            // Squaring the parts would overflow or underflow the working precision.
+            var scale = flavour == 'c' ? 1e30 : 1e200;
+            var values = new[] { new Complex(3.0*scale, 4.0*scale), new Complex(3.0/scale, -4.0/scale) };
+            var x = Make(flavour, values);
+            double[] abs;
+            if (flavour == 'c')
+            {
+                var single = new float[2];
+                c_abs(2, (Complex32[])x, single);
+                abs = single.Select(v => (double)v).ToArray();
+            }
+            else
+            {
+                abs = new double[2];
+                z_abs(2, (Complex[])x, abs);
+            }
+
+            Assert.That(abs[0]/scale, Is.EqualTo(5.0).Within(5.0*Tolerance(flavour)));
+            Assert.That(abs[1]*scale, Is.EqualTo(5.0).Within(5.0*Tolerance(flavour)));
+        }
+
+        [TestCase('c')]
+        [TestCase('z')]
+        public void PolarAndSplitFormsRoundTrip(char flavour)
+        {
+            const int n = 1000;
+            var values = RandomValues(n, 2, flavour);
+            var x = Make(flavour, values);
+            var read = Read(x);
+            var fromPolar = Make(flavour, new Complex[n]);
+            var merged = Make(flavour, new Complex[n]);
+            double[] real, imaginary;
+
+            if (flavour == 'c')
+            {
+                var magnitude = read.Select(v => (float)v.Magnitude).ToArray();
+                var phase = read.Select(v => (float)v.Phase).ToArray();
+                var re = new float[n];
+                var im = new float[n];
+                c_from_polar(n, magnitude, phase, (Complex32[])fromPolar);
+                c_split(n, (Complex32[])x, re, im);
+                c_merge(n, re, im, (Complex32[])merged);
+                real = re.Select(v => (double)v).ToArray();
+                imaginary = im.Select(v => (double)v).ToArray();
+            }
+            else
+            {
+                real = new double[n];
+                imaginary = new double[n];
+                z_from_polar(n, read.Select(v => v.Magnitude).ToArray(), read.Select(v => v.Phase).ToArray(), (Complex[])fromPolar);
+                z_split(n, (Complex[])x, real, imaginary);
+                z_merge(n, real, imaginary, (Complex[])merged);
+            }
+
+            Assert.That(RelativeError(read, Read(fromPolar)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(real, Is.EqualTo(read.Select(v => v.Real).ToArray()));
+            Assert.That(imaginary, Is.EqualTo(read.Select(v => v.Imaginary).ToArray()));
+            Assert.That(Read(merged), Is.EqualTo(read));
+        }
+    }
+}
+
+#endif
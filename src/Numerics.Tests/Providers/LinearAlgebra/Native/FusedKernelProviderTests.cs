@@ -0,0 +1,208 @@
+﻿// <copyright file="FusedKernelProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using System.Runtime.InteropServices;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the fused element-wise exports against the same expressions evaluated one element at a time.
+    /// The length spans more than one evaluation block.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class FusedKernelProviderTests
+    {
+        const int Length = 1100;
+
+        const int Load = 1;
+        const int Const = 2;
+        const int Add = 3;
+        const int Sub = 4;
+        const int Mul = 5;
+        const int Div = 6;
+        const int Neg = 7;
+        const int Fma = 8;
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void LinearCombinationsMatchReference(char flavour)
+        {
+            var x0 = RandomValues(Length, 1, flavour);
+            var y0 = RandomValues(Length, 2, flavour);
+            var z0 = RandomValues(Length, 3, flavour);
+            var alpha = IsComplex(flavour) ? new Complex(1.5, -0.5) : new Complex(1.5, 0.0);
+            var beta = IsComplex(flavour) ? new Complex(-2.0, 0.25) : new Complex(-2.0, 0.0);
+            var gamma = new Complex(0.75, 0.0);
+            var x = Make(flavour, x0);
+            var y = Make(flavour, y0);
+            var z = Make(flavour, z0);
+            var axpby = Make(flavour, new Complex[Length]);
+            var axpbypcz = Make(flavour, new Complex[Length]);
+            var fma = Make(flavour, new Complex[Length]);
+
+            switch (flavour)
+            {
+                case 's':
+                    s_fused_axpby(Length, (float)alpha.Real, (float[])x, (float)beta.Real, (float[])y, (float[])axpby);
+                    s_fused_axpbypcz(Length, (float)alpha.Real, (float[])x, (float)beta.Real, (float[])y, (float)gamma.Real, (float[])z, (float[])axpbypcz);
+                    s_fused_multiply_add(Length, (float[])x, (float[])y, (float[])z, (float[])fma);
+                    break;
+                case 'd':
+                    d_fused_axpby(Length, alpha.Real, (double[])x, beta.Real, (double[])y, (double[])axpby);
+                    d_fused_axpbypcz(Length, alpha.Real, (double[])x, beta.Real, (double[])y, gamma.Real, (double[])z, (double[])axpbypcz);
+                    d_fused_multiply_add(Length, (double[])x, (double[])y, (double[])z, (double[])fma);
+                    break;
+                case 'c':
+                    c_fused_axpby(Length, ToComplex32(alpha), (Complex32[])x, ToComplex32(beta), (Complex32[])y, (Complex32[])axpby);
+                    c_fused_axpbypcz(Length, ToComplex32(alpha), (Complex32[])x, ToComplex32(beta), (Complex32[])y, ToComplex32(gamma), (Complex32[])z, (Complex32[])axpbypcz);
+                    c_fused_multiply_add(Length, (Complex32[])x, (Complex32[])y, (Complex32[])z, (Complex32[])fma);
+                    break;
+                case 'z':
+                    z_fused_axpby(Length, alpha, (Complex[])x, beta, (Complex[])y, (Complex[])axpby);
+                    z_fused_axpbypcz(Length, alpha, (Complex[])x, beta, (Complex[])y, gamma, (Complex[])z, (Complex[])axpbypcz);
+                    z_fused_multiply_add(Length, (Complex[])x, (Complex[])y, (Complex[])z, (Complex[])fma);
+                    break;
+            }
+
+            var indices = Enumerable.Range(0, Length);
+            Assert.That(RelativeError(indices.Select(i => alpha*x0[i] + beta*y0[i]).ToArray(), Read(axpby)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(indices.Select(i => alpha*x0[i] + beta*y0[i] + gamma*z0[i]).ToArray(), Read(axpbypcz)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(indices.Select(i => x0[i]*y0[i] + z0[i]).ToArray(), Read(fma)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        public void LinearFractionMatchesReference(char flavour)
+        {
+            var x = RandomValues(Length, 4, flavour).Select(v => v.Real).ToArray();
+            var y = RandomValues(Length, 5, flavour).Select(v => v.Real).ToArray();
+            var result = new double[Length];
+            if (flavour == 's')
+            {
+                var single = new float[Length];
+                s_fused_linear_frac(Length, x.Select(v => (float)v).ToArray(), y.Select(v => (float)v).ToArray(), 2.0f, 1.0f, 0.5f, 3.0f, single);
+                result = single.Select(v => (double)v).ToArray();
+            }
+            else
+            {
+                d_fused_linear_frac(Length, x, y, 2.0, 1.0, 0.5, 3.0, result);
+            }
+
+            var expected = x.Zip(y, (a, b) => new Complex((2.0*a + 1.0)/(0.5*b + 3.0), 0.0)).ToArray();
+            Assert.That(RelativeError(expected, result.Select(v => new Complex(v, 0.0)).ToArray()), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        public void EvaluateRunsStackProgram(char flavour)
+        {
+            // r = -(x*y + z)/c0 - (x - c1), with a scalar constant broadcast over the arrays.
+            var program = new[] { Load, 0, Load, 1, Load, 2, Fma, 0, Const, 0, Div, 0, Neg, 0, Load, 0, Const, 1, Sub, 0, Sub, 0 };
+            var x = RandomValues(Length, 6, flavour).Select(v => v.Real).ToArray();
+            var y = RandomValues(Length, 7, flavour).Select(v => v.Real).ToArray();
+            var z = RandomValues(Length, 8, flavour).Select(v => v.Real).ToArray();
+            var constants = new[] { 4.0, 0.5 };
+
+            var result = Evaluate(flavour, Length, program, constants, x, y, z);
+
+            Assert.That(result.Info, Is.EqualTo(0));
+            var expected = Enumerable.Range(0, Length).Select(i => new Complex(-(x[i]*y[i] + z[i])/4.0 - (x[i] - 0.5), 0.0)).ToArray();
+            Assert.That(RelativeError(expected, result.Values.Select(v => new Complex(v, 0.0)).ToArray()), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        public void EvaluateReportsBadPrograms(char flavour)
+        {
+            var x = new double[4];
+            var constants = new[] { 1.0 };
+
+            Assert.That(Evaluate(flavour, -1, new[] { Load, 0 }, constants, x).Info, Is.EqualTo(-1));
+            Assert.That(Evaluate(flavour, 4, new int[0], constants, x).Info, Is.EqualTo(-2));
+
+            // Instruction k is reported as -(9 + k): a missing input, an operator short of operands, an unknown opcode.
+            Assert.That(Evaluate(flavour, 4, new[] { Load, 0, Load, 1, Add, 0 }, constants, x).Info, Is.EqualTo(-10));
+            Assert.That(Evaluate(flavour, 4, new[] { Const, 0, Mul, 0 }, constants, x).Info, Is.EqualTo(-10));
+            Assert.That(Evaluate(flavour, 4, new[] { Load, 0, Const, 0, 42, 0 }, constants, x).Info, Is.EqualTo(-11));
+
+            // Two values left on the stack after two instructions.
+            Assert.That(Evaluate(flavour, 4, new[] { Load, 0, Const, 0 }, constants, x).Info, Is.EqualTo(-11));
+        }
+
+        static Complex32 ToComplex32(Complex value)
+        {
+            return new Complex32((float)value.Real, (float)value.Imaginary);
+        }
+
+        /// <summary>
+        /// Runs s_ or d_fused_evaluate on pinned copies of the inputs.
+        /// </summary>
+        static (int Info, double[] Values) Evaluate(char flavour, int n, int[] program, double[] constants, params double[][] inputs)
+        {
+            var arrays = inputs.Select(input => flavour == 's' ? (Array)input.Select(v => (float)v).ToArray() : input).ToArray();
+            var handles = arrays.Select(array => GCHandle.Alloc(array, GCHandleType.Pinned)).ToArray();
+            try
+            {
+                var pointers = handles.Select(handle => handle.AddrOfPinnedObject()).ToArray();
+                var length = Math.Max(n, 0);
+                if (flavour == 's')
+                {
+                    var single = new float[length];
+                    var info = s_fused_evaluate(n, program.Length/2, program, constants.Length, constants.Select(v => (float)v).ToArray(), pointers.Length, pointers, single);
+                    return (info, single.Select(v => (double)v).ToArray());
+                }
+
+                var result = new double[length];
+                return (d_fused_evaluate(n, program.Length/2, program, constants.Length, constants, pointers.Length, pointers, result), result);
+            }
+            finally
+            {
+                foreach (var handle in handles)
+                {
+                    handle.Free();
+                }
+            }
+        }
+    }
+}
+
+#endif
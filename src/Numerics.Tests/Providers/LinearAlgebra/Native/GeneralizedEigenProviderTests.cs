@@ -0,0 +1,308 @@
+﻿// <copyright file="GeneralizedEigenProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the generalized eigenproblem exports: eigenpairs must satisfy beta*A*x = alpha*B*x, and the
+    /// QZ factors must reproduce the pencil.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class GeneralizedEigenProviderTests
+    {
+        const int Size = 6;
+
+        [TestCase('s', 1)]
+        [TestCase('d', 1)]
+        [TestCase('c', 1)]
+        [TestCase('z', 1)]
+        [TestCase('d', 2)]
+        [TestCase('z', 2)]
+        [TestCase('d', 3)]
+        [TestCase('z', 3)]
+        public void SymmetricDefinitePencil(char flavour, int itype)
+        {
+            const int n = Size;
+            var a = Hermitian(n, 1, flavour);
+            var b = Read(Make(flavour, PositiveDefinite(n, 2, flavour)));
+            var values = new double[n];
+            var vectors = Make(flavour, new Complex[n*n]);
+            var info = SymmetricEigen(flavour, true, itype, n, Make(flavour, a), Make(flavour, b), values, vectors);
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(values.Zip(values.Skip(1), (p, q) => p <= q).All(ascending => ascending), Is.True);
+
+            // itype 1: A*x = l*B*x with X'*B*X = I; 2: A*B*x = l*x; 3: B*A*x = l*x.
+            var x = Read(vectors);
+            var left = itype == 1 ? Multiply(n, n, n, a, x) : itype == 2 ? Multiply(n, n, n, a, Multiply(n, n, n, b, x)) : Multiply(n, n, n, b, Multiply(n, n, n, a, x));
+            var right = itype == 1 ? Multiply(n, n, n, b, x) : x;
+            var scaled = right.Select((v, k) => values[k/n]*v).ToArray();
+            Assert.That(RelativeError(left, scaled), Is.LessThan(Tolerance(flavour)*n));
+            if (itype == 1)
+            {
+                Assert.That(RelativeError(Identity(n), Multiply(n, n, n, Adjoint(n, n, x), Multiply(n, n, n, b, x))), Is.LessThan(Tolerance(flavour)*n));
+            }
+
+            // The values alone come out the same.
+            var valuesOnly = new double[n];
+            Assert.That(SymmetricEigen(flavour, false, itype, n, Make(flavour, a), Make(flavour, b), valuesOnly, null), Is.EqualTo(0));
+            Assert.That(RelativeError(values.Select(v => new Complex(v, 0.0)).ToArray(), valuesOnly.Select(v => new Complex(v, 0.0)).ToArray()), Is.LessThan(Tolerance(flavour)*n));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void SymmetricDefiniteReportsBadArguments(char flavour)
+        {
+            const int n = Size;
+            var a = Hermitian(n, 3, flavour);
+            var b = PositiveDefinite(n, 4, flavour);
+            var values = new double[n];
+            Assert.That(SymmetricEigen(flavour, false, 4, n, Make(flavour, a), Make(flavour, b), values, null), Is.EqualTo(-2));
+
+            // info > n: B is not positive definite.
+            var negative = b.Select(v => -v).ToArray();
+            Assert.That(SymmetricEigen(flavour, false, 1, n, Make(flavour, a), Make(flavour, negative), values, null), Is.GreaterThan(n));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void GeneralPencil(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, RandomValues(n*n, 5, flavour)));
+            var b = Read(Make(flavour, RandomValues(n*n, 6, flavour)));
+
+            // A zero column of B gives an infinite eigenvalue, beta = 0.
+            for (var i = 0; i < n; i++)
+            {
+                b[Index(i, n - 1, n, n)] = Complex.Zero;
+            }
+
+            var alpha = new Complex[n];
+            var beta = new Complex[n];
+            var vectors = Make(flavour, new Complex[n*n]);
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_generalized_eigen(true, n, (float[])Make(flavour, a), (float[])Make(flavour, b), alpha, beta, (float[])vectors); break;
+                case 'd': info = d_generalized_eigen(true, n, (double[])Make(flavour, a), (double[])Make(flavour, b), alpha, beta, (double[])vectors); break;
+                case 'c': info = c_generalized_eigen(true, n, (Complex32[])Make(flavour, a), (Complex32[])Make(flavour, b), alpha, beta, (Complex32[])vectors); break;
+                default: info = z_generalized_eigen(true, n, (Complex[])Make(flavour, a), (Complex[])Make(flavour, b), alpha, beta, (Complex[])vectors); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(beta.Count(v => v.Magnitude < Tolerance(flavour)), Is.EqualTo(1));
+            var x = EigenvectorColumns(flavour, n, alpha, Read(vectors));
+            for (var j = 0; j < n; j++)
+            {
+                Assert.That(PairResidual(n, a, b, alpha[j], beta[j], x[j]), Is.LessThan(Tolerance(flavour)*n));
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void QZFactorsReproducePencil(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, RandomValues(n*n, 7, flavour)));
+            var b = Read(Make(flavour, RandomValues(n*n, 8, flavour)));
+            var s = Make(flavour, a);
+            var t = Make(flavour, b);
+            var q = Make(flavour, new Complex[n*n]);
+            var z = Make(flavour, new Complex[n*n]);
+            var alpha = new Complex[n];
+            var beta = new Complex[n];
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_qz_factor(n, (float[])s, (float[])t, (float[])q, (float[])z, alpha, beta); break;
+                case 'd': info = d_qz_factor(n, (double[])s, (double[])t, (double[])q, (double[])z, alpha, beta); break;
+                case 'c': info = c_qz_factor(n, (Complex32[])s, (Complex32[])t, (Complex32[])q, (Complex32[])z, alpha, beta); break;
+                default: info = z_qz_factor(n, (Complex[])s, (Complex[])t, (Complex[])q, (Complex[])z, alpha, beta); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            var qq = Read(q);
+            var zz = Read(z);
+            var ss = Read(s);
+            var tt = Read(t);
+            Assert.That(RelativeError(Identity(n), Multiply(n, n, n, Adjoint(n, n, qq), qq)), Is.LessThan(Tolerance(flavour)*n));
+            Assert.That(RelativeError(Identity(n), Multiply(n, n, n, Adjoint(n, n, zz), zz)), Is.LessThan(Tolerance(flavour)*n));
+            Assert.That(RelativeError(a, Multiply(n, n, n, qq, Multiply(n, n, n, ss, Adjoint(n, n, zz)))), Is.LessThan(Tolerance(flavour)*n));
+            Assert.That(RelativeError(b, Multiply(n, n, n, qq, Multiply(n, n, n, tt, Adjoint(n, n, zz)))), Is.LessThan(Tolerance(flavour)*n));
+
+            // T is upper triangular; S is too, up to the 2x2 blocks of complex pairs in the real case.
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = j + 1; i < n; i++)
+                {
+                    Assert.That(tt[Index(i, j, n, n)], Is.EqualTo(Complex.Zero));
+                    if (i > j + 1 || IsComplex(flavour))
+                    {
+                        Assert.That(ss[Index(i, j, n, n)], Is.EqualTo(Complex.Zero));
+                    }
+                }
+            }
+
+            // Every alpha/beta is an eigenvalue of the pencil: det(beta*A - alpha*B) = 0.
+            for (var j = 0; j < n; j++)
+            {
+                var pencil = a.Zip(b, (p, r) => beta[j]*p - alpha[j]*r).ToArray();
+                Assert.That(SmallestSingularValueBound(n, pencil), Is.LessThan(Tolerance(flavour)*n));
+            }
+        }
+
+        static int SymmetricEigen(char flavour, bool computeVectors, int itype, int n, Array a, Array b, double[] values, Array vectors)
+        {
+            int info;
+            switch (flavour)
+            {
+                case 's':
+                    var single = new float[n];
+                    info = s_symmetric_generalized_eigen(computeVectors, itype, n, (float[])a, (float[])b, single, (float[])vectors);
+                    Array.Copy(single.Select(v => (double)v).ToArray(), values, n);
+                    return info;
+                case 'd':
+                    return d_symmetric_generalized_eigen(computeVectors, itype, n, (double[])a, (double[])b, values, (double[])vectors);
+                case 'c':
+                    var real = new float[n];
+                    info = c_hermitian_generalized_eigen(computeVectors, itype, n, (Complex32[])a, (Complex32[])b, real, (Complex32[])vectors);
+                    Array.Copy(real.Select(v => (double)v).ToArray(), values, n);
+                    return info;
+                default:
+                    return z_hermitian_generalized_eigen(computeVectors, itype, n, (Complex[])a, (Complex[])b, values, (Complex[])vectors);
+            }
+        }
+
+        /// <summary>
+        /// Random Hermitian (real symmetric for the real flavours) n x n matrix.
+        /// </summary>
+        static Complex[] Hermitian(int n, int seed, char flavour)
+        {
+            var a = Read(Make(flavour, RandomValues(n*n, seed, flavour)));
+            for (var j = 0; j < n; j++)
+            {
+                a[Index(j, j, n, n)] = new Complex(a[Index(j, j, n, n)].Real, 0.0);
+                for (var i = j + 1; i < n; i++)
+                {
+                    a[Index(j, i, n, n)] = Complex.Conjugate(a[Index(i, j, n, n)]);
+                }
+            }
+
+            return a;
+        }
+
+        /// <summary>
+        /// Eigenvector j as a complex column. The real flavours store a complex pair in consecutive columns as (re, im).
+        /// </summary>
+        static Complex[][] EigenvectorColumns(char flavour, int n, Complex[] alpha, Complex[] vectors)
+        {
+            var columns = new Complex[n][];
+            for (var j = 0; j < n; j++)
+            {
+                var column = vectors.Skip(j*n).Take(n).ToArray();
+                if (!IsComplex(flavour) && alpha[j].Imaginary != 0.0)
+                {
+                    var first = alpha[j].Imaginary > 0.0 ? j : j - 1;
+                    var re = vectors.Skip(first*n).Take(n).ToArray();
+                    var im = vectors.Skip((first + 1)*n).Take(n).ToArray();
+                    var sign = first == j ? 1.0 : -1.0;
+                    column = re.Zip(im, (p, q) => new Complex(p.Real, sign*q.Real)).ToArray();
+                }
+
+                columns[j] = column;
+            }
+
+            return columns;
+        }
+
+        /// <summary>
+        /// ||beta*A*x - alpha*B*x|| relative to (|beta|*||A|| + |alpha|*||B||)*||x||, in the max norm.
+        /// </summary>
+        static double PairResidual(int n, Complex[] a, Complex[] b, Complex alpha, Complex beta, Complex[] x)
+        {
+            var ax = Multiply(n, n, 1, a, x);
+            var bx = Multiply(n, n, 1, b, x);
+            var residual = ax.Zip(bx, (p, q) => beta*p - alpha*q).Max(v => v.Magnitude);
+            var scale = (beta.Magnitude*a.Max(v => v.Magnitude) + alpha.Magnitude*b.Max(v => v.Magnitude))*x.Max(v => v.Magnitude);
+            return residual/scale;
+        }
+
+        /// <summary>
+        /// Smallest pivot of Gaussian elimination with complete pivoting relative to the largest entry, which is
+        /// at most a small multiple of the relative smallest singular value.
+        /// </summary>
+        static double SmallestSingularValueBound(int n, Complex[] matrix)
+        {
+            var m = matrix.ToArray();
+            var scale = m.Max(v => v.Magnitude);
+            var smallest = double.MaxValue;
+            var rows = Enumerable.Range(0, n).ToList();
+            var columns = Enumerable.Range(0, n).ToList();
+            while (rows.Count > 0)
+            {
+                var pivot = (from i in rows from j in columns select (i, j)).OrderByDescending(p => m[Index(p.i, p.j, n, n)].Magnitude).First();
+                var value = m[Index(pivot.i, pivot.j, n, n)];
+                smallest = Math.Min(smallest, value.Magnitude);
+                rows.Remove(pivot.i);
+                columns.Remove(pivot.j);
+                foreach (var i in rows)
+                {
+                    var factor = m[Index(i, pivot.j, n, n)]/value;
+                    foreach (var j in columns)
+                    {
+                        m[Index(i, j, n, n)] -= factor*m[Index(pivot.i, j, n, n)];
+                    }
+                }
+            }
+
+            return smallest/scale;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,222 @@
+﻿// <copyright file="InPlaceSolveProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the in-place solve exports, which factor A where it lies: the solution, and what is
+    /// left in A and B afterwards.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class InPlaceSolveProviderTests
+    {
+        const int Size = 40;
+        const int Rhs = 3;
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void LuSolvesInPlace(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, DiagonallyDominant(n, 1, flavour)));
+            var b = Read(Make(flavour, RandomValues(n*Rhs, 2, flavour)));
+            var factors = Make(flavour, a);
+            var x = Make(flavour, b);
+            Assert.That(LuSolve(flavour, n, Rhs, factors, x), Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x))), Is.LessThan(Tolerance(flavour)*n));
+
+            // A holds U on and above the diagonal: |det A| is the product of its diagonal.
+            var u = Read(factors);
+            var logDet = Enumerable.Range(0, n).Sum(i => Math.Log(u[Index(i, i, n, n)].Magnitude));
+            Assert.That(Math.Abs(logDet - LogAbsDeterminant(n, a)), Is.LessThan(Tolerance(flavour)*n));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void CholeskySolvesInPlace(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, PositiveDefinite(n, 3, flavour)));
+            var b = Read(Make(flavour, RandomValues(n*Rhs, 4, flavour)));
+            var factors = Make(flavour, a);
+            var x = Make(flavour, b);
+            Assert.That(CholeskySolve(flavour, n, Rhs, factors, x), Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x))), Is.LessThan(Tolerance(flavour)*n));
+
+            // The lower triangle of A holds L with L*L' = A.
+            var l = Read(factors);
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = 0; i < j; i++)
+                {
+                    l[Index(i, j, n, n)] = Complex.Zero;
+                }
+            }
+
+            Assert.That(RelativeError(a, Multiply(n, n, n, l, Adjoint(n, n, l))), Is.LessThan(Tolerance(flavour)*n));
+        }
+
+        [TestCase('s', 60, 40)]
+        [TestCase('d', 60, 40)]
+        [TestCase('c', 60, 40)]
+        [TestCase('z', 60, 40)]
+        [TestCase('d', 40, 40)]
+        public void QrSolvesInPlace(char flavour, int m, int n)
+        {
+            var a = Read(Make(flavour, RandomValues(m*n, 5, flavour)));
+            var b = Read(Make(flavour, RandomValues(m*Rhs, 6, flavour)));
+            var factors = Make(flavour, a);
+            var qb = Make(flavour, b);
+            var x = Make(flavour, new Complex[n*Rhs]);
+            Assert.That(QrSolve(flavour, m, n, Rhs, factors, qb, x), Is.EqualTo(0));
+
+            // Least squares: the residual is orthogonal to the range of A.
+            var xx = Read(x);
+            var residual = b.Zip(Multiply(m, n, Rhs, a, xx), (p, q) => p - q).ToArray();
+            var scale = b.Max(v => v.Magnitude)*m;
+            Assert.That(Multiply(n, m, Rhs, Adjoint(m, n, a), residual).Max(v => v.Magnitude)/scale, Is.LessThan(Tolerance(flavour)*n));
+
+            // B holds Q'*b: x in its first n rows and, below, a vector with the norm of the residual.
+            var q = Read(qb);
+            for (var j = 0; j < Rhs; j++)
+            {
+                var top = Enumerable.Range(0, n).Select(i => q[Index(i, j, m, Rhs)]).ToArray();
+                Assert.That(RelativeError(top, xx.Skip(j*n).Take(n).ToArray()), Is.EqualTo(0.0));
+                var tail = Enumerable.Range(n, m - n).Sum(i => q[Index(i, j, m, Rhs)].Magnitude*q[Index(i, j, m, Rhs)].Magnitude);
+                var norm = Enumerable.Range(0, m).Sum(i => residual[Index(i, j, m, Rhs)].Magnitude*residual[Index(i, j, m, Rhs)].Magnitude);
+                Assert.That(Math.Abs(Math.Sqrt(tail) - Math.Sqrt(norm)), Is.LessThan(Tolerance(flavour)*m));
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsSingularMatrices(char flavour)
+        {
+            // A zero third column: the third pivot of LU and the third diagonal of R are zero.
+            const int n = 6;
+            var a = RandomValues(n*n, 7, flavour);
+            for (var i = 0; i < n; i++)
+            {
+                a[Index(i, 2, n, n)] = Complex.Zero;
+            }
+
+            var b = RandomValues(n, 8, flavour);
+            Assert.That(LuSolve(flavour, n, 1, Make(flavour, a), Make(flavour, b)), Is.EqualTo(3));
+            Assert.That(QrSolve(flavour, n, n, 1, Make(flavour, a), Make(flavour, b), Make(flavour, new Complex[n])), Is.EqualTo(3));
+
+            var negative = Identity(n).Select(v => -v).ToArray();
+            Assert.That(CholeskySolve(flavour, n, 1, Make(flavour, negative), Make(flavour, b)), Is.EqualTo(1));
+        }
+
+        static int LuSolve(char flavour, int n, int nrhs, Array a, Array b)
+        {
+            switch (flavour)
+            {
+                case 's': return s_lu_solve_inplace(n, nrhs, (float[])a, (float[])b);
+                case 'd': return d_lu_solve_inplace(n, nrhs, (double[])a, (double[])b);
+                case 'c': return c_lu_solve_inplace(n, nrhs, (Complex32[])a, (Complex32[])b);
+                default: return z_lu_solve_inplace(n, nrhs, (Complex[])a, (Complex[])b);
+            }
+        }
+
+        static int CholeskySolve(char flavour, int n, int nrhs, Array a, Array b)
+        {
+            switch (flavour)
+            {
+                case 's': return s_cholesky_solve_inplace(n, nrhs, (float[])a, (float[])b);
+                case 'd': return d_cholesky_solve_inplace(n, nrhs, (double[])a, (double[])b);
+                case 'c': return c_cholesky_solve_inplace(n, nrhs, (Complex32[])a, (Complex32[])b);
+                default: return z_cholesky_solve_inplace(n, nrhs, (Complex[])a, (Complex[])b);
+            }
+        }
+
+        static int QrSolve(char flavour, int m, int n, int bn, Array a, Array b, Array x)
+        {
+            switch (flavour)
+            {
+                case 's': return s_qr_solve_inplace(m, n, bn, (float[])a, (float[])b, (float[])x);
+                case 'd': return d_qr_solve_inplace(m, n, bn, (double[])a, (double[])b, (double[])x);
+                case 'c': return c_qr_solve_inplace(m, n, bn, (Complex32[])a, (Complex32[])b, (Complex32[])x);
+                default: return z_qr_solve_inplace(m, n, bn, (Complex[])a, (Complex[])b, (Complex[])x);
+            }
+        }
+
+        /// <summary>
+        /// log |det A| by Gaussian elimination with partial pivoting.
+        /// </summary>
+        static double LogAbsDeterminant(int n, Complex[] a)
+        {
+            var m = a.ToArray();
+            var sum = 0.0;
+            for (var k = 0; k < n; k++)
+            {
+                var p = Enumerable.Range(k, n - k).OrderByDescending(i => m[Index(i, k, n, n)].Magnitude).First();
+                for (var j = 0; j < n; j++)
+                {
+                    var t = m[Index(k, j, n, n)];
+                    m[Index(k, j, n, n)] = m[Index(p, j, n, n)];
+                    m[Index(p, j, n, n)] = t;
+                }
+
+                var pivot = m[Index(k, k, n, n)];
+                sum += Math.Log(pivot.Magnitude);
+                for (var i = k + 1; i < n; i++)
+                {
+                    var factor = m[Index(i, k, n, n)]/pivot;
+                    for (var j = k; j < n; j++)
+                    {
+                        m[Index(i, j, n, n)] -= factor*m[Index(k, j, n, n)];
+                    }
+                }
+            }
+
+            return sum;
+        }
+    }
+}
+
+#endif
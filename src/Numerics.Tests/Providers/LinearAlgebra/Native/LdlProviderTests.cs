@@ -0,0 +1,202 @@
+﻿// <copyright file="LdlProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the symmetric and Hermitian indefinite LDL' exports. The matrices have a zero diagonal,
+    /// so Cholesky fails and the pivoting variants need 2x2 blocks.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class LdlProviderTests
+    {
+        const int Size = 8;
+        const int Rhs = 2;
+        const int BunchKaufman = 0;
+        const int Rook = 1;
+        const int Aasen = 2;
+
+        [TestCase('s', BunchKaufman)]
+        [TestCase('d', BunchKaufman)]
+        [TestCase('c', BunchKaufman)]
+        [TestCase('z', BunchKaufman)]
+        [TestCase('s', Rook)]
+        [TestCase('d', Rook)]
+        [TestCase('c', Rook)]
+        [TestCase('z', Rook)]
+        [TestCase('s', Aasen)]
+        [TestCase('d', Aasen)]
+        [TestCase('c', Aasen)]
+        [TestCase('z', Aasen)]
+        public void SymmetricSolvesIndefiniteSystem(char flavour, int variant)
+        {
+            Solve(flavour, variant, false);
+        }
+
+        [TestCase('c', BunchKaufman)]
+        [TestCase('z', BunchKaufman)]
+        [TestCase('c', Rook)]
+        [TestCase('z', Rook)]
+        [TestCase('c', Aasen)]
+        [TestCase('z', Aasen)]
+        public void HermitianSolvesIndefiniteSystem(char flavour, int variant)
+        {
+            Solve(flavour, variant, true);
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsUnknownVariant(char flavour)
+        {
+            const int n = Size, bad = 3;
+            var a = Make(flavour, ZeroDiagonal(n, 1, flavour, false));
+            var b = Make(flavour, new Complex[n]);
+            var ipiv = new int[n];
+            switch (flavour)
+            {
+                case 's':
+                    Assert.That(s_ldl_factor(n, (float[])a, ipiv, bad), Is.EqualTo(-4));
+                    Assert.That(s_ldl_solve_factored(n, 1, (float[])a, ipiv, (float[])b, bad), Is.EqualTo(-6));
+                    Assert.That(s_ldl_solve(n, 1, (float[])a, (float[])b, bad), Is.EqualTo(-5));
+                    break;
+                case 'd':
+                    Assert.That(d_ldl_factor(n, (double[])a, ipiv, bad), Is.EqualTo(-4));
+                    Assert.That(d_ldl_solve_factored(n, 1, (double[])a, ipiv, (double[])b, bad), Is.EqualTo(-6));
+                    Assert.That(d_ldl_solve(n, 1, (double[])a, (double[])b, bad), Is.EqualTo(-5));
+                    break;
+                case 'c':
+                    Assert.That(c_hermitian_ldl_factor(n, (Complex32[])a, ipiv, bad), Is.EqualTo(-4));
+                    Assert.That(c_hermitian_ldl_solve_factored(n, 1, (Complex32[])a, ipiv, (Complex32[])b, bad), Is.EqualTo(-6));
+                    Assert.That(c_hermitian_ldl_solve(n, 1, (Complex32[])a, (Complex32[])b, bad), Is.EqualTo(-5));
+                    break;
+                default:
+                    Assert.That(z_ldl_factor(n, (Complex[])a, ipiv, bad), Is.EqualTo(-4));
+                    Assert.That(z_ldl_solve_factored(n, 1, (Complex[])a, ipiv, (Complex[])b, bad), Is.EqualTo(-6));
+                    Assert.That(z_ldl_solve(n, 1, (Complex[])a, (Complex[])b, bad), Is.EqualTo(-5));
+                    break;
+            }
+        }
+
+        static void Solve(char flavour, int variant, bool hermitian)
+        {
+            const int n = Size;
+            var a = ZeroDiagonal(n, 2, flavour, hermitian);
+            var b = RandomValues(n*Rhs, 3, flavour);
+
+            // Factor, then solve with the factors; the one-shot solve leaves a unchanged.
+            var factors = Make(flavour, a);
+            var ipiv = new int[n];
+            var x1 = Make(flavour, b);
+            var a2 = Make(flavour, a);
+            var x2 = Make(flavour, b);
+            int info1, info2, info3;
+            switch (flavour)
+            {
+                case 's':
+                    info1 = s_ldl_factor(n, (float[])factors, ipiv, variant);
+                    info2 = s_ldl_solve_factored(n, Rhs, (float[])factors, ipiv, (float[])x1, variant);
+                    info3 = s_ldl_solve(n, Rhs, (float[])a2, (float[])x2, variant);
+                    break;
+                case 'd':
+                    info1 = d_ldl_factor(n, (double[])factors, ipiv, variant);
+                    info2 = d_ldl_solve_factored(n, Rhs, (double[])factors, ipiv, (double[])x1, variant);
+                    info3 = d_ldl_solve(n, Rhs, (double[])a2, (double[])x2, variant);
+                    break;
+                case 'c' when hermitian:
+                    info1 = c_hermitian_ldl_factor(n, (Complex32[])factors, ipiv, variant);
+                    info2 = c_hermitian_ldl_solve_factored(n, Rhs, (Complex32[])factors, ipiv, (Complex32[])x1, variant);
+                    info3 = c_hermitian_ldl_solve(n, Rhs, (Complex32[])a2, (Complex32[])x2, variant);
+                    break;
+                case 'c':
+                    info1 = c_ldl_factor(n, (Complex32[])factors, ipiv, variant);
+                    info2 = c_ldl_solve_factored(n, Rhs, (Complex32[])factors, ipiv, (Complex32[])x1, variant);
+                    info3 = c_ldl_solve(n, Rhs, (Complex32[])a2, (Complex32[])x2, variant);
+                    break;
+                case 'z' when hermitian:
+                    info1 = z_hermitian_ldl_factor(n, (Complex[])factors, ipiv, variant);
+                    info2 = z_hermitian_ldl_solve_factored(n, Rhs, (Complex[])factors, ipiv, (Complex[])x1, variant);
+                    info3 = z_hermitian_ldl_solve(n, Rhs, (Complex[])a2, (Complex[])x2, variant);
+                    break;
+                default:
+                    info1 = z_ldl_factor(n, (Complex[])factors, ipiv, variant);
+                    info2 = z_ldl_solve_factored(n, Rhs, (Complex[])factors, ipiv, (Complex[])x1, variant);
+                    info3 = z_ldl_solve(n, Rhs, (Complex[])a2, (Complex[])x2, variant);
+                    break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+            Assert.That(info3, Is.EqualTo(0));
+            if (variant != Aasen)
+            {
+                // A zero diagonal admits no 1x1 pivot at the first step; 2x2 blocks are stored as ~p.
+                Assert.That(ipiv.Any(p => p < 0), Is.True);
+                Assert.That(ipiv.All(p => (p < 0 ? ~p : p) < n), Is.True);
+            }
+
+            Assert.That(RelativeError(Read(Make(flavour, a)), Read(a2)), Is.EqualTo(0.0));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x1))), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(b, Multiply(n, n, Rhs, a, Read(x2))), Is.LessThan(Tolerance(flavour)));
+        }
+
+        /// <summary>
+        /// Random symmetric (or Hermitian) n x n matrix with a zero diagonal.
+        /// </summary>
+        static Complex[] ZeroDiagonal(int n, int seed, char flavour, bool hermitian)
+        {
+            var a = Read(Make(flavour, RandomValues(n*n, seed, flavour)));
+            for (var j = 0; j < n; j++)
+            {
+                a[Index(j, j, n, n)] = Complex.Zero;
+                for (var i = j + 1; i < n; i++)
+                {
+                    a[Index(j, i, n, n)] = hermitian ? Complex.Conjugate(a[Index(i, j, n, n)]) : a[Index(i, j, n, n)];
+                }
+            }
+
+            return a;
+        }
+    }
+}
+
+#endif
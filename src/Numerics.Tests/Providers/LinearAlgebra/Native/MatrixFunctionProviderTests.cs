@@ -0,0 +1,286 @@
+﻿// <copyright file="MatrixFunctionProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the dense matrix function exports against a Taylor series reference for exp and the
+    /// defining identities for the square root and the logarithm.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class MatrixFunctionProviderTests
+    {
+        const int Size = 8;
+
+        [TestCase('s', 0.01)]
+        [TestCase('d', 0.01)]
+        [TestCase('d', 0.5)]
+        [TestCase('d', 2.0)]
+        [TestCase('d', 20.0)]
+        [TestCase('s', 2.0)]
+        [TestCase('c', 2.0)]
+        [TestCase('z', 0.5)]
+        [TestCase('z', 20.0)]
+        public void ExpMatchesTaylorSeries(char flavour, double scale)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, RandomValues(n*n, 1, flavour).Select(v => v*scale/n).ToArray()));
+            var result = Make(flavour, new Complex[n*n]);
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_expm(n, (float[])Make(flavour, a), (float[])result); break;
+                case 'd': info = d_expm(n, (double[])Make(flavour, a), (double[])result); break;
+                case 'c': info = c_expm(n, (Complex32[])Make(flavour, a), (Complex32[])result); break;
+                default: info = z_expm(n, (Complex[])Make(flavour, a), (Complex[])result); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(RelativeError(Exp(n, a), Read(result)), Is.LessThan(Tolerance(flavour)*n));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ExpHandleScalesByT(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, RandomValues(n*n, 2, flavour).Select(v => v/n).ToArray()));
+            var handle = IntPtr.Zero;
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_expm_create(out handle, n, (float[])Make(flavour, a)); break;
+                case 'd': info = d_expm_create(out handle, n, (double[])Make(flavour, a)); break;
+                case 'c': info = c_expm_create(out handle, n, (Complex32[])Make(flavour, a)); break;
+                default: info = z_expm_create(out handle, n, (Complex[])Make(flavour, a)); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(handle, Is.Not.EqualTo(IntPtr.Zero));
+
+            // Complex t for the complex flavours: exp(i*t*A) as well.
+            foreach (var t in new[] { new Complex(0.25, 0.0), new Complex(-1.0, 0.0), new Complex(8.0, 0.0), new Complex(0.5, IsComplex(flavour) ? 3.0 : 0.0) })
+            {
+                var result = Make(flavour, new Complex[n*n]);
+                switch (flavour)
+                {
+                    case 's': info = s_expm_compute(handle, (float)t.Real, (float[])result); break;
+                    case 'd': info = d_expm_compute(handle, t.Real, (double[])result); break;
+                    case 'c': info = c_expm_compute(handle, new Complex32((float)t.Real, (float)t.Imaginary), (Complex32[])result); break;
+                    default: info = z_expm_compute(handle, t, (Complex[])result); break;
+                }
+
+                Assert.That(info, Is.EqualTo(0));
+                Assert.That(RelativeError(Exp(n, a.Select(v => t*v).ToArray()), Read(result)), Is.LessThan(Tolerance(flavour)*n));
+            }
+
+            switch (flavour)
+            {
+                case 's': info = s_expm_free(ref handle); break;
+                case 'd': info = d_expm_free(ref handle); break;
+                case 'c': info = c_expm_free(ref handle); break;
+                default: info = z_expm_free(ref handle); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ExpBatchMatchesSingle(char flavour)
+        {
+            const int n = 5;
+            const int count = 40;
+            var a = Read(Make(flavour, RandomValues(n*n*count, 3, flavour).Select((v, k) => v*(1 + k/(n*n)%7)/n).ToArray()));
+            var result = Make(flavour, new Complex[n*n*count]);
+            var info = new int[count];
+            int failed;
+            switch (flavour)
+            {
+                case 's': failed = s_expm_batch(n, count, (float[])Make(flavour, a), (float[])result, info); break;
+                case 'd': failed = d_expm_batch(n, count, (double[])Make(flavour, a), (double[])result, info); break;
+                case 'c': failed = c_expm_batch(n, count, (Complex32[])Make(flavour, a), (Complex32[])result, info); break;
+                default: failed = z_expm_batch(n, count, (Complex[])Make(flavour, a), (Complex[])result, info); break;
+            }
+
+            Assert.That(failed, Is.EqualTo(0));
+            Assert.That(info.All(i => i == 0), Is.True);
+            var actual = Read(result);
+            for (var k = 0; k < count; k++)
+            {
+                var expected = Exp(n, a.Skip(k*n*n).Take(n*n).ToArray());
+                Assert.That(RelativeError(expected, actual.Skip(k*n*n).Take(n*n).ToArray()), Is.LessThan(Tolerance(flavour)*n));
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void SqrtSquaresBack(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, DiagonallyDominant(n, 4, flavour)));
+            var result = Make(flavour, new Complex[n*n]);
+            Assert.That(Sqrt(flavour, n, a, result), Is.EqualTo(0));
+            var r = Read(result);
+            Assert.That(RelativeError(a, Multiply(n, n, n, r, r)), Is.LessThan(Tolerance(flavour)*n));
+
+            // The principal root: every eigenvalue in the right half plane, so the trace is positive.
+            Assert.That(Enumerable.Range(0, n).Sum(i => r[Index(i, i, n, n)].Real), Is.GreaterThan(0.0));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void LogInvertsExp(char flavour)
+        {
+            const int n = Size;
+            var a = Read(Make(flavour, PositiveDefinite(n, 5, flavour))).Select(v => v/n).ToArray();
+            var result = Make(flavour, new Complex[n*n]);
+            Assert.That(Log(flavour, n, Make(flavour, a), result), Is.EqualTo(0));
+            Assert.That(RelativeError(a, Exp(n, Read(result))), Is.LessThan(Tolerance(flavour)*n*10));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsMissingFunctionsAndBadArguments(char flavour)
+        {
+            const int n = 4;
+            var result = Make(flavour, new Complex[n*n]);
+
+            // A negative eigenvalue has no real square root or logarithm; a singular matrix has no logarithm.
+            var negative = Identity(n).Select(v => -v).ToArray();
+            var expected = IsComplex(flavour) ? 0 : 1;
+            Assert.That(Sqrt(flavour, n, negative, result), Is.EqualTo(expected));
+            Assert.That(Log(flavour, n, Make(flavour, negative), result), Is.EqualTo(expected));
+            Assert.That(Log(flavour, n, Make(flavour, new Complex[n*n]), result), Is.EqualTo(1));
+
+            var handle = IntPtr.Zero;
+            switch (flavour)
+            {
+                case 's':
+                    Assert.That(s_expm(-1, new float[1], new float[1]), Is.EqualTo(-1));
+                    Assert.That(s_expm_create(out handle, -1, new float[1]), Is.EqualTo(-2));
+                    Assert.That(s_expm_batch(n, -1, new float[1], new float[1], new int[1]), Is.EqualTo(-2));
+                    break;
+                case 'd':
+                    Assert.That(d_expm(-1, new double[1], new double[1]), Is.EqualTo(-1));
+                    Assert.That(d_expm_create(out handle, -1, new double[1]), Is.EqualTo(-2));
+                    Assert.That(d_expm_batch(n, -1, new double[1], new double[1], new int[1]), Is.EqualTo(-2));
+                    break;
+                case 'c':
+                    Assert.That(c_expm(-1, new Complex32[1], new Complex32[1]), Is.EqualTo(-1));
+                    Assert.That(c_expm_create(out handle, -1, new Complex32[1]), Is.EqualTo(-2));
+                    Assert.That(c_expm_batch(n, -1, new Complex32[1], new Complex32[1], new int[1]), Is.EqualTo(-2));
+                    break;
+                default:
+                    Assert.That(z_expm(-1, new Complex[1], new Complex[1]), Is.EqualTo(-1));
+                    Assert.That(z_expm_create(out handle, -1, new Complex[1]), Is.EqualTo(-2));
+                    Assert.That(z_expm_batch(n, -1, new Complex[1], new Complex[1], new int[1]), Is.EqualTo(-2));
+                    break;
+            }
+
+            Assert.That(Sqrt(flavour, -1, new Complex[1], Make(flavour, new Complex[1])), Is.EqualTo(-1));
+        }
+
+        static int Sqrt(char flavour, int n, Complex[] a, Array result)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sqrtm(n, (float[])Make(flavour, a), (float[])result);
+                case 'd': return d_sqrtm(n, (double[])Make(flavour, a), (double[])result);
+                case 'c': return c_sqrtm(n, (Complex32[])Make(flavour, a), (Complex32[])result);
+                default: return z_sqrtm(n, (Complex[])Make(flavour, a), (Complex[])result);
+            }
+        }
+
+        static int Log(char flavour, int n, Array a, Array result)
+        {
+            switch (flavour)
+            {
+                case 's': return s_logm(n, (float[])a, (float[])result);
+                case 'd': return d_logm(n, (double[])a, (double[])result);
+                case 'c': return c_logm(n, (Complex32[])a, (Complex32[])result);
+                default: return z_logm(n, (Complex[])a, (Complex[])result);
+            }
+        }
+
+        /// <summary>
+        /// exp(A) by a Taylor series of A/2^s with ||A/2^s|| below 1/2, squared s times.
+        /// </summary>
+        static Complex[] Exp(int n, Complex[] a)
+        {
+            var norm = 0.0;
+            for (var j = 0; j < n; j++)
+            {
+                norm = Math.Max(norm, a.Skip(j*n).Take(n).Sum(v => v.Magnitude));
+            }
+
+            var s = Math.Max(0, (int)Math.Ceiling(Math.Log(norm/0.5, 2.0)));
+            var scaled = a.Select(v => v/Math.Pow(2.0, s)).ToArray();
+            var sum = Identity(n);
+            var term = Identity(n);
+            for (var k = 1; k <= 30; k++)
+            {
+                term = Multiply(n, n, n, term, scaled).Select(v => v/k).ToArray();
+                sum = sum.Zip(term, (p, q) => p + q).ToArray();
+            }
+
+            for (var k = 0; k < s; k++)
+            {
+                sum = Multiply(n, n, n, sum, sum);
+            }
+
+            return sum;
+        }
+    }
+}
+
+#endif
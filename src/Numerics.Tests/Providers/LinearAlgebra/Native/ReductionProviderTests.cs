@@ -0,0 +1,160 @@
+﻿// <copyright file="ReductionProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the vector reduction exports (BLAS norms and indices, pairwise sums, extremes).
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class ReductionProviderTests
+    {
+        /// <summary>
+        /// Longer than one parallel piece of the sums, so the partial results are combined.
+        /// </summary>
+        const int Long = 3*65536 + 5;
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void NormsAndIndicesMatchReference(char flavour)
+        {
+            const int n = 1000;
+            var values = RandomValues(n, 1, flavour);
+            values[417] = new Complex(3.0, IsComplex(flavour) ? -2.0 : 0.0);
+            values[612] = values[417];
+            values[233] = new Complex(1e-3, 0.0);
+            var x = Make(flavour, values);
+
+            double nrm2, asum;
+            int iamax, iamin;
+            switch (flavour)
+            {
+                case 's': nrm2 = s_nrm2(n, (float[])x); asum = s_asum(n, (float[])x); iamax = s_iamax(n, (float[])x); iamin = s_iamin(n, (float[])x); break;
+                case 'd': nrm2 = d_nrm2(n, (double[])x); asum = d_asum(n, (double[])x); iamax = d_iamax(n, (double[])x); iamin = d_iamin(n, (double[])x); break;
+                case 'c': nrm2 = c_nrm2(n, (Complex32[])x); asum = c_asum(n, (Complex32[])x); iamax = c_iamax(n, (Complex32[])x); iamin = c_iamin(n, (Complex32[])x); break;
+                default: nrm2 = z_nrm2(n, (Complex[])x); asum = z_asum(n, (Complex[])x); iamax = z_iamax(n, (Complex[])x); iamin = z_iamin(n, (Complex[])x); break;
+            }
+
+            // BLAS measures complex elements by |re| + |im|, and returns the first of equal ones.
+            var read = Read(x);
+            var expectedNorm = Math.Sqrt(read.Sum(v => v.Magnitude*v.Magnitude));
+            var expectedSum = read.Sum(v => Math.Abs(v.Real) + Math.Abs(v.Imaginary));
+            Assert.That(nrm2, Is.EqualTo(expectedNorm).Within(Tolerance(flavour)*expectedNorm));
+            Assert.That(asum, Is.EqualTo(expectedSum).Within(Tolerance(flavour)*expectedSum));
+            Assert.That(iamax, Is.EqualTo(417));
+            Assert.That(iamin, Is.EqualTo(233));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void SumMatchesReference(char flavour)
+        {
+            var values = RandomValues(Long, 2, flavour);
+            var x = Make(flavour, values);
+
+            Complex sum;
+            switch (flavour)
+            {
+                case 's': sum = s_sum(Long, (float[])x); break;
+                case 'd': sum = d_sum(Long, (double[])x); break;
+                case 'c': c_sum(Long, (Complex32[])x, out var single); sum = new Complex(single.Real, single.Imaginary); break;
+                default: z_sum(Long, (Complex[])x, out sum); break;
+            }
+
+            // A pairwise sum stays within a few roundings of the exact one, relative to the sum of magnitudes.
+            var read = Read(x);
+            var expected = read.Aggregate(Complex.Zero, (a, v) => a + v);
+            var scale = read.Sum(v => v.Magnitude);
+            Assert.That((sum - expected).Magnitude, Is.LessThan(Tolerance(flavour)*scale));
+
+            Assert.That(s_sum(0, new float[0]), Is.EqualTo(0.0f));
+            Assert.That(d_sum(0, new double[0]), Is.EqualTo(0.0));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        public void ExtremesReturnFirstOccurrence(char flavour)
+        {
+            // The largest and smallest values occur twice, in different parallel pieces.
+            var values = RandomValues(Long, 3, flavour).Select(v => v.Real).ToArray();
+            values[70000] = values[140000] = 2.0;
+            values[1000] = values[150000] = -2.0;
+
+            double max, min;
+            int argmax, argmin;
+            if (flavour == 's')
+            {
+                var x = values.Select(v => (float)v).ToArray();
+                max = s_max(Long, x);
+                min = s_min(Long, x);
+                argmax = s_argmax(Long, x);
+                argmin = s_argmin(Long, x);
+            }
+            else
+            {
+                max = d_max(Long, values);
+                min = d_min(Long, values);
+                argmax = d_argmax(Long, values);
+                argmin = d_argmin(Long, values);
+            }
+
+            Assert.That(max, Is.EqualTo(2.0));
+            Assert.That(min, Is.EqualTo(-2.0));
+            Assert.That(argmax, Is.EqualTo(70000));
+            Assert.That(argmin, Is.EqualTo(1000));
+        }
+
+        [Test]
+        public void ExtremesOfEmptyVectorAreUndefined()
+        {
+            Assert.That(s_argmax(0, new float[0]), Is.EqualTo(-1));
+            Assert.That(d_argmin(0, new double[0]), Is.EqualTo(-1));
+            Assert.That(float.IsNaN(s_min(0, new float[0])), Is.True);
+            Assert.That(double.IsNaN(d_max(0, new double[0])), Is.True);
+        }
+    }
+}
+
+#endif
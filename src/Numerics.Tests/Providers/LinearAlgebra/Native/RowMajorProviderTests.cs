@@ -0,0 +1,282 @@
+﻿// <copyright file="RowMajorProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using AHSEsim.Numerics.Providers.LinearAlgebra;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the row-major (x_*_rm) gemm, factor and solve exports against dense references.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class RowMajorProviderTests
+    {
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void MatrixMultiplyMatchesReference(char flavour)
+        {
+            const int m = 3, k = 4, n = 5;
+            var a = RandomValues(m*k, 1, flavour);
+            var b = RandomValues(k*n, 2, flavour);
+            var c0 = RandomValues(m*n, 3, flavour);
+            var x = Make(flavour, a);
+            var y = Make(flavour, b);
+            var c = Make(flavour, c0);
+
+            switch (flavour)
+            {
+                case 's': s_matrix_multiply_rm(Transpose.DontTranspose, Transpose.DontTranspose, m, n, k, 2.0f, (float[])x, (float[])y, 0.5f, (float[])c); break;
+                case 'd': d_matrix_multiply_rm(Transpose.DontTranspose, Transpose.DontTranspose, m, n, k, 2.0, (double[])x, (double[])y, 0.5, (double[])c); break;
+                case 'c': c_matrix_multiply_rm(Transpose.DontTranspose, Transpose.DontTranspose, m, n, k, new Complex32(2.0f, 0.0f), (Complex32[])x, (Complex32[])y, new Complex32(0.5f, 0.0f), (Complex32[])c); break;
+                case 'z': z_matrix_multiply_rm(Transpose.DontTranspose, Transpose.DontTranspose, m, n, k, new Complex(2.0, 0.0), (Complex[])x, (Complex[])y, new Complex(0.5, 0.0), (Complex[])c); break;
+            }
+
+            var expected = Multiply(m, k, n, a, b, true).Zip(c0, (p, q) => 2.0*p + 0.5*q).ToArray();
+            Assert.That(RelativeError(expected, Read(c)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void LuSolvesRowMajorSystem(char flavour)
+        {
+            const int n = 6, nrhs = 2;
+            var a = DiagonallyDominant(n, 4, flavour);
+            a[0] = Complex.Zero; // forces a row interchange
+            var b = RandomValues(n*nrhs, 5, flavour);
+
+            // Factor, then solve with the factors.
+            var lu = Make(flavour, a);
+            var ipiv = new int[n];
+            var x1 = Make(flavour, b);
+            int info1, info2;
+            switch (flavour)
+            {
+                case 's': info1 = s_lu_factor_rm(n, (float[])lu, ipiv); info2 = s_lu_solve_factored_rm(n, nrhs, (float[])lu, ipiv, (float[])x1); break;
+                case 'd': info1 = d_lu_factor_rm(n, (double[])lu, ipiv); info2 = d_lu_solve_factored_rm(n, nrhs, (double[])lu, ipiv, (double[])x1); break;
+                case 'c': info1 = c_lu_factor_rm(n, (Complex32[])lu, ipiv); info2 = c_lu_solve_factored_rm(n, nrhs, (Complex32[])lu, ipiv, (Complex32[])x1); break;
+                default: info1 = z_lu_factor_rm(n, (Complex[])lu, ipiv); info2 = z_lu_solve_factored_rm(n, nrhs, (Complex[])lu, ipiv, (Complex[])x1); break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+            Assert.That(ipiv[0], Is.Not.EqualTo(0));
+            Assert.That(ipiv.All(p => p >= 0 && p < n), Is.True);
+            Assert.That(RelativeError(b, Multiply(n, n, nrhs, a, Read(x1), true)), Is.LessThan(Tolerance(flavour)));
+
+            // One-shot solve; a must be left unchanged.
+            var a2 = Make(flavour, a);
+            var x2 = Make(flavour, b);
+            int info3;
+            switch (flavour)
+            {
+                case 's': info3 = s_lu_solve_rm(n, nrhs, (float[])a2, (float[])x2); break;
+                case 'd': info3 = d_lu_solve_rm(n, nrhs, (double[])a2, (double[])x2); break;
+                case 'c': info3 = c_lu_solve_rm(n, nrhs, (Complex32[])a2, (Complex32[])x2); break;
+                default: info3 = z_lu_solve_rm(n, nrhs, (Complex[])a2, (Complex[])x2); break;
+            }
+
+            Assert.That(info3, Is.EqualTo(0));
+            Assert.That(RelativeError(a, Read(a2)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(b, Multiply(n, n, nrhs, a, Read(x2), true)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void CholeskySolvesRowMajorSystem(char flavour)
+        {
+            const int n = 5, nrhs = 3;
+            var a = PositiveDefinite(n, 6, flavour);
+            var b = RandomValues(n*nrhs, 7, flavour);
+
+            var l = Make(flavour, a);
+            var x1 = Make(flavour, b);
+            int info1, info2;
+            switch (flavour)
+            {
+                case 's': info1 = s_cholesky_factor_rm(n, (float[])l); info2 = s_cholesky_solve_factored_rm(n, nrhs, (float[])l, (float[])x1); break;
+                case 'd': info1 = d_cholesky_factor_rm(n, (double[])l); info2 = d_cholesky_solve_factored_rm(n, nrhs, (double[])l, (double[])x1); break;
+                case 'c': info1 = c_cholesky_factor_rm(n, (Complex32[])l); info2 = c_cholesky_solve_factored_rm(n, nrhs, (Complex32[])l, (Complex32[])x1); break;
+                default: info1 = z_cholesky_factor_rm(n, (Complex[])l); info2 = z_cholesky_solve_factored_rm(n, nrhs, (Complex[])l, (Complex[])x1); break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+
+            // The factor is lower triangular by rows and L*L' = A.
+            var factor = Read(l);
+            var adjoint = new Complex[n*n];
+            for (var i = 0; i < n; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    if (j > i)
+                    {
+                        Assert.That(factor[i*n + j].Magnitude, Is.EqualTo(0.0));
+                    }
+
+                    adjoint[j*n + i] = Complex.Conjugate(factor[i*n + j]);
+                }
+            }
+
+            Assert.That(RelativeError(a, Multiply(n, n, n, factor, adjoint, true)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(RelativeError(b, Multiply(n, n, nrhs, a, Read(x1), true)), Is.LessThan(Tolerance(flavour)));
+
+            var x2 = Make(flavour, b);
+            int info3;
+            switch (flavour)
+            {
+                case 's': info3 = s_cholesky_solve_rm(n, nrhs, (float[])Make(flavour, a), (float[])x2); break;
+                case 'd': info3 = d_cholesky_solve_rm(n, nrhs, (double[])Make(flavour, a), (double[])x2); break;
+                case 'c': info3 = c_cholesky_solve_rm(n, nrhs, (Complex32[])Make(flavour, a), (Complex32[])x2); break;
+                default: info3 = z_cholesky_solve_rm(n, nrhs, (Complex[])Make(flavour, a), (Complex[])x2); break;
+            }
+
+            Assert.That(info3, Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(n, n, nrhs, a, Read(x2), true)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void CholeskyReportsIndefiniteMinor(char flavour)
+        {
+            const int n = 4;
+            var a = PositiveDefinite(n, 8, flavour);
+            a[2*n + 2] = -a[2*n + 2];
+
+            var l = Make(flavour, a);
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_cholesky_factor_rm(n, (float[])l); break;
+                case 'd': info = d_cholesky_factor_rm(n, (double[])l); break;
+                case 'c': info = c_cholesky_factor_rm(n, (Complex32[])l); break;
+                default: info = z_cholesky_factor_rm(n, (Complex[])l); break;
+            }
+
+            Assert.That(info, Is.EqualTo(3));
+        }
+
+        /// <summary>
+        /// Overdetermined systems get the least squares solution: A'(Ax - b) = 0.
+        /// </summary>
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void QrSolvesOverdeterminedRowMajorSystem(char flavour)
+        {
+            const int m = 7, n = 4, bn = 2;
+            var a = RandomValues(m*n, 9, flavour);
+            var b = RandomValues(m*bn, 10, flavour);
+            var x = QrSolve(flavour, m, n, bn, a, b, out var info);
+
+            Assert.That(info, Is.EqualTo(0));
+            var residual = Multiply(m, n, bn, a, x, true).Zip(b, (p, q) => p - q).ToArray();
+            var normal = Multiply(n, m, bn, Adjoint(m, n, a), residual, true);
+            Assert.That(RelativeError(new Complex[n*bn], normal), Is.LessThan(Tolerance(flavour)));
+        }
+
+        /// <summary>
+        /// Underdetermined systems get the minimum norm solution: Ax = b with x in the range of A'.
+        /// b holds only m rows; the solver must not touch anything past them.
+        /// </summary>
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void QrSolvesUnderdeterminedRowMajorSystem(char flavour)
+        {
+            const int m = 3, n = 6, bn = 2;
+            var a = RandomValues(m*n, 11, flavour);
+            var b = RandomValues(m*bn, 12, flavour);
+            var x = QrSolve(flavour, m, n, bn, a, b, out var info);
+
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(m, n, bn, a, x, true)), Is.LessThan(Tolerance(flavour)));
+
+            // x = A'w for the w that solves this (consistent) overdetermined system.
+            var adjoint = Adjoint(m, n, a);
+            var w = QrSolve(flavour, n, m, bn, adjoint, x, out info);
+            Assert.That(info, Is.EqualTo(0));
+            Assert.That(RelativeError(x, Multiply(n, m, bn, adjoint, w, true)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        static Complex[] QrSolve(char flavour, int m, int n, int bn, Complex[] a, Complex[] b, out int info)
+        {
+            var r = Make(flavour, a);
+            var rhs = Make(flavour, b);
+            var x = Make(flavour, new Complex[n*bn]);
+            switch (flavour)
+            {
+                case 's': info = s_qr_solve_rm(m, n, bn, (float[])r, (float[])rhs, (float[])x); break;
+                case 'd': info = d_qr_solve_rm(m, n, bn, (double[])r, (double[])rhs, (double[])x); break;
+                case 'c': info = c_qr_solve_rm(m, n, bn, (Complex32[])r, (Complex32[])rhs, (Complex32[])x); break;
+                default: info = z_qr_solve_rm(m, n, bn, (Complex[])r, (Complex[])rhs, (Complex[])x); break;
+            }
+
+            Assert.That(RelativeError(Read(Make(flavour, b)), Read(rhs)), Is.EqualTo(0.0));
+            return Read(x);
+        }
+
+        static Complex[] Adjoint(int m, int n, Complex[] a)
+        {
+            var t = new Complex[n*m];
+            for (var i = 0; i < m; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    t[j*m + i] = Complex.Conjugate(a[i*n + j]);
+                }
+            }
+
+            return t;
+        }
+    }
+}
+
+#endif
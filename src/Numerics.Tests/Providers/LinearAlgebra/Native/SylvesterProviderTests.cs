@@ -0,0 +1,155 @@
+﻿// <copyright file="SylvesterProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the Sylvester and Lyapunov equation exports, direct and recursive, by their residuals.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class SylvesterProviderTests
+    {
+        [TestCase('s', 7, 5, false)]
+        [TestCase('d', 7, 5, false)]
+        [TestCase('c', 7, 5, false)]
+        [TestCase('z', 7, 5, false)]
+        [TestCase('s', 150, 90, true)]
+        [TestCase('d', 150, 90, true)]
+        [TestCase('c', 150, 90, true)]
+        [TestCase('z', 150, 90, true)]
+        [TestCase('d', 90, 150, true)]
+        [TestCase('z', 90, 150, true)]
+        public void SylvesterResidualIsSmall(char flavour, int m, int n, bool recursive)
+        {
+            // The spectra of A and -B are apart, so the equation is well conditioned.
+            var a = Read(Make(flavour, DiagonallyDominant(m, 1, flavour)));
+            var b = Read(Make(flavour, DiagonallyDominant(n, 2, flavour)));
+            var c = Read(Make(flavour, RandomValues(m*n, 3, flavour)));
+            var x = Make(flavour, c);
+            Assert.That(Sylvester(flavour, recursive, m, n, a, b, x), Is.EqualTo(0));
+
+            var xx = Read(x);
+            var residual = Multiply(m, m, n, a, xx).Zip(Multiply(m, n, n, xx, b), (p, q) => p + q).ToArray();
+            Assert.That(RelativeError(c, residual), Is.LessThan(Tolerance(flavour)*(m + n)));
+        }
+
+        [TestCase('s', 6, false)]
+        [TestCase('d', 6, false)]
+        [TestCase('c', 6, false)]
+        [TestCase('z', 6, false)]
+        [TestCase('s', 140, true)]
+        [TestCase('d', 140, true)]
+        [TestCase('c', 140, true)]
+        [TestCase('z', 140, true)]
+        public void LyapunovResidualIsSmall(char flavour, int n, bool recursive)
+        {
+            // -A is diagonally dominant, so A is stable and X is Hermitian positive definite.
+            var a = Read(Make(flavour, DiagonallyDominant(n, 4, flavour))).Select(v => -v).ToArray();
+            var q = Read(Make(flavour, PositiveDefinite(n, 5, flavour)));
+            var x = Make(flavour, q);
+            Assert.That(Lyapunov(flavour, recursive, n, a, x), Is.EqualTo(0));
+
+            var xx = Read(x);
+            var residual = Multiply(n, n, n, a, xx).Zip(Multiply(n, n, n, xx, Adjoint(n, n, a)), (p, r) => -(p + r)).ToArray();
+            Assert.That(RelativeError(q, residual), Is.LessThan(Tolerance(flavour)*n));
+            Assert.That(RelativeError(xx, Adjoint(n, n, xx)), Is.LessThan(Tolerance(flavour)*n));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsCloseSpectraAndBadArguments(char flavour)
+        {
+            // A = I and B = -I share an eigenvalue of A and -B: ?trsyl perturbs and returns 1.
+            const int n = 3;
+            var identity = Identity(n);
+            var minus = identity.Select(v => -v).ToArray();
+            foreach (var recursive in new[] { false, true })
+            {
+                Assert.That(Sylvester(flavour, recursive, n, n, identity, minus, Make(flavour, identity)), Is.EqualTo(1));
+                Assert.That(Sylvester(flavour, recursive, -1, n, identity, minus, Make(flavour, identity)), Is.EqualTo(-1));
+                Assert.That(Sylvester(flavour, recursive, n, -1, identity, minus, Make(flavour, identity)), Is.EqualTo(-2));
+                Assert.That(Lyapunov(flavour, recursive, -1, identity, Make(flavour, identity)), Is.EqualTo(-1));
+            }
+        }
+
+        static int Sylvester(char flavour, bool recursive, int m, int n, Complex[] a, Complex[] b, Array c)
+        {
+            switch (flavour)
+            {
+                case 's':
+                    return recursive
+                        ? s_sylvester_solve_recursive(m, n, (float[])Make(flavour, a), (float[])Make(flavour, b), (float[])c)
+                        : s_sylvester_solve(m, n, (float[])Make(flavour, a), (float[])Make(flavour, b), (float[])c);
+                case 'd':
+                    return recursive
+                        ? d_sylvester_solve_recursive(m, n, (double[])Make(flavour, a), (double[])Make(flavour, b), (double[])c)
+                        : d_sylvester_solve(m, n, (double[])Make(flavour, a), (double[])Make(flavour, b), (double[])c);
+                case 'c':
+                    return recursive
+                        ? c_sylvester_solve_recursive(m, n, (Complex32[])Make(flavour, a), (Complex32[])Make(flavour, b), (Complex32[])c)
+                        : c_sylvester_solve(m, n, (Complex32[])Make(flavour, a), (Complex32[])Make(flavour, b), (Complex32[])c);
+                default:
+                    return recursive
+                        ? z_sylvester_solve_recursive(m, n, (Complex[])Make(flavour, a), (Complex[])Make(flavour, b), (Complex[])c)
+                        : z_sylvester_solve(m, n, (Complex[])Make(flavour, a), (Complex[])Make(flavour, b), (Complex[])c);
+            }
+        }
+
+        static int Lyapunov(char flavour, bool recursive, int n, Complex[] a, Array q)
+        {
+            switch (flavour)
+            {
+                case 's':
+                    return recursive ? s_lyapunov_solve_recursive(n, (float[])Make(flavour, a), (float[])q) : s_lyapunov_solve(n, (float[])Make(flavour, a), (float[])q);
+                case 'd':
+                    return recursive ? d_lyapunov_solve_recursive(n, (double[])Make(flavour, a), (double[])q) : d_lyapunov_solve(n, (double[])Make(flavour, a), (double[])q);
+                case 'c':
+                    return recursive ? c_lyapunov_solve_recursive(n, (Complex32[])Make(flavour, a), (Complex32[])q) : c_lyapunov_solve(n, (Complex32[])Make(flavour, a), (Complex32[])q);
+                default:
+                    return recursive ? z_lyapunov_solve_recursive(n, (Complex[])Make(flavour, a), (Complex[])q) : z_lyapunov_solve(n, (Complex[])Make(flavour, a), (Complex[])q);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,185 @@
+﻿// <copyright file="TallSkinnyQRProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the tall-skinny QR exports. 100000 x 4 splits into three leaves and two tree nodes,
+    /// 50 x 4 is a single leaf.
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class TallSkinnyQRProviderTests
+    {
+        const int Columns = 4;
+
+        [TestCase('s', 100000, 20)]
+        [TestCase('d', 100000, 20)]
+        [TestCase('c', 100000, 20)]
+        [TestCase('z', 100000, 20)]
+        [TestCase('d', 50, 4)]
+        [TestCase('z', 50, 4)]
+        public void FactorsReproduceMatrix(char flavour, int m, int tauSize)
+        {
+            const int n = Columns;
+            var a = RandomValues(m*n, 1, flavour);
+            var q = Make(flavour, a);
+            var r1 = Make(flavour, new Complex[n*n]);
+            var implicitQ = Make(flavour, a);
+            var r2 = Make(flavour, new Complex[n*n]);
+            var tau = Make(flavour, new Complex[tauSize]);
+
+            int size, info1, info2;
+            switch (flavour)
+            {
+                case 's': size = s_tsqr_tau_size(m, n); info1 = s_tsqr_thin_factor(m, n, (float[])q, (float[])r1); info2 = s_tsqr_factor(m, n, (float[])implicitQ, (float[])r2, (float[])tau); break;
+                case 'd': size = d_tsqr_tau_size(m, n); info1 = d_tsqr_thin_factor(m, n, (double[])q, (double[])r1); info2 = d_tsqr_factor(m, n, (double[])implicitQ, (double[])r2, (double[])tau); break;
+                case 'c': size = c_tsqr_tau_size(m, n); info1 = c_tsqr_thin_factor(m, n, (Complex32[])q, (Complex32[])r1); info2 = c_tsqr_factor(m, n, (Complex32[])implicitQ, (Complex32[])r2, (Complex32[])tau); break;
+                default: size = z_tsqr_tau_size(m, n); info1 = z_tsqr_thin_factor(m, n, (Complex[])q, (Complex[])r1); info2 = z_tsqr_factor(m, n, (Complex[])implicitQ, (Complex[])r2, (Complex[])tau); break;
+            }
+
+            Assert.That(size, Is.EqualTo(tauSize));
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+
+            // Q has orthonormal columns, R is upper triangular and Q*R = A.
+            var qq = Read(q);
+            var r = Read(r1);
+            Assert.That(RelativeError(Identity(n), Multiply(n, m, n, Adjoint(m, n, qq), qq)), Is.LessThan(Tolerance(flavour)));
+            Assert.That(Enumerable.Range(0, n).All(j => Enumerable.Range(j + 1, n - j - 1).All(i => r[Index(i, j, n, n)] == Complex.Zero)), Is.True);
+            Assert.That(RelativeError(Read(Make(flavour, a)), Multiply(m, n, n, qq, r)), Is.LessThan(Tolerance(flavour)));
+
+            // Both calls build the same tree, so they return the same R.
+            Assert.That(RelativeError(r, Read(r2)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void LeastSquaresResidualIsOrthogonal(char flavour)
+        {
+            const int m = 100000, n = Columns, bn = 2;
+            var a = Read(Make(flavour, RandomValues(m*n, 2, flavour)));
+            var b = Read(Make(flavour, RandomValues(m*bn, 3, flavour)));
+            var factors = Make(flavour, a);
+            var r = Make(flavour, new Complex[n*n]);
+            var tau = Make(flavour, new Complex[5*n]);
+            var x1 = Make(flavour, new Complex[n*bn]);
+            var x2 = Make(flavour, new Complex[n*bn]);
+
+            int info1, info2, info3;
+            switch (flavour)
+            {
+                case 's':
+                    info1 = s_tsqr_factor(m, n, (float[])factors, (float[])r, (float[])tau);
+                    info2 = s_tsqr_solve_factored(m, n, bn, (float[])factors, (float[])Make(flavour, b), (float[])tau, (float[])x1);
+                    info3 = s_tsqr_solve(m, n, bn, (float[])Make(flavour, a), (float[])Make(flavour, b), (float[])x2);
+                    break;
+                case 'd':
+                    info1 = d_tsqr_factor(m, n, (double[])factors, (double[])r, (double[])tau);
+                    info2 = d_tsqr_solve_factored(m, n, bn, (double[])factors, (double[])Make(flavour, b), (double[])tau, (double[])x1);
+                    info3 = d_tsqr_solve(m, n, bn, (double[])Make(flavour, a), (double[])Make(flavour, b), (double[])x2);
+                    break;
+                case 'c':
+                    info1 = c_tsqr_factor(m, n, (Complex32[])factors, (Complex32[])r, (Complex32[])tau);
+                    info2 = c_tsqr_solve_factored(m, n, bn, (Complex32[])factors, (Complex32[])Make(flavour, b), (Complex32[])tau, (Complex32[])x1);
+                    info3 = c_tsqr_solve(m, n, bn, (Complex32[])Make(flavour, a), (Complex32[])Make(flavour, b), (Complex32[])x2);
+                    break;
+                default:
+                    info1 = z_tsqr_factor(m, n, (Complex[])factors, (Complex[])r, (Complex[])tau);
+                    info2 = z_tsqr_solve_factored(m, n, bn, (Complex[])factors, (Complex[])Make(flavour, b), (Complex[])tau, (Complex[])x1);
+                    info3 = z_tsqr_solve(m, n, bn, (Complex[])Make(flavour, a), (Complex[])Make(flavour, b), (Complex[])x2);
+                    break;
+            }
+
+            Assert.That(info1, Is.EqualTo(0));
+            Assert.That(info2, Is.EqualTo(0));
+            Assert.That(info3, Is.EqualTo(0));
+
+            // A'(b - A*x) = 0, relative to the size of A'b.
+            var adjoint = Adjoint(m, n, a);
+            var scale = Multiply(n, m, bn, adjoint, b);
+            foreach (var x in new[] { Read(x1), Read(x2) })
+            {
+                var residual = b.Zip(Multiply(m, n, bn, a, x), (p, q) => p - q).ToArray();
+                var normal = Multiply(n, m, bn, adjoint, residual);
+                Assert.That(normal.Max(v => v.Magnitude), Is.LessThan(Tolerance(flavour)*scale.Max(v => v.Magnitude)));
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBadArguments(char flavour)
+        {
+            const int m = 3, n = 4;
+            var a = Make(flavour, new Complex[m*n]);
+            var r = Make(flavour, new Complex[n*n]);
+            var tau = Make(flavour, new Complex[n]);
+            var b = Make(flavour, new Complex[m]);
+            var x = Make(flavour, new Complex[n]);
+
+            // Wider than tall, and a negative number of right-hand sides.
+            switch (flavour)
+            {
+                case 's':
+                    Assert.That(s_tsqr_factor(m, n, (float[])a, (float[])r, (float[])tau), Is.EqualTo(-2));
+                    Assert.That(s_tsqr_solve_factored(n, m, -1, (float[])a, (float[])b, (float[])tau, (float[])x), Is.EqualTo(-3));
+                    break;
+                case 'd':
+                    Assert.That(d_tsqr_factor(m, n, (double[])a, (double[])r, (double[])tau), Is.EqualTo(-2));
+                    Assert.That(d_tsqr_solve_factored(n, m, -1, (double[])a, (double[])b, (double[])tau, (double[])x), Is.EqualTo(-3));
+                    break;
+                case 'c':
+                    Assert.That(c_tsqr_factor(m, n, (Complex32[])a, (Complex32[])r, (Complex32[])tau), Is.EqualTo(-2));
+                    Assert.That(c_tsqr_solve_factored(n, m, -1, (Complex32[])a, (Complex32[])b, (Complex32[])tau, (Complex32[])x), Is.EqualTo(-3));
+                    break;
+                default:
+                    Assert.That(z_tsqr_factor(m, n, (Complex[])a, (Complex[])r, (Complex[])tau), Is.EqualTo(-2));
+                    Assert.That(z_tsqr_solve_factored(n, m, -1, (Complex[])a, (Complex[])b, (Complex[])tau, (Complex[])x), Is.EqualTo(-3));
+                    break;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,129 @@
+﻿// <copyright file="TransposeProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.LinearAlgebra.Native
+{
+    /// <summary>
+    /// Tests for the scaled copy and transpose exports, out of place and in place, against element-wise op(A).
+    /// </summary>
+    [TestFixture, Category("LAProvider")]
+    public class TransposeProviderTests
+    {
+        [TestCase('s', 70, 70)]
+        [TestCase('d', 70, 70)]
+        [TestCase('c', 70, 70)]
+        [TestCase('z', 70, 70)]
+        [TestCase('s', 45, 70)]
+        [TestCase('d', 45, 70)]
+        [TestCase('c', 70, 45)]
+        [TestCase('z', 70, 45)]
+        [TestCase('d', 1, 9)]
+        [TestCase('z', 300, 257)]
+        public void TransposeMatchesElementwise(char flavour, int rows, int columns)
+        {
+            var a = Read(Make(flavour, RandomValues(rows*columns, rows + columns, flavour)));
+            var alpha = IsComplex(flavour) ? new Complex(2.0, -1.0) : new Complex(2.0, 0.0);
+            foreach (var trans in "NTCR")
+            {
+                var transpose = trans == 'T' || trans == 'C';
+                var conjugate = trans == 'C' || trans == 'R';
+                var expected = new Complex[rows*columns];
+                for (var i = 0; i < rows; i++)
+                {
+                    for (var j = 0; j < columns; j++)
+                    {
+                        var value = a[Index(i, j, rows, columns)];
+                        value = alpha*(conjugate ? Complex.Conjugate(value) : value);
+                        expected[transpose ? Index(j, i, columns, rows) : Index(i, j, rows, columns)] = value;
+                    }
+                }
+
+                var b = Make(flavour, new Complex[rows*columns]);
+                Assert.That(Transpose(flavour, trans, rows, columns, alpha, Make(flavour, a), b), Is.EqualTo(0));
+                Assert.That(RelativeError(expected, Read(b)), Is.LessThan(Tolerance(flavour)));
+
+                var inPlace = Make(flavour, a);
+                Assert.That(Transpose(flavour, trans, rows, columns, alpha, inPlace, null), Is.EqualTo(0));
+                Assert.That(RelativeError(expected, Read(inPlace)), Is.LessThan(Tolerance(flavour)));
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsUnknownTrans(char flavour)
+        {
+            var a = Make(flavour, RandomValues(6, 1, flavour));
+            Assert.That(Transpose(flavour, 'X', 2, 3, Complex.One, a, Make(flavour, new Complex[6])), Is.EqualTo(-1));
+            Assert.That(Transpose(flavour, 'X', 2, 3, Complex.One, a, null), Is.EqualTo(-1));
+        }
+
+        /// <summary>
+        /// b := alpha*op(a), or a := alpha*op(a) in place when b is null.
+        /// </summary>
+        static int Transpose(char flavour, char trans, int rows, int columns, Complex alpha, Array a, Array b)
+        {
+            var mode = (byte)trans;
+            switch (flavour)
+            {
+                case 's':
+                    return b == null
+                        ? s_matrix_transpose_inplace(mode, rows, columns, (float)alpha.Real, (float[])a)
+                        : s_matrix_transpose(mode, rows, columns, (float)alpha.Real, (float[])a, (float[])b);
+                case 'd':
+                    return b == null
+                        ? d_matrix_transpose_inplace(mode, rows, columns, alpha.Real, (double[])a)
+                        : d_matrix_transpose(mode, rows, columns, alpha.Real, (double[])a, (double[])b);
+                case 'c':
+                    var single = new Complex32((float)alpha.Real, (float)alpha.Imaginary);
+                    return b == null
+                        ? c_matrix_transpose_inplace(mode, rows, columns, single, (Complex32[])a)
+                        : c_matrix_transpose(mode, rows, columns, single, (Complex32[])a, (Complex32[])b);
+                default:
+                    return b == null
+                        ? z_matrix_transpose_inplace(mode, rows, columns, alpha, (Complex[])a)
+                        : z_matrix_transpose(mode, rows, columns, alpha, (Complex[])a, (Complex[])b);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,341 @@
+﻿// <copyright file="NativeArrays.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using Complex = System.Numerics.Complex;
+
+namespace AHSEsim.Numerics.Tests.Providers
+{
+    /// <summary>
+    /// Test data for the native provider exports, which come in s, d, c and z flavours. Data is built
+    /// as complex values and converted to the array type of the flavour under test (real flavours drop
+    /// the imaginary part), so one test body can check all four against the same dense reference.
+    /// </summary>
+    internal static class NativeArrays
+    {
+        /// <summary>
+        /// Converts values to float[], double[], Complex32[] or Complex[] for flavour 's', 'd', 'c' or 'z'.
+        /// </summary>
+        public static Array Make(char flavour, Complex[] values)
+        {
+            switch (flavour)
+            {
+                case 's': return values.Select(v => (float)v.Real).ToArray();
+                case 'd': return values.Select(v => v.Real).ToArray();
+                case 'c': return values.Select(v => new Complex32((float)v.Real, (float)v.Imaginary)).ToArray();
+                case 'z': return values.ToArray();
+                default: throw new ArgumentOutOfRangeException(nameof(flavour));
+            }
+        }
+
+        /// <summary>
+        /// Converts an array made by <see cref="Make"/> back to complex values.
+        /// </summary>
+        public static Complex[] Read(Array array)
+        {
+            switch (array)
+            {
+                case float[] s: return s.Select(v => new Complex(v, 0.0)).ToArray();
+                case double[] d: return d.Select(v => new Complex(v, 0.0)).ToArray();
+                case Complex32[] c: return c.Select(v => new Complex(v.Real, v.Imaginary)).ToArray();
+                case Complex[] z: return z.ToArray();
+                default: throw new ArgumentException("Unsupported array type.", nameof(array));
+            }
+        }
+
+        /// <summary>
+        /// Reads n values of the flavour from native memory.
+        /// </summary>
+        public static Complex[] Load(char flavour, IntPtr source, int n)
+        {
+            switch (flavour)
+            {
+                case 's':
+                    var s = new float[n];
+                    Marshal.Copy(source, s, 0, n);
+                    return s.Select(v => new Complex(v, 0.0)).ToArray();
+                case 'd':
+                    var d = new double[n];
+                    Marshal.Copy(source, d, 0, n);
+                    return d.Select(v => new Complex(v, 0.0)).ToArray();
+                case 'c':
+                    var c = new float[2*n];
+                    Marshal.Copy(source, c, 0, 2*n);
+                    return Enumerable.Range(0, n).Select(i => new Complex(c[2*i], c[2*i + 1])).ToArray();
+                default:
+                    var z = new double[2*n];
+                    Marshal.Copy(source, z, 0, 2*n);
+                    return Enumerable.Range(0, n).Select(i => new Complex(z[2*i], z[2*i + 1])).ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Writes values to native memory as the flavour.
+        /// </summary>
+        public static void Store(char flavour, Complex[] values, IntPtr destination)
+        {
+            switch (flavour)
+            {
+                case 's':
+                    Marshal.Copy(values.Select(v => (float)v.Real).ToArray(), 0, destination, values.Length);
+                    break;
+                case 'd':
+                    Marshal.Copy(values.Select(v => v.Real).ToArray(), 0, destination, values.Length);
+                    break;
+                case 'c':
+                    Marshal.Copy(values.SelectMany(v => new[] { (float)v.Real, (float)v.Imaginary }).ToArray(), 0, destination, 2*values.Length);
+                    break;
+                default:
+                    Marshal.Copy(values.SelectMany(v => new[] { v.Real, v.Imaginary }).ToArray(), 0, destination, 2*values.Length);
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Whether the flavour is complex.
+        /// </summary>
+        public static bool IsComplex(char flavour)
+        {
+            return flavour == 'c' || flavour == 'z';
+        }
+
+        /// <summary>
+        /// Relative tolerance for results of the flavour: single or double precision.
+        /// </summary>
+        public static double Tolerance(char flavour)
+        {
+            return flavour == 's' || flavour == 'c' ? 1e-4 : 1e-11;
+        }
+
+        /// <summary>
+        /// Uniform random values in [-1, 1), with an imaginary part for complex flavours.
+        /// </summary>
+        public static Complex[] RandomValues(int count, int seed, char flavour)
+        {
+            var random = new System.Random(seed);
+            return Enumerable.Range(0, count)
+                .Select(_ => new Complex(2.0*random.NextDouble() - 1.0, IsComplex(flavour) ? 2.0*random.NextDouble() - 1.0 : 0.0))
+                .ToArray();
+        }
+
+        /// <summary>
+        /// Random n x n matrix with a dominant diagonal (well conditioned, any storage order).
+        /// </summary>
+        public static Complex[] DiagonallyDominant(int n, int seed, char flavour)
+        {
+            var a = RandomValues(n*n, seed, flavour);
+            for (var i = 0; i < n; i++)
+            {
+                a[i*n + i] += n;
+            }
+
+            return a;
+        }
+
+        /// <summary>
+        /// Random Hermitian positive definite n x n matrix (the same in both storage orders up to conjugation).
+        /// </summary>
+        public static Complex[] PositiveDefinite(int n, int seed, char flavour)
+        {
+            var g = RandomValues(n*n, seed, flavour);
+            var a = new Complex[n*n];
+            for (var i = 0; i < n; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    var sum = i == j ? new Complex(n, 0.0) : Complex.Zero;
+                    for (var k = 0; k < n; k++)
+                    {
+                        sum += g[k*n + i]*Complex.Conjugate(g[k*n + j]);
+                    }
+
+                    a[j*n + i] = sum;
+                }
+            }
+
+            return a;
+        }
+
+        /// <summary>
+        /// CSR matrix with sorted column indices: the diagonal (when in range), both neighbours and
+        /// up to extra random entries per row.
+        /// </summary>
+        public static (int[] RowPointers, int[] ColumnIndices, Complex[] Values) RandomCsr(int m, int n, int extra, int seed, char flavour)
+        {
+            var random = new System.Random(seed);
+            var rowPointers = new int[m + 1];
+            var columnIndices = new List<int>();
+            for (var i = 0; i < m; i++)
+            {
+                var row = Enumerable.Range(0, extra).Select(_ => random.Next(n)).Concat(new[] { i - 1, i, i + 1 })
+                    .Where(j => j >= 0 && j < n).Distinct().OrderBy(j => j);
+                columnIndices.AddRange(row);
+                rowPointers[i + 1] = columnIndices.Count;
+            }
+
+            return (rowPointers, columnIndices.ToArray(), RandomValues(columnIndices.Count, seed + 1, flavour));
+        }
+
+        /// <summary>
+        /// Random CSR matrix, made Hermitian when asked, with a diagonal that dominates its row.
+        /// </summary>
+        public static (int[] RowPointers, int[] ColumnIndices, Complex[] Values) DominantCsr(int n, int seed, char flavour, bool hermitian)
+        {
+            var csr = RandomCsr(n, n, 3, seed, flavour);
+            var rows = Enumerable.Range(0, n).Select(_ => new SortedDictionary<int, Complex>()).ToArray();
+            for (var i = 0; i < n; i++)
+            {
+                for (var p = csr.RowPointers[i]; p < csr.RowPointers[i + 1]; p++)
+                {
+                    var j = csr.ColumnIndices[p];
+                    rows[i].TryGetValue(j, out var value);
+                    rows[i][j] = value + csr.Values[p];
+                    if (hermitian)
+                    {
+                        rows[j].TryGetValue(i, out value);
+                        rows[j][i] = value + Complex.Conjugate(csr.Values[p]);
+                    }
+                }
+            }
+
+            var rowPointers = new int[n + 1];
+            var columnIndices = new List<int>();
+            var values = new List<Complex>();
+            for (var i = 0; i < n; i++)
+            {
+                var offDiagonal = rows[i].Where(e => e.Key != i).Sum(e => e.Value.Magnitude);
+                rows[i][i] = new Complex(offDiagonal + 1.0, 0.0);
+                columnIndices.AddRange(rows[i].Keys);
+                values.AddRange(rows[i].Values);
+                rowPointers[i + 1] = columnIndices.Count;
+            }
+
+            return (rowPointers, columnIndices.ToArray(), values.ToArray());
+        }
+
+        /// <summary>
+        /// Column-major dense form of an m x n CSR matrix; duplicate entries are summed.
+        /// </summary>
+        public static Complex[] CsrToDense(int m, int n, int[] rowPointers, int[] columnIndices, Complex[] values)
+        {
+            var dense = new Complex[m*n];
+            for (var i = 0; i < m; i++)
+            {
+                for (var p = rowPointers[i]; p < rowPointers[i + 1]; p++)
+                {
+                    dense[Index(i, columnIndices[p], m, n)] += values[p];
+                }
+            }
+
+            return dense;
+        }
+
+        /// <summary>
+        /// Element (i, j) of a rows x columns matrix stored by columns, or by rows when rowMajor is set.
+        /// </summary>
+        public static int Index(int i, int j, int rows, int columns, bool rowMajor = false)
+        {
+            return rowMajor ? i*columns + j : j*rows + i;
+        }
+
+        /// <summary>
+        /// The n x n identity matrix.
+        /// </summary>
+        public static Complex[] Identity(int n)
+        {
+            var identity = new Complex[n*n];
+            for (var i = 0; i < n; i++)
+            {
+                identity[i*n + i] = Complex.One;
+            }
+
+            return identity;
+        }
+
+        /// <summary>
+        /// Conjugate transpose of a rows x columns matrix in the given storage order.
+        /// </summary>
+        public static Complex[] Adjoint(int rows, int columns, Complex[] a, bool rowMajor = false)
+        {
+            var t = new Complex[rows*columns];
+            for (var i = 0; i < rows; i++)
+            {
+                for (var j = 0; j < columns; j++)
+                {
+                    t[Index(j, i, columns, rows, rowMajor)] = Complex.Conjugate(a[Index(i, j, rows, columns, rowMajor)]);
+                }
+            }
+
+            return t;
+        }
+
+        /// <summary>
+        /// Dense product of an m x k and a k x n matrix in the given storage order.
+        /// </summary>
+        public static Complex[] Multiply(int m, int k, int n, Complex[] a, Complex[] b, bool rowMajor = false)
+        {
+            var c = new Complex[m*n];
+            for (var i = 0; i < m; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    var sum = Complex.Zero;
+                    for (var p = 0; p < k; p++)
+                    {
+                        sum += a[Index(i, p, m, k, rowMajor)]*b[Index(p, j, k, n, rowMajor)];
+                    }
+
+                    c[Index(i, j, m, n, rowMajor)] = sum;
+                }
+            }
+
+            return c;
+        }
+
+        /// <summary>
+        /// Largest absolute difference between two arrays, relative to the largest absolute value of expected.
+        /// </summary>
+        public static double RelativeError(Complex[] expected, Complex[] actual)
+        {
+            if (expected.Length != actual.Length)
+            {
+                throw new ArgumentException("Length mismatch.", nameof(actual));
+            }
+
+            var scale = Math.Max(1.0, expected.Max(v => v.Magnitude));
+            return expected.Zip(actual, (e, a) => (e - a).Magnitude).DefaultIfEmpty(0.0).Max()/scale;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,208 @@
+﻿// <copyright file="MatrixFreeKrylovProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the matrix-free Krylov solver exports, with the operator and a Jacobi preconditioner
+    /// supplied as callbacks over a CSR matrix.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class MatrixFreeKrylovProviderTests
+    {
+        const int Converged = 0;
+        const int Failed = 3;
+
+        [TestCase('s', "cg")]
+        [TestCase('d', "cg")]
+        [TestCase('c', "cg")]
+        [TestCase('z', "cg")]
+        [TestCase('s', "bicgstab")]
+        [TestCase('d', "bicgstab")]
+        [TestCase('c', "bicgstab")]
+        [TestCase('z', "bicgstab")]
+        [TestCase('s', "gmres")]
+        [TestCase('d', "gmres")]
+        [TestCase('c', "gmres")]
+        [TestCase('z', "gmres")]
+        public void SolversConverge(char flavour, string method)
+        {
+            const int n = 300;
+            var a = DominantCsr(n, 1, flavour, method == "cg");
+            var values = Read(Make(flavour, a.Values));
+            var diagonal = Enumerable.Range(0, n).Select(i => values[Enumerable.Range(a.RowPointers[i], a.RowPointers[i + 1] - a.RowPointers[i]).First(p => a.ColumnIndices[p] == i)]).ToArray();
+            var b = Read(Make(flavour, RandomValues(n, 2, flavour)));
+            var norm = Math.Sqrt(b.Sum(v => v.Magnitude*v.Magnitude));
+            var tolerance = Tolerance(flavour)/10;
+            var products = 0;
+
+            SparseCallback multiply = (context, x, y) =>
+            {
+                products++;
+                var input = Load(flavour, x, n);
+                var output = new Complex[n];
+                for (var i = 0; i < n; i++)
+                {
+                    for (var p = a.RowPointers[i]; p < a.RowPointers[i + 1]; p++)
+                    {
+                        output[i] += values[p]*input[a.ColumnIndices[p]];
+                    }
+                }
+
+                Store(flavour, output, y);
+                return 0;
+            };
+            SparseCallback jacobi = (context, x, y) =>
+            {
+                Store(flavour, Load(flavour, x, n).Zip(diagonal, (p, d) => p/d).ToArray(), y);
+                return 0;
+            };
+
+            foreach (var precondition in new[] { null, jacobi })
+            {
+                const int maxIterations = 200;
+                var x = Make(flavour, new Complex[n]);
+                var residuals = new double[maxIterations + 1];
+                int iterations;
+                double seconds;
+                products = 0;
+                Assert.That(Solve(flavour, method, n, multiply, precondition, b, x, maxIterations, 20, tolerance, out iterations, residuals, out seconds), Is.EqualTo(Converged));
+                Assert.That(iterations, Is.GreaterThan(0));
+                Assert.That(products, Is.GreaterThanOrEqualTo(iterations));
+                Assert.That(residuals[iterations], Is.LessThanOrEqualTo(tolerance*norm*1.01));
+
+                var r = Multiply(n, n, 1, CsrToDense(n, n, a.RowPointers, a.ColumnIndices, values), Read(x)).Zip(b, (p, q) => q - p).ToArray();
+                Assert.That(Math.Sqrt(r.Sum(v => v.Magnitude*v.Magnitude)), Is.LessThanOrEqualTo(tolerance*norm*10));
+            }
+
+            GC.KeepAlive(multiply);
+            GC.KeepAlive(jacobi);
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsCallbackFailureAndBadArguments(char flavour)
+        {
+            const int n = 10;
+            var b = Read(Make(flavour, RandomValues(n, 3, flavour)));
+            var residuals = new double[21];
+            int iterations;
+            double seconds;
+
+            // diag(1, ..., n) takes n iterations; the failing callbacks return an error on their third call.
+            var calls = 0;
+            SparseCallback diagonal = (context, x, y) =>
+            {
+                Store(flavour, Load(flavour, x, n).Select((v, i) => v*(i + 1)).ToArray(), y);
+                return 0;
+            };
+            SparseCallback failingDiagonal = (context, x, y) => diagonal(context, x, y) == 0 && ++calls < 3 ? 0 : -1;
+            SparseCallback failingIdentity = (context, x, y) =>
+            {
+                Store(flavour, Load(flavour, x, n), y);
+                return ++calls < 3 ? 0 : -1;
+            };
+
+            foreach (var method in new[] { "cg", "bicgstab", "gmres" })
+            {
+                calls = 0;
+                Assert.That(Solve(flavour, method, n, diagonal, failingIdentity, b, Make(flavour, new Complex[n]), 20, 5, 1e-30, out iterations, residuals, out seconds), Is.EqualTo(Failed), method);
+                calls = 0;
+                Assert.That(Solve(flavour, method, n, failingDiagonal, null, b, Make(flavour, new Complex[n]), 20, 5, 1e-30, out iterations, residuals, out seconds), Is.EqualTo(Failed), method);
+
+                Assert.That(Solve(flavour, method, -1, diagonal, null, b, Make(flavour, new Complex[n]), 20, 5, 1e-6, out iterations, residuals, out seconds), Is.EqualTo(-1), method);
+                Assert.That(Solve(flavour, method, n, null, null, b, Make(flavour, new Complex[n]), 20, 5, 1e-6, out iterations, residuals, out seconds), Is.EqualTo(-2), method);
+                Assert.That(Solve(flavour, method, n, diagonal, null, b, Make(flavour, new Complex[n]), -1, 5, 1e-6, out iterations, residuals, out seconds), Is.EqualTo(-7), method);
+            }
+
+            Assert.That(Solve(flavour, "gmres", n, diagonal, null, b, Make(flavour, new Complex[n]), 20, 0, 1e-6, out iterations, residuals, out seconds), Is.EqualTo(-8));
+            GC.KeepAlive(diagonal);
+            GC.KeepAlive(failingDiagonal);
+            GC.KeepAlive(failingIdentity);
+        }
+
+        /// <summary>
+        /// Runs the named solver from a zero initial guess in x; residuals are widened to double for the
+        /// single precision flavours.
+        /// </summary>
+        static int Solve(char flavour, string method, int n, SparseCallback multiply, SparseCallback precondition, Complex[] b, Array x,
+            int maxIterations, int restart, double tolerance, out int iterations, double[] residuals, out double seconds)
+        {
+            int info;
+            var bb = Make(flavour, b);
+            if (flavour == 's' || flavour == 'c')
+            {
+                var single = new float[residuals.Length];
+                var t = (float)tolerance;
+                if (flavour == 's')
+                {
+                    info = method == "cg" ? s_matrix_free_cg(n, multiply, precondition, IntPtr.Zero, (float[])bb, (float[])x, maxIterations, t, 0f, out iterations, single, out seconds)
+                        : method == "bicgstab" ? s_matrix_free_bicgstab(n, multiply, precondition, IntPtr.Zero, (float[])bb, (float[])x, maxIterations, t, 0f, out iterations, single, out seconds)
+                        : s_matrix_free_gmres(n, multiply, precondition, IntPtr.Zero, (float[])bb, (float[])x, maxIterations, restart, t, 0f, out iterations, single, out seconds);
+                }
+                else
+                {
+                    info = method == "cg" ? c_matrix_free_cg(n, multiply, precondition, IntPtr.Zero, (Complex32[])bb, (Complex32[])x, maxIterations, t, 0f, out iterations, single, out seconds)
+                        : method == "bicgstab" ? c_matrix_free_bicgstab(n, multiply, precondition, IntPtr.Zero, (Complex32[])bb, (Complex32[])x, maxIterations, t, 0f, out iterations, single, out seconds)
+                        : c_matrix_free_gmres(n, multiply, precondition, IntPtr.Zero, (Complex32[])bb, (Complex32[])x, maxIterations, restart, t, 0f, out iterations, single, out seconds);
+                }
+
+                Array.Copy(single.Select(r => (double)r).ToArray(), residuals, residuals.Length);
+                return info;
+            }
+
+            if (flavour == 'd')
+            {
+                return method == "cg" ? d_matrix_free_cg(n, multiply, precondition, IntPtr.Zero, (double[])bb, (double[])x, maxIterations, tolerance, 0.0, out iterations, residuals, out seconds)
+                    : method == "bicgstab" ? d_matrix_free_bicgstab(n, multiply, precondition, IntPtr.Zero, (double[])bb, (double[])x, maxIterations, tolerance, 0.0, out iterations, residuals, out seconds)
+                    : d_matrix_free_gmres(n, multiply, precondition, IntPtr.Zero, (double[])bb, (double[])x, maxIterations, restart, tolerance, 0.0, out iterations, residuals, out seconds);
+            }
+
+            return method == "cg" ? z_matrix_free_cg(n, multiply, precondition, IntPtr.Zero, (Complex[])bb, (Complex[])x, maxIterations, tolerance, 0.0, out iterations, residuals, out seconds)
+                : method == "bicgstab" ? z_matrix_free_bicgstab(n, multiply, precondition, IntPtr.Zero, (Complex[])bb, (Complex[])x, maxIterations, tolerance, 0.0, out iterations, residuals, out seconds)
+                : z_matrix_free_gmres(n, multiply, precondition, IntPtr.Zero, (Complex[])bb, (Complex[])x, maxIterations, restart, tolerance, 0.0, out iterations, residuals, out seconds);
+        }
+    }
+}
+
+#endif
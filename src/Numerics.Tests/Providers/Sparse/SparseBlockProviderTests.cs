@@ -0,0 +1,182 @@
+﻿// <copyright file="SparseBlockProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the block sparse row exports: the conversion from CSR, and the products against the dense
+    /// matrix padded to whole blocks.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseBlockProviderTests
+    {
+        [TestCase('s', 3)]
+        [TestCase('d', 1)]
+        [TestCase('d', 2)]
+        [TestCase('d', 3)]
+        [TestCase('d', 4)]
+        [TestCase('d', 5)]
+        [TestCase('d', 6)]
+        [TestCase('c', 4)]
+        [TestCase('z', 2)]
+        [TestCase('z', 6)]
+        public void BsrMatchesCsr(char flavour, int block)
+        {
+            // Neither dimension is a multiple of the block, so the last blocks are padded.
+            const int m = 37, n = 29, columns = 3;
+            var a = RandomCsr(m, n, 3, block, flavour);
+            var values = Read(Make(flavour, a.Values));
+            var mb = (m + block - 1)/block;
+            var nb = (n + block - 1)/block;
+
+            var blockRowPointers = new int[mb + 1];
+            Assert.That(sparse_bsr_count(m, n, block, a.RowPointers, a.ColumnIndices, blockRowPointers), Is.EqualTo(0));
+            var blocks = blockRowPointers[mb];
+            var blockColumnIndices = new int[blocks];
+            var blockValues = Make(flavour, new Complex[blocks*block*block]);
+            Assert.That(CsrToBsr(flavour, m, n, block, a.RowPointers, a.ColumnIndices, Make(flavour, values), blockRowPointers, blockColumnIndices, blockValues), Is.EqualTo(0));
+
+            // Dense form of the BSR matrix, with row-major blocks.
+            var rows = mb*block;
+            var cols = nb*block;
+            var bsr = new Complex[rows*cols];
+            var v = Read(blockValues);
+            for (var ib = 0; ib < mb; ib++)
+            {
+                for (var p = blockRowPointers[ib]; p < blockRowPointers[ib + 1]; p++)
+                {
+                    Assert.That(p == blockRowPointers[ib] || blockColumnIndices[p - 1] < blockColumnIndices[p], Is.True);
+                    for (var i = 0; i < block; i++)
+                    {
+                        for (var j = 0; j < block; j++)
+                        {
+                            bsr[Index(ib*block + i, blockColumnIndices[p]*block + j, rows, cols)] = v[p*block*block + i*block + j];
+                        }
+                    }
+                }
+            }
+
+            var dense = CsrToDense(m, n, a.RowPointers, a.ColumnIndices, values);
+            var padded = new Complex[rows*cols];
+            for (var i = 0; i < m; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    padded[Index(i, j, rows, cols)] = dense[Index(i, j, m, n)];
+                }
+            }
+
+            Assert.That(RelativeError(padded, bsr), Is.EqualTo(0.0));
+
+            var x = Read(Make(flavour, RandomValues(cols*columns, 7, flavour)));
+            var expected = Multiply(rows, cols, columns, padded, x);
+            var y = Make(flavour, new Complex[rows]);
+            Assert.That(Mv(flavour, mb, nb, block, blockRowPointers, blockColumnIndices, blockValues, Make(flavour, x.Take(cols).ToArray()), y), Is.EqualTo(0));
+            Assert.That(RelativeError(expected.Take(rows).ToArray(), Read(y)), Is.LessThan(Tolerance(flavour)*10));
+
+            var yy = Make(flavour, new Complex[rows*columns]);
+            Assert.That(Mm(flavour, mb, nb, block, blockRowPointers, blockColumnIndices, blockValues, columns, Make(flavour, x), yy), Is.EqualTo(0));
+            Assert.That(RelativeError(expected, Read(yy)), Is.LessThan(Tolerance(flavour)*10));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBadArguments(char flavour)
+        {
+            const int n = 6;
+            var a = RandomCsr(n, n, 1, 9, flavour);
+            var blockRowPointers = new int[4];
+            Assert.That(sparse_bsr_count(-1, n, 2, a.RowPointers, a.ColumnIndices, blockRowPointers), Is.EqualTo(-1));
+            Assert.That(sparse_bsr_count(n, -1, 2, a.RowPointers, a.ColumnIndices, blockRowPointers), Is.EqualTo(-2));
+            Assert.That(sparse_bsr_count(n, n, 0, a.RowPointers, a.ColumnIndices, blockRowPointers), Is.EqualTo(-3));
+
+            // A column index outside the n columns.
+            var columnIndices = a.ColumnIndices.ToArray();
+            columnIndices[0] = n;
+            Assert.That(sparse_bsr_count(n, n, 2, a.RowPointers, columnIndices, blockRowPointers), Is.EqualTo(-5));
+            Assert.That(CsrToBsr(flavour, n, n, 2, a.RowPointers, columnIndices, Make(flavour, a.Values), blockRowPointers, new int[n*n], Make(flavour, new Complex[4*n*n])), Is.EqualTo(-5));
+
+            Assert.That(sparse_bsr_count(n, n, 2, a.RowPointers, a.ColumnIndices, blockRowPointers), Is.EqualTo(0));
+            var values = Make(flavour, new Complex[4*blockRowPointers[3]]);
+            var x = Make(flavour, new Complex[n]);
+            Assert.That(Mv(flavour, -1, 3, 2, blockRowPointers, new int[blockRowPointers[3]], values, x, Make(flavour, new Complex[n])), Is.EqualTo(-1));
+            Assert.That(Mv(flavour, 3, 3, 0, blockRowPointers, new int[blockRowPointers[3]], values, x, Make(flavour, new Complex[n])), Is.EqualTo(-3));
+            Assert.That(Mm(flavour, 3, 3, 2, blockRowPointers, new int[blockRowPointers[3]], values, -1, x, Make(flavour, new Complex[n])), Is.EqualTo(-7));
+        }
+
+        static int CsrToBsr(char flavour, int m, int n, int block, int[] rowPointers, int[] columnIndices, Array values, int[] blockRowPointers, int[] blockColumnIndices, Array blockValues)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_to_bsr(m, n, block, rowPointers, columnIndices, (float[])values, blockRowPointers, blockColumnIndices, (float[])blockValues);
+                case 'd': return d_sparse_csr_to_bsr(m, n, block, rowPointers, columnIndices, (double[])values, blockRowPointers, blockColumnIndices, (double[])blockValues);
+                case 'c': return c_sparse_csr_to_bsr(m, n, block, rowPointers, columnIndices, (Complex32[])values, blockRowPointers, blockColumnIndices, (Complex32[])blockValues);
+                default: return z_sparse_csr_to_bsr(m, n, block, rowPointers, columnIndices, (Complex[])values, blockRowPointers, blockColumnIndices, (Complex[])blockValues);
+            }
+        }
+
+        static int Mv(char flavour, int mb, int nb, int block, int[] blockRowPointers, int[] blockColumnIndices, Array blockValues, Array x, Array y)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_bsr_mv(mb, nb, block, blockRowPointers, blockColumnIndices, (float[])blockValues, (float[])x, (float[])y);
+                case 'd': return d_sparse_bsr_mv(mb, nb, block, blockRowPointers, blockColumnIndices, (double[])blockValues, (double[])x, (double[])y);
+                case 'c': return c_sparse_bsr_mv(mb, nb, block, blockRowPointers, blockColumnIndices, (Complex32[])blockValues, (Complex32[])x, (Complex32[])y);
+                default: return z_sparse_bsr_mv(mb, nb, block, blockRowPointers, blockColumnIndices, (Complex[])blockValues, (Complex[])x, (Complex[])y);
+            }
+        }
+
+        static int Mm(char flavour, int mb, int nb, int block, int[] blockRowPointers, int[] blockColumnIndices, Array blockValues, int columns, Array x, Array y)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_bsr_mm(mb, nb, block, blockRowPointers, blockColumnIndices, (float[])blockValues, columns, (float[])x, (float[])y);
+                case 'd': return d_sparse_bsr_mm(mb, nb, block, blockRowPointers, blockColumnIndices, (double[])blockValues, columns, (double[])x, (double[])y);
+                case 'c': return c_sparse_bsr_mm(mb, nb, block, blockRowPointers, blockColumnIndices, (Complex32[])blockValues, columns, (Complex32[])x, (Complex32[])y);
+                default: return z_sparse_bsr_mm(mb, nb, block, blockRowPointers, blockColumnIndices, (Complex[])blockValues, columns, (Complex[])x, (Complex[])y);
+            }
+        }
+    }
+}
+
+#endif
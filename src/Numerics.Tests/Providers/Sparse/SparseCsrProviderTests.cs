@@ -0,0 +1,238 @@
+﻿// <copyright file="SparseCsrProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the CSR product exports with a matrix descriptor (x_sparse_csr_create/mv/free and
+    /// x_sparse_csr_mv_descr/mm_descr) against the dense matrix the descriptor describes.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseCsrProviderTests
+    {
+        const int General = 0;
+        const int Symmetric = 1;
+        const int Hermitian = 2;
+        const int Triangular = 3;
+
+        // (matrix type, fill mode, diag type)
+        static readonly int[][] Descriptors =
+        {
+            new[] { General, 0, 0 },
+            new[] { Symmetric, 0, 0 },
+            new[] { Symmetric, 1, 0 },
+            new[] { Hermitian, 0, 0 },
+            new[] { Hermitian, 1, 0 },
+            new[] { Triangular, 0, 0 },
+            new[] { Triangular, 1, 1 },
+        };
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ProductsMatchDescribedMatrix(char flavour)
+        {
+            const int n = 40, columns = 3;
+            var csr = RandomCsr(n, n, 6, 11, flavour);
+            var values = Make(flavour, csr.Values);
+            var x = RandomValues(n*columns, 12, flavour);
+
+            foreach (var d in Descriptors)
+            {
+                var dense = Dense(n, n, csr.RowPointers, csr.ColumnIndices, csr.Values, d[0], d[1], d[2]);
+                var expected = Multiply(n, n, columns, dense, x);
+                var first = expected.Take(n).ToArray();
+
+                IntPtr handle;
+                Assert.That(Create(flavour, out handle, n, n, csr.RowPointers, csr.ColumnIndices, values, d[0], d[1], d[2]), Is.EqualTo(0));
+                var y1 = Make(flavour, new Complex[n]);
+                Assert.That(Mv(flavour, handle, Make(flavour, x.Take(n).ToArray()), y1), Is.EqualTo(0));
+                Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+                Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+                Assert.That(RelativeError(first, Read(y1)), Is.LessThan(Tolerance(flavour)), $"handle, descriptor {string.Join(",", d)}");
+
+                var y2 = Make(flavour, new Complex[n]);
+                Assert.That(MvDescr(flavour, n, n, values, csr.RowPointers, csr.ColumnIndices, csr.RowPointers[n], Make(flavour, x.Take(n).ToArray()), y2, d[0], d[1], d[2]), Is.EqualTo(0));
+                Assert.That(RelativeError(first, Read(y2)), Is.LessThan(Tolerance(flavour)), $"mv, descriptor {string.Join(",", d)}");
+
+                var c = Make(flavour, new Complex[n*columns]);
+                Assert.That(MmDescr(flavour, n, n, columns, values, csr.RowPointers, csr.ColumnIndices, csr.RowPointers[n], Make(flavour, x), c, d[0], d[1], d[2]), Is.EqualTo(0));
+                Assert.That(RelativeError(expected, Read(c)), Is.LessThan(Tolerance(flavour)), $"mm, descriptor {string.Join(",", d)}");
+            }
+
+            Assert.That(RelativeError(Read(Make(flavour, csr.Values)), Read(values)), Is.EqualTo(0.0));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void RectangularGeneralProduct(char flavour)
+        {
+            const int m = 7, k = 12, columns = 2;
+            var csr = RandomCsr(m, k, 4, 13, flavour);
+            var values = Make(flavour, csr.Values);
+            var b = RandomValues(k*columns, 14, flavour);
+            var expected = Multiply(m, k, columns, Dense(m, k, csr.RowPointers, csr.ColumnIndices, csr.Values, General, 0, 0), b);
+
+            var c = Make(flavour, new Complex[m*columns]);
+            Assert.That(MmDescr(flavour, m, k, columns, values, csr.RowPointers, csr.ColumnIndices, csr.RowPointers[m], Make(flavour, b), c, General, 0, 0), Is.EqualTo(0));
+            Assert.That(RelativeError(expected, Read(c)), Is.LessThan(Tolerance(flavour)));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBadArguments(char flavour)
+        {
+            const int n = 5;
+            var csr = RandomCsr(n, n, 2, 15, flavour);
+            var values = Make(flavour, csr.Values);
+            var nnz = csr.RowPointers[n];
+            var x = Make(flavour, new Complex[n]);
+            var y = Make(flavour, new Complex[n]);
+
+            // nnz must equal row_ptr[m].
+            Assert.That(MvDescr(flavour, n, n, values, csr.RowPointers, csr.ColumnIndices, nnz - 1, x, y, General, 0, 0), Is.EqualTo(-6));
+            Assert.That(MmDescr(flavour, n, n, 1, values, csr.RowPointers, csr.ColumnIndices, nnz + 1, x, y, General, 0, 0), Is.EqualTo(-7));
+
+            // Unknown matrix type, bad fill mode; symmetric types must be square.
+            Assert.That(MvDescr(flavour, n, n, values, csr.RowPointers, csr.ColumnIndices, nnz, x, y, 4, 0, 0), Is.EqualTo(-9));
+            Assert.That(MmDescr(flavour, n, n, 1, values, csr.RowPointers, csr.ColumnIndices, nnz, x, y, General, 2, 0), Is.EqualTo(-11));
+            Assert.That(MvDescr(flavour, n - 1, n, values, csr.RowPointers, csr.ColumnIndices, csr.RowPointers[n - 1], x, y, Symmetric, 0, 0), Is.EqualTo(-9));
+
+            IntPtr handle;
+            Assert.That(Create(flavour, out handle, n, n, csr.RowPointers, csr.ColumnIndices, values, Hermitian, 0, 3), Is.EqualTo(-9));
+            Assert.That(Mv(flavour, IntPtr.Zero, x, y), Is.EqualTo(-1));
+        }
+
+        /// <summary>
+        /// Column-major dense matrix described by a CSR matrix and a descriptor.
+        /// </summary>
+        static Complex[] Dense(int m, int n, int[] rowPointers, int[] columnIndices, Complex[] values, int type, int fill, int diag)
+        {
+            var dense = new Complex[m*n];
+            for (var i = 0; i < m; i++)
+            {
+                if (type != General && diag == 1)
+                {
+                    dense[Index(i, i, m, n)] = Complex.One;
+                }
+
+                for (var p = rowPointers[i]; p < rowPointers[i + 1]; p++)
+                {
+                    var j = columnIndices[p];
+                    if (type != General && ((fill == 0 ? j > i : j < i) || (diag == 1 && j == i)))
+                    {
+                        continue;
+                    }
+
+                    dense[Index(i, j, m, n)] += values[p];
+                    if ((type == Symmetric || type == Hermitian) && j != i)
+                    {
+                        dense[Index(j, i, m, n)] += type == Hermitian ? Complex.Conjugate(values[p]) : values[p];
+                    }
+                }
+            }
+
+            return dense;
+        }
+
+        static int Create(char flavour, out IntPtr handle, int m, int n, int[] rowPointers, int[] columnIndices, Array values, int type, int fill, int diag)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_create(out handle, m, n, rowPointers, columnIndices, (float[])values, type, fill, diag, 1);
+                case 'd': return d_sparse_csr_create(out handle, m, n, rowPointers, columnIndices, (double[])values, type, fill, diag, 1);
+                case 'c': return c_sparse_csr_create(out handle, m, n, rowPointers, columnIndices, (Complex32[])values, type, fill, diag, 1);
+                default: return z_sparse_csr_create(out handle, m, n, rowPointers, columnIndices, (Complex[])values, type, fill, diag, 1);
+            }
+        }
+
+        static int Mv(char flavour, IntPtr handle, Array x, Array y)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_mv(handle, (float[])x, (float[])y);
+                case 'd': return d_sparse_csr_mv(handle, (double[])x, (double[])y);
+                case 'c': return c_sparse_csr_mv(handle, (Complex32[])x, (Complex32[])y);
+                default: return z_sparse_csr_mv(handle, (Complex[])x, (Complex[])y);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_free(ref handle);
+                case 'd': return d_sparse_csr_free(ref handle);
+                case 'c': return c_sparse_csr_free(ref handle);
+                default: return z_sparse_csr_free(ref handle);
+            }
+        }
+
+        static int MvDescr(char flavour, int m, int n, Array values, int[] rowPointers, int[] columnIndices, int nnz, Array x, Array y, int type, int fill, int diag)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_mv_descr(m, n, (float[])values, rowPointers, columnIndices, nnz, (float[])x, (float[])y, type, fill, diag);
+                case 'd': return d_sparse_csr_mv_descr(m, n, (double[])values, rowPointers, columnIndices, nnz, (double[])x, (double[])y, type, fill, diag);
+                case 'c': return c_sparse_csr_mv_descr(m, n, (Complex32[])values, rowPointers, columnIndices, nnz, (Complex32[])x, (Complex32[])y, type, fill, diag);
+                default: return z_sparse_csr_mv_descr(m, n, (Complex[])values, rowPointers, columnIndices, nnz, (Complex[])x, (Complex[])y, type, fill, diag);
+            }
+        }
+
+        static int MmDescr(char flavour, int m, int k, int n, Array values, int[] rowPointers, int[] columnIndices, int nnz, Array b, Array c, int type, int fill, int diag)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_csr_mm_descr(m, k, n, (float[])values, rowPointers, columnIndices, nnz, (float[])b, (float[])c, type, fill, diag);
+                case 'd': return d_sparse_csr_mm_descr(m, k, n, (double[])values, rowPointers, columnIndices, nnz, (double[])b, (double[])c, type, fill, diag);
+                case 'c': return c_sparse_csr_mm_descr(m, k, n, (Complex32[])values, rowPointers, columnIndices, nnz, (Complex32[])b, (Complex32[])c, type, fill, diag);
+                default: return z_sparse_csr_mm_descr(m, k, n, (Complex[])values, rowPointers, columnIndices, nnz, (Complex[])b, (Complex[])c, type, fill, diag);
+            }
+        }
+    }
+}
+
+#endif
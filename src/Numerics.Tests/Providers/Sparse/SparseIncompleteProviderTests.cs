@@ -0,0 +1,254 @@
+﻿// <copyright file="SparseIncompleteProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the ILU(0) and IC(0) exports: the factor reproduces A on its pattern, and applying the
+    /// preconditioner solves with the exported factor.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseIncompleteProviderTests
+    {
+        [TestCase('s', 40)]
+        [TestCase('d', 40)]
+        [TestCase('c', 40)]
+        [TestCase('z', 40)]
+        [TestCase('d', 1500)]
+        [TestCase('z', 1500)]
+        public void Ilu0MatchesOnPattern(char flavour, int n)
+        {
+            var a = DominantCsr(n, 1, flavour, false);
+            var values = Read(Make(flavour, a.Values));
+
+            IntPtr handle;
+            int nnz;
+            Assert.That(Create(flavour, false, out handle, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), out nnz), Is.EqualTo(0));
+            Assert.That(nnz, Is.EqualTo(a.RowPointers[n]));
+            var factor = Export(flavour, handle, n, nnz);
+            Assert.That(factor.RowPointers, Is.EqualTo(a.RowPointers));
+            Assert.That(factor.ColumnIndices, Is.EqualTo(a.ColumnIndices));
+
+            // L is unit lower and U upper, both stored in the pattern of A.
+            var dense = CsrToDense(n, n, factor.RowPointers, factor.ColumnIndices, factor.Values);
+            var l = Part(n, dense, true);
+            var u = Part(n, dense, false);
+            for (var i = 0; i < n; i++)
+            {
+                l[Index(i, i, n, n)] = Complex.One;
+            }
+
+            CheckPreconditioner(flavour, handle, n, a, values, l, u);
+        }
+
+        [TestCase('s', 40)]
+        [TestCase('d', 40)]
+        [TestCase('c', 40)]
+        [TestCase('z', 40)]
+        [TestCase('d', 1500)]
+        [TestCase('z', 1500)]
+        public void Ic0MatchesOnLowerPattern(char flavour, int n)
+        {
+            var a = DominantCsr(n, 2, flavour, true);
+            var values = Read(Make(flavour, a.Values));
+
+            IntPtr handle;
+            int nnz;
+            Assert.That(Create(flavour, true, out handle, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), out nnz), Is.EqualTo(0));
+
+            // Only the lower triangle of A is kept.
+            var lowerCount = Enumerable.Range(0, n).Sum(i => Enumerable.Range(a.RowPointers[i], a.RowPointers[i + 1] - a.RowPointers[i]).Count(p => a.ColumnIndices[p] <= i));
+            Assert.That(nnz, Is.EqualTo(lowerCount));
+            var factor = Export(flavour, handle, n, nnz);
+            var l = CsrToDense(n, n, factor.RowPointers, factor.ColumnIndices, factor.Values);
+            Assert.That(Enumerable.Range(0, n).All(i => l[Index(i, i, n, n)].Real > 0.0 && l[Index(i, i, n, n)].Imaginary == 0.0), Is.True);
+
+            CheckPreconditioner(flavour, handle, n, a, values, l, Adjoint(n, n, l));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBreakdownAndBadArguments(char flavour)
+        {
+            const int n = 5;
+            var a = DominantCsr(n, 3, flavour, true);
+            IntPtr handle;
+            int nnz;
+
+            // IC(0) needs positive pivots: -A fails on the first row.
+            var negative = Make(flavour, a.Values.Select(v => -v).ToArray());
+            Assert.That(Create(flavour, true, out handle, n, a.RowPointers, a.ColumnIndices, negative, out nnz), Is.EqualTo(1));
+            Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+
+            // No diagonal in row 2.
+            var keep = Enumerable.Range(0, a.ColumnIndices.Length).Where(p => !(a.ColumnIndices[p] == 2 && p >= a.RowPointers[2] && p < a.RowPointers[3])).ToArray();
+            var rowPointers = a.RowPointers.Select(r => r > a.RowPointers[2] ? r - 1 : r).ToArray();
+            var columnIndices = keep.Select(p => a.ColumnIndices[p]).ToArray();
+            var values = Make(flavour, keep.Select(p => a.Values[p]).ToArray());
+            Assert.That(Create(flavour, false, out handle, n, rowPointers, columnIndices, values, out nnz), Is.EqualTo(3));
+            Assert.That(Create(flavour, true, out handle, n, rowPointers, columnIndices, values, out nnz), Is.EqualTo(3));
+
+            Assert.That(Create(flavour, false, out handle, -1, a.RowPointers, a.ColumnIndices, Make(flavour, a.Values), out nnz), Is.EqualTo(-2));
+            Assert.That(Create(flavour, true, out handle, -1, a.RowPointers, a.ColumnIndices, Make(flavour, a.Values), out nnz), Is.EqualTo(-2));
+        }
+
+        /// <summary>
+        /// Checks that L*U equals A on the pattern of the factor, that applying the handle solves L*U*x = b,
+        /// and frees the handle.
+        /// </summary>
+        static void CheckPreconditioner(char flavour, IntPtr handle, int n, (int[] RowPointers, int[] ColumnIndices, Complex[] Values) a, Complex[] values, Complex[] l, Complex[] u)
+        {
+            var dense = CsrToDense(n, n, a.RowPointers, a.ColumnIndices, values);
+            var scale = dense.Max(v => v.Magnitude);
+            for (var i = 0; i < n; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    if (l[Index(i, j, n, n)] != Complex.Zero || u[Index(i, j, n, n)] != Complex.Zero)
+                    {
+                        var sum = Complex.Zero;
+                        for (var k = 0; k <= Math.Min(i, j); k++)
+                        {
+                            sum += l[Index(i, k, n, n)]*u[Index(k, j, n, n)];
+                        }
+
+                        Assert.That((sum - dense[Index(i, j, n, n)]).Magnitude/scale, Is.LessThan(Tolerance(flavour)*10), $"({i}, {j})");
+                    }
+                }
+            }
+
+            var b = Read(Make(flavour, RandomValues(n, 4, flavour)));
+            var x = Make(flavour, new Complex[n]);
+            Assert.That(Apply(flavour, handle, Make(flavour, b), x), Is.EqualTo(0));
+            Assert.That(RelativeError(b, Multiply(n, n, 1, l, Multiply(n, n, 1, u, Read(x)))), Is.LessThan(Tolerance(flavour)*10));
+
+            Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+            Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Strict lower triangle, or upper triangle with the diagonal, of a dense n x n matrix.
+        /// </summary>
+        static Complex[] Part(int n, Complex[] a, bool strictLower)
+        {
+            var part = new Complex[n*n];
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = 0; i < n; i++)
+                {
+                    if (strictLower ? i > j : i <= j)
+                    {
+                        part[Index(i, j, n, n)] = a[Index(i, j, n, n)];
+                    }
+                }
+            }
+
+            return part;
+        }
+
+        static (int[] RowPointers, int[] ColumnIndices, Complex[] Values) Export(char flavour, IntPtr handle, int n, int nnz)
+        {
+            var rowPointers = new int[n + 1];
+            var columnIndices = new int[nnz];
+            var values = Make(flavour, new Complex[nnz]);
+            int info;
+            switch (flavour)
+            {
+                case 's': info = s_sparse_incomplete_export(handle, rowPointers, columnIndices, (float[])values); break;
+                case 'd': info = d_sparse_incomplete_export(handle, rowPointers, columnIndices, (double[])values); break;
+                case 'c': info = c_sparse_incomplete_export(handle, rowPointers, columnIndices, (Complex32[])values); break;
+                default: info = z_sparse_incomplete_export(handle, rowPointers, columnIndices, (Complex[])values); break;
+            }
+
+            Assert.That(info, Is.EqualTo(0));
+            return (rowPointers, columnIndices, Read(values));
+        }
+
+        static int Create(char flavour, bool cholesky, out IntPtr handle, int n, int[] rowPointers, int[] columnIndices, Array values, out int nnz)
+        {
+            switch (flavour)
+            {
+                case 's':
+                    return cholesky
+                        ? s_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (float[])values, out nnz)
+                        : s_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (float[])values, out nnz);
+                case 'd':
+                    return cholesky
+                        ? d_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (double[])values, out nnz)
+                        : d_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (double[])values, out nnz);
+                case 'c':
+                    return cholesky
+                        ? c_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (Complex32[])values, out nnz)
+                        : c_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (Complex32[])values, out nnz);
+                default:
+                    return cholesky
+                        ? z_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (Complex[])values, out nnz)
+                        : z_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (Complex[])values, out nnz);
+            }
+        }
+
+        static int Apply(char flavour, IntPtr handle, Array b, Array x)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_preconditioner_apply(handle, (float[])b, (float[])x);
+                case 'd': return d_sparse_preconditioner_apply(handle, (double[])b, (double[])x);
+                case 'c': return c_sparse_preconditioner_apply(handle, (Complex32[])b, (Complex32[])x);
+                default: return z_sparse_preconditioner_apply(handle, (Complex[])b, (Complex[])x);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_preconditioner_free(ref handle);
+                case 'd': return d_sparse_preconditioner_free(ref handle);
+                case 'c': return c_sparse_preconditioner_free(ref handle);
+                default: return z_sparse_preconditioner_free(ref handle);
+            }
+        }
+    }
+}
+
+#endif
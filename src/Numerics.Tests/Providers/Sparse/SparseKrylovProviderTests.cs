@@ -0,0 +1,216 @@
+﻿// <copyright file="SparseKrylovProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the CSR Krylov solver exports (CG, BiCGStab, GMRES), with and without an incomplete
+    /// factorization preconditioner, by the true residual of the returned solution.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseKrylovProviderTests
+    {
+        const int Converged = 0;
+        const int IterationLimit = 1;
+
+        [TestCase('s', "cg")]
+        [TestCase('d', "cg")]
+        [TestCase('c', "cg")]
+        [TestCase('z', "cg")]
+        [TestCase('s', "bicgstab")]
+        [TestCase('d', "bicgstab")]
+        [TestCase('c', "bicgstab")]
+        [TestCase('z', "bicgstab")]
+        [TestCase('s', "gmres")]
+        [TestCase('d', "gmres")]
+        [TestCase('c', "gmres")]
+        [TestCase('z', "gmres")]
+        public void SolversConverge(char flavour, string method)
+        {
+            SolverConverges(flavour, method, false);
+            SolverConverges(flavour, method, true);
+        }
+
+        static void SolverConverges(char flavour, string method, bool preconditioned)
+        {
+            const int n = 300;
+            var cg = method == "cg";
+            var a = DominantCsr(n, 1, flavour, cg);
+            var values = Make(flavour, a.Values);
+            var b = Read(Make(flavour, RandomValues(n, 2, flavour)));
+            var tolerance = Tolerance(flavour)/10;
+
+            var preconditioner = IntPtr.Zero;
+            if (preconditioned)
+            {
+                Assert.That(Factor(flavour, cg, out preconditioner, n, a.RowPointers, a.ColumnIndices, values), Is.EqualTo(0));
+            }
+
+            var x = Make(flavour, new Complex[n]);
+            const int maxIterations = 200;
+            var residuals = new double[maxIterations + 1];
+            int iterations;
+            double seconds;
+            var info = Solve(flavour, method, n, a.RowPointers, a.ColumnIndices, values, preconditioner, Make(flavour, b), x, maxIterations, 20, tolerance, 0.0, out iterations, residuals, out seconds);
+            if (preconditioned)
+            {
+                Assert.That(Free(flavour, ref preconditioner), Is.EqualTo(0));
+            }
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(iterations, Is.GreaterThan(0));
+            Assert.That(iterations, Is.LessThanOrEqualTo(maxIterations));
+            Assert.That(seconds, Is.GreaterThanOrEqualTo(0.0));
+
+            // The first entry is ||b|| for the zero initial guess, the last is within tolerance.
+            var norm = Math.Sqrt(b.Sum(v => v.Magnitude*v.Magnitude));
+            Assert.That(Math.Abs(residuals[0] - norm)/norm, Is.LessThan(Tolerance(flavour)*10));
+            Assert.That(residuals[iterations], Is.LessThanOrEqualTo(tolerance*norm*1.01));
+
+            var r = Multiply(n, n, 1, CsrToDense(n, n, a.RowPointers, a.ColumnIndices, Read(values)), Read(x)).Zip(b, (p, q) => q - p).ToArray();
+            Assert.That(Math.Sqrt(r.Sum(v => v.Magnitude*v.Magnitude)), Is.LessThanOrEqualTo(tolerance*norm*10));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void StopsAtIterationLimitAndReportsBadArguments(char flavour)
+        {
+            const int n = 200;
+            var a = DominantCsr(n, 3, flavour, true);
+            var values = Make(flavour, a.Values);
+            var b = Make(flavour, RandomValues(n, 4, flavour));
+            var residuals = new double[4];
+            int iterations;
+            double seconds;
+            foreach (var method in new[] { "cg", "bicgstab", "gmres" })
+            {
+                Assert.That(Solve(flavour, method, n, a.RowPointers, a.ColumnIndices, values, IntPtr.Zero, b, Make(flavour, new Complex[n]), 3, 20, 1e-30, 0.0, out iterations, residuals, out seconds), Is.EqualTo(IterationLimit), method);
+                Assert.That(iterations, Is.EqualTo(3), method);
+                Assert.That(residuals[3], Is.LessThan(residuals[0]), method);
+
+                Assert.That(Solve(flavour, method, -1, a.RowPointers, a.ColumnIndices, values, IntPtr.Zero, b, Make(flavour, new Complex[n]), 3, 20, 1e-6, 0.0, out iterations, residuals, out seconds), Is.EqualTo(-1), method);
+                Assert.That(Solve(flavour, method, n, a.RowPointers, a.ColumnIndices, values, IntPtr.Zero, b, Make(flavour, new Complex[n]), -1, 20, 1e-6, 0.0, out iterations, residuals, out seconds), Is.EqualTo(-8), method);
+            }
+
+            Assert.That(Solve(flavour, "gmres", n, a.RowPointers, a.ColumnIndices, values, IntPtr.Zero, b, Make(flavour, new Complex[n]), 3, 0, 1e-6, 0.0, out iterations, residuals, out seconds), Is.EqualTo(-9));
+        }
+
+        static int Factor(char flavour, bool cholesky, out IntPtr handle, int n, int[] rowPointers, int[] columnIndices, Array values)
+        {
+            int nnz;
+            switch (flavour)
+            {
+                case 's': return cholesky ? s_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (float[])values, out nnz) : s_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (float[])values, out nnz);
+                case 'd': return cholesky ? d_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (double[])values, out nnz) : d_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (double[])values, out nnz);
+                case 'c': return cholesky ? c_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (Complex32[])values, out nnz) : c_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (Complex32[])values, out nnz);
+                default: return cholesky ? z_sparse_ic0_create(out handle, n, rowPointers, columnIndices, (Complex[])values, out nnz) : z_sparse_ilu0_create(out handle, n, rowPointers, columnIndices, (Complex[])values, out nnz);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_preconditioner_free(ref handle);
+                case 'd': return d_sparse_preconditioner_free(ref handle);
+                case 'c': return c_sparse_preconditioner_free(ref handle);
+                default: return z_sparse_preconditioner_free(ref handle);
+            }
+        }
+
+        /// <summary>
+        /// Runs the named solver; residuals are widened to double for the single precision flavours.
+        /// </summary>
+        static int Solve(char flavour, string method, int n, int[] rowPointers, int[] columnIndices, Array values, IntPtr preconditioner, Array b, Array x,
+            int maxIterations, int restart, double tolerance, double absoluteTolerance, out int iterations, double[] residuals, out double seconds)
+        {
+            int info;
+            if (flavour == 's' || flavour == 'c')
+            {
+                var single = new float[residuals.Length];
+                var t = (float)tolerance;
+                var at = (float)absoluteTolerance;
+                if (flavour == 's')
+                {
+                    var v = (float[])values;
+                    var bb = (float[])b;
+                    var xx = (float[])x;
+                    info = method == "cg" ? s_sparse_cg(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, t, at, out iterations, single, out seconds)
+                        : method == "bicgstab" ? s_sparse_bicgstab(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, t, at, out iterations, single, out seconds)
+                        : s_sparse_gmres(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, restart, t, at, out iterations, single, out seconds);
+                }
+                else
+                {
+                    var v = (Complex32[])values;
+                    var bb = (Complex32[])b;
+                    var xx = (Complex32[])x;
+                    info = method == "cg" ? c_sparse_cg(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, t, at, out iterations, single, out seconds)
+                        : method == "bicgstab" ? c_sparse_bicgstab(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, t, at, out iterations, single, out seconds)
+                        : c_sparse_gmres(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, restart, t, at, out iterations, single, out seconds);
+                }
+
+                Array.Copy(single.Select(r => (double)r).ToArray(), residuals, residuals.Length);
+                return info;
+            }
+
+            if (flavour == 'd')
+            {
+                var v = (double[])values;
+                var bb = (double[])b;
+                var xx = (double[])x;
+                return method == "cg" ? d_sparse_cg(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, tolerance, absoluteTolerance, out iterations, residuals, out seconds)
+                    : method == "bicgstab" ? d_sparse_bicgstab(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, tolerance, absoluteTolerance, out iterations, residuals, out seconds)
+                    : d_sparse_gmres(n, rowPointers, columnIndices, v, preconditioner, bb, xx, maxIterations, restart, tolerance, absoluteTolerance, out iterations, residuals, out seconds);
+            }
+
+            var zv = (Complex[])values;
+            var zb = (Complex[])b;
+            var zx = (Complex[])x;
+            return method == "cg" ? z_sparse_cg(n, rowPointers, columnIndices, zv, preconditioner, zb, zx, maxIterations, tolerance, absoluteTolerance, out iterations, residuals, out seconds)
+                : method == "bicgstab" ? z_sparse_bicgstab(n, rowPointers, columnIndices, zv, preconditioner, zb, zx, maxIterations, tolerance, absoluteTolerance, out iterations, residuals, out seconds)
+                : z_sparse_gmres(n, rowPointers, columnIndices, zv, preconditioner, zb, zx, maxIterations, restart, tolerance, absoluteTolerance, out iterations, residuals, out seconds);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,313 @@
+﻿// <copyright file="SparseOrderingProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using AHSEsim.Numerics.Providers.SparseSolver;
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the fill-reducing and bandwidth-reducing ordering exports on a shuffled grid Laplacian,
+    /// and for the symmetric permutation export against the dense A(perm, perm).
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseOrderingProviderTests
+    {
+        const int Grid = 30;
+
+        [Test]
+        public void RcmReducesBandwidth()
+        {
+            var a = ShuffledGrid(Grid, 1);
+            var perm = Reorder("rcm", a.RowPointers, a.ColumnIndices);
+            var b = Permute(a, perm);
+
+            // The natural grid ordering has bandwidth Grid; a random one close to n.
+            Assert.That(Bandwidth(a.RowPointers, a.ColumnIndices), Is.GreaterThan(Grid*Grid/2));
+            Assert.That(Bandwidth(b.RowPointers, b.ColumnIndices), Is.LessThanOrEqualTo(2*Grid));
+        }
+
+        [TestCase("amd")]
+        [TestCase("nd")]
+        public void FillReducingOrderingBeatsNaturalOrder(string method)
+        {
+            var natural = ShuffledGrid(Grid, -1);
+            var a = ShuffledGrid(Grid, 2);
+            var perm = Reorder(method, a.RowPointers, a.ColumnIndices);
+            var b = Permute(a, perm);
+
+            var naturalFill = CholeskyCount(natural.RowPointers, natural.ColumnIndices);
+            Assert.That(CholeskyCount(b.RowPointers, b.ColumnIndices), Is.LessThan(0.75*naturalFill));
+            Assert.That(CholeskyCount(a.RowPointers, a.ColumnIndices), Is.GreaterThan(naturalFill));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void PermuteMatchesDense(char flavour)
+        {
+            const int n = 60;
+            var a = RandomCsr(n, n, 4, 3, flavour);
+            var values = Read(Make(flavour, a.Values));
+            var random = new System.Random(4);
+            var perm = Enumerable.Range(0, n).OrderBy(_ => random.Next()).ToArray();
+
+            var nnz = a.RowPointers[n];
+            var rowPointers = new int[n + 1];
+            var columnIndices = new int[nnz];
+            var permuted = Make(flavour, new Complex[nnz]);
+            Assert.That(SparsePermute(flavour, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), perm, rowPointers, columnIndices, permuted), Is.EqualTo(0));
+
+            var dense = CsrToDense(n, n, a.RowPointers, a.ColumnIndices, values);
+            var expected = new Complex[n*n];
+            for (var i = 0; i < n; i++)
+            {
+                for (var j = 0; j < n; j++)
+                {
+                    expected[Index(i, j, n, n)] = dense[Index(perm[i], perm[j], n, n)];
+                }
+            }
+
+            Assert.That(RelativeError(expected, CsrToDense(n, n, rowPointers, columnIndices, Read(permuted))), Is.EqualTo(0.0));
+            Assert.That(Enumerable.Range(0, n).All(i => Enumerable.Range(rowPointers[i] + 1, Math.Max(0, rowPointers[i + 1] - rowPointers[i] - 1)).All(p => columnIndices[p - 1] < columnIndices[p])), Is.True);
+
+            // Not a permutation.
+            var repeated = perm.ToArray();
+            repeated[1] = repeated[0];
+            Assert.That(SparsePermute(flavour, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), repeated, rowPointers, columnIndices, permuted), Is.EqualTo(-5));
+            Assert.That(SparsePermute(flavour, -1, a.RowPointers, a.ColumnIndices, Make(flavour, values), perm, rowPointers, columnIndices, permuted), Is.EqualTo(-1));
+        }
+
+#if MKL
+        /// <summary>
+        /// DSS returns its own ordering when asked and solves with a supplied one: its own, or the
+        /// inverse of an AMD permutation.
+        /// </summary>
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void DssSolvesWithSuppliedOrdering(char flavour)
+        {
+            const int n = 200;
+            var a = DominantCsr(n, 1, flavour, false);
+            var values = Read(Make(flavour, a.Values));
+            var b = Read(Make(flavour, RandomValues(n, 2, flavour)));
+            var dense = CsrToDense(n, n, a.RowPointers, a.ColumnIndices, values);
+            var norm = Math.Sqrt(b.Sum(v => v.Magnitude*v.Magnitude));
+
+            var automatic = new int[n];
+            var amd = new int[n];
+            Assert.That(sparse_reorder_amd(n, a.RowPointers, a.ColumnIndices, new int[n], amd), Is.EqualTo(0));
+            foreach (var (userOrder, permutation) in new[] { (0, automatic), (1, automatic), (1, amd) })
+            {
+                var x = Make(flavour, new Complex[n]);
+                Assert.That(DssSolveOrdered(flavour, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), Make(flavour, b), x, userOrder, permutation), Is.EqualTo(0));
+                Assert.That(permutation.OrderBy(k => k).ToArray(), Is.EqualTo(Enumerable.Range(0, n).ToArray()));
+
+                var r = Multiply(n, n, 1, dense, Read(x)).Zip(b, (p, q) => q - p).ToArray();
+                Assert.That(Math.Sqrt(r.Sum(v => v.Magnitude*v.Magnitude)), Is.LessThan(Tolerance(flavour)*norm));
+            }
+        }
+
+#endif
+        [TestCase("rcm")]
+        [TestCase("amd")]
+        [TestCase("nd")]
+        public void ReportsBadArguments(string method)
+        {
+            var a = ShuffledGrid(4, 5);
+            var perm = new int[16];
+            Assert.That(Reorder(method, -1, a.RowPointers, a.ColumnIndices, perm, null), Is.EqualTo(-1));
+
+            var columnIndices = a.ColumnIndices.ToArray();
+            columnIndices[3] = 16;
+            Assert.That(Reorder(method, 16, a.RowPointers, columnIndices, perm, null), Is.EqualTo(-3));
+        }
+
+        /// <summary>
+        /// Runs the ordering and checks that perm is a permutation with inverse[perm[k]] = k.
+        /// </summary>
+        static int[] Reorder(string method, int[] rowPointers, int[] columnIndices)
+        {
+            var n = rowPointers.Length - 1;
+            var perm = new int[n];
+            var inverse = new int[n];
+            Assert.That(Reorder(method, n, rowPointers, columnIndices, perm, inverse), Is.EqualTo(0));
+            Assert.That(perm.OrderBy(k => k).ToArray(), Is.EqualTo(Enumerable.Range(0, n).ToArray()));
+            Assert.That(Enumerable.Range(0, n).All(k => inverse[perm[k]] == k), Is.True);
+
+            // The inverse is optional.
+            var again = new int[n];
+            Assert.That(Reorder(method, n, rowPointers, columnIndices, again, null), Is.EqualTo(0));
+            Assert.That(again, Is.EqualTo(perm));
+            return perm;
+        }
+
+        static int Reorder(string method, int n, int[] rowPointers, int[] columnIndices, int[] perm, int[] inverse)
+        {
+            switch (method)
+            {
+                case "rcm": return sparse_reorder_rcm(n, rowPointers, columnIndices, perm, inverse);
+                case "amd": return sparse_reorder_amd(n, rowPointers, columnIndices, perm, inverse);
+                default: return sparse_reorder_nested_dissection(n, rowPointers, columnIndices, perm, inverse);
+            }
+        }
+
+#if MKL
+        static int DssSolveOrdered(char flavour, int n, int[] rowPointers, int[] columnIndices, Array values, Array b, Array x, int userOrder, int[] permutation)
+        {
+            var structure = (int)(IsComplex(flavour) ? DssMatrixStructure.NonsymmetricComplex : DssMatrixStructure.Nonsymmetric);
+            var type = (int)DssMatrixType.Indefinite;
+            var system = (int)DssSystemType.DontTranspose;
+            var nnz = rowPointers[n];
+            switch (flavour)
+            {
+                case 's': return s_dss_solve_ordered(structure, type, system, n, n, nnz, rowPointers, columnIndices, (float[])values, 1, (float[])b, (float[])x, userOrder, permutation);
+                case 'd': return d_dss_solve_ordered(structure, type, system, n, n, nnz, rowPointers, columnIndices, (double[])values, 1, (double[])b, (double[])x, userOrder, permutation);
+                case 'c': return c_dss_solve_ordered(structure, type, system, n, n, nnz, rowPointers, columnIndices, (Complex32[])values, 1, (Complex32[])b, (Complex32[])x, userOrder, permutation);
+                default: return z_dss_solve_ordered(structure, type, system, n, n, nnz, rowPointers, columnIndices, (Complex[])values, 1, (Complex[])b, (Complex[])x, userOrder, permutation);
+            }
+        }
+
+#endif
+        static (int[] RowPointers, int[] ColumnIndices) Permute((int[] RowPointers, int[] ColumnIndices) a, int[] perm)
+        {
+            var n = perm.Length;
+            var rowPointers = new int[n + 1];
+            var columnIndices = new int[a.RowPointers[n]];
+            var values = new double[a.RowPointers[n]];
+            Assert.That(d_sparse_permute(n, a.RowPointers, a.ColumnIndices, new double[a.RowPointers[n]], perm, rowPointers, columnIndices, values), Is.EqualTo(0));
+            return (rowPointers, columnIndices);
+        }
+
+        static int SparsePermute(char flavour, int n, int[] rowPointers, int[] columnIndices, Array values, int[] perm, int[] permutedRowPointers, int[] permutedColumnIndices, Array permutedValues)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_permute(n, rowPointers, columnIndices, (float[])values, perm, permutedRowPointers, permutedColumnIndices, (float[])permutedValues);
+                case 'd': return d_sparse_permute(n, rowPointers, columnIndices, (double[])values, perm, permutedRowPointers, permutedColumnIndices, (double[])permutedValues);
+                case 'c': return c_sparse_permute(n, rowPointers, columnIndices, (Complex32[])values, perm, permutedRowPointers, permutedColumnIndices, (Complex32[])permutedValues);
+                default: return z_sparse_permute(n, rowPointers, columnIndices, (Complex[])values, perm, permutedRowPointers, permutedColumnIndices, (Complex[])permutedValues);
+            }
+        }
+
+        /// <summary>
+        /// Five-point Laplacian pattern on a grid x grid mesh, with the nodes numbered in a random order
+        /// (or row by row for a negative seed).
+        /// </summary>
+        static (int[] RowPointers, int[] ColumnIndices) ShuffledGrid(int grid, int seed)
+        {
+            var n = grid*grid;
+            var random = new System.Random(Math.Max(seed, 0));
+            var label = seed < 0 ? Enumerable.Range(0, n).ToArray() : Enumerable.Range(0, n).OrderBy(_ => random.Next()).ToArray();
+            var rows = new List<int>[n];
+            for (var i = 0; i < grid; i++)
+            {
+                for (var j = 0; j < grid; j++)
+                {
+                    var node = i*grid + j;
+                    var row = rows[label[node]] = new List<int> { label[node] };
+                    if (i > 0) row.Add(label[node - grid]);
+                    if (j > 0) row.Add(label[node - 1]);
+                    if (j < grid - 1) row.Add(label[node + 1]);
+                    if (i < grid - 1) row.Add(label[node + grid]);
+                    row.Sort();
+                }
+            }
+
+            var rowPointers = new int[n + 1];
+            for (var i = 0; i < n; i++)
+            {
+                rowPointers[i + 1] = rowPointers[i] + rows[i].Count;
+            }
+
+            return (rowPointers, rows.SelectMany(r => r).ToArray());
+        }
+
+        static int Bandwidth(int[] rowPointers, int[] columnIndices)
+        {
+            var bandwidth = 0;
+            for (var i = 0; i < rowPointers.Length - 1; i++)
+            {
+                for (var p = rowPointers[i]; p < rowPointers[i + 1]; p++)
+                {
+                    bandwidth = Math.Max(bandwidth, Math.Abs(columnIndices[p] - i));
+                }
+            }
+
+            return bandwidth;
+        }
+
+        /// <summary>
+        /// Number of nonzeros of the Cholesky factor of a symmetric pattern, from the row subtrees of the
+        /// elimination tree.
+        /// </summary>
+        static long CholeskyCount(int[] rowPointers, int[] columnIndices)
+        {
+            var n = rowPointers.Length - 1;
+            var parent = Enumerable.Repeat(-1, n).ToArray();
+            var mark = Enumerable.Repeat(-1, n).ToArray();
+            long count = n;
+            for (var i = 0; i < n; i++)
+            {
+                mark[i] = i;
+                for (var p = rowPointers[i]; p < rowPointers[i + 1]; p++)
+                {
+                    // Row i of L: every node on the path from column j < i up to the root of its subtree.
+                    for (var j = columnIndices[p]; j < i && mark[j] != i; j = parent[j])
+                    {
+                        mark[j] = i;
+                        count++;
+                        if (parent[j] == -1)
+                        {
+                            parent[j] = i;
+                        }
+                    }
+                }
+            }
+
+            return count;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,194 @@
+﻿// <copyright file="SparseProductProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the two-phase sparse-sparse product and the CSR transpose exports against dense products.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseProductProviderTests
+    {
+        [TestCase('s', 30, 20, 25)]
+        [TestCase('d', 30, 20, 25)]
+        [TestCase('c', 30, 20, 25)]
+        [TestCase('z', 30, 20, 25)]
+        [TestCase('d', 400, 300, 350)]
+        [TestCase('z', 400, 300, 350)]
+        public void ProductMatchesDense(char flavour, int m, int k, int n)
+        {
+            var a = RandomCsr(m, k, 4, 1, flavour);
+            var b = RandomCsr(k, n, 3, 3, flavour);
+
+            IntPtr handle;
+            int nnz;
+            Assert.That(Symbolic(flavour, out handle, m, k, n, a.RowPointers, a.ColumnIndices, b.RowPointers, b.ColumnIndices, out nnz), Is.EqualTo(0));
+            Assert.That(handle, Is.Not.EqualTo(IntPtr.Zero));
+
+            // The numeric phase runs again with new values on the same patterns.
+            foreach (var seed in new[] { 5, 6 })
+            {
+                var aValues = RandomValues(a.Values.Length, seed, flavour);
+                var bValues = RandomValues(b.Values.Length, seed + 10, flavour);
+                var rowPointers = new int[m + 1];
+                var columnIndices = new int[nnz];
+                var values = Make(flavour, new Complex[nnz]);
+                Assert.That(Numeric(flavour, handle, Make(flavour, aValues), Make(flavour, bValues), rowPointers, columnIndices, values), Is.EqualTo(0));
+
+                Assert.That(rowPointers[m], Is.EqualTo(nnz));
+                Assert.That(Enumerable.Range(0, m).All(i => Sorted(columnIndices, rowPointers[i], rowPointers[i + 1])), Is.True);
+                var expected = Multiply(m, k, n, CsrToDense(m, k, a.RowPointers, a.ColumnIndices, Read(Make(flavour, aValues))), CsrToDense(k, n, b.RowPointers, b.ColumnIndices, Read(Make(flavour, bValues))));
+                Assert.That(RelativeError(expected, CsrToDense(m, n, rowPointers, columnIndices, Read(values))), Is.LessThan(Tolerance(flavour)*k));
+            }
+
+            Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+            Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void TransposeMatchesDense(char flavour)
+        {
+            const int m = 35, n = 22;
+            var a = RandomCsr(m, n, 5, 7, flavour);
+            var values = Read(Make(flavour, a.Values));
+            var nnz = a.RowPointers[m];
+            var rowPointers = new int[n + 1];
+            var columnIndices = new int[nnz];
+            var t = Make(flavour, new Complex[nnz]);
+            Assert.That(Transpose(flavour, m, n, a.RowPointers, a.ColumnIndices, Make(flavour, values), rowPointers, columnIndices, t), Is.EqualTo(0));
+
+            // Plain transpose, no conjugation, with ascending column indices.
+            var dense = CsrToDense(m, n, a.RowPointers, a.ColumnIndices, values);
+            var expected = Adjoint(m, n, dense).Select(Complex.Conjugate).ToArray();
+            Assert.That(RelativeError(expected, CsrToDense(n, m, rowPointers, columnIndices, Read(t))), Is.EqualTo(0.0));
+            Assert.That(Enumerable.Range(0, n).All(j => Sorted(columnIndices, rowPointers[j], rowPointers[j + 1])), Is.True);
+
+            // Transposing back gives the original CSR arrays.
+            var backRowPointers = new int[m + 1];
+            var backColumnIndices = new int[nnz];
+            var back = Make(flavour, new Complex[nnz]);
+            Assert.That(Transpose(flavour, n, m, rowPointers, columnIndices, t, backRowPointers, backColumnIndices, back), Is.EqualTo(0));
+            Assert.That(backRowPointers, Is.EqualTo(a.RowPointers));
+            Assert.That(backColumnIndices, Is.EqualTo(a.ColumnIndices));
+            Assert.That(RelativeError(values, Read(back)), Is.EqualTo(0.0));
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBadArguments(char flavour)
+        {
+            var a = RandomCsr(4, 4, 1, 9, flavour);
+            IntPtr handle;
+            int nnz;
+            Assert.That(Symbolic(flavour, out handle, -1, 4, 4, a.RowPointers, a.ColumnIndices, a.RowPointers, a.ColumnIndices, out nnz), Is.EqualTo(-2));
+            Assert.That(Symbolic(flavour, out handle, 4, -1, 4, a.RowPointers, a.ColumnIndices, a.RowPointers, a.ColumnIndices, out nnz), Is.EqualTo(-3));
+            Assert.That(Symbolic(flavour, out handle, 4, 4, -1, a.RowPointers, a.ColumnIndices, a.RowPointers, a.ColumnIndices, out nnz), Is.EqualTo(-4));
+
+            var values = Make(flavour, a.Values);
+            Assert.That(Transpose(flavour, -1, 4, a.RowPointers, a.ColumnIndices, values, new int[5], new int[1], Make(flavour, new Complex[1])), Is.EqualTo(-1));
+            Assert.That(Transpose(flavour, 4, -1, a.RowPointers, a.ColumnIndices, values, new int[5], new int[1], Make(flavour, new Complex[1])), Is.EqualTo(-2));
+        }
+
+        static bool Sorted(int[] indices, int begin, int end)
+        {
+            for (var p = begin + 1; p < end; p++)
+            {
+                if (indices[p - 1] >= indices[p])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        static int Symbolic(char flavour, out IntPtr handle, int m, int k, int n, int[] aRowPointers, int[] aColumnIndices, int[] bRowPointers, int[] bColumnIndices, out int nnz)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_product_symbolic(out handle, m, k, n, aRowPointers, aColumnIndices, bRowPointers, bColumnIndices, out nnz);
+                case 'd': return d_sparse_product_symbolic(out handle, m, k, n, aRowPointers, aColumnIndices, bRowPointers, bColumnIndices, out nnz);
+                case 'c': return c_sparse_product_symbolic(out handle, m, k, n, aRowPointers, aColumnIndices, bRowPointers, bColumnIndices, out nnz);
+                default: return z_sparse_product_symbolic(out handle, m, k, n, aRowPointers, aColumnIndices, bRowPointers, bColumnIndices, out nnz);
+            }
+        }
+
+        static int Numeric(char flavour, IntPtr handle, Array aValues, Array bValues, int[] rowPointers, int[] columnIndices, Array values)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_product_numeric(handle, (float[])aValues, (float[])bValues, rowPointers, columnIndices, (float[])values);
+                case 'd': return d_sparse_product_numeric(handle, (double[])aValues, (double[])bValues, rowPointers, columnIndices, (double[])values);
+                case 'c': return c_sparse_product_numeric(handle, (Complex32[])aValues, (Complex32[])bValues, rowPointers, columnIndices, (Complex32[])values);
+                default: return z_sparse_product_numeric(handle, (Complex[])aValues, (Complex[])bValues, rowPointers, columnIndices, (Complex[])values);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_product_free(ref handle);
+                case 'd': return d_sparse_product_free(ref handle);
+                case 'c': return c_sparse_product_free(ref handle);
+                default: return z_sparse_product_free(ref handle);
+            }
+        }
+
+        static int Transpose(char flavour, int m, int n, int[] rowPointers, int[] columnIndices, Array values, int[] tRowPointers, int[] tColumnIndices, Array tValues)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_transpose(m, n, rowPointers, columnIndices, (float[])values, tRowPointers, tColumnIndices, (float[])tValues);
+                case 'd': return d_sparse_transpose(m, n, rowPointers, columnIndices, (double[])values, tRowPointers, tColumnIndices, (double[])tValues);
+                case 'c': return c_sparse_transpose(m, n, rowPointers, columnIndices, (Complex32[])values, tRowPointers, tColumnIndices, (Complex32[])tValues);
+                default: return z_sparse_transpose(m, n, rowPointers, columnIndices, (Complex[])values, tRowPointers, tColumnIndices, (Complex[])tValues);
+            }
+        }
+    }
+}
+
+#endif
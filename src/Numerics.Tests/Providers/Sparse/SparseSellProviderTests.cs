@@ -0,0 +1,159 @@
+﻿// <copyright file="SparseSellProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the SELL-C-sigma exports: the product for several chunk sizes and sorting windows, on
+    /// whichever kernel the CPU selects, against the dense product.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseSellProviderTests
+    {
+        static readonly int[][] Shapes =
+        {
+            new[] { 0, 0 },
+            new[] { 1, 1 },
+            new[] { 4, 1 },
+            new[] { 8, 0 },
+            new[] { 8, 7 },
+            new[] { 16, 64 },
+            new[] { 5, 3 },
+            new[] { 64, 0 },
+        };
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ProductMatchesDense(char flavour)
+        {
+            Assert.That(sparse_sell_instruction_set(), Is.GreaterThanOrEqualTo(0));
+            Assert.That(sparse_sell_instruction_set(), Is.LessThanOrEqualTo(2));
+
+            // Row lengths from 0 to about 30, so chunks need padding.
+            const int m = 203, n = 150;
+            var random = new System.Random(1);
+            var rowPointers = new int[m + 1];
+            var columnIndices = Enumerable.Range(0, m).SelectMany(i =>
+            {
+                var row = Enumerable.Range(0, i%7 == 3 ? 0 : random.Next(30)).Select(_ => random.Next(n)).Distinct().OrderBy(j => j).ToArray();
+                rowPointers[i + 1] = rowPointers[i] + row.Length;
+                return row;
+            }).ToArray();
+            var nnz = rowPointers[m];
+            var values = Read(Make(flavour, RandomValues(nnz, 2, flavour)));
+            var x = Read(Make(flavour, RandomValues(n, 3, flavour)));
+            var expected = Multiply(m, n, 1, CsrToDense(m, n, rowPointers, columnIndices, values), x);
+
+            foreach (var shape in Shapes)
+            {
+                IntPtr handle;
+                int padded;
+                Assert.That(Create(flavour, out handle, m, n, rowPointers, columnIndices, Make(flavour, values), shape[0], shape[1], out padded), Is.EqualTo(0));
+                Assert.That(padded, Is.GreaterThanOrEqualTo(nnz));
+                if (shape[0] == 1)
+                {
+                    Assert.That(padded, Is.EqualTo(nnz));
+                }
+
+                var y = Make(flavour, new Complex[m]);
+                Assert.That(Mv(flavour, handle, Make(flavour, x), y), Is.EqualTo(0));
+                Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+                Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+                Assert.That(RelativeError(expected, Read(y)), Is.LessThan(Tolerance(flavour)*10), $"chunk {shape[0]}, sigma {shape[1]}");
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsBadArguments(char flavour)
+        {
+            const int n = 5;
+            var a = RandomCsr(n, n, 1, 4, flavour);
+            var values = Make(flavour, a.Values);
+            IntPtr handle;
+            int padded;
+            Assert.That(Create(flavour, out handle, -1, n, a.RowPointers, a.ColumnIndices, values, 0, 0, out padded), Is.EqualTo(-2));
+            Assert.That(Create(flavour, out handle, n, -1, a.RowPointers, a.ColumnIndices, values, 0, 0, out padded), Is.EqualTo(-3));
+            Assert.That(Create(flavour, out handle, n, n, a.RowPointers, a.ColumnIndices, values, 65, 0, out padded), Is.EqualTo(-7));
+            Assert.That(Create(flavour, out handle, n, n, a.RowPointers, a.ColumnIndices, values, 0, -1, out padded), Is.EqualTo(-8));
+            Assert.That(Mv(flavour, IntPtr.Zero, Make(flavour, new Complex[n]), Make(flavour, new Complex[n])), Is.EqualTo(-1));
+        }
+
+        static int Create(char flavour, out IntPtr handle, int m, int n, int[] rowPointers, int[] columnIndices, Array values, int chunk, int sigma, out int padded)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_sell_create(out handle, m, n, rowPointers, columnIndices, (float[])values, chunk, sigma, out padded);
+                case 'd': return d_sparse_sell_create(out handle, m, n, rowPointers, columnIndices, (double[])values, chunk, sigma, out padded);
+                case 'c': return c_sparse_sell_create(out handle, m, n, rowPointers, columnIndices, (Complex32[])values, chunk, sigma, out padded);
+                default: return z_sparse_sell_create(out handle, m, n, rowPointers, columnIndices, (Complex[])values, chunk, sigma, out padded);
+            }
+        }
+
+        static int Mv(char flavour, IntPtr handle, Array x, Array y)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_sell_mv(handle, (float[])x, (float[])y);
+                case 'd': return d_sparse_sell_mv(handle, (double[])x, (double[])y);
+                case 'c': return c_sparse_sell_mv(handle, (Complex32[])x, (Complex32[])y);
+                default: return z_sparse_sell_mv(handle, (Complex[])x, (Complex[])y);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_sell_free(ref handle);
+                case 'd': return d_sparse_sell_free(ref handle);
+                case 'c': return c_sparse_sell_free(ref handle);
+                default: return z_sparse_sell_free(ref handle);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,175 @@
+﻿// <copyright file="SparseTriangularProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.Sparse
+{
+    /// <summary>
+    /// Tests for the sparse triangular solve exports: the residual against the dense triangle of the CSR matrix.
+    /// </summary>
+    [TestFixture, Category("SparseProvider")]
+    public class SparseTriangularProviderTests
+    {
+        [TestCase('s', 50)]
+        [TestCase('d', 50)]
+        [TestCase('c', 50)]
+        [TestCase('z', 50)]
+        [TestCase('d', 2000)]
+        [TestCase('z', 2000)]
+        public void SolveMatchesDenseTriangle(char flavour, int n)
+        {
+            var a = RandomCsr(n, n, 4, 1, flavour);
+            var values = a.Values.ToArray();
+            for (var i = 0; i < n; i++)
+            {
+                for (var p = a.RowPointers[i]; p < a.RowPointers[i + 1]; p++)
+                {
+                    if (a.ColumnIndices[p] == i)
+                    {
+                        values[p] += 4.0;
+                    }
+                }
+            }
+
+            values = Read(Make(flavour, values));
+            var b = Read(Make(flavour, RandomValues(n, 2, flavour)));
+            foreach (var uplo in "LU")
+            {
+                foreach (var diag in "NU")
+                {
+                    IntPtr handle;
+                    Assert.That(Create(flavour, out handle, uplo, diag, n, a.RowPointers, a.ColumnIndices, Make(flavour, values)), Is.EqualTo(0));
+
+                    // Twice on one handle, the second time with b and x the same array.
+                    var x = Make(flavour, new Complex[n]);
+                    Assert.That(Solve(flavour, handle, Make(flavour, b), x), Is.EqualTo(0));
+                    var inPlace = Make(flavour, b);
+                    Assert.That(Solve(flavour, handle, inPlace, inPlace), Is.EqualTo(0));
+                    Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+                    Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+
+                    var residual = Multiply(n, n, 1, Triangle(n, a.RowPointers, a.ColumnIndices, values, uplo, diag), Read(x));
+                    Assert.That(RelativeError(b, residual), Is.LessThan(Tolerance(flavour)*10), $"uplo {uplo}, diag {diag}");
+                    Assert.That(RelativeError(Read(x), Read(inPlace)), Is.EqualTo(0.0));
+                }
+            }
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsZeroDiagonalAndBadArguments(char flavour)
+        {
+            // Row 3 has no diagonal entry: fine with a unit diagonal, info 4 otherwise.
+            const int n = 6;
+            var a = RandomCsr(n, n, 0, 3, flavour);
+            var keep = Enumerable.Range(0, a.ColumnIndices.Length).Where(p => !(a.ColumnIndices[p] == 3 && p >= a.RowPointers[3] && p < a.RowPointers[4])).ToArray();
+            var rowPointers = a.RowPointers.Select(r => r > a.RowPointers[3] ? r - 1 : r).ToArray();
+            var columnIndices = keep.Select(p => a.ColumnIndices[p]).ToArray();
+            var values = Make(flavour, keep.Select(p => a.Values[p]).ToArray());
+
+            IntPtr handle;
+            Assert.That(Create(flavour, out handle, 'L', 'N', n, rowPointers, columnIndices, values), Is.EqualTo(4));
+            Assert.That(handle, Is.EqualTo(IntPtr.Zero));
+            Assert.That(Create(flavour, out handle, 'L', 'U', n, rowPointers, columnIndices, values), Is.EqualTo(0));
+            Assert.That(Free(flavour, ref handle), Is.EqualTo(0));
+
+            Assert.That(Create(flavour, out handle, 'X', 'N', n, rowPointers, columnIndices, values), Is.EqualTo(-2));
+            Assert.That(Create(flavour, out handle, 'L', 'X', n, rowPointers, columnIndices, values), Is.EqualTo(-3));
+            Assert.That(Create(flavour, out handle, 'L', 'N', -1, rowPointers, columnIndices, values), Is.EqualTo(-4));
+        }
+
+        /// <summary>
+        /// Dense lower or upper triangle of a CSR matrix, with ones on the diagonal for a unit diagonal.
+        /// </summary>
+        static Complex[] Triangle(int n, int[] rowPointers, int[] columnIndices, Complex[] values, char uplo, char diag)
+        {
+            var dense = CsrToDense(n, n, rowPointers, columnIndices, values);
+            for (var j = 0; j < n; j++)
+            {
+                for (var i = 0; i < n; i++)
+                {
+                    if (i == j ? diag == 'U' : (uplo == 'L') == (j > i))
+                    {
+                        dense[Index(i, j, n, n)] = i == j ? Complex.One : Complex.Zero;
+                    }
+                }
+            }
+
+            return dense;
+        }
+
+        static int Create(char flavour, out IntPtr handle, char uplo, char diag, int n, int[] rowPointers, int[] columnIndices, Array values)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_triangular_create(out handle, (byte)uplo, (byte)diag, n, rowPointers, columnIndices, (float[])values);
+                case 'd': return d_sparse_triangular_create(out handle, (byte)uplo, (byte)diag, n, rowPointers, columnIndices, (double[])values);
+                case 'c': return c_sparse_triangular_create(out handle, (byte)uplo, (byte)diag, n, rowPointers, columnIndices, (Complex32[])values);
+                default: return z_sparse_triangular_create(out handle, (byte)uplo, (byte)diag, n, rowPointers, columnIndices, (Complex[])values);
+            }
+        }
+
+        static int Solve(char flavour, IntPtr handle, Array b, Array x)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_triangular_solve(handle, (float[])b, (float[])x);
+                case 'd': return d_sparse_triangular_solve(handle, (double[])b, (double[])x);
+                case 'c': return c_sparse_triangular_solve(handle, (Complex32[])b, (Complex32[])x);
+                default: return z_sparse_triangular_solve(handle, (Complex[])b, (Complex[])x);
+            }
+        }
+
+        static int Free(char flavour, ref IntPtr handle)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_triangular_free(ref handle);
+                case 'd': return d_sparse_triangular_free(ref handle);
+                case 'c': return c_sparse_triangular_free(ref handle);
+                default: return z_sparse_triangular_free(ref handle);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,414 @@
+﻿// <copyright file="SparseEigenProviderTests.cs" company="AHSEsim">
+// AHSEsim Numerics, part of the AHSEsim Project
+// https://numerics.mathdotnet.com
+//
+// Copyright (c) 2024-2026 AHSEsim
+//
+// Permission is hereby granted, free of charge, to any person
+// obtaining a copy of this software and associated documentation
+// files (the "Software"), to deal in the Software without
+// restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following
+// conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+// OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// </copyright>
+
+#if MKL || OPENBLAS
+
+using System;
+using System.Linq;
+using NUnit.Framework;
+using Complex = System.Numerics.Complex;
+using static AHSEsim.Numerics.Tests.Providers.NativeArrays;
+#if MKL
+using static AHSEsim.Numerics.Providers.MKL.SafeNativeMethods;
+#else
+using static AHSEsim.Numerics.Providers.OpenBLAS.SafeNativeMethods;
+#endif
+
+namespace AHSEsim.Numerics.Tests.Providers.SparseEigen
+{
+    /// <summary>
+    /// Regression tests for the native sparse eigensolver on the 5-point Laplacian of a 40 x 40 grid,
+    /// whose eigenvalues 4 - 2cos(i*pi/41) - 2cos(j*pi/41) are known in closed form.
+    /// </summary>
+    [TestFixture, Category("SparseEigenProvider")]
+    public class SparseEigenProviderTests
+    {
+        const int Grid = 40;
+        const int Smallest = 0;
+        const int Largest = 1;
+        const int Nearest = 2;
+        const int Interval = 3;
+        const int Converged = 0;
+        const int IntervalFull = 2;
+        const int Failed = 3;
+
+        int[] _rowPointers;
+        int[] _columnIndices;
+        double[] _values;
+        double[] _exact;
+
+        [OneTimeSetUp]
+        public void Setup()
+        {
+            var n = Grid*Grid;
+            _rowPointers = new int[n + 1];
+            var columns = new int[5*n];
+            var values = new double[5*n];
+            var nnz = 0;
+            for (var i = 0; i < Grid; i++)
+            {
+                for (var j = 0; j < Grid; j++)
+                {
+                    var row = i*Grid + j;
+                    if (i > 0) { columns[nnz] = row - Grid; values[nnz++] = -1.0; }
+                    if (j > 0) { columns[nnz] = row - 1; values[nnz++] = -1.0; }
+                    columns[nnz] = row; values[nnz++] = 4.0;
+                    if (j < Grid - 1) { columns[nnz] = row + 1; values[nnz++] = -1.0; }
+                    if (i < Grid - 1) { columns[nnz] = row + Grid; values[nnz++] = -1.0; }
+                    _rowPointers[row + 1] = nnz;
+                }
+            }
+
+            _columnIndices = columns.Take(nnz).ToArray();
+            _values = values.Take(nnz).ToArray();
+            _exact = (from i in Enumerable.Range(1, Grid)
+                      from j in Enumerable.Range(1, Grid)
+                      select 4.0 - 2.0*Math.Cos(i*Math.PI/(Grid + 1)) - 2.0*Math.Cos(j*Math.PI/(Grid + 1)))
+                .OrderBy(x => x).ToArray();
+        }
+
+        /// <summary>
+        /// A shift that is an eigenvalue of a leading block, but not of the matrix, must not break the factorization.
+        /// </summary>
+        [TestCase(2.0)]
+        [TestCase(3.0)]
+        [TestCase(4.0)]
+        public void NearestSurvivesSingularLeadingBlock(double sigma)
+        {
+            const int k = 6;
+            var eigenvalues = new double[k];
+            var info = d_sparse_eigen(Grid*Grid, _rowPointers, _columnIndices, _values, Nearest, k, sigma, 0.0, 0.0, 0, 500, 0.0, eigenvalues, null, out var found, out _);
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(found, Is.EqualTo(k));
+            var expected = _exact.OrderBy(x => Math.Abs(x - sigma)).Take(k).OrderBy(x => x).ToArray();
+            for (var i = 0; i < k; i++)
+            {
+                Assert.That(eigenvalues[i], Is.EqualTo(expected[i]).Within(1e-8));
+            }
+        }
+
+        /// <summary>
+        /// Pivots of 1e-7 pass the breakdown test but grow an unpivoted factorization by 1e7; the pairs
+        /// must still come back with residuals of a stable solve.
+        /// </summary>
+        [Test]
+        public void NearestSurvivesPivotGrowth()
+        {
+            // Blocks [e b; b e] with eigenvalues e - b and e + b.
+            const int blocks = 20;
+            const double e = 1e-7;
+            const int k = 4;
+            var n = 2*blocks;
+            var rowPointers = Enumerable.Range(0, n + 1).Select(i => 2*i).ToArray();
+            var columnIndices = Enumerable.Range(0, n).SelectMany(i => new[] { i - i%2, i - i%2 + 1 }).ToArray();
+            var values = Enumerable.Range(0, n).SelectMany(i => i%2 == 0 ? new[] { e, 1.0 + 0.2*(i/2) } : new[] { 1.0 + 0.2*(i/2), e }).ToArray();
+
+            var eigenvalues = new double[k];
+            var eigenvectors = new double[n*k];
+            var info = d_sparse_eigen(n, rowPointers, columnIndices, values, Nearest, k, 0.0, 0.0, 0.0, 0, 500, 0.0, eigenvalues, eigenvectors, out var found, out _);
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(found, Is.EqualTo(k));
+            var expected = new[] { e - 1.2, e - 1.0, e + 1.0, e + 1.2 };
+            for (var j = 0; j < k; j++)
+            {
+                Assert.That(eigenvalues[j], Is.EqualTo(expected[j]).Within(1e-12));
+                var residual = 0.0;
+                for (var i = 0; i < n; i++)
+                {
+                    var ax = -eigenvalues[j]*eigenvectors[j*n + i];
+                    for (var p = rowPointers[i]; p < rowPointers[i + 1]; p++)
+                    {
+                        ax += values[p]*eigenvectors[j*n + columnIndices[p]];
+                    }
+
+                    residual += ax*ax;
+                }
+
+                Assert.That(Math.Sqrt(residual), Is.LessThan(1e-12));
+            }
+        }
+
+        /// <summary>
+        /// An interval holding exactly k eigenvalues is complete, one holding more is reported full.
+        /// </summary>
+        [TestCase(1.0, 1.05)]
+        [TestCase(0.5, 0.6)]
+        [TestCase(0.0, 0.012)]
+        public void IntervalHoldingExactlyKIsNotFull(double lower, double upper)
+        {
+            var expected = _exact.Where(x => x >= lower && x <= upper).ToArray();
+            var k = expected.Length;
+            var eigenvalues = new double[k];
+            var info = d_sparse_eigen(Grid*Grid, _rowPointers, _columnIndices, _values, Interval, k, 0.0, lower, upper, 0, 500, 0.0, eigenvalues, null, out var found, out _);
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(found, Is.EqualTo(k));
+            for (var i = 0; i < k; i++)
+            {
+                Assert.That(eigenvalues[i], Is.EqualTo(expected[i]).Within(1e-8));
+            }
+
+            if (k > 1)
+            {
+                info = d_sparse_eigen(Grid*Grid, _rowPointers, _columnIndices, _values, Interval, k - 1, 0.0, lower, upper, 0, 500, 0.0, eigenvalues, null, out found, out _);
+                Assert.That(info, Is.EqualTo(IntervalFull));
+                Assert.That(found, Is.EqualTo(k - 1));
+            }
+        }
+
+        /// <summary>
+        /// Every flavour and selection on a 12 x 12 grid Laplacian, made complex Hermitian for c and z by a
+        /// diagonal unitary similarity that keeps the closed-form eigenvalues.
+        /// </summary>
+        [TestCase('s', Smallest)]
+        [TestCase('d', Smallest)]
+        [TestCase('c', Smallest)]
+        [TestCase('z', Smallest)]
+        [TestCase('s', Largest)]
+        [TestCase('d', Largest)]
+        [TestCase('c', Largest)]
+        [TestCase('z', Largest)]
+        [TestCase('s', Nearest)]
+        [TestCase('d', Nearest)]
+        [TestCase('c', Nearest)]
+        [TestCase('z', Nearest)]
+        [TestCase('s', Interval)]
+        [TestCase('d', Interval)]
+        [TestCase('c', Interval)]
+        [TestCase('z', Interval)]
+        public void SparseEigenFindsClosedFormPairs(char flavour, int which)
+        {
+            const int grid = 12;
+            const double sigma = 3.3, lower = 2.0, upper = 2.5;
+            var a = GridLaplacian(grid, flavour);
+            var n = grid*grid;
+            var exact = GridEigenvalues(grid);
+
+            // Room for one more than the interval holds, so it is reported complete.
+            var k = which == Interval ? exact.Count(x => x >= lower && x <= upper) + 1 : 5;
+            var expected = Select(exact, which, k, sigma, lower, upper);
+
+            var eigenvalues = RealArray(flavour, k);
+            var eigenvectors = Make(flavour, new Complex[n*k]);
+            var info = SparseEigen(flavour, n, a.RowPointers, a.ColumnIndices, Make(flavour, a.Values), which, k, sigma, lower, upper, eigenvalues, eigenvectors, out var found);
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(found, Is.EqualTo(expected.Length));
+            CheckPairs(flavour, n, found, expected, Read(eigenvalues), Read(eigenvectors), x => Multiply(n, n, 1, CsrToDense(n, n, a.RowPointers, a.ColumnIndices, a.Values), x));
+        }
+
+        /// <summary>
+        /// The matrix-free form: the grid Laplacian applied by a callback for the ends of the spectrum, and
+        /// diag(1, ..., n) applied shift-inverted for the eigenvalues nearest a shift.
+        /// </summary>
+        [TestCase('s', Smallest)]
+        [TestCase('d', Smallest)]
+        [TestCase('c', Smallest)]
+        [TestCase('z', Smallest)]
+        [TestCase('s', Largest)]
+        [TestCase('d', Largest)]
+        [TestCase('c', Largest)]
+        [TestCase('z', Largest)]
+        [TestCase('s', Nearest)]
+        [TestCase('d', Nearest)]
+        [TestCase('c', Nearest)]
+        [TestCase('z', Nearest)]
+        public void MatrixFreeEigenFindsClosedFormPairs(char flavour, int which)
+        {
+            const int grid = 12, k = 5;
+            const double sigma = 40.3;
+            var n = grid*grid;
+            var a = GridLaplacian(grid, flavour);
+            var dense = CsrToDense(n, n, a.RowPointers, a.ColumnIndices, a.Values);
+            var diagonal = Enumerable.Range(1, n).Select(i => new Complex(i, 0.0)).ToArray();
+            Func<Complex[], Complex[]> multiply = which == Nearest ? x => x.Zip(diagonal, (p, d) => p*d).ToArray() : (Func<Complex[], Complex[]>)(x => Multiply(n, n, 1, dense, x));
+            var exact = which == Nearest ? diagonal.Select(d => d.Real).ToArray() : GridEigenvalues(grid);
+            var expected = Select(exact, which, k, sigma, 0.0, 0.0);
+
+            SparseCallback apply = (context, x, y) =>
+            {
+                var input = Load(flavour, x, n);
+                Store(flavour, which == Nearest ? input.Zip(diagonal, (p, d) => p/(d - sigma)).ToArray() : multiply(input), y);
+                return 0;
+            };
+
+            var eigenvalues = RealArray(flavour, k);
+            var eigenvectors = Make(flavour, new Complex[n*k]);
+            var info = MatrixFreeEigen(flavour, n, apply, which, k, sigma, 0.0, 0.0, eigenvalues, eigenvectors, out var found);
+            GC.KeepAlive(apply);
+
+            Assert.That(info, Is.EqualTo(Converged));
+            Assert.That(found, Is.EqualTo(k));
+            CheckPairs(flavour, n, found, expected, Read(eigenvalues), Read(eigenvectors), multiply);
+        }
+
+        [TestCase('s')]
+        [TestCase('d')]
+        [TestCase('c')]
+        [TestCase('z')]
+        public void ReportsCallbackFailureAndBadArguments(char flavour)
+        {
+            const int grid = 4, k = 2;
+            var n = grid*grid;
+            var a = GridLaplacian(grid, flavour);
+            var values = Make(flavour, a.Values);
+            var eigenvalues = RealArray(flavour, k);
+            int found;
+
+            Assert.That(SparseEigen(flavour, n, a.RowPointers, a.ColumnIndices, values, 4, k, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-5));
+            Assert.That(SparseEigen(flavour, n, a.RowPointers, a.ColumnIndices, values, Smallest, n + 1, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-6));
+            Assert.That(SparseEigen(flavour, n, a.RowPointers, a.ColumnIndices, values, Interval, k, 0.0, 1.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-9));
+
+            var calls = 0;
+            SparseCallback failing = (context, x, y) =>
+            {
+                Store(flavour, Load(flavour, x, n), y);
+                return ++calls < 3 ? 0 : -1;
+            };
+            Assert.That(MatrixFreeEigen(flavour, n, null, Smallest, k, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-2));
+            Assert.That(MatrixFreeEigen(flavour, n, failing, 4, k, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-4));
+            Assert.That(MatrixFreeEigen(flavour, n, failing, Smallest, 0, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(-5));
+            Assert.That(MatrixFreeEigen(flavour, n, failing, Smallest, k, 0.0, 0.0, 0.0, eigenvalues, null, out found), Is.EqualTo(Failed));
+            GC.KeepAlive(failing);
+        }
+
+        /// <summary>
+        /// The 5-point Laplacian of a grid x grid grid; for complex flavours the entry (r, c) is scaled by
+        /// exp(i*(r - c)/10), a similarity by a diagonal unitary matrix.
+        /// </summary>
+        static (int[] RowPointers, int[] ColumnIndices, Complex[] Values) GridLaplacian(int grid, char flavour)
+        {
+            var n = grid*grid;
+            var rowPointers = new int[n + 1];
+            var columnIndices = new System.Collections.Generic.List<int>();
+            var values = new System.Collections.Generic.List<Complex>();
+            for (var row = 0; row < n; row++)
+            {
+                foreach (var column in new[] { row - grid, row%grid > 0 ? row - 1 : -1, row, row%grid < grid - 1 ? row + 1 : -1, row + grid })
+                {
+                    if (column < 0 || column >= n)
+                    {
+                        continue;
+                    }
+
+                    columnIndices.Add(column);
+                    values.Add(column == row ? new Complex(4.0, 0.0) : -(IsComplex(flavour) ? Complex.FromPolarCoordinates(1.0, (row - column)/10.0) : Complex.One));
+                }
+
+                rowPointers[row + 1] = columnIndices.Count;
+            }
+
+            return (rowPointers, columnIndices.ToArray(), values.ToArray());
+        }
+
+        static double[] GridEigenvalues(int grid)
+        {
+            return (from i in Enumerable.Range(1, grid)
+                    from j in Enumerable.Range(1, grid)
+                    select 4.0 - 2.0*Math.Cos(i*Math.PI/(grid + 1)) - 2.0*Math.Cos(j*Math.PI/(grid + 1)))
+                .OrderBy(x => x).ToArray();
+        }
+
+        /// <summary>
+        /// The eigenvalues a selection should return, in ascending order.
+        /// </summary>
+        static double[] Select(double[] exact, int which, int k, double sigma, double lower, double upper)
+        {
+            switch (which)
+            {
+                case Smallest: return exact.OrderBy(x => x).Take(k).ToArray();
+                case Largest: return exact.OrderByDescending(x => x).Take(k).OrderBy(x => x).ToArray();
+                case Nearest: return exact.OrderBy(x => Math.Abs(x - sigma)).Take(k).OrderBy(x => x).ToArray();
+                default: return exact.Where(x => x >= lower && x <= upper).OrderBy(x => x).ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Checks the eigenvalues against the expected ones, the residuals against multiply and that the
+        /// eigenvectors are orthonormal.
+        /// </summary>
+        static void CheckPairs(char flavour, int n, int found, double[] expected, Complex[] eigenvalues, Complex[] eigenvectors, Func<Complex[], Complex[]> multiply)
+        {
+            var tolerance = Tolerance(flavour)*10;
+            var scale = expected.Max(x => Math.Abs(x));
+            for (var j = 0; j < found; j++)
+            {
+                Assert.That(eigenvalues[j].Real, Is.EqualTo(expected[j]).Within(tolerance*scale));
+                var v = eigenvectors.Skip(j*n).Take(n).ToArray();
+                var residual = multiply(v).Zip(v, (p, q) => p - eigenvalues[j].Real*q).Sum(r => r.Magnitude*r.Magnitude);
+                Assert.That(Math.Sqrt(residual), Is.LessThan(tolerance*scale), $"residual of pair {j}");
+                for (var i = 0; i <= j; i++)
+                {
+                    var dot = Complex.Zero;
+                    for (var p = 0; p < n; p++)
+                    {
+                        dot += Complex.Conjugate(eigenvectors[i*n + p])*v[p];
+                    }
+
+                    Assert.That(dot, Is.EqualTo(i == j ? Complex.One : Complex.Zero).Within(tolerance));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Eigenvalue array of the flavour: float for s and c, double for d and z.
+        /// </summary>
+        static Array RealArray(char flavour, int k)
+        {
+            return flavour == 's' || flavour == 'c' ? (Array)new float[k] : new double[k];
+        }
+
+        static int SparseEigen(char flavour, int n, int[] rowPointers, int[] columnIndices, Array values, int which, int k, double sigma, double lower, double upper,
+            Array eigenvalues, Array eigenvectors, out int found)
+        {
+            switch (flavour)
+            {
+                case 's': return s_sparse_eigen(n, rowPointers, columnIndices, (float[])values, which, k, (float)sigma, (float)lower, (float)upper, 0, 500, 0.0f, (float[])eigenvalues, (float[])eigenvectors, out found, out _);
+                case 'd': return d_sparse_eigen(n, rowPointers, columnIndices, (double[])values, which, k, sigma, lower, upper, 0, 500, 0.0, (double[])eigenvalues, (double[])eigenvectors, out found, out _);
+                case 'c': return c_sparse_eigen(n, rowPointers, columnIndices, (Complex32[])values, which, k, (float)sigma, (float)lower, (float)upper, 0, 500, 0.0f, (float[])eigenvalues, (Complex32[])eigenvectors, out found, out _);
+                default: return z_sparse_eigen(n, rowPointers, columnIndices, (Complex[])values, which, k, sigma, lower, upper, 0, 500, 0.0, (double[])eigenvalues, (Complex[])eigenvectors, out found, out _);
+            }
+        }
+
+        static int MatrixFreeEigen(char flavour, int n, SparseCallback apply, int which, int k, double sigma, double lower, double upper,
+            Array eigenvalues, Array eigenvectors, out int found)
+        {
+            switch (flavour)
+            {
+                case 's': return s_matrix_free_eigen(n, apply, IntPtr.Zero, which, k, (float)sigma, (float)lower, (float)upper, 0, 500, 0.0f, (float[])eigenvalues, (float[])eigenvectors, out found, out _);
+                case 'd': return d_matrix_free_eigen(n, apply, IntPtr.Zero, which, k, sigma, lower, upper, 0, 500, 0.0, (double[])eigenvalues, (double[])eigenvectors, out found, out _);
+                case 'c': return c_matrix_free_eigen(n, apply, IntPtr.Zero, which, k, (float)sigma, (float)lower, (float)upper, 0, 500, 0.0f, (float[])eigenvalues, (Complex32[])eigenvectors, out found, out _);
+                default: return z_matrix_free_eigen(n, apply, IntPtr.Zero, which, k, sigma, lower, upper, 0, 500, 0.0, (double[])eigenvalues, (Complex[])eigenvectors, out found, out _);
+            }
+        }
+    }
+}
+
+#endif
@@ -51,6 +51,17 @@ internal sealed class DenseQR : QR
         /// </summary>
         Complex[] Tau { get; set; }
 
+        /// <summary>
+        /// Gets or sets Z of the complete orthogonal factorization [R11 R12]' = Z*T of a rank deficient column
+        /// pivoted factorization, used for the minimum norm solution. Null otherwise.
+        /// </summary>
+        Complex[] Complement { get; set; }
+
+        /// <summary>
+        /// Gets or sets T of the complete orthogonal factorization, see <see cref="Complement"/>.
+        /// </summary>
+        Complex[] ComplementR { get; set; }
+
         /// <summary>
         /// Initializes a new instance of the <see cref="DenseQR"/> class. This object will compute the
         /// QR factorization when the constructor is called and cache it's factorization.
@@ -69,6 +80,10 @@ public static DenseQR Create(DenseMatrix matrix, QRMethod method = QRMethod.Full
             var tau = new Complex[Math.Min(matrix.RowCount, matrix.ColumnCount)];
             Matrix<Complex> q;
             Matrix<Complex> r;
+            int[] pivots = null;
+            Complex[] complement = null;
+            Complex[] complementR = null;
+            var rank = -1;
 
             if (method == QRMethod.Full)
             {
@@ -76,6 +91,18 @@ public static DenseQR Create(DenseMatrix matrix, QRMethod method = QRMethod.Full
                 q = new DenseMatrix(matrix.RowCount);
                 LinearAlgebraControl.Provider.QRFactor(((DenseMatrix) r).Values, matrix.RowCount, matrix.ColumnCount, ((DenseMatrix) q).Values, tau);
             }
+            else if (method == QRMethod.ColumnPivoted)
+            {
+                q = matrix.Clone();
+                r = new DenseMatrix(matrix.ColumnCount);
+                pivots = new int[matrix.ColumnCount];
+                rank = LinearAlgebraControl.Provider.PivotedQRFactor(((DenseMatrix) q).Values, matrix.RowCount, matrix.ColumnCount, ((DenseMatrix) r).Values, tau, pivots);
+                if (rank < matrix.ColumnCount)
+                {
+                    complementR = new Complex[rank*rank];
+                    complement = ManagedLinearAlgebraProvider.PivotedQRComplement(((DenseMatrix) r).Values, matrix.ColumnCount, rank, complementR);
+                }
+            }
             else
             {
                 q = matrix.Clone();
@@ -83,13 +110,15 @@ public static DenseQR Create(DenseMatrix matrix, QRMethod method = QRMethod.Full
                 LinearAlgebraControl.Provider.ThinQRFactor(((DenseMatrix) q).Values, matrix.RowCount, matrix.ColumnCount, ((DenseMatrix) r).Values, tau);
             }
 
-            return new DenseQR(q, r, method, tau);
+            return new DenseQR(q, r, method, tau, pivots, rank, complement, complementR);
         }
 
-        DenseQR(Matrix<Complex> q, Matrix<Complex> rFull, QRMethod method, Complex[] tau)
-            : base(q, rFull, method)
+        DenseQR(Matrix<Complex> q, Matrix<Complex> rFull, QRMethod method, Complex[] tau, int[] pivots, int rank, Complex[] complement, Complex[] complementR)
+            : base(q, rFull, method, pivots, rank)
         {
             Tau = tau;
+            Complement = complement;
+            ComplementR = complementR;
         }
 
         /// <summary>
@@ -117,6 +146,12 @@ public override void Solve(Matrix<Complex> input, Matrix<Complex> result)
                 throw new ArgumentException("Matrix column dimensions must agree.");
             }
 
+            if (Method == QRMethod.ColumnPivoted)
+            {
+                SolvePivoted(input, result);
+                return;
+            }
+
             if (input is DenseMatrix dinput && result is DenseMatrix dresult)
             {
                 LinearAlgebraControl.Provider.QRSolveFactored(((DenseMatrix) Q).Values, ((DenseMatrix) FullR).Values, Q.RowCount, FullR.ColumnCount, Tau, dinput.Values, input.ColumnCount, dresult.Values, Method);
@@ -147,6 +182,14 @@ public override void Solve(Vector<Complex> input, Vector<Complex> result)
                 throw Matrix.DimensionsDontMatch<ArgumentException>(FullR, result);
             }
 
+            if (Method == QRMethod.ColumnPivoted)
+            {
+                var x = new DenseMatrix(result.Count, 1);
+                SolvePivoted(input.ToColumnMatrix(), x);
+                x.Column(0).CopyTo(result);
+                return;
+            }
+
             if (input is DenseVector dinput && result is DenseVector dresult)
             {
                 LinearAlgebraControl.Provider.QRSolveFactored(((DenseMatrix) Q).Values, ((DenseMatrix) FullR).Values, Q.RowCount, FullR.ColumnCount, Tau, dinput.Values, 1, dresult.Values, Method);
@@ -156,5 +199,21 @@ public override void Solve(Vector<Complex> input, Vector<Complex> result)
                 throw new NotSupportedException("Can only do QR factorization for dense vectors at the moment.");
             }
         }
+
+        /// <summary>
+        /// Computes the minimum norm least squares solution of a column pivoted factorization from Q, R and P,
+        /// so rank deficient systems get the same answer as the pseudo-inverse.
+        /// </summary>
+        void SolvePivoted(Matrix<Complex> input, Matrix<Complex> result)
+        {
+            var b = input as DenseMatrix ?? DenseMatrix.OfMatrix(input);
+            var x = result as DenseMatrix ?? new DenseMatrix(result.RowCount, result.ColumnCount);
+            ManagedLinearAlgebraProvider.PivotedQRSolveFactored(((DenseMatrix) Q).Values, ((DenseMatrix) FullR).Values, Q.RowCount, FullR.ColumnCount, Pivots, Rank, Complement, ComplementR, b.Values, input.ColumnCount, x.Values);
+
+            if (!ReferenceEquals(x, result))
+            {
+                x.CopyTo(result);
+            }
+        }
     }
 }
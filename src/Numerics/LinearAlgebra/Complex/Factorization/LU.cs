@@ -31,6 +31,7 @@
 
 namespace AHSEsim.Numerics.LinearAlgebra.Complex.Factorization
 {
+    using System;
     using Complex = System.Numerics.Complex;
 
     /// <summary>
@@ -73,5 +74,46 @@ public override Complex Determinant
                 return det;
             }
         }
+
+        /// <summary>
+        /// Gets the natural logarithm of the absolute value of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override Complex DeterminantLn
+        {
+            get
+            {
+                var det = 0.0;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    det += Math.Log(Factors.At(j, j).Magnitude);
+                }
+
+                return det;
+            }
+        }
+
+        /// <summary>
+        /// Gets the phase (a complex number of magnitude 1, or 0) of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override Complex DeterminantSign
+        {
+            get
+            {
+                var sign = Complex.One;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    var d = Factors.At(j, j);
+                    var magnitude = d.Magnitude;
+                    if (magnitude == 0.0)
+                    {
+                        return Complex.Zero;
+                    }
+
+                    sign *= Pivots[j] != j ? -d/magnitude : d/magnitude;
+                }
+
+                return sign;
+            }
+        }
     }
 }
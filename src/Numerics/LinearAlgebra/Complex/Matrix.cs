@@ -834,6 +834,11 @@ public override LU<Complex> LU()
 
         public override QR<Complex> QR(QRMethod method = QRMethod.Thin)
         {
+            if (method == QRMethod.ColumnPivoted)
+            {
+                return DenseQR.Create(DenseMatrix.OfMatrix(this), method);
+            }
+
             return UserQR.Create(this, method);
         }
 
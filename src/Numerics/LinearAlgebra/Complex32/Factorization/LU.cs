@@ -31,6 +31,7 @@
 
 namespace AHSEsim.Numerics.LinearAlgebra.Complex32.Factorization
 {
+    using System;
     using Numerics;
 
     /// <summary>
@@ -73,5 +74,46 @@ public override Complex32 Determinant
                 return det;
             }
         }
+
+        /// <summary>
+        /// Gets the natural logarithm of the absolute value of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override Complex32 DeterminantLn
+        {
+            get
+            {
+                var det = 0.0;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    det += Math.Log(Factors.At(j, j).Magnitude);
+                }
+
+                return Convert.ToSingle(det);
+            }
+        }
+
+        /// <summary>
+        /// Gets the phase (a complex number of magnitude 1, or 0) of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override Complex32 DeterminantSign
+        {
+            get
+            {
+                var sign = Complex32.One;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    var d = Factors.At(j, j);
+                    var magnitude = d.Magnitude;
+                    if (magnitude == 0.0f)
+                    {
+                        return Complex32.Zero;
+                    }
+
+                    sign *= Pivots[j] != j ? -d/magnitude : d/magnitude;
+                }
+
+                return sign;
+            }
+        }
     }
 }
@@ -44,7 +44,8 @@ namespace AHSEsim.Numerics.LinearAlgebra.Complex32.Factorization
     /// The computation of the QR decomposition is done at construction time by Householder transformation.
     /// If a <seealso cref="QRMethod.Full"/> factorization is performed, the resulting Q matrix is an m x m matrix
     /// and the R matrix is an m x n matrix. If a <seealso cref="QRMethod.Thin"/> factorization is performed, the
-    /// resulting Q matrix is an m x n matrix and the R matrix is an n x n matrix.
+    /// resulting Q matrix is an m x n matrix and the R matrix is an n x n matrix. A <seealso cref="QRMethod.ColumnPivoted"/>
+    /// factorization has the shape of the thin factorization, but of the column permuted matrix A*P.
     /// </remarks>
     internal abstract class QR : QR<Complex32>
     {
@@ -53,6 +54,11 @@ protected QR(Matrix<Complex32> q, Matrix<Complex32> rFull, QRMethod method)
         {
         }
 
+        protected QR(Matrix<Complex32> q, Matrix<Complex32> rFull, QRMethod method, int[] pivots, int rank)
+            : base(q, rFull, method, pivots, rank)
+        {
+        }
+
         /// <summary>
         /// Gets the absolute determinant value of the matrix for which the QR matrix was computed.
         /// </summary>
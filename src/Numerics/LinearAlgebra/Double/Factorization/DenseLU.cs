@@ -42,6 +42,8 @@ namespace AHSEsim.Numerics.LinearAlgebra.Double.Factorization
     /// </remarks>
     internal sealed class DenseLU : LU
     {
+        readonly double _norm;
+
         /// <summary>
         /// Initializes a new instance of the <see cref="DenseLU"/> class. This object will compute the
         /// LU factorization when the constructor is called and cache it's factorization.
@@ -64,18 +66,27 @@ public static DenseLU Create(DenseMatrix matrix)
             // Create an array for the pivot indices.
             var pivots = new int[matrix.RowCount];
 
+            // The condition estimate needs the norm of the original matrix.
+            var norm = LinearAlgebraControl.Provider.MatrixNorm(Norm.OneNorm, matrix.RowCount, matrix.ColumnCount, matrix.Values);
+
             // Create a new matrix for the LU factors, then perform factorization (while overwriting).
             var factors = (DenseMatrix) matrix.Clone();
             LinearAlgebraControl.Provider.LUFactor(factors.Values, factors.RowCount, pivots);
 
-            return new DenseLU(factors, pivots);
+            return new DenseLU(factors, pivots, norm);
         }
 
-        DenseLU(Matrix<double> factors, int[] pivots)
+        DenseLU(Matrix<double> factors, int[] pivots, double norm)
             : base(factors, pivots)
         {
+            _norm = norm;
         }
 
+        /// <summary>
+        /// Gets an estimate of the reciprocal condition number in the 1-norm, computed in O(n^2) from the factors.
+        /// </summary>
+        public override double ReciprocalConditionNumber => LinearAlgebraControl.Provider.LUReciprocalCondition(Norm.OneNorm, ((DenseMatrix) Factors).Values, Factors.RowCount, _norm);
+
         /// <summary>
         /// Solves a system of linear equations, <c>AX = B</c>, with A LU factorized.
         /// </summary>
@@ -31,6 +31,8 @@
 
 namespace AHSEsim.Numerics.LinearAlgebra.Double.Factorization
 {
+    using System;
+
     /// <summary>
     /// <para>A class which encapsulates the functionality of an LU factorization.</para>
     /// <para>For a matrix A, the LU factorization is a pair of lower triangular matrix L and
@@ -71,5 +73,48 @@ public override double Determinant
                 return det;
             }
         }
+
+        /// <summary>
+        /// Gets the natural logarithm of the absolute value of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override double DeterminantLn
+        {
+            get
+            {
+                var det = 0.0;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    det += Math.Log(Math.Abs(Factors.At(j, j)));
+                }
+
+                return det;
+            }
+        }
+
+        /// <summary>
+        /// Gets the sign (1, -1 or 0) of the determinant of the matrix for which the LU factorization was computed.
+        /// </summary>
+        public override double DeterminantSign
+        {
+            get
+            {
+                var sign = 1.0;
+                for (var j = 0; j < Factors.RowCount; j++)
+                {
+                    var d = Factors.At(j, j);
+                    if (d == 0.0)
+                    {
+                        return 0.0;
+                    }
+
+                    if ((d < 0.0) != (Pivots[j] != j))
+                    {
+                        sign = -sign;
+                    }
+                }
+
+                return sign;
+            }
+        }
     }
 }
@@ -780,6 +780,11 @@ public override LU<double> LU()
 
         public override QR<double> QR(QRMethod method = QRMethod.Thin)
         {
+            if (method == QRMethod.ColumnPivoted)
+            {
+                return DenseQR.Create(DenseMatrix.OfMatrix(this), method);
+            }
+
             return UserQR.Create(this, method);
         }
 
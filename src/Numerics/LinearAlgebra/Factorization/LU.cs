@@ -94,6 +94,59 @@ Matrix<T> ComputeL()
         /// </summary>
         public abstract T Determinant { get; }
 
+        /// <summary>
+        /// Gets the natural logarithm of the absolute value of the determinant of the matrix for which
+        /// the LU factorization was computed. Unlike <see cref="Determinant"/> it does not overflow
+        /// or underflow for large matrices; the determinant is <see cref="DeterminantSign"/> times its exponential.
+        /// </summary>
+        public virtual T DeterminantLn => Factors.Diagonal().PointwiseAbs().PointwiseLog().Sum();
+
+        /// <summary>
+        /// Gets the sign of the determinant of the matrix for which the LU factorization was computed:
+        /// 1, -1 or 0 for real matrices, and a complex number of magnitude 1 (or 0) for complex matrices.
+        /// </summary>
+        public virtual T DeterminantSign
+        {
+            get
+            {
+                var diagonal = Factors.Diagonal();
+                var magnitude = diagonal.PointwiseAbs();
+                if (magnitude.Exists(x => x.Equals(default(T)), Zeros.Include))
+                {
+                    return default(T);
+                }
+
+                var phase = diagonal.PointwiseDivide(magnitude);
+                var sign = Vector<T>.Build.Dense(1, One);
+                for (var i = 0; i < phase.Count; i++)
+                {
+                    sign.Multiply(phase.At(i), sign);
+                    if (Pivots[i] != i)
+                    {
+                        sign.Negate(sign);
+                    }
+                }
+
+                return sign.At(0);
+            }
+        }
+
+        /// <summary>
+        /// Gets an estimate of the reciprocal condition number in the 1-norm, 1/(|A|*|inv(A)|), of the matrix
+        /// for which the LU factorization was computed: close to 1 for a well conditioned matrix and 0 for a
+        /// singular one. Dense factorizations estimate it in O(n^2) from the factors, without the inverse.
+        /// </summary>
+        public virtual double ReciprocalConditionNumber
+        {
+            get
+            {
+                var matrix = L*U;
+                matrix.PermuteRows(P.Inverse());
+                var norm = matrix.L1Norm();
+                return norm == 0.0 ? 0.0 : 1.0/(norm*Inverse().L1Norm());
+            }
+        }
+
         /// <summary>
         /// Solves a system of linear equations, <b>AX = B</b>, with A LU factorized.
         /// </summary>
@@ -28,6 +28,7 @@
 // </copyright>
 
 using System;
+using System.Linq;
 
 namespace AHSEsim.Numerics.LinearAlgebra.Factorization
 {
@@ -44,7 +45,13 @@ public enum QRMethod
         /// <summary>
         /// Compute the thin QR factorization of a matrix.
         /// </summary>
-        Thin = 1
+        Thin = 1,
+
+        /// <summary>
+        /// Compute the thin QR factorization of a matrix with column pivoting, A*P = Q*R.
+        /// The magnitude of the diagonal of R is non-increasing, which reveals the numerical rank.
+        /// </summary>
+        ColumnPivoted = 2
     }
 
     /// <summary>
@@ -57,24 +64,51 @@ public enum QRMethod
     /// The computation of the QR decomposition is done at construction time by Householder transformation.
     /// If a <seealso cref="QRMethod.Full"/> factorization is performed, the resulting Q matrix is an m x m matrix
     /// and the R matrix is an m x n matrix. If a <seealso cref="QRMethod.Thin"/> factorization is performed, the
-    /// resulting Q matrix is an m x n matrix and the R matrix is an n x n matrix.
+    /// resulting Q matrix is an m x n matrix and the R matrix is an n x n matrix. A <seealso cref="QRMethod.ColumnPivoted"/>
+    /// factorization has the shape of the thin factorization, but of the column permuted matrix A*P.
     /// </remarks>
     /// <typeparam name="T">Supported data types are double, single, <see cref="Complex"/>, and <see cref="Complex32"/>.</typeparam>
     public abstract class QR<T> : ISolver<T>
         where T : struct, IEquatable<T>, IFormattable
     {
         readonly Lazy<Matrix<T>> _lazyR;
+        readonly Lazy<Permutation> _lazyP;
+        readonly Lazy<int> _lazyRank;
 
         protected readonly Matrix<T> FullR;
         protected readonly QRMethod Method;
 
+        /// <summary>
+        /// Column pivots of a <seealso cref="QRMethod.ColumnPivoted"/> factorization: column j of A*P is column Pivots[j] of A.
+        /// Null for the other methods.
+        /// </summary>
+        protected readonly int[] Pivots;
+
         protected QR(Matrix<T> q, Matrix<T> rFull, QRMethod method)
+            : this(q, rFull, method, null, -1)
+        {
+        }
+
+        /// <param name="rank">The numerical rank reported by the factorization, or -1 to estimate it from the diagonal of R.</param>
+        protected QR(Matrix<T> q, Matrix<T> rFull, QRMethod method, int[] pivots, int rank)
         {
             Q = q;
             FullR = rFull;
             Method = method;
+            Pivots = pivots;
 
             _lazyR = new Lazy<Matrix<T>>(FullR.UpperTriangle);
+            _lazyP = new Lazy<Permutation>(() =>
+            {
+                var indices = new int[FullR.ColumnCount];
+                for (var j = 0; j < indices.Length; j++)
+                {
+                    indices[Pivots != null ? Pivots[j] : j] = j;
+                }
+
+                return new Permutation(indices);
+            });
+            _lazyRank = new Lazy<int>(() => rank >= 0 ? rank : EstimateRank());
         }
 
         /// <summary>
@@ -87,6 +121,19 @@ protected QR(Matrix<T> q, Matrix<T> rFull, QRMethod method)
         /// </summary>
         public Matrix<T> R => _lazyR.Value;
 
+        /// <summary>
+        /// Gets the column permutation P with A*P = Q*R, such that <c>A.PermuteColumns(P)</c> yields A*P.
+        /// This is the identity unless the factorization was computed with <seealso cref="QRMethod.ColumnPivoted"/>.
+        /// </summary>
+        public Permutation P => _lazyP.Value;
+
+        /// <summary>
+        /// Gets the numerical rank, the number of diagonal entries of R larger than max(m,n)*eps*max|R(i,i)|.
+        /// Only reliable for a <seealso cref="QRMethod.ColumnPivoted"/> factorization, where it is the rank
+        /// reported by the factorization itself.
+        /// </summary>
+        public virtual int Rank => _lazyRank.Value;
+
         /// <summary>
         /// Gets the absolute determinant value of the matrix for which the QR matrix was computed.
         /// </summary>
@@ -135,5 +182,18 @@ public virtual Vector<T> Solve(Vector<T> input)
         /// <param name="input">The right hand side vector, <b>b</b>.</param>
         /// <param name="result">The left hand side <see cref="Matrix{T}"/>, <b>x</b>.</param>
         public abstract void Solve(Vector<T> input, Vector<T> result);
+
+        int EstimateRank()
+        {
+            var diagonal = FullR.Diagonal();
+            if (diagonal.Count == 0)
+            {
+                return 0;
+            }
+
+            var epsilon = typeof(T) == typeof(float) || typeof(T) == typeof(Numerics.Complex32) ? Precision.PositiveSinglePrecision : Precision.PositiveDoublePrecision;
+            diagonal.CoerceZero(Math.Max(Q.RowCount, FullR.ColumnCount)*epsilon*diagonal.InfinityNorm());
+            return diagonal.Enumerate().Count(x => !x.Equals(default(T)));
+        }
     }
 }
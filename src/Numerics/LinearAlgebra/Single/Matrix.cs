@@ -781,6 +781,11 @@ public override LU<float> LU()
 
         public override QR<float> QR(QRMethod method = QRMethod.Thin)
         {
+            if (method == QRMethod.ColumnPivoted)
+            {
+                return DenseQR.Create(DenseMatrix.OfMatrix(this), method);
+            }
+
             return UserQR.Create(this, method);
         }
 
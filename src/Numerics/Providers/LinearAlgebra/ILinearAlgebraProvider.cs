@@ -288,6 +288,17 @@ public interface ILinearAlgebraProvider<T>
         /// <remarks>This is equivalent to the GETRI LAPACK routine.</remarks>
         void LUInverseFactored(T[] a, int order, int[] ipiv);
 
+        /// <summary>
+        /// Estimates the reciprocal condition number of a previously factored matrix, 1/(|A|*|inv(A)|).
+        /// </summary>
+        /// <param name="norm">The norm to use, either <see cref="Norm.OneNorm"/> or <see cref="Norm.InfinityNorm"/>.</param>
+        /// <param name="a">The LU factored N by N matrix.</param>
+        /// <param name="order">The order of the square matrix <paramref name="a"/>.</param>
+        /// <param name="matrixNorm">The same norm of the original matrix, taken before factoring.</param>
+        /// <returns>The reciprocal condition number, 0 for a singular matrix.</returns>
+        /// <remarks>This is equivalent to the GECON LAPACK routine.</remarks>
+        double LUReciprocalCondition(Norm norm, T[] a, int order, double matrixNorm);
+
         /// <summary>
         /// Solves A*X=B for X using LU factorization.
         /// </summary>
@@ -366,6 +377,37 @@ public interface ILinearAlgebraProvider<T>
         /// <remarks>This is similar to the GEQRF and ORGQR LAPACK routines.</remarks>
         void ThinQRFactor(T[] a, int rowsA, int columnsA, T[] r, T[] tau);
 
+        /// <summary>
+        /// Computes the thin QR factorization of A with column pivoting, A*P = Q*R, where M &gt;= N.
+        /// </summary>
+        /// <param name="a">On entry, it is the M by N A matrix to factor. On exit,
+        /// it is overwritten with the Q matrix of the QR factorization.</param>
+        /// <param name="rowsA">The number of rows in the A matrix.</param>
+        /// <param name="columnsA">The number of columns in the A matrix.</param>
+        /// <param name="r">On exit, A N by N matrix that holds the R matrix of the
+        /// QR factorization, with non-increasing magnitude on its diagonal.</param>
+        /// <param name="tau">A min(m,n) vector. On exit, contains additional information
+        /// about the Householder reflections.</param>
+        /// <param name="pivots">A N vector. On exit, column j of A*P is column pivots[j] of A.</param>
+        /// <returns>The numerical rank, the number of leading diagonal entries of R larger than max(m,n)*eps*|R(0,0)|.</returns>
+        /// <remarks>This is similar to the GEQP3 and ORGQR LAPACK routines. Rows must be greater or equal to columns,
+        /// otherwise an <see cref="ArgumentException"/> is thrown; wide systems can be solved with QRSolveRankRevealing.</remarks>
+        int PivotedQRFactor(T[] a, int rowsA, int columnsA, T[] r, T[] tau, int[] pivots);
+
+        /// <summary>
+        /// Computes the minimum norm least squares solution of A*X=B, which is well defined also for
+        /// rank deficient and wide A.
+        /// </summary>
+        /// <param name="a">The A matrix. It is not modified.</param>
+        /// <param name="rows">The number of rows in the A matrix.</param>
+        /// <param name="columns">The number of columns in the A matrix.</param>
+        /// <param name="b">The B matrix.</param>
+        /// <param name="columnsB">The number of columns of B.</param>
+        /// <param name="x">On exit, the solution matrix.</param>
+        /// <returns>The effective rank of A.</returns>
+        /// <remarks>This is similar to the GELSY LAPACK routine.</remarks>
+        int QRSolveRankRevealing(T[] a, int rows, int columns, T[] b, int columnsB, T[] x);
+
         /// <summary>
         /// Solves A*X=B for X using QR factorization of A.
         /// </summary>
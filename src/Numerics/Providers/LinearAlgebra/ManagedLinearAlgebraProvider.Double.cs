@@ -827,6 +827,58 @@ public void LUInverseFactored(double[] a, int order, int[] ipiv)
             inverse.Copy(a);
         }
 
+        /// <summary>
+        /// Estimates the reciprocal condition number of a previously factored matrix, 1/(|A|*|inv(A)|).
+        /// </summary>
+        /// <param name="norm">The norm to use, either <see cref="Norm.OneNorm"/> or <see cref="Norm.InfinityNorm"/>.</param>
+        /// <param name="a">The LU factored N by N matrix.</param>
+        /// <param name="order">The order of the square matrix <paramref name="a"/>.</param>
+        /// <param name="matrixNorm">The same norm of the original matrix, taken before factoring.</param>
+        /// <returns>The reciprocal condition number, 0 for a singular matrix.</returns>
+        /// <remarks>This is equivalent to the GECON LAPACK routine.</remarks>
+        public double LUReciprocalCondition(Norm norm, double[] a, int order, double matrixNorm)
+        {
+            if (a == null)
+            {
+                throw new ArgumentNullException(nameof(a));
+            }
+
+            if (a.Length != order*order)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(a));
+            }
+
+            if (norm != Norm.OneNorm && norm != Norm.InfinityNorm)
+            {
+                throw new ArgumentOutOfRangeException(nameof(norm));
+            }
+
+            for (var i = 0; i < order; i++)
+            {
+                if (a[i*order + i] == 0.0)
+                {
+                    return 0.0;
+                }
+            }
+
+            if (matrixNorm == 0.0)
+            {
+                return 0.0;
+            }
+
+            // The pivots do not change the norm of the inverse, so the identity permutation is enough.
+            var inverse = new double[a.Length];
+            a.Copy(inverse);
+            var identity = new int[order];
+            for (var i = 0; i < order; i++)
+            {
+                identity[i] = i;
+            }
+
+            LUInverseFactored(inverse, order, identity);
+            return 1.0/(matrixNorm*MatrixNorm(norm, order, order, inverse));
+        }
+
         /// <summary>
         /// Solves A*X=B for X using LU factorization.
         /// </summary>
@@ -1267,11 +1319,320 @@ public void ThinQRFactor(double[] a, int rowsA, int columnsA, double[] r, double
                 throw new ArgumentException("The given array has the wrong length. Should be columnsA * columnsA.", nameof(r));
             }
 
+            ThinQR(a, rowsA, columnsA, r, null);
+        }
+
+        /// <summary>
+        /// Computes the thin QR factorization of A with column pivoting, A*P = Q*R, where M &gt;= N.
+        /// </summary>
+        /// <param name="a">On entry, it is the M by N A matrix to factor. On exit,
+        /// it is overwritten with the Q matrix of the QR factorization.</param>
+        /// <param name="rowsA">The number of rows in the A matrix.</param>
+        /// <param name="columnsA">The number of columns in the A matrix.</param>
+        /// <param name="r">On exit, A N by N matrix that holds the R matrix of the
+        /// QR factorization, with non-increasing magnitude on its diagonal.</param>
+        /// <param name="tau">A min(m,n) vector. On exit, contains additional information
+        /// about the Householder reflections.</param>
+        /// <param name="pivots">A N vector. On exit, column j of A*P is column pivots[j] of A.</param>
+        /// <returns>The numerical rank, the number of leading diagonal entries of R larger than max(m,n)*eps*|R(0,0)|.</returns>
+        /// <remarks>This is similar to the GEQP3 and ORGQR LAPACK routines. Rows must be greater or equal to columns,
+        /// otherwise an <see cref="ArgumentException"/> is thrown; wide systems can be solved with QRSolveRankRevealing.</remarks>
+        public int PivotedQRFactor(double[] a, int rowsA, int columnsA, double[] r, double[] tau, int[] pivots)
+        {
+            if (r == null)
+            {
+                throw new ArgumentNullException(nameof(r));
+            }
+
+            if (a == null)
+            {
+                throw new ArgumentNullException(nameof(a));
+            }
+
+            if (pivots == null)
+            {
+                throw new ArgumentNullException(nameof(pivots));
+            }
+
+            if (a.Length != rowsA*columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be rowsR * columnsR.", nameof(a));
+            }
+
+            if (tau.Length < Math.Min(rowsA, columnsA))
+            {
+                throw new ArgumentException("The given array is too small. It must be at least min(m,n) long.", nameof(tau));
+            }
+
+            if (r.Length != columnsA*columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be columnsA * columnsA.", nameof(r));
+            }
+
+            if (pivots.Length != columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be columnsA.", nameof(pivots));
+            }
+
+            if (rowsA < columnsA)
+            {
+                throw new ArgumentException("The number of rows must greater than or equal to the number of columns.");
+            }
+
+            for (var j = 0; j < columnsA; j++)
+            {
+                pivots[j] = j;
+            }
+
+            ThinQR(a, rowsA, columnsA, r, pivots);
+
+            if (columnsA == 0)
+            {
+                return 0;
+            }
+
+            var tolerance = Math.Max(rowsA, columnsA)*Precision.PositiveDoublePrecision*Math.Abs(r[0]);
+            var rank = 0;
+            while (rank < columnsA && Math.Abs(r[rank*columnsA + rank]) > tolerance)
+            {
+                rank++;
+            }
+
+            return rank;
+        }
+
+        /// <summary>
+        /// Computes the minimum norm least squares solution of A*X=B, which is well defined also for
+        /// rank deficient and wide A.
+        /// </summary>
+        /// <param name="a">The A matrix. It is not modified.</param>
+        /// <param name="rows">The number of rows in the A matrix.</param>
+        /// <param name="columns">The number of columns in the A matrix.</param>
+        /// <param name="b">The B matrix.</param>
+        /// <param name="columnsB">The number of columns of B.</param>
+        /// <param name="x">On exit, the solution matrix.</param>
+        /// <returns>The effective rank of A.</returns>
+        /// <remarks>This is similar to the GELSY LAPACK routine: a column pivoted QR followed by a complete
+        /// orthogonal factorization of its leading rank rows.</remarks>
+        public int QRSolveRankRevealing(double[] a, int rows, int columns, double[] b, int columnsB, double[] x)
+        {
+            if (a == null)
+            {
+                throw new ArgumentNullException(nameof(a));
+            }
+
+            if (b == null)
+            {
+                throw new ArgumentNullException(nameof(b));
+            }
+
+            if (x == null)
+            {
+                throw new ArgumentNullException(nameof(x));
+            }
+
+            if (a.Length != rows*columns)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(a));
+            }
+
+            if (b.Length != rows*columnsB)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(b));
+            }
+
+            if (x.Length != columns*columnsB)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(x));
+            }
+
+            if (rows >= columns)
+            {
+                var q = new double[a.Length];
+                a.Copy(q);
+                var r = new double[columns*columns];
+                var pivots = new int[columns];
+                var rank = PivotedQRFactor(q, rows, columns, r, new double[columns], pivots);
+                var t = new double[rank*rank];
+                var z = rank < columns ? PivotedQRComplement(r, columns, rank, t) : null;
+                PivotedQRSolveFactored(q, r, rows, columns, pivots, rank, z, t, b, columnsB, x);
+                return rank;
+            }
+
+            // A wide A is factored through its transpose, A'*P = Q*R. With W the leading rank rows of R,
+            // Q1 the leading rank columns of Q and W' = Z*T, A = P*Z*T*Q1' and X = Q1*inv(T)*Z'*P'*B.
+            var qt = new double[a.Length];
+            for (var j = 0; j < columns; j++)
+            {
+                for (var i = 0; i < rows; i++)
+                {
+                    qt[i*columns + j] = a[j*rows + i];
+                }
+            }
+
+            var rt = new double[rows*rows];
+            var pt = new int[rows];
+            var rankT = PivotedQRFactor(qt, columns, rows, rt, new double[rows], pt);
+            var tt = new double[rankT*rankT];
+            var zt = PivotedQRComplement(rt, rows, rankT, tt);
+
+            var u = new double[rankT];
+            for (var k = 0; k < columnsB; k++)
+            {
+                for (var i = 0; i < rankT; i++)
+                {
+                    var sum = 0.0;
+                    for (var p = 0; p < rows; p++)
+                    {
+                        sum += zt[i*rows + p]*b[k*rows + pt[p]];
+                    }
+
+                    u[i] = sum;
+                }
+
+                for (var i = rankT - 1; i >= 0; i--)
+                {
+                    var sum = u[i];
+                    for (var j = i + 1; j < rankT; j++)
+                    {
+                        sum -= tt[j*rankT + i]*u[j];
+                    }
+
+                    u[i] = sum/tt[i*rankT + i];
+                }
+
+                for (var p = 0; p < columns; p++)
+                {
+                    var sum = 0.0;
+                    for (var i = 0; i < rankT; i++)
+                    {
+                        sum += qt[i*columns + p]*u[i];
+                    }
+
+                    x[k*columns + p] = sum;
+                }
+            }
+
+            return rankT;
+        }
+
+        /// <summary>
+        /// Factors the leading rank rows W = [R11 R12] of a column pivoted R as W' = Z*T, a thin QR of W'. Together
+        /// with the pivoted QR this is a complete orthogonal factorization of A, from which the minimum norm solution
+        /// of a rank deficient system follows.
+        /// </summary>
+        /// <param name="r">The columns by columns R factor of <see cref="PivotedQRFactor"/>.</param>
+        /// <param name="columns">The order of R.</param>
+        /// <param name="rank">The numerical rank reported by <see cref="PivotedQRFactor"/>.</param>
+        /// <param name="t">On exit, the rank by rank upper triangular factor T.</param>
+        /// <returns>Z, a columns by rank matrix with orthonormal columns.</returns>
+        internal static double[] PivotedQRComplement(double[] r, int columns, int rank, double[] t)
+        {
+            var z = new double[columns*rank];
+            for (var i = 0; i < rank; i++)
+            {
+                for (var j = i; j < columns; j++)
+                {
+                    z[i*columns + j] = r[j*columns + i];
+                }
+            }
+
+            ThinQR(z, columns, rank, t, null);
+            return z;
+        }
+
+        /// <summary>
+        /// Computes the minimum norm least squares solution of A*X=B from a column pivoted QR of A, A*P = Q*R with
+        /// rows &gt;= columns, treating the trailing block of R below the rank as zero.
+        /// </summary>
+        /// <param name="q">The rows by columns Q factor.</param>
+        /// <param name="r">The columns by columns R factor.</param>
+        /// <param name="rows">The number of rows in the A matrix.</param>
+        /// <param name="columns">The number of columns in the A matrix.</param>
+        /// <param name="pivots">The column pivots.</param>
+        /// <param name="rank">The numerical rank.</param>
+        /// <param name="z">The Z factor of <see cref="PivotedQRComplement"/>, or <c>null</c> when rank equals columns.</param>
+        /// <param name="t">The T factor of <see cref="PivotedQRComplement"/>. Not used when <paramref name="z"/> is <c>null</c>.</param>
+        /// <param name="b">The B matrix.</param>
+        /// <param name="columnsB">The number of columns of B.</param>
+        /// <param name="x">On exit, the solution matrix.</param>
+        internal static void PivotedQRSolveFactored(double[] q, double[] r, int rows, int columns, int[] pivots, int rank, double[] z, double[] t, double[] b, int columnsB, double[] x)
+        {
+            var c = new double[rank];
+            var y = new double[columns];
+            for (var k = 0; k < columnsB; k++)
+            {
+                // c = Q1'*b over the leading rank columns of Q.
+                for (var i = 0; i < rank; i++)
+                {
+                    var sum = 0.0;
+                    for (var l = 0; l < rows; l++)
+                    {
+                        sum += q[i*rows + l]*b[k*rows + l];
+                    }
+
+                    c[i] = sum;
+                }
+
+                if (z == null)
+                {
+                    // Full rank: R*y = c.
+                    for (var i = rank - 1; i >= 0; i--)
+                    {
+                        var sum = c[i];
+                        for (var j = i + 1; j < rank; j++)
+                        {
+                            sum -= r[j*columns + i]*y[j];
+                        }
+
+                        y[i] = sum/r[i*columns + i];
+                    }
+                }
+                else
+                {
+                    // [R11 R12]*y = c with y = Z*w: T'*w = c.
+                    for (var i = 0; i < rank; i++)
+                    {
+                        var sum = c[i];
+                        for (var j = 0; j < i; j++)
+                        {
+                            sum -= t[i*rank + j]*c[j];
+                        }
+
+                        c[i] = sum/t[i*rank + i];
+                    }
+
+                    for (var p = 0; p < columns; p++)
+                    {
+                        var sum = 0.0;
+                        for (var i = 0; i < rank; i++)
+                        {
+                            sum += z[i*columns + p]*c[i];
+                        }
+
+                        y[p] = sum;
+                    }
+                }
+
+                for (var p = 0; p < columns; p++)
+                {
+                    x[k*columns + pivots[p]] = y[p];
+                }
+            }
+        }
+
+        static void ThinQR(double[] a, int rowsA, int columnsA, double[] r, int[] pivots)
+        {
             var work = new double[rowsA*columnsA];
 
             var minmn = Math.Min(rowsA, columnsA);
             for (var i = 0; i < minmn; i++)
             {
+                if (pivots != null)
+                {
+                    PivotColumn(a, rowsA, columnsA, i, pivots);
+                }
+
                 GenerateColumn(work, a, rowsA, i, i);
                 ComputeQR(work, i, a, i, rowsA, i + 1, columnsA, Control.MaxDegreeOfParallelism);
             }
@@ -1302,6 +1663,47 @@ public void ThinQRFactor(double[] a, int rowsA, int columnsA, double[] r, double
 
         #region QR Factor Helper functions
 
+        /// <summary>
+        /// Swap the remaining column with the largest norm into the given column
+        /// </summary>
+        /// <param name="a">Partially reduced matrix</param>
+        /// <param name="rowCount">The number of rows in matrix</param>
+        /// <param name="columnCount">The number of columns in matrix</param>
+        /// <param name="column">Column index, also the first row of the remaining block</param>
+        /// <param name="pivots">Column pivots, updated with the swap</param>
+        static void PivotColumn(double[] a, int rowCount, int columnCount, int column, int[] pivots)
+        {
+            var best = column;
+            var bestNorm = -1.0;
+            for (var j = column; j < columnCount; j++)
+            {
+                var norm = 0.0;
+                for (var i = column; i < rowCount; i++)
+                {
+                    var value = a[(j*rowCount) + i];
+                    norm += value*value;
+                }
+
+                if (norm > bestNorm)
+                {
+                    bestNorm = norm;
+                    best = j;
+                }
+            }
+
+            if (best == column)
+            {
+                return;
+            }
+
+            for (var i = 0; i < rowCount; i++)
+            {
+                (a[(column*rowCount) + i], a[(best*rowCount) + i]) = (a[(best*rowCount) + i], a[(column*rowCount) + i]);
+            }
+
+            (pivots[column], pivots[best]) = (pivots[best], pivots[column]);
+        }
+
         /// <summary>
         /// Perform calculation of Q or R
         /// </summary>
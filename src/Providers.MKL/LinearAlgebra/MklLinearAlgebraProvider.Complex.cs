@@ -183,10 +183,22 @@ public void ConjugateArray(Complex[] x, Complex[] result)
                 throw new ArgumentNullException(nameof(x));
             }
 
-            for (int i = 0; i < result.Length; i++)
+            if (result == null)
             {
-                result[i] = x[i].Conjugate();
+                throw new ArgumentNullException(nameof(result));
             }
+
+            if (_vectorFunctionsMajor != 0 || _vectorFunctionsMinor < 3 || x.Length != result.Length)
+            {
+                for (int i = 0; i < result.Length; i++)
+                {
+                    result[i] = x[i].Conjugate();
+                }
+
+                return;
+            }
+
+            SafeNativeMethods.z_conjugate(x.Length, x, result);
         }
 
         /// <summary>
@@ -376,6 +388,48 @@ public void LUInverseFactored(Complex[] a, int order, int[] ipiv)
             }
         }
 
+        /// <summary>
+        /// Estimates the reciprocal condition number of a previously factored matrix, 1/(|A|*|inv(A)|).
+        /// </summary>
+        /// <param name="norm">The norm to use, either <see cref="Norm.OneNorm"/> or <see cref="Norm.InfinityNorm"/>.</param>
+        /// <param name="a">The LU factored N by N matrix.</param>
+        /// <param name="order">The order of the square matrix <paramref name="a"/>.</param>
+        /// <param name="matrixNorm">The same norm of the original matrix, taken before factoring.</param>
+        /// <returns>The reciprocal condition number, 0 for a singular matrix.</returns>
+        /// <remarks>This is equivalent to the GECON LAPACK routine.</remarks>
+        [SecuritySafeCritical]
+        public double LUReciprocalCondition(Norm norm, Complex[] a, int order, double matrixNorm)
+        {
+            if (a == null)
+            {
+                throw new ArgumentNullException(nameof(a));
+            }
+
+            if (a.Length != order*order)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(a));
+            }
+
+            if (norm != Norm.OneNorm && norm != Norm.InfinityNorm)
+            {
+                throw new ArgumentOutOfRangeException(nameof(norm));
+            }
+
+            if (_linearAlgebraMinor < 7)
+            {
+                return ManagedLinearAlgebraProvider.Instance.LUReciprocalCondition(norm, a, order, matrixNorm);
+            }
+
+            var info = SafeNativeMethods.z_lu_rcond((byte)norm, order, a, (double)matrixNorm, out var rcond);
+
+            if (info < 0)
+            {
+                throw new InvalidParameterException(Math.Abs(info));
+            }
+
+            return rcond;
+        }
+
         /// <summary>
         /// Solves A*X=B for X using LU factorization.
         /// </summary>
@@ -693,6 +747,144 @@ public void ThinQRFactor(Complex[] q, int rowsA, int columnsA, Complex[] r, Comp
             }
         }
 
+        /// <summary>
+        /// Computes the thin QR factorization of A with column pivoting, A*P = Q*R, where M &gt;= N.
+        /// </summary>
+        /// <param name="q">On entry, it is the M by N A matrix to factor. On exit,
+        /// it is overwritten with the Q matrix of the QR factorization.</param>
+        /// <param name="rowsA">The number of rows in the A matrix.</param>
+        /// <param name="columnsA">The number of columns in the A matrix.</param>
+        /// <param name="r">On exit, A N by N matrix that holds the R matrix of the
+        /// QR factorization, with non-increasing magnitude on its diagonal.</param>
+        /// <param name="tau">A min(m,n) vector. On exit, contains additional information
+        /// about the Householder reflections.</param>
+        /// <param name="pivots">A N vector. On exit, column j of A*P is column pivots[j] of A.</param>
+        /// <returns>The numerical rank, the number of leading diagonal entries of R larger than max(m,n)*eps*|R(0,0)|.</returns>
+        /// <remarks>This is similar to the GEQP3 and ORGQR LAPACK routines. Rows must be greater or equal to columns,
+        /// otherwise an <see cref="ArgumentException"/> is thrown; wide systems can be solved with QRSolveRankRevealing.</remarks>
+        [SecuritySafeCritical]
+        public int PivotedQRFactor(Complex[] q, int rowsA, int columnsA, Complex[] r, Complex[] tau, int[] pivots)
+        {
+            if (r == null)
+            {
+                throw new ArgumentNullException(nameof(r));
+            }
+
+            if (q == null)
+            {
+                throw new ArgumentNullException(nameof(q));
+            }
+
+            if (pivots == null)
+            {
+                throw new ArgumentNullException(nameof(pivots));
+            }
+
+            if (q.Length != rowsA * columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be rowsR * columnsR.", nameof(q));
+            }
+
+            if (tau.Length < Math.Min(rowsA, columnsA))
+            {
+                throw new ArgumentException("The given array is too small. It must be at least min(m,n) long.", nameof(tau));
+            }
+
+            if (r.Length != columnsA * columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be columnsA * columnsA.", nameof(r));
+            }
+
+            if (pivots.Length != columnsA)
+            {
+                throw new ArgumentException("The given array has the wrong length. Should be columnsA.", nameof(pivots));
+            }
+
+            if (rowsA < columnsA)
+            {
+                throw new ArgumentException("The number of rows must greater than or equal to the number of columns.");
+            }
+
+            if (_linearAlgebraMinor < 3)
+            {
+                return ManagedLinearAlgebraProvider.Instance.PivotedQRFactor(q, rowsA, columnsA, r, tau, pivots);
+            }
+
+            var info = SafeNativeMethods.z_qr_pivot_factor(rowsA, columnsA, q, tau, r, pivots, 0, out var rank);
+
+            if (info < 0)
+            {
+                throw new InvalidParameterException(Math.Abs(info));
+            }
+
+            return rank;
+        }
+
+        /// <summary>
+        /// Computes the minimum norm least squares solution of A*X=B, which is well defined also for
+        /// rank deficient and wide A.
+        /// </summary>
+        /// <param name="a">The A matrix. It is not modified.</param>
+        /// <param name="rows">The number of rows in the A matrix.</param>
+        /// <param name="columns">The number of columns in the A matrix.</param>
+        /// <param name="b">The B matrix.</param>
+        /// <param name="columnsB">The number of columns of B.</param>
+        /// <param name="x">On exit, the solution matrix.</param>
+        /// <returns>The effective rank of A.</returns>
+        /// <remarks>This is similar to the GELSY LAPACK routine.</remarks>
+        [SecuritySafeCritical]
+        public int QRSolveRankRevealing(Complex[] a, int rows, int columns, Complex[] b, int columnsB, Complex[] x)
+        {
+            if (a == null)
+            {
+                throw new ArgumentNullException(nameof(a));
+            }
+
+            if (b == null)
+            {
+                throw new ArgumentNullException(nameof(b));
+            }
+
+            if (x == null)
+            {
+                throw new ArgumentNullException(nameof(x));
+            }
+
+            if (a.Length != rows*columns)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(a));
+            }
+
+            if (b.Length != rows*columnsB)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(b));
+            }
+
+            if (x.Length != columns*columnsB)
+            {
+                throw new ArgumentException("The array arguments must have the same length.", nameof(x));
+            }
+
+            if (_linearAlgebraMinor < 3)
+            {
+                return ManagedLinearAlgebraProvider.Instance.QRSolveRankRevealing(a, rows, columns, b, columnsB, x);
+            }
+
+            var info = SafeNativeMethods.z_qr_solve_rank_revealing(rows, columns, columnsB, a, b, x, 0, out var rank);
+
+            if (info == (int)MklError.MemoryAllocation)
+            {
+                throw new MemoryAllocationException();
+            }
+
+            if (info < 0)
+            {
+                throw new InvalidParameterException(Math.Abs(info));
+            }
+
+            return rank;
+        }
+
         /// <summary>
         /// Solves A*X=B for X using QR factorization of A.
         /// </summary>
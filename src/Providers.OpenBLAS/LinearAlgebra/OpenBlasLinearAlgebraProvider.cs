@@ -60,6 +60,8 @@ internal sealed partial class OpenBlasLinearAlgebraProvider : ILinearAlgebraProv
 
         readonly string _hintPath;
 
+        int _linearAlgebraMinor;
+
         /// <param name="hintPath">Hint path where to look for the native binaries</param>
         internal OpenBlasLinearAlgebraProvider(string hintPath)
         {
@@ -94,6 +96,8 @@ public void InitializeVerify()
             {
                 throw new NotSupportedException(FormattableString.Invariant($"OpenBLAS Native Provider not compatible. Expecting linear algebra v1 but provider implements v{linearAlgebra}."));
             }
+
+            _linearAlgebraMinor = SafeNativeMethods.query_capability((int)ProviderCapability.LinearAlgebraMinor);
         }
 
         /// <summary>
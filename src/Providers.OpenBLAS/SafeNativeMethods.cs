@@ -26,6 +26,7 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 // </copyright>
 
+using System;
 using System.Runtime.InteropServices;
 using System.Security;
 using AHSEsim.Numerics.Providers.LinearAlgebra;
@@ -111,6 +112,18 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern void z_matrix_multiply(Transpose transA, Transpose transB, int m, int n, int k, Complex alpha, Complex[] x, Complex[] y, Complex beta, [In, Out] Complex[] c);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void s_matrix_multiply_rm(Transpose transA, Transpose transB, int m, int n, int k, float alpha, float[] x, float[] y, float beta, [In, Out] float[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void d_matrix_multiply_rm(Transpose transA, Transpose transB, int m, int n, int k, double alpha, double[] x, double[] y, double beta, [In, Out] double[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_matrix_multiply_rm(Transpose transA, Transpose transB, int m, int n, int k, Complex32 alpha, Complex32[] x, Complex32[] y, Complex32 beta, [In, Out] Complex32[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_matrix_multiply_rm(Transpose transA, Transpose transB, int m, int n, int k, Complex alpha, Complex[] x, Complex[] y, Complex beta, [In, Out] Complex[] c);
+
         #endregion BLAS
 
         #region LAPACK
@@ -139,6 +152,18 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int z_cholesky_factor(int n, [In, Out] Complex[] a);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_cholesky_factor_rm(int n, [In, Out] float[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_cholesky_factor_rm(int n, [In, Out] double[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_cholesky_factor_rm(int n, [In, Out] Complex32[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_cholesky_factor_rm(int n, [In, Out] Complex[] a);
+
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int s_lu_factor(int n, [In, Out] float[] a, [In, Out] int[] ipiv);
 
@@ -151,6 +176,18 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int z_lu_factor(int n, [In, Out] Complex[] a, [In, Out] int[] ipiv);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lu_factor_rm(int n, [In, Out] float[] a, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lu_factor_rm(int n, [In, Out] double[] a, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lu_factor_rm(int n, [In, Out] Complex32[] a, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lu_factor_rm(int n, [In, Out] Complex[] a, [In, Out] int[] ipiv);
+
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int s_lu_inverse(int n, [In, Out] float[] a);
 
@@ -187,6 +224,18 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int z_lu_solve_factored(int n, int nrhs, Complex[] a, [In, Out] int[] ipiv, [In, Out] Complex[] b);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lu_solve_factored_rm(int n, int nrhs, float[] a, [In, Out] int[] ipiv, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lu_solve_factored_rm(int n, int nrhs, double[] a, [In, Out] int[] ipiv, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lu_solve_factored_rm(int n, int nrhs, Complex32[] a, [In, Out] int[] ipiv, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lu_solve_factored_rm(int n, int nrhs, Complex[] a, [In, Out] int[] ipiv, [In, Out] Complex[] b);
+
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int s_lu_solve(int n, int nrhs, float[] a, [In, Out] float[] b);
 
@@ -199,6 +248,30 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int z_lu_solve(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lu_solve_rm(int n, int nrhs, float[] a, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lu_solve_rm(int n, int nrhs, double[] a, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lu_solve_rm(int n, int nrhs, Complex32[] a, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lu_solve_rm(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lu_solve_inplace(int n, int nrhs, [In, Out] float[] a, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lu_solve_inplace(int n, int nrhs, [In, Out] double[] a, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lu_solve_inplace(int n, int nrhs, [In, Out] Complex32[] a, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lu_solve_inplace(int n, int nrhs, [In, Out] Complex[] a, [In, Out] Complex[] b);
+
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int s_cholesky_solve(int n, int nrhs, float[] a, [In, Out] float[] b);
 
@@ -211,6 +284,30 @@ internal static class SafeNativeMethods
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int z_cholesky_solve(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
 
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_cholesky_solve_rm(int n, int nrhs, float[] a, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_cholesky_solve_rm(int n, int nrhs, double[] a, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_cholesky_solve_rm(int n, int nrhs, Complex32[] a, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_cholesky_solve_rm(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_cholesky_solve_inplace(int n, int nrhs, [In, Out] float[] a, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_cholesky_solve_inplace(int n, int nrhs, [In, Out] double[] a, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_cholesky_solve_inplace(int n, int nrhs, [In, Out] Complex32[] a, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_cholesky_solve_inplace(int n, int nrhs, [In, Out] Complex[] a, [In, Out] Complex[] b);
+
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
         internal static extern int s_cholesky_solve_factored(int n, int nrhs, float[] a, [In, Out] float[] b);
 
@@ -224,77 +321,1149 @@ internal static class SafeNativeMethods
         internal static extern int z_cholesky_solve_factored(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_qr_factor(int m, int n, [In, Out] float[] r, [In, Out] float[] tau, [In, Out] float[] q);
+        internal static extern int s_cholesky_solve_factored_rm(int n, int nrhs, float[] a, [In, Out] float[] b);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_qr_factor(int m, int n, [In, Out] double[] r, [In, Out] double[] tau, [In, Out] double[] q);
+        internal static extern int d_cholesky_solve_factored_rm(int n, int nrhs, double[] a, [In, Out] double[] b);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_qr_factor(int m, int n, [In, Out] Complex32[] r, [In, Out] Complex32[] tau, [In, Out] Complex32[] q);
+        internal static extern int c_cholesky_solve_factored_rm(int n, int nrhs, Complex32[] a, [In, Out] Complex32[] b);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_qr_factor(int m, int n, [In, Out] Complex[] r, [In, Out] Complex[] tau, [In, Out] Complex[] q);
+        internal static extern int z_cholesky_solve_factored_rm(int n, int nrhs, Complex[] a, [In, Out] Complex[] b);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_qr_thin_factor(int m, int n, [In, Out] float[] q, [In, Out] float[] tau, [In, Out] float[] r);
+        internal static extern int s_cholesky_update(int n, int k, [In, Out] float[] a, [In, Out] float[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_qr_thin_factor(int m, int n, [In, Out] double[] q, [In, Out] double[] tau, [In, Out] double[] r);
+        internal static extern int d_cholesky_update(int n, int k, [In, Out] double[] a, [In, Out] double[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_qr_thin_factor(int m, int n, [In, Out] Complex32[] q, [In, Out] Complex32[] tau, [In, Out] Complex32[] r);
+        internal static extern int c_cholesky_update(int n, int k, [In, Out] Complex32[] a, [In, Out] Complex32[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_qr_thin_factor(int m, int n, [In, Out] Complex[] q, [In, Out] Complex[] tau, [In, Out] Complex[] r);
+        internal static extern int z_cholesky_update(int n, int k, [In, Out] Complex[] a, [In, Out] Complex[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_qr_solve(int m, int n, int bn, float[] r, float[] b, [In, Out] float[] x);
+        internal static extern int s_cholesky_downdate(int n, int k, [In, Out] float[] a, [In, Out] float[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_qr_solve(int m, int n, int bn, double[] r, double[] b, [In, Out] double[] x);
+        internal static extern int d_cholesky_downdate(int n, int k, [In, Out] double[] a, [In, Out] double[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_qr_solve(int m, int n, int bn, Complex32[] r, Complex32[] b, [In, Out] Complex32[] x);
+        internal static extern int c_cholesky_downdate(int n, int k, [In, Out] Complex32[] a, [In, Out] Complex32[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_qr_solve(int m, int n, int bn, Complex[] r, Complex[] b, [In, Out] Complex[] x);
+        internal static extern int z_cholesky_downdate(int n, int k, [In, Out] Complex[] a, [In, Out] Complex[] x);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_qr_solve_factored(int m, int n, int bn, float[] r, float[] b, float[] tau, [In, Out] float[] x);
+        internal static extern int s_ldl_factor(int n, [In, Out] float[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_qr_solve_factored(int m, int n, int bn, double[] r, double[] b, double[] tau, [In, Out] double[] x);
+        internal static extern int d_ldl_factor(int n, [In, Out] double[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_qr_solve_factored(int m, int n, int bn, Complex32[] r, Complex32[] b, Complex32[] tau, [In, Out] Complex32[] x);
+        internal static extern int c_ldl_factor(int n, [In, Out] Complex32[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_qr_solve_factored(int m, int n, int bn, Complex[] r, Complex[] b, Complex[] tau, [In, Out] Complex[] x);
+        internal static extern int z_ldl_factor(int n, [In, Out] Complex[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] float[] a, [In, Out] float[] s, [In, Out] float[] u, [In, Out] float[] v);
+        internal static extern int c_hermitian_ldl_factor(int n, [In, Out] Complex32[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] double[] a, [In, Out] double[] s, [In, Out] double[] u, [In, Out] double[] v);
+        internal static extern int z_hermitian_ldl_factor(int n, [In, Out] Complex[] a, [In, Out] int[] ipiv, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] Complex32[] a, [In, Out] Complex32[] s, [In, Out] Complex32[] u, [In, Out] Complex32[] v);
+        internal static extern int s_ldl_solve_factored(int n, int nrhs, float[] a, [In, Out] int[] ipiv, [In, Out] float[] b, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] Complex[] a, [In, Out] Complex[] s, [In, Out] Complex[] u, [In, Out] Complex[] v);
+        internal static extern int d_ldl_solve_factored(int n, int nrhs, double[] a, [In, Out] int[] ipiv, [In, Out] double[] b, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int s_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] float[] a, [In, Out] float[] vectors, [In, Out] Complex[] values, [In, Out] float[] d);
+        internal static extern int c_ldl_solve_factored(int n, int nrhs, Complex32[] a, [In, Out] int[] ipiv, [In, Out] Complex32[] b, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int d_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] double[] a, [In, Out] double[] vectors, [In, Out] Complex[] values, [In, Out] double[] d);
+        internal static extern int z_ldl_solve_factored(int n, int nrhs, Complex[] a, [In, Out] int[] ipiv, [In, Out] Complex[] b, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int c_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] Complex32[] a, [In, Out] Complex32[] vectors, [In, Out] Complex[] values, [In, Out] Complex32[] d);
+        internal static extern int c_hermitian_ldl_solve_factored(int n, int nrhs, Complex32[] a, [In, Out] int[] ipiv, [In, Out] Complex32[] b, int variant);
 
         [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int z_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] Complex[] a, [In, Out] Complex[] vectors, [In, Out] Complex[] values, [In, Out] Complex[] d);
+        internal static extern int z_hermitian_ldl_solve_factored(int n, int nrhs, Complex[] a, [In, Out] int[] ipiv, [In, Out] Complex[] b, int variant);
 
-        #endregion LAPACK
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_ldl_solve(int n, int nrhs, float[] a, [In, Out] float[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_ldl_solve(int n, int nrhs, double[] a, [In, Out] double[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_ldl_solve(int n, int nrhs, Complex32[] a, [In, Out] Complex32[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_ldl_solve(int n, int nrhs, Complex[] a, [In, Out] Complex[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_hermitian_ldl_solve(int n, int nrhs, Complex32[] a, [In, Out] Complex32[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_hermitian_ldl_solve(int n, int nrhs, Complex[] a, [In, Out] Complex[] b, int variant);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lu_rcond(byte norm, int n, float[] a, float anorm, out float rcond);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lu_rcond(byte norm, int n, double[] a, double anorm, out double rcond);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lu_rcond(byte norm, int n, Complex32[] a, float anorm, out float rcond);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lu_rcond(byte norm, int n, Complex[] a, double anorm, out double rcond);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_symmetric_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int itype, int n, [In] float[] a, [In] float[] b, [In, Out] float[] values, [In, Out] float[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_symmetric_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int itype, int n, [In] double[] a, [In] double[] b, [In, Out] double[] values, [In, Out] double[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_hermitian_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int itype, int n, [In] Complex32[] a, [In] Complex32[] b, [In, Out] float[] values, [In, Out] Complex32[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_hermitian_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int itype, int n, [In] Complex[] a, [In] Complex[] b, [In, Out] double[] values, [In, Out] Complex[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int n, [In] float[] a, [In] float[] b, [In, Out] Complex[] alpha, [In, Out] Complex[] beta, [In, Out] float[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int n, [In] double[] a, [In] double[] b, [In, Out] Complex[] alpha, [In, Out] Complex[] beta, [In, Out] double[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int n, [In] Complex32[] a, [In] Complex32[] b, [In, Out] Complex[] alpha, [In, Out] Complex[] beta, [In, Out] Complex32[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_generalized_eigen([MarshalAs(UnmanagedType.U1)] bool computeVectors, int n, [In] Complex[] a, [In] Complex[] b, [In, Out] Complex[] alpha, [In, Out] Complex[] beta, [In, Out] Complex[] vectors);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qz_factor(int n, [In, Out] float[] a, [In, Out] float[] b, [In, Out] float[] q, [In, Out] float[] z, [In, Out] Complex[] alpha, [In, Out] Complex[] beta);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qz_factor(int n, [In, Out] double[] a, [In, Out] double[] b, [In, Out] double[] q, [In, Out] double[] z, [In, Out] Complex[] alpha, [In, Out] Complex[] beta);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qz_factor(int n, [In, Out] Complex32[] a, [In, Out] Complex32[] b, [In, Out] Complex32[] q, [In, Out] Complex32[] z, [In, Out] Complex[] alpha, [In, Out] Complex[] beta);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qz_factor(int n, [In, Out] Complex[] a, [In, Out] Complex[] b, [In, Out] Complex[] q, [In, Out] Complex[] z, [In, Out] Complex[] alpha, [In, Out] Complex[] beta);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_expm(int n, [In] float[] a, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_expm(int n, [In] double[] a, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_expm(int n, [In] Complex32[] a, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_expm(int n, [In] Complex[] a, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_expm_create([Out] out IntPtr handle, int n, [In] float[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_expm_create([Out] out IntPtr handle, int n, [In] double[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_expm_create([Out] out IntPtr handle, int n, [In] Complex32[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_expm_create([Out] out IntPtr handle, int n, [In] Complex[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_expm_compute([In] IntPtr handle, float t, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_expm_compute([In] IntPtr handle, double t, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_expm_compute([In] IntPtr handle, Complex32 t, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_expm_compute([In] IntPtr handle, Complex t, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_expm_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_expm_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_expm_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_expm_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_expm_batch(int n, int count, [In] float[] a, [In, Out] float[] result, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_expm_batch(int n, int count, [In] double[] a, [In, Out] double[] result, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_expm_batch(int n, int count, [In] Complex32[] a, [In, Out] Complex32[] result, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_expm_batch(int n, int count, [In] Complex[] a, [In, Out] Complex[] result, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sqrtm(int n, [In] float[] a, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sqrtm(int n, [In] double[] a, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sqrtm(int n, [In] Complex32[] a, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sqrtm(int n, [In] Complex[] a, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_logm(int n, [In] float[] a, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_logm(int n, [In] double[] a, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_logm(int n, [In] Complex32[] a, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_logm(int n, [In] Complex[] a, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sylvester_solve(int m, int n, [In] float[] a, [In] float[] b, [In, Out] float[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sylvester_solve(int m, int n, [In] double[] a, [In] double[] b, [In, Out] double[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sylvester_solve(int m, int n, [In] Complex32[] a, [In] Complex32[] b, [In, Out] Complex32[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sylvester_solve(int m, int n, [In] Complex[] a, [In] Complex[] b, [In, Out] Complex[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sylvester_solve_recursive(int m, int n, [In] float[] a, [In] float[] b, [In, Out] float[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sylvester_solve_recursive(int m, int n, [In] double[] a, [In] double[] b, [In, Out] double[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sylvester_solve_recursive(int m, int n, [In] Complex32[] a, [In] Complex32[] b, [In, Out] Complex32[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sylvester_solve_recursive(int m, int n, [In] Complex[] a, [In] Complex[] b, [In, Out] Complex[] c);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lyapunov_solve(int n, [In] float[] a, [In, Out] float[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lyapunov_solve(int n, [In] double[] a, [In, Out] double[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lyapunov_solve(int n, [In] Complex32[] a, [In, Out] Complex32[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lyapunov_solve(int n, [In] Complex[] a, [In, Out] Complex[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_lyapunov_solve_recursive(int n, [In] float[] a, [In, Out] float[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_lyapunov_solve_recursive(int n, [In] double[] a, [In, Out] double[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_lyapunov_solve_recursive(int n, [In] Complex32[] a, [In, Out] Complex32[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_lyapunov_solve_recursive(int n, [In] Complex[] a, [In, Out] Complex[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_transpose(byte trans, int rows, int columns, float alpha, [In] float[] a, [Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_transpose(byte trans, int rows, int columns, double alpha, [In] double[] a, [Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_transpose(byte trans, int rows, int columns, Complex32 alpha, [In] Complex32[] a, [Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_transpose(byte trans, int rows, int columns, Complex alpha, [In] Complex[] a, [Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_transpose_inplace(byte trans, int rows, int columns, float alpha, [In, Out] float[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_transpose_inplace(byte trans, int rows, int columns, double alpha, [In, Out] double[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_transpose_inplace(byte trans, int rows, int columns, Complex32 alpha, [In, Out] Complex32[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_transpose_inplace(byte trans, int rows, int columns, Complex alpha, [In, Out] Complex[] a);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_factor(int m, int n, [In, Out] float[] r, [In, Out] float[] tau, [In, Out] float[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_factor(int m, int n, [In, Out] double[] r, [In, Out] double[] tau, [In, Out] double[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_factor(int m, int n, [In, Out] Complex32[] r, [In, Out] Complex32[] tau, [In, Out] Complex32[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_factor(int m, int n, [In, Out] Complex[] r, [In, Out] Complex[] tau, [In, Out] Complex[] q);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_thin_factor(int m, int n, [In, Out] float[] q, [In, Out] float[] tau, [In, Out] float[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_thin_factor(int m, int n, [In, Out] double[] q, [In, Out] double[] tau, [In, Out] double[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_thin_factor(int m, int n, [In, Out] Complex32[] q, [In, Out] Complex32[] tau, [In, Out] Complex32[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_thin_factor(int m, int n, [In, Out] Complex[] q, [In, Out] Complex[] tau, [In, Out] Complex[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_pivot_factor(int m, int n, [In, Out] float[] q, [In, Out] float[] tau, [In, Out] float[] r, [In, Out] int[] jpvt, float tolerance, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_pivot_factor(int m, int n, [In, Out] double[] q, [In, Out] double[] tau, [In, Out] double[] r, [In, Out] int[] jpvt, double tolerance, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_pivot_factor(int m, int n, [In, Out] Complex32[] q, [In, Out] Complex32[] tau, [In, Out] Complex32[] r, [In, Out] int[] jpvt, float tolerance, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_pivot_factor(int m, int n, [In, Out] Complex[] q, [In, Out] Complex[] tau, [In, Out] Complex[] r, [In, Out] int[] jpvt, double tolerance, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_solve(int m, int n, int bn, float[] r, float[] b, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_solve(int m, int n, int bn, double[] r, double[] b, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_solve(int m, int n, int bn, Complex32[] r, Complex32[] b, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_solve(int m, int n, int bn, Complex[] r, Complex[] b, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_solve_rm(int m, int n, int bn, float[] r, float[] b, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_solve_rm(int m, int n, int bn, double[] r, double[] b, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_solve_rm(int m, int n, int bn, Complex32[] r, Complex32[] b, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_solve_rm(int m, int n, int bn, Complex[] r, Complex[] b, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_solve_inplace(int m, int n, int bn, [In, Out] float[] r, [In, Out] float[] b, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_solve_inplace(int m, int n, int bn, [In, Out] double[] r, [In, Out] double[] b, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_solve_inplace(int m, int n, int bn, [In, Out] Complex32[] r, [In, Out] Complex32[] b, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_solve_inplace(int m, int n, int bn, [In, Out] Complex[] r, [In, Out] Complex[] b, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_solve_rank_revealing(int m, int n, int bn, float[] a, float[] b, [In, Out] float[] x, float rcond, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_solve_rank_revealing(int m, int n, int bn, double[] a, double[] b, [In, Out] double[] x, double rcond, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_solve_rank_revealing(int m, int n, int bn, Complex32[] a, Complex32[] b, [In, Out] Complex32[] x, float rcond, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_solve_rank_revealing(int m, int n, int bn, Complex[] a, Complex[] b, [In, Out] Complex[] x, double rcond, out int rank);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tsqr_tau_size(int m, int n);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tsqr_tau_size(int m, int n);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tsqr_tau_size(int m, int n);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tsqr_tau_size(int m, int n);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tsqr_factor(int m, int n, [In, Out] float[] a, [In, Out] float[] r, [In, Out] float[] tau);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tsqr_factor(int m, int n, [In, Out] double[] a, [In, Out] double[] r, [In, Out] double[] tau);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tsqr_factor(int m, int n, [In, Out] Complex32[] a, [In, Out] Complex32[] r, [In, Out] Complex32[] tau);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tsqr_factor(int m, int n, [In, Out] Complex[] a, [In, Out] Complex[] r, [In, Out] Complex[] tau);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tsqr_thin_factor(int m, int n, [In, Out] float[] q, [In, Out] float[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tsqr_thin_factor(int m, int n, [In, Out] double[] q, [In, Out] double[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tsqr_thin_factor(int m, int n, [In, Out] Complex32[] q, [In, Out] Complex32[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tsqr_thin_factor(int m, int n, [In, Out] Complex[] q, [In, Out] Complex[] r);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tsqr_solve_factored(int m, int n, int bn, float[] a, float[] b, float[] tau, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tsqr_solve_factored(int m, int n, int bn, double[] a, double[] b, double[] tau, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tsqr_solve_factored(int m, int n, int bn, Complex32[] a, Complex32[] b, Complex32[] tau, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tsqr_solve_factored(int m, int n, int bn, Complex[] a, Complex[] b, Complex[] tau, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tsqr_solve(int m, int n, int bn, float[] a, float[] b, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tsqr_solve(int m, int n, int bn, double[] a, double[] b, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tsqr_solve(int m, int n, int bn, Complex32[] a, Complex32[] b, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tsqr_solve(int m, int n, int bn, Complex[] a, Complex[] b, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_band_lu_factor(int n, int kl, int ku, [In, Out] float[] ab, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_band_lu_factor(int n, int kl, int ku, [In, Out] double[] ab, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_band_lu_factor(int n, int kl, int ku, [In, Out] Complex32[] ab, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_band_lu_factor(int n, int kl, int ku, [In, Out] Complex[] ab, [In, Out] int[] ipiv);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_band_lu_solve_factored(int n, int kl, int ku, int nrhs, float[] ab, [In, Out] int[] ipiv, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_band_lu_solve_factored(int n, int kl, int ku, int nrhs, double[] ab, [In, Out] int[] ipiv, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_band_lu_solve_factored(int n, int kl, int ku, int nrhs, Complex32[] ab, [In, Out] int[] ipiv, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_band_lu_solve_factored(int n, int kl, int ku, int nrhs, Complex[] ab, [In, Out] int[] ipiv, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_band_lu_solve(int n, int kl, int ku, int nrhs, float[] ab, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_band_lu_solve(int n, int kl, int ku, int nrhs, double[] ab, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_band_lu_solve(int n, int kl, int ku, int nrhs, Complex32[] ab, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_band_lu_solve(int n, int kl, int ku, int nrhs, Complex[] ab, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_band_cholesky_solve(int n, int kd, int nrhs, float[] ab, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_band_cholesky_solve(int n, int kd, int nrhs, double[] ab, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_band_cholesky_solve(int n, int kd, int nrhs, Complex32[] ab, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_band_cholesky_solve(int n, int kd, int nrhs, Complex[] ab, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tridiagonal_solve(int n, int nrhs, float[] dl, float[] d, float[] du, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tridiagonal_solve(int n, int nrhs, double[] dl, double[] d, double[] du, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tridiagonal_solve(int n, int nrhs, Complex32[] dl, Complex32[] d, Complex32[] du, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tridiagonal_solve(int n, int nrhs, Complex[] dl, Complex[] d, Complex[] du, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tridiagonal_cholesky_solve(int n, int nrhs, float[] d, float[] e, [In, Out] float[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tridiagonal_cholesky_solve(int n, int nrhs, double[] d, double[] e, [In, Out] double[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tridiagonal_cholesky_solve(int n, int nrhs, float[] d, Complex32[] e, [In, Out] Complex32[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tridiagonal_cholesky_solve(int n, int nrhs, double[] d, Complex[] e, [In, Out] Complex[] b);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_tridiagonal_solve_batch(int n, int count, float[] dl, float[] d, float[] du, [In, Out] float[] b, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_tridiagonal_solve_batch(int n, int count, double[] dl, double[] d, double[] du, [In, Out] double[] b, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_tridiagonal_solve_batch(int n, int count, Complex32[] dl, Complex32[] d, Complex32[] du, [In, Out] Complex32[] b, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_tridiagonal_solve_batch(int n, int count, Complex[] dl, Complex[] d, Complex[] du, [In, Out] Complex[] b, [In, Out] int[] info);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_qr_solve_factored(int m, int n, int bn, float[] r, float[] b, float[] tau, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_qr_solve_factored(int m, int n, int bn, double[] r, double[] b, double[] tau, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_qr_solve_factored(int m, int n, int bn, Complex32[] r, Complex32[] b, Complex32[] tau, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_qr_solve_factored(int m, int n, int bn, Complex[] r, Complex[] b, Complex[] tau, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] float[] a, [In, Out] float[] s, [In, Out] float[] u, [In, Out] float[] v);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] double[] a, [In, Out] double[] s, [In, Out] double[] u, [In, Out] double[] v);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] Complex32[] a, [In, Out] Complex32[] s, [In, Out] Complex32[] u, [In, Out] Complex32[] v);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_svd_factor([MarshalAs(UnmanagedType.U1)] bool computeVectors, int m, int n, [In, Out] Complex[] a, [In, Out] Complex[] s, [In, Out] Complex[] u, [In, Out] Complex[] v);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] float[] a, [In, Out] float[] vectors, [In, Out] Complex[] values, [In, Out] float[] d);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] double[] a, [In, Out] double[] vectors, [In, Out] Complex[] values, [In, Out] double[] d);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] Complex32[] a, [In, Out] Complex32[] vectors, [In, Out] Complex[] values, [In, Out] Complex32[] d);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_eigen([MarshalAs(UnmanagedType.U1)] bool isSymmetric, int n, [In] Complex[] a, [In, Out] Complex[] vectors, [In, Out] Complex[] values, [In, Out] Complex[] d);
+
+        #endregion LAPACK
+
+        #region Fused Kernels
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void s_fused_axpby(int n, float alpha, float[] x, float beta, float[] y, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void d_fused_axpby(int n, double alpha, double[] x, double beta, double[] y, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_fused_axpby(int n, Complex32 alpha, Complex32[] x, Complex32 beta, Complex32[] y, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_fused_axpby(int n, Complex alpha, Complex[] x, Complex beta, Complex[] y, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void s_fused_axpbypcz(int n, float alpha, float[] x, float beta, float[] y, float gamma, float[] z, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void d_fused_axpbypcz(int n, double alpha, double[] x, double beta, double[] y, double gamma, double[] z, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_fused_axpbypcz(int n, Complex32 alpha, Complex32[] x, Complex32 beta, Complex32[] y, Complex32 gamma, Complex32[] z, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_fused_axpbypcz(int n, Complex alpha, Complex[] x, Complex beta, Complex[] y, Complex gamma, Complex[] z, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void s_fused_multiply_add(int n, float[] x, float[] y, float[] z, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void d_fused_multiply_add(int n, double[] x, double[] y, double[] z, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_fused_multiply_add(int n, Complex32[] x, Complex32[] y, Complex32[] z, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_fused_multiply_add(int n, Complex[] x, Complex[] y, Complex[] z, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void s_fused_linear_frac(int n, float[] x, float[] y, float scaleX, float shiftX, float scaleY, float shiftY, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void d_fused_linear_frac(int n, double[] x, double[] y, double scaleX, double shiftX, double scaleY, double shiftY, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_fused_evaluate(int n, int instructions, int[] program, int constantCount, float[] constants, int inputCount, IntPtr[] inputs, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_fused_evaluate(int n, int instructions, int[] program, int constantCount, double[] constants, int inputCount, IntPtr[] inputs, [In, Out] double[] result);
+
+        #endregion Fused Kernels
+
+        #region Reductions
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float s_nrm2(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double d_nrm2(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float c_nrm2(int n, Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double z_nrm2(int n, Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float s_asum(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double d_asum(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float c_asum(int n, Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double z_asum(int n, Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_iamax(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_iamax(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_iamax(int n, Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_iamax(int n, Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_iamin(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_iamin(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_iamin(int n, Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_iamin(int n, Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float s_sum(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double d_sum(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_sum(int n, Complex32[] x, out Complex32 result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_sum(int n, Complex[] x, out Complex result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float s_max(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double d_max(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern float s_min(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern double d_min(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_argmax(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_argmax(int n, double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_argmin(int n, float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_argmin(int n, double[] x);
+
+        #endregion Reductions
+
+        #region Complex Functions
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_conjugate(int n, Complex32[] x, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_conjugate(int n, Complex[] x, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_abs(int n, Complex32[] x, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_abs(int n, Complex[] x, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_arg(int n, Complex32[] x, [In, Out] float[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_arg(int n, Complex[] x, [In, Out] double[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_from_polar(int n, float[] magnitude, float[] phase, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_from_polar(int n, double[] magnitude, double[] phase, [In, Out] Complex[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_split(int n, Complex32[] x, [In, Out] float[] real, [In, Out] float[] imaginary);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_split(int n, Complex[] x, [In, Out] double[] real, [In, Out] double[] imaginary);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void c_merge(int n, float[] real, float[] imaginary, [In, Out] Complex32[] result);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void z_merge(int n, double[] real, double[] imaginary, [In, Out] Complex[] result);
+
+        #endregion Complex Functions
+
+        #region Sparse Kernels
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_product_symbolic([Out] out IntPtr handle, int m, int k, int n, [In] int[] aRowPointers, [In] int[] aColumnIndices, [In] int[] bRowPointers, [In] int[] bColumnIndices, out int nonZerosCount);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_product_symbolic([Out] out IntPtr handle, int m, int k, int n, [In] int[] aRowPointers, [In] int[] aColumnIndices, [In] int[] bRowPointers, [In] int[] bColumnIndices, out int nonZerosCount);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_product_symbolic([Out] out IntPtr handle, int m, int k, int n, [In] int[] aRowPointers, [In] int[] aColumnIndices, [In] int[] bRowPointers, [In] int[] bColumnIndices, out int nonZerosCount);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_product_symbolic([Out] out IntPtr handle, int m, int k, int n, [In] int[] aRowPointers, [In] int[] aColumnIndices, [In] int[] bRowPointers, [In] int[] bColumnIndices, out int nonZerosCount);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_product_numeric([In] IntPtr handle, [In] float[] aValues, [In] float[] bValues, [Out] int[] cRowPointers, [Out] int[] cColumnIndices, [Out] float[] cValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_product_numeric([In] IntPtr handle, [In] double[] aValues, [In] double[] bValues, [Out] int[] cRowPointers, [Out] int[] cColumnIndices, [Out] double[] cValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_product_numeric([In] IntPtr handle, [In] Complex32[] aValues, [In] Complex32[] bValues, [Out] int[] cRowPointers, [Out] int[] cColumnIndices, [Out] Complex32[] cValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_product_numeric([In] IntPtr handle, [In] Complex[] aValues, [In] Complex[] bValues, [Out] int[] cRowPointers, [Out] int[] cColumnIndices, [Out] Complex[] cValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_product_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_product_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_product_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_product_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_transpose(int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, [Out] int[] tRowPointers, [Out] int[] tColumnIndices, [Out] float[] tValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_transpose(int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, [Out] int[] tRowPointers, [Out] int[] tColumnIndices, [Out] double[] tValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_transpose(int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, [Out] int[] tRowPointers, [Out] int[] tColumnIndices, [Out] Complex32[] tValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_transpose(int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, [Out] int[] tRowPointers, [Out] int[] tColumnIndices, [Out] Complex[] tValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_triangular_create([Out] out IntPtr handle, byte uplo, byte diag, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_triangular_create([Out] out IntPtr handle, byte uplo, byte diag, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_triangular_create([Out] out IntPtr handle, byte uplo, byte diag, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_triangular_create([Out] out IntPtr handle, byte uplo, byte diag, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_triangular_solve([In] IntPtr handle, [In] float[] b, [In, Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_triangular_solve([In] IntPtr handle, [In] double[] b, [In, Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_triangular_solve([In] IntPtr handle, [In] Complex32[] b, [In, Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_triangular_solve([In] IntPtr handle, [In] Complex[] b, [In, Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_triangular_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_triangular_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_triangular_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_triangular_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_ilu0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_ilu0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_ilu0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_ilu0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_ic0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_ic0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_ic0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_ic0_create([Out] out IntPtr handle, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, out int nnz);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_incomplete_export([In] IntPtr handle, [Out] int[] rowPointers, [Out] int[] columnIndices, [Out] float[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_incomplete_export([In] IntPtr handle, [Out] int[] rowPointers, [Out] int[] columnIndices, [Out] double[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_incomplete_export([In] IntPtr handle, [Out] int[] rowPointers, [Out] int[] columnIndices, [Out] Complex32[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_incomplete_export([In] IntPtr handle, [Out] int[] rowPointers, [Out] int[] columnIndices, [Out] Complex[] values);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_preconditioner_apply([In] IntPtr handle, [In] float[] b, [Out] float[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_preconditioner_apply([In] IntPtr handle, [In] double[] b, [Out] double[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_preconditioner_apply([In] IntPtr handle, [In] Complex32[] b, [Out] Complex32[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_preconditioner_apply([In] IntPtr handle, [In] Complex[] b, [Out] Complex[] x);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_preconditioner_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_preconditioner_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_preconditioner_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_preconditioner_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_cg(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, IntPtr preconditioner, [In] float[] b, [In, Out] float[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_cg(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, IntPtr preconditioner, [In] double[] b, [In, Out] double[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_cg(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, IntPtr preconditioner, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_cg(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, IntPtr preconditioner, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_bicgstab(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, IntPtr preconditioner, [In] float[] b, [In, Out] float[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_bicgstab(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, IntPtr preconditioner, [In] double[] b, [In, Out] double[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_bicgstab(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, IntPtr preconditioner, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_bicgstab(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, IntPtr preconditioner, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_gmres(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, IntPtr preconditioner, [In] float[] b, [In, Out] float[] x, int maxIterations, int restart, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_gmres(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, IntPtr preconditioner, [In] double[] b, [In, Out] double[] x, int maxIterations, int restart, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_gmres(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, IntPtr preconditioner, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, int restart, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_gmres(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, IntPtr preconditioner, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, int restart, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        internal delegate int SparseCallback(IntPtr context, IntPtr x, IntPtr y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_free_cg(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] float[] b, [In, Out] float[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_free_cg(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] double[] b, [In, Out] double[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_free_cg(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_free_cg(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_free_bicgstab(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] float[] b, [In, Out] float[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_free_bicgstab(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] double[] b, [In, Out] double[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_free_bicgstab(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_free_bicgstab(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_free_gmres(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] float[] b, [In, Out] float[] x, int maxIterations, int restart, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_free_gmres(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] double[] b, [In, Out] double[] x, int maxIterations, int restart, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_free_gmres(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex32[] b, [In, Out] Complex32[] x, int maxIterations, int restart, float tolerance, float absoluteTolerance, out int iterations, [Out] float[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_free_gmres(int n, SparseCallback multiply, SparseCallback precondition, IntPtr context, [In] Complex[] b, [In, Out] Complex[] x, int maxIterations, int restart, double tolerance, double absoluteTolerance, out int iterations, [Out] double[] residuals, out double seconds);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int sparse_reorder_rcm(int n, [In] int[] rowPointers, [In] int[] columnIndices, [Out] int[] permutation, [Out] int[] inverse);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int sparse_reorder_amd(int n, [In] int[] rowPointers, [In] int[] columnIndices, [Out] int[] permutation, [Out] int[] inverse);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int sparse_reorder_nested_dissection(int n, [In] int[] rowPointers, [In] int[] columnIndices, [Out] int[] permutation, [Out] int[] inverse);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_permute(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, [In] int[] permutation, [Out] int[] permutedRowPointers, [Out] int[] permutedColumnIndices, [Out] float[] permutedValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_permute(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, [In] int[] permutation, [Out] int[] permutedRowPointers, [Out] int[] permutedColumnIndices, [Out] double[] permutedValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_permute(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, [In] int[] permutation, [Out] int[] permutedRowPointers, [Out] int[] permutedColumnIndices, [Out] Complex32[] permutedValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_permute(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, [In] int[] permutation, [Out] int[] permutedRowPointers, [Out] int[] permutedColumnIndices, [Out] Complex[] permutedValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int sparse_bsr_count(int m, int n, int block, [In] int[] rowPointers, [In] int[] columnIndices, [Out] int[] blockRowPointers);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_to_bsr(int m, int n, int block, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, [In] int[] blockRowPointers, [Out] int[] blockColumnIndices, [Out] float[] blockValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_to_bsr(int m, int n, int block, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, [In] int[] blockRowPointers, [Out] int[] blockColumnIndices, [Out] double[] blockValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_to_bsr(int m, int n, int block, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, [In] int[] blockRowPointers, [Out] int[] blockColumnIndices, [Out] Complex32[] blockValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_to_bsr(int m, int n, int block, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, [In] int[] blockRowPointers, [Out] int[] blockColumnIndices, [Out] Complex[] blockValues);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_bsr_mv(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] float[] blockValues, [In] float[] x, [Out] float[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_bsr_mv(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] double[] blockValues, [In] double[] x, [Out] double[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_bsr_mv(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] Complex32[] blockValues, [In] Complex32[] x, [Out] Complex32[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_bsr_mv(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] Complex[] blockValues, [In] Complex[] x, [Out] Complex[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_bsr_mm(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] float[] blockValues, int columns, [In] float[] x, [Out] float[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_bsr_mm(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] double[] blockValues, int columns, [In] double[] x, [Out] double[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_bsr_mm(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] Complex32[] blockValues, int columns, [In] Complex32[] x, [Out] Complex32[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_bsr_mm(int blockRows, int blockColumns, int block, [In] int[] blockRowPointers, [In] int[] blockColumnIndices, [In] Complex[] blockValues, int columns, [In] Complex[] x, [Out] Complex[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, int matrixType, int fillMode, int diagType, int expectedCalls);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, int matrixType, int fillMode, int diagType, int expectedCalls);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, int matrixType, int fillMode, int diagType, int expectedCalls);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, int matrixType, int fillMode, int diagType, int expectedCalls);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_mv(IntPtr handle, [In] float[] x, [Out] float[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_mv(IntPtr handle, [In] double[] x, [Out] double[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_mv(IntPtr handle, [In] Complex32[] x, [Out] Complex32[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_mv(IntPtr handle, [In] Complex[] x, [Out] Complex[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_mv_descr(int m, int n, [In] float[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] float[] x, [Out] float[] y, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_mv_descr(int m, int n, [In] double[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] double[] x, [Out] double[] y, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_mv_descr(int m, int n, [In] Complex32[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] Complex32[] x, [Out] Complex32[] y, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_mv_descr(int m, int n, [In] Complex[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] Complex[] x, [Out] Complex[] y, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_csr_mm_descr(int m, int k, int n, [In] float[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] float[] b, [Out] float[] c, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_csr_mm_descr(int m, int k, int n, [In] double[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] double[] b, [Out] double[] c, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_csr_mm_descr(int m, int k, int n, [In] Complex32[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] Complex32[] b, [Out] Complex32[] c, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_csr_mm_descr(int m, int k, int n, [In] Complex[] values, [In] int[] rowPointers, [In] int[] columnIndices, int nnz, [In] Complex[] b, [Out] Complex[] c, int matrixType, int fillMode, int diagType);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int sparse_sell_instruction_set();
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_sell_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, int chunk, int sigma, out int padded);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_sell_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, int chunk, int sigma, out int padded);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_sell_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, int chunk, int sigma, out int padded);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_sell_create([Out] out IntPtr handle, int m, int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, int chunk, int sigma, out int padded);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_sell_mv(IntPtr handle, [In] float[] x, [Out] float[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_sell_mv(IntPtr handle, [In] double[] x, [Out] double[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_sell_mv(IntPtr handle, [In] Complex32[] x, [Out] Complex32[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_sell_mv(IntPtr handle, [In] Complex[] x, [Out] Complex[] y);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_sell_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_sell_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_sell_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_sell_free([In] ref IntPtr handle);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_sparse_eigen(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] float[] values, int which, int k, float sigma, float lower, float upper, int subspace, int maxRestarts, float tolerance, [Out] float[] eigenvalues, [Out] float[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_sparse_eigen(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] double[] values, int which, int k, double sigma, double lower, double upper, int subspace, int maxRestarts, double tolerance, [Out] double[] eigenvalues, [Out] double[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_sparse_eigen(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex32[] values, int which, int k, float sigma, float lower, float upper, int subspace, int maxRestarts, float tolerance, [Out] float[] eigenvalues, [Out] Complex32[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_sparse_eigen(int n, [In] int[] rowPointers, [In] int[] columnIndices, [In] Complex[] values, int which, int k, double sigma, double lower, double upper, int subspace, int maxRestarts, double tolerance, [Out] double[] eigenvalues, [Out] Complex[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int s_matrix_free_eigen(int n, SparseCallback apply, IntPtr context, int which, int k, float sigma, float lower, float upper, int subspace, int maxRestarts, float tolerance, [Out] float[] eigenvalues, [Out] float[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int d_matrix_free_eigen(int n, SparseCallback apply, IntPtr context, int which, int k, double sigma, double lower, double upper, int subspace, int maxRestarts, double tolerance, [Out] double[] eigenvalues, [Out] double[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int c_matrix_free_eigen(int n, SparseCallback apply, IntPtr context, int which, int k, float sigma, float lower, float upper, int subspace, int maxRestarts, float tolerance, [Out] float[] eigenvalues, [Out] Complex32[] eigenvectors, out int found, out int restarts);
+
+        [DllImport(DllName, ExactSpelling = true, SetLastError = false, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int z_matrix_free_eigen(int n, SparseCallback apply, IntPtr context, int which, int k, double sigma, double lower, double upper, int subspace, int maxRestarts, double tolerance, [Out] double[] eigenvalues, [Out] Complex[] eigenvectors, out int found, out int restarts);
+
+        #endregion Sparse Kernels
     }
 }